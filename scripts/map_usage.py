@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""
+Static RAM usage per module from a GNU ld map file.
+
+Sums the input sections placed in the .data and .bss output sections (and the
+RP2040 scratch / uninitialized sections) by the object file they came from.
+
+Usage: python3 scripts/map_usage.py build/AirSense.elf.map [-o report.txt] [--top N]
+
+The firmware build runs it after linking and writes AirSense.ram.txt next to the .elf.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Output section -> column of the report
+SECTION_KIND = {
+    ".data": "data",
+    ".ram_vector_table": "data",
+    ".scratch_x": "data",
+    ".scratch_y": "data",
+    ".bss": "bss",
+    ".uninitialized_data": "bss",
+}
+
+OUTPUT_RE = re.compile(r"^(\.\S+)(?:\s+0x[0-9a-fA-F]+\s+0x[0-9a-fA-F]+.*)?$")
+INPUT_RE = re.compile(r"^ (\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(.+))?$")
+CONT_RE = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*)$")
+
+
+def module_name(obj):
+    obj = obj.strip()
+    archive = re.match(r"^(.*\.a)\((.+)\)$", obj)
+    if archive:
+        return "%s(%s)" % (os.path.basename(archive.group(1)), archive.group(2))
+    name = os.path.basename(obj)
+    for suffix in (".obj", ".o"):
+        if name.endswith(suffix):
+            return name[:-len(suffix)]
+    return name
+
+
+def parse(lines):
+    usage = {}
+    in_map = False
+    kind = None
+    pending = None      # Input section whose address/size/object follow on the next line
+
+    def add(size, obj):
+        if kind is None or size == 0:
+            return
+        entry = usage.setdefault(module_name(obj), {"data": 0, "bss": 0})
+        entry[kind] += size
+
+    for line in lines:
+        line = line.rstrip("\n")
+        if not in_map:
+            in_map = line.startswith("Linker script and memory map")
+            continue
+
+        if pending is not None:
+            m = CONT_RE.match(line)
+            if m:
+                add(int(m.group(2), 16), m.group(3))
+            pending = None
+            continue
+
+        if line and not line[0].isspace():
+            m = OUTPUT_RE.match(line)
+            kind = SECTION_KIND.get(m.group(1)) if m else None
+            continue
+
+        m = INPUT_RE.match(line)
+        if not m or kind is None or m.group(1).startswith("*"):
+            continue
+        if m.group(2) is None:
+            pending = m.group(1)
+        else:
+            add(int(m.group(3), 16), m.group(4))
+    return usage
+
+
+def report(usage, top):
+    rows = sorted(usage.items(), key=lambda kv: kv[1]["data"] + kv[1]["bss"], reverse=True)
+    total_data = sum(v["data"] for v in usage.values())
+    total_bss = sum(v["bss"] for v in usage.values())
+    width = max([len(name) for name, _ in rows] + [len("TOTAL")])
+    out = ["%-*s %8s %8s %8s" % (width, "module", "data", "bss", "total")]
+    for name, v in rows[:top] if top else rows:
+        out.append("%-*s %8d %8d %8d" % (width, name, v["data"], v["bss"], v["data"] + v["bss"]))
+    out.append("%-*s %8d %8d %8d" % (width, "TOTAL", total_data, total_bss, total_data + total_bss))
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Static RAM usage per module from a GNU ld map file")
+    parser.add_argument("map", help="Linker map file (e.g. AirSense.elf.map)")
+    parser.add_argument("-o", "--output", help="Write the report to this file as well")
+    parser.add_argument("--top", type=int, default=0, help="Only list the N largest modules")
+    args = parser.parse_args()
+
+    try:
+        with open(args.map, "r", errors="replace") as f:
+            usage = parse(f)
+    except OSError as e:
+        print("map_usage: %s" % e, file=sys.stderr)
+        return 1
+
+    text = report(usage, args.top)
+    if args.output:
+        # Keep build logs short: full table in the file, totals on stdout
+        with open(args.output, "w") as f:
+            f.write(text)
+        sys.stdout.write("static RAM: " + text.splitlines()[-1] + "\n")
+    else:
+        sys.stdout.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
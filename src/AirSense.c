@@ -1,23 +1,683 @@
 #include <stdio.h>
+#include <string.h>
 #include "pico/stdlib.h"
+#include "hardware/watchdog.h"
 #include "pm2_5.h"
 #include "pm2_5_hal.h"
+#include "pm2_5_hal_pio.h"
+#include "pin_config.h"
+#include "temp_hum.h"
+#include "i2c_bus.h"
+#include "fixed_point.h"
+#include "aqi.h"
+#include "spike_filter.h"
+#include "adaptive_rate.h"
+#include "sample_cache.h"
+#include "sample_assembly.h"
+#include "wifi.h"
+#include "mqtt_client.h"
+#include "report_by_exception.h"
+#include "diagnostics.h"
+#include "clock_policy.h"
+#include "power_mgr.h"
+#include "boot_seq.h"
+#include "sample_archive.h"
+#include "runtime_config.h"
+#include "metrics_page.h"
+#include "http_server.h"
+#include "http_listen.h"
+#include "mqtt_config.h"
+#include "wifi_config.h"
+#include "archive_config.h"
+#include "http_config.h"
+
+#define PM25_SENSOR_COUNT (1 + PMS_PIO_SENSOR_COUNT)
+
+_Static_assert(PM25_SENSOR_COUNT <= HTTP_MAX_SENSORS, "raise HTTP_MAX_SENSORS with PMS_PIO_SENSOR_COUNT");
+_Static_assert(PM25_SENSOR_COUNT <= ARCHIVE_MAX_SOURCES, "raise ARCHIVE_MAX_SOURCES with PMS_PIO_SENSOR_COUNT");
+
+// Wake-up period of the main loop while boot phases are still running
+#define BOOT_POLL_MS 50
+
+// Watchdog scratch register that records whether the sensors were running; it survives a watchdog reboot only
+#define SCRATCH_SENSORS_AWAKE 0
+#define SENSORS_AWAKE_MAGIC 0x504D5341u
+
+// Latest filtered sample of every sensor, for consumers that must not touch the UART
+static sample_cache_t pm25_latest;
+static i2c_bus_t sensor_bus;
+
+static boot_seq_t boot;
+static int boot_pms = -1;
+static bool boot_finished = false;
+static bool boot_reported = false;
+static uint32_t first_sample_ms = 0;
+
+// Every filtered sample goes to the flash archive; blocks are sent back on request
+static sample_archive_t archive;
+static bool archive_ready = false;
+static volatile bool archive_get_pending = false;
+static volatile uint32_t archive_get_args[3];
+static volatile int archive_get_argc;
+static uint32_t archive_send_seq;
+static uint32_t archive_send_end;
+
+// Runtime configuration: written by the MQTT handler, applied by the main loop between samples
+static runtime_config_store_t runtime_config;
+
+// Local /metrics and /latest endpoints, rebuilt after every sample and served as they are
+static metrics_page_t metrics_page;
+static http_server_t http;
+
+static uint32_t mqtt_lane_high_water(void *ctx) {
+    const mqtt_lane_stats_t *stats = get_mqtt_lane_stats((mqtt_lane_t)(uintptr_t)ctx);
+    return (stats != NULL) ? stats->max_depth : 0;
+}
+
+static uint32_t pio_ring_high_water(void *ctx) {
+    return pm25_pio_uart_max_fill((uart_inst_t *)ctx);
+}
+
+// clk_peri follows clk_sys, so UART and PIO baud dividers are re-derived after every clock change
+static void reclock_uarts(uint32_t sys_hz, void *ctx) {
+    (void)sys_hz;
+    (void)ctx;
+    uart_set_baudrate(PMS_UART, PMS_BAUD_RATE);
+    pm25_pio_uart_reclock();
+}
+
+typedef struct {
+    pm25_sensor_t *sensors;
+    int count;
+} pm25_sensor_set_t;
+
+// The hardware UART is not clocked in deep sleep, so a frame may have started before the wake-up
+static void resync_sensors(power_wake_t cause, void *ctx) {
+    (void)cause;
+    const pm25_sensor_set_t *set = (const pm25_sensor_set_t *)ctx;
+    for (int i = 0; i < set->count; i++) {
+        pm25_sensor_resync(&set->sensors[i]);
+    }
+}
+
+static void mark_sensors_awake(bool awake) {
+    watchdog_hw->scratch[SCRATCH_SENSORS_AWAKE] = awake ? SENSORS_AWAKE_MAGIC : 0;
+}
+
+// Boot phases: each one kicks its work off and is polled until done (boot_seq.h)
+static boot_step_t pms_warmup_poll(void *ctx, uint32_t elapsed_ms) {
+    const uint32_t *warmup_ms = (const uint32_t *)ctx;
+    return (elapsed_ms >= *warmup_ms) ? BOOT_STEP_DONE : BOOT_STEP_PENDING;
+}
+
+static bool sht3x_start(void *ctx) {
+    (void)ctx;
+    gpio_set_function(SENSOR_I2C_SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(SENSOR_I2C_SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(SENSOR_I2C_SDA_PIN);
+    gpio_pull_up(SENSOR_I2C_SCL_PIN);
+    i2c_bus_init(&sensor_bus, SENSOR_I2C, SENSOR_I2C_BAUD, NULL);
+    if (!init_temp_hum_sensor(&sensor_bus)) {
+        printf("SHT3x not responding\n");
+        return false;
+    }
+    return true;
+}
+
+static bool radio_start(void *ctx) {
+    (void)ctx;
+    return init_wifi();
+}
+
+static bool join_start(void *ctx) {
+    (void)ctx;
+    return wifi_connect_start();
+}
+
+// Done once the state has reached the one in ctx
+static boot_step_t wifi_poll(void *ctx, uint32_t elapsed_ms) {
+    (void)elapsed_ms;
+    wifi_state_t target = *(const wifi_state_t *)ctx;
+    wifi_state_t state = wifi_get_state();
+    if (state == WIFI_STATE_FAILED) {
+        return BOOT_STEP_FAILED;
+    }
+    return (state >= target) ? BOOT_STEP_DONE : BOOT_STEP_PENDING;
+}
+
+static bool mqtt_start(void *ctx) {
+    (void)ctx;
+    return start_mqtt_client();
+}
+
+static boot_step_t mqtt_poll(void *ctx, uint32_t elapsed_ms) {
+    (void)ctx;
+    (void)elapsed_ms;
+    return is_mqtt_connected() ? BOOT_STEP_DONE : BOOT_STEP_PENDING;
+}
+
+static bool archive_start(void *ctx) {
+    (void)ctx;
+    archive_ready = sample_archive_init(&archive, archive_get_pico_flash());
+    if (!archive_ready) {
+        printf("Sample archive disabled: program image overlaps the archive region\n");
+    }
+    return archive_ready;
+}
+
+static bool http_start(void *ctx) {
+    (void)ctx;
+    return http_listen_start(&http, HTTP_PORT);
+}
+
+static void boot_build(uint32_t pms_warmup_ms) {
+    static uint32_t warmup_ms;
+    static const wifi_state_t joined = WIFI_STATE_NO_IP;
+    static const wifi_state_t leased = WIFI_STATE_UP;
+    warmup_ms = pms_warmup_ms;
+
+    boot_seq_init(&boot);
+    boot_task_t pms = { .name = "pms", .poll = pms_warmup_poll, .ctx = &warmup_ms };
+    boot_pms = boot_seq_add(&boot, &pms);
+    boot_task_t sht3x = { .name = "sht3x", .start = sht3x_start };
+    boot_seq_add(&boot, &sht3x);
+    boot_task_t radio = { .name = "radio", .start = radio_start };
+    int radio_id = boot_seq_add(&boot, &radio);
+    boot_task_t join = { .name = "join", .start = join_start, .poll = wifi_poll, .ctx = (void *)&joined,
+                         .deps = BOOT_DEP(radio_id), .timeout_ms = WIFI_JOIN_TIMEOUT_MS };
+    int join_id = boot_seq_add(&boot, &join);
+    boot_task_t dhcp = { .name = "dhcp", .poll = wifi_poll, .ctx = (void *)&leased,
+                         .deps = BOOT_DEP(join_id), .timeout_ms = WIFI_DHCP_TIMEOUT_MS };
+    int dhcp_id = boot_seq_add(&boot, &dhcp);
+    boot_task_t mqtt = { .name = "mqtt", .start = mqtt_start, .poll = mqtt_poll,
+                         .deps = BOOT_DEP(dhcp_id), .timeout_ms = WIFI_MQTT_TIMEOUT_MS };
+    boot_seq_add(&boot, &mqtt);
+    boot_task_t archive_mount = { .name = "archive", .start = archive_start };
+    boot_seq_add(&boot, &archive_mount);
+    boot_task_t http_listen = { .name = "http", .start = http_start, .deps = BOOT_DEP(dhcp_id) };
+    boot_seq_add(&boot, &http_listen);
+}
+
+// Advance the boot phases; once all have finished and a sample was taken, report the timings
+static void boot_advance(void) {
+    if (boot_reported) {
+        return;
+    }
+    if (!boot_finished) {
+        boot_finished = boot_seq_poll(&boot, to_ms_since_boot(get_absolute_time()));
+    }
+    if (!boot_finished || first_sample_ms == 0) {
+        return;
+    }
+    for (int i = 0; i < boot.count; i++) {
+        const boot_slot_t *slot = boot_seq_slot(&boot, i);
+        static const char *const states[] = { "pending", "running", "done", "failed", "skipped" };
+        printf("Boot: %-6s %6lu .. %6lu ms %s\n", slot->task.name, (unsigned long)slot->start_ms,
+               (unsigned long)slot->end_ms, states[slot->state]);
+    }
+    printf("Boot: first sample at %lu ms, all phases finished at %lu ms\n", (unsigned long)first_sample_ms,
+           (unsigned long)boot.end_ms);
+    if (!is_mqtt_connected()) {
+        printf("Network unavailable, samples stay queued\n");
+    }
+    publish_boot_report(&boot, first_sample_ms);
+    boot_reported = true;
+}
+
+// The network boot phases run once. Whatever they left undone (radio, join, DHCP, broker, listener) is retried
+// here after boot, with a growing gap between join attempts.
+static void network_service(void) {
+    static bool waiting = false;
+    static uint32_t attempt_ms;
+    static uint32_t retry_ms = WIFI_RETRY_MIN_MS;
+    if (!boot_finished) {
+        return;
+    }
+    uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+    if (wifi_get_state() == WIFI_STATE_UP) {
+        waiting = false;
+        retry_ms = WIFI_RETRY_MIN_MS;
+        // Both return at once when already running; the MQTT client reconnects on its own from then on
+        start_mqtt_client();
+        if (http_listen_port() == 0) {
+            http_listen_start(&http, HTTP_PORT);
+        }
+        return;
+    }
+    if (!waiting) {
+        // The boot attempt (or the link that just dropped) counts as the first try
+        waiting = true;
+        attempt_ms = now_ms;
+        return;
+    }
+    if (now_ms - attempt_ms < retry_ms) {
+        return;
+    }
+    attempt_ms = now_ms;
+    retry_ms = (retry_ms >= WIFI_RETRY_MAX_MS / 2) ? WIFI_RETRY_MAX_MS : retry_ms * 2;
+    printf("Network down, joining again (next try in %lu s)\n", (unsigned long)(retry_ms / 1000));
+    if (!init_wifi() || !wifi_connect_start()) {
+        printf("Wi-Fi join could not be started\n");
+    }
+}
+
+// Archive request: "<seq>" sends the stored blocks from that sequence number on, "<sensor> <boot> <ms>" those from
+// the block holding that time. Runs in the lwIP context, so only the request is kept; the main loop serves it.
+static void archive_get_handler(const char *topic, size_t topic_len, const uint8_t *payload, size_t len, bool retain) {
+    // A retained request would be served again on every connection
+    if (retain || topic_len != strlen(MQTT_TOPIC_ARCHIVE_GET) ||
+        memcmp(topic, MQTT_TOPIC_ARCHIVE_GET, topic_len) != 0) {
+        return;
+    }
+    uint32_t args[3] = { 0 };
+    int argc = 0;
+    bool in_number = false;
+    for (size_t i = 0; i < len; i++) {
+        if (payload[i] >= '0' && payload[i] <= '9') {
+            if (!in_number) {
+                if (argc == 3) {
+                    return;
+                }
+                argc++;
+                in_number = true;
+            }
+            uint32_t digit = (uint32_t)(payload[i] - '0');
+            if (args[argc - 1] > (UINT32_MAX - digit) / 10u) {
+                return;
+            }
+            args[argc - 1] = args[argc - 1] * 10u + digit;
+        } else if (payload[i] == ' ') {
+            in_number = false;
+        } else {
+            return;
+        }
+    }
+    if (argc != 1 && argc != 3) {
+        return;
+    }
+    // "source boot ts": the narrowing casts in archive_service() must not wrap
+    if (argc == 3 && (args[0] >= PM25_SENSOR_COUNT || args[1] > UINT16_MAX)) {
+        return;
+    }
+    for (int i = 0; i < argc; i++) {
+        archive_get_args[i] = args[i];
+    }
+    archive_get_argc = argc;
+    archive_get_pending = true;
+}
+
+// Configuration message (runtime_config.h). The broker delivers the retained one on every subscription, which is
+// how a rebooted node gets its configuration back; the same version again changes nothing.
+static void config_handler(const char *topic, size_t topic_len, const uint8_t *payload, size_t len, bool retain) {
+    (void)retain;
+    if (topic_len != strlen(MQTT_TOPIC_CONFIG) || memcmp(topic, MQTT_TOPIC_CONFIG, topic_len) != 0) {
+        return;
+    }
+    runtime_config_store_update(&runtime_config, (const char *)payload, len);
+}
+
+static void on_mqtt_message(const char *topic, size_t topic_len, const uint8_t *payload, size_t len, bool retain) {
+    archive_get_handler(topic, topic_len, payload, len, retain);
+    config_handler(topic, topic_len, payload, len, retain);
+}
+
+// Swap a new configuration into the modules it tunes; their measurement state (last report, sampling channel) is
+// kept, so the change takes effect from the next sample on
+static void apply_runtime_config(const runtime_config_t *config, adaptive_rate_t *rate, rbe_filter_t *rbe) {
+    adaptive_rate_set_limits(rate, config->sample_min_ms, config->sample_max_ms);
+
+    rbe_config_t rbe_config = rbe->config;
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        rbe_config.abs_deadband[f] = (f >= PM25_FIELD_COUNT_0_3) ? config->deadband_count : config->deadband_mass;
+        rbe_config.pct_deadband_x10[f] = config->deadband_pct_x10;
+    }
+    rbe_config.heartbeat_ms = config->heartbeat_ms;
+    rbe_config.max_sample_interval_ms = config->sample_max_ms;
+    rbe_filter_set_config(rbe, &rbe_config);
+
+    set_mqtt_publish_rates(config->window_ms, config->window_max_ms, config->bulk_rate_bps);
+}
+
+// Queue the requested blocks a few at a time, so samples and alerts are not held up behind them
+static void archive_service(void) {
+    if (!archive_ready) {
+        return;
+    }
+    if (archive_get_pending) {
+        archive_get_pending = false;
+        uint32_t start = archive_get_args[0];
+        if (archive_get_argc == 3) {
+            start = sample_archive_seek(&archive, (uint8_t)archive_get_args[0], (uint16_t)archive_get_args[1],
+                                        archive_get_args[2]);
+        }
+        // Nothing stored from there on
+        if (start == ARCHIVE_SEQ_NONE || start >= archive.next_seq) {
+            return;
+        }
+        if (start < archive.oldest_seq) {
+            start = archive.oldest_seq;
+        }
+        archive_send_seq = start;
+        archive_send_end = (archive.next_seq - start > ARCHIVE_SEND_MAX) ? start + ARCHIVE_SEND_MAX
+                                                                         : archive.next_seq;
+    }
+    while (archive_send_seq < archive_send_end) {
+        const mqtt_lane_stats_t *bulk = get_mqtt_lane_stats(MQTT_LANE_BULK);
+        if (bulk->depth >= ARCHIVE_SEND_QUEUE_MAX) {
+            return;
+        }
+        uint8_t block[ARCHIVE_BLOCK_SIZE];
+        // A block lost to a torn write is skipped
+        if (sample_archive_read_block(&archive, archive_send_seq, block)) {
+            archive_header_t header;
+            archive_parse_header(block, sizeof(block), &header);
+            if (!publish_archive_block(block, ARCHIVE_HEADER_SIZE + header.len)) {
+                return;
+            }
+        }
+        archive_send_seq++;
+    }
+}
+
+// Wait between samples; while boot phases are still running, wake every BOOT_POLL_MS to advance them
+static void loop_sleep_ms(uint32_t ms) {
+    while (!boot_reported && ms > 0) {
+        uint32_t step = (ms < BOOT_POLL_MS) ? ms : BOOT_POLL_MS;
+        mqtt_sleep_ms(step);
+        ms -= step;
+        boot_advance();
+    }
+    network_service();
+    if (ms > 0) {
+        mqtt_sleep_ms(ms);
+    }
+}
 
 int main()
 {
+    // Paint the stacks before anything else runs on them
+    diag_init();
+
+    // Leave the boot clock before any peripheral derives a divider from it
+    if (!clock_policy_init(NULL, clock_get_pico_hal())) {
+        printf("Clock policy could not leave the boot clock\n");
+    }
+
+    power_mgr_init(NULL, power_get_pico_hal());
+
     stdio_init_all();
-    
+
+    // Readings are queued from the first sample on and sent once the broker connection is up
+    init_mqtt_client();
+    runtime_config_store_init(&runtime_config);
+    set_mqtt_message_handler(on_mqtt_message);
+    subscribe_topic(MQTT_TOPIC_ARCHIVE_GET);
+    subscribe_topic(MQTT_TOPIC_CONFIG);
+    diag_register_ring("mqtt_alert", MQTT_QUEUE_POOL_SIZE, mqtt_lane_high_water, (void *)(uintptr_t)MQTT_LANE_ALERT);
+    diag_register_ring("mqtt_bulk", MQTT_QUEUE_POOL_SIZE, mqtt_lane_high_water, (void *)(uintptr_t)MQTT_LANE_BULK);
+
+    // After a watchdog reboot the sensors kept running through the reset and need no warm-up
+    bool sensors_warm = watchdog_caused_reboot() &&
+                        watchdog_hw->scratch[SCRATCH_SENSORS_AWAKE] == SENSORS_AWAKE_MAGIC;
+
     pm25_hal_t const *hal = pm25_get_default_hal();
-    pm25_sensor_init(hal);
+    pm25_sensor_t pm25_sensors[PM25_SENSOR_COUNT];
+    int sensor_count = 0;
+
+    // On-board sensor on the hardware UART
+    pm25_sensor_init(&pm25_sensors[sensor_count++], NULL, hal);
+
+    // Extra sensors on PIO-based UARTs
+    const unsigned int pio_pins[][4] = PMS_PIO_SENSOR_PINS;
+    for (int i = 0; i < PMS_PIO_SENSOR_COUNT; i++) {
+        pm25_sensor_config_t config = {
+            .uart = pm25_pio_uart_claim(pio_pins[i][0], pio_pins[i][1]),
+            .tx_pin = pio_pins[i][0],
+            .rx_pin = pio_pins[i][1],
+            .set_pin = pio_pins[i][2],
+            .reset_pin = pio_pins[i][3]
+        };
+        if (config.uart == NULL) {
+            printf("Failed to claim PIO UART for sensor %d\n", i + 1);
+            break;
+        }
+        pm25_sensor_init(&pm25_sensors[sensor_count++], &config, pm25_get_pio_hal());
+        static const char *const ring_names[PM25_PIO_UART_MAX] = { "pms1_rx", "pms2_rx", "pms3_rx", "pms4_rx" };
+        diag_register_ring(ring_names[i], PM25_PIO_UART_RING_SIZE, pio_ring_high_water, config.uart);
+    }
+    clock_policy_add_listener(reclock_uarts, NULL);
+
+    // Sleep between tasks; a start bit from the on-board sensor wakes the core for its frame
+    static pm25_sensor_set_t wake_sensors;
+    wake_sensors.sensors = pm25_sensors;
+    wake_sensors.count = sensor_count;
+    power_mgr_add_listener(resync_sensors, &wake_sensors);
+    power_mgr_set_rx_wake(true);
+    mark_sensors_awake(true);
+
+    // Sensor warm-up, radio power-up, association, DHCP and the MQTT/TLS connect overlap
+    boot_build(sensors_warm ? 0 : PMS_WAKEUP_STABLE_MS);
+    boot_advance();
+
+    // Spike filter state per sensor (kept off the stack, ~1.7 KB each)
+    static spike_filter_t pm25_filters[PM25_SENSOR_COUNT];
+    for (int i = 0; i < sensor_count; i++) {
+        spike_filter_init(&pm25_filters[i], NULL);
+    }
+
+    sample_cache_init(&pm25_latest, 0);
+    metrics_page_init(&metrics_page);
+    http_server_init(&http, &metrics_page);
+
+    adaptive_rate_t sample_rate;
+    adaptive_rate_init(&sample_rate, NULL);
+
+    rbe_filter_t pm25_rbe;
+    rbe_filter_init(&pm25_rbe, NULL);
+
+    sample_assembly_t env_assembly;
+    sample_assembly_init(&env_assembly, NULL);
+
+    aqi_nowcast_t pm25_nowcast;
+    aqi_nowcast_init(&pm25_nowcast);
+
+    // Sample as soon as the sensors are warm; the network phases carry on in the background
+    clock_policy_set_phase(CLOCK_PHASE_IDLE);
+    while (!boot_seq_ready(&boot, BOOT_DEP(boot_pms))) {
+        loop_sleep_ms(BOOT_POLL_MS);
+    }
+    uint32_t last_diag_ms = to_ms_since_boot(get_absolute_time());
+    aqi_report_t aqi;
+    bool have_aqi = false;
+    runtime_config_t active_config;
+    runtime_config_default(&active_config);
+    uint32_t config_messages_seen = UINT32_MAX;    // Publish the built-in configuration once
 
     while (true) {
-        pm25_data_t data;
-        if (pm25_sensor_read(&data)) {
-            printf("PM2.5 Concentration in atmostphere environment: %.2f µg/m³, PM2.5 Concentration in standard particle: %.2f µg/m³\n",
-                   data.pm2_5_atm / 1.0, data.pm2_5_cf1 / 1.0);
+        // Configuration changes land here, between two samples
+        runtime_config_t config;
+        runtime_config_status_t config_status;
+        if (runtime_config_store_read(&runtime_config, &config, &config_status) &&
+            config_status.messages != config_messages_seen) {
+            config_messages_seen = config_status.messages;
+            if (config.version != active_config.version) {
+                apply_runtime_config(&config, &sample_rate, &pm25_rbe);
+                active_config = config;
+                printf("Configuration version %lu applied\n", (unsigned long)config.version);
+            } else if (config_status.result != RUNTIME_CONFIG_OK) {
+                printf("Configuration version %lu rejected: %s\n", (unsigned long)config_status.received,
+                       runtime_config_result_name(config_status.result));
+            }
+            publish_config_status(&active_config, &config_status);
+        }
+
+        clock_policy_set_phase(CLOCK_PHASE_ACQUIRE);
+
+        // Start the SHT3x conversion first so it runs while the PMS7003 frames are transferred
+        bool env_started = start_temp_hum_measurement();
+
+        pm25_data_t samples[PM25_SENSOR_COUNT];
+        bool have_sample[PM25_SENSOR_COUNT];
+        for (int i = 0; i < sensor_count; i++) {
+            // A wedged sensor is reset and reads are skipped until it is back
+            if (pm25_sensor_check_link(&pm25_sensors[i])) {
+                have_sample[i] = false;
+                continue;
+            }
+            have_sample[i] = pm25_sensor_read(&pm25_sensors[i], &samples[i]);
+            if (have_sample[i] && first_sample_ms == 0) {
+                first_sample_ms = to_ms_since_boot(get_absolute_time());
+            }
+        }
+
+        fx_centi_t temperature = 0;
+        fx_centi_t humidity = 0;
+        uint64_t env_time_us = 0;
+        if (env_started && fetch_temp_hum_data(&temperature, &humidity, &env_time_us)) {
+            sample_assembly_add_env(&env_assembly, env_time_us, temperature, humidity);
+        }
+
+        for (int i = 0; i < sensor_count; i++) {
+            if (!have_sample[i]) {
+                const pm25_sensor_t *s = &pm25_sensors[i];
+                if (s->recovery != PM25_RECOVERY_NONE) {
+                    printf("[%d] Sensor link being reset (%lu so far)\n", i, (unsigned long)s->link.resets);
+                } else {
+                    printf("[%d] Failed to read PM2.5 data: %s\n", i, pm25_link_result_name(s->last_result));
+                }
+                continue;
+            }
+            pm25_data_t data = samples[i];
+            uint16_t suppressed = spike_filter_apply(&pm25_filters[i], &data);
+            if (suppressed != 0) {
+                printf("[%d] Spike suppressed, field mask 0x%03X\n", i, suppressed);
+            }
+            sample_cache_publish(&pm25_latest, i, &data, pm25_sensors[i].frame_time_us);
+            if (archive_ready) {
+                sample_archive_append(&archive, (uint8_t)i, (uint32_t)(pm25_sensors[i].frame_time_us / 1000), &data);
+            }
+
+            // Temperature/humidity at the instant of this frame
+            joint_sample_t joint;
+            sample_assembly_join(&env_assembly, pm25_sensors[i].frame_time_us, &data, &joint);
+
+            printf("[%d] PM2.5 Concentration in atmostphere environment: %u µg/m³, PM2.5 Concentration in standard particle: %u µg/m³\n",
+                   i, data.pm2_5_atm, data.pm2_5_cf1);
+            if (i == 0) {
+                uint32_t prev_interval = adaptive_rate_interval_ms(&sample_rate);
+                if (adaptive_rate_update(&sample_rate, &data) < prev_interval) {
+                    printf("[%d] Change detected, back to full sampling rate\n", i);
+                }
+
+                aqi_nowcast_add(&pm25_nowcast, to_ms_since_boot(get_absolute_time()) / 1000,
+                                FX_FROM_INT(data.pm2_5_atm));
+                aqi_report_pm25(&pm25_nowcast, data.pm2_5_atm, &aqi);
+                have_aqi = true;
+                printf("[%d] AQI: %u, NowCast AQI: %u%s\n", i, aqi.aqi, aqi.nowcast_aqi,
+                       aqi.nowcast_valid ? "" : " (insufficient data)");
+
+                // Only publish samples that carry new information
+                rbe_report_t report;
+                if (rbe_filter_check(&pm25_rbe, &data, to_ms_since_boot(get_absolute_time()), &report)) {
+                    publish_pm25_report(&report);
+                    publish_aqi(&aqi);
+                }
+            }
+            if (joint.has_env) {
+                char corrected[FX_FORMAT_CENTI_MAX];
+                fx_format_centi(corrected, sizeof(corrected), fx_pm25_humidity_correct(data.pm2_5_cf1, joint.humidity));
+                printf("[%d] PM2.5 humidity corrected: %s µg/m³ (RH skew %lu us%s)\n", i, corrected,
+                       (unsigned long)joint.skew_us, joint.interpolated ? ", interpolated" : "");
+            }
+        }
+        metrics_page_update(&metrics_page, &pm25_latest, sensor_count, time_us_64(), have_aqi ? &aqi : NULL);
+
+        uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+        if (now_ms - last_diag_ms >= MQTT_DIAG_INTERVAL_MS) {
+            static diag_stats_t diag;
+            diag_get_stats(&diag);
+            printf("Stack high-water: core0 %lu/%lu, core1 %lu/%lu bytes\n",
+                   (unsigned long)diag.stack[0].used, (unsigned long)diag.stack[0].size,
+                   (unsigned long)diag.stack[1].used, (unsigned long)diag.stack[1].size);
+            const mqtt_session_stats_t *conn = get_mqtt_session_stats();
+            printf("MQTT: %lu connects, TLS %lu full / %lu resumed, session present %lu, subscribed %lu times\n",
+                   (unsigned long)conn->connects, (unsigned long)conn->full_handshakes,
+                   (unsigned long)conn->resumed_handshakes, (unsigned long)conn->session_present,
+                   (unsigned long)conn->resubscribes);
+            radio_sched_stats_t radio;
+            get_mqtt_radio_stats(&radio);
+            printf("Radio: active %u.%u%% of the time, %lu windows (%lu for alerts), %lu keep-alive pings\n",
+                   radio.duty_permille / 10, radio.duty_permille % 10, (unsigned long)radio.windows,
+                   (unsigned long)radio.urgent_windows, (unsigned long)radio.keepalive_pings);
+            clock_policy_stats_t clock;
+            clock_policy_get_stats(&clock);
+            printf("Clock: mean %lu kHz, %lu bursts, %lu changes; idle/acquire/burst %llu/%llu/%llu ms\n",
+                   (unsigned long)clock.avg_khz, (unsigned long)clock.bursts, (unsigned long)clock.transitions,
+                   (unsigned long long)clock.residency_ms[CLOCK_LEVEL_IDLE],
+                   (unsigned long long)clock.residency_ms[CLOCK_LEVEL_ACQUIRE],
+                   (unsigned long long)clock.residency_ms[CLOCK_LEVEL_BURST]);
+            power_mgr_stats_t power;
+            power_mgr_get_stats(&power);
+            printf("Power: deep sleep %u.%u%% of the time, run/idle/sleep %llu/%llu/%llu ms, %lu RX / %lu timer wakes\n",
+                   power.sleep_permille / 10, power.sleep_permille % 10,
+                   (unsigned long long)power.residency_ms[POWER_STATE_RUN],
+                   (unsigned long long)power.residency_ms[POWER_STATE_IDLE],
+                   (unsigned long long)power.residency_ms[POWER_STATE_SLEEP],
+                   (unsigned long)power.rx_wakes, (unsigned long)power.timer_wakes);
+            printf("HTTP: %lu served, %lu errors, %lu refused, %lu timeouts; /metrics %u of %u bytes\n",
+                   (unsigned long)http.stats.served, (unsigned long)http.stats.errors,
+                   (unsigned long)http.stats.refused, (unsigned long)http.stats.timeouts,
+                   metrics_page.stats.max_len[METRICS_PAGE_METRICS], (unsigned)HTTP_METRICS_BUFFER);
+            archive_stats_t stored;
+            sample_archive_get_stats(&archive, &stored);
+            printf("Archive: blocks %lu..%lu, %lu records, %llu bytes for %llu raw, %lu flash errors\n",
+                   (unsigned long)archive.oldest_seq, (unsigned long)archive.next_seq, (unsigned long)stored.records,
+                   (unsigned long long)stored.encoded_bytes, (unsigned long long)stored.raw_bytes,
+                   (unsigned long)stored.errors);
+            printf("Config: version %lu, %lu messages, %lu applied\n", (unsigned long)active_config.version,
+                   (unsigned long)config_status.messages, (unsigned long)config_status.applied);
+            uint64_t now_us = time_us_64();
+            for (int i = 0; i < sensor_count; i++) {
+                const pm25_link_stats_t *link = &pm25_sensors[i].link;
+                char last_good[32] = "never";
+                if (link->last_good_us != 0) {
+                    snprintf(last_good, sizeof(last_good), "%llu ms ago",
+                             (unsigned long long)((now_us - link->last_good_us) / 1000u));
+                }
+                printf("[%d] Link: %lu good, bad no data/start/length/checksum %lu/%lu/%lu/%lu, %lu resync bytes, "
+                       "%lu resets, last good %s\n", i, (unsigned long)link->good,
+                       (unsigned long)link->bad[PM25_LINK_NO_DATA], (unsigned long)link->bad[PM25_LINK_BAD_START],
+                       (unsigned long)link->bad[PM25_LINK_BAD_LENGTH],
+                       (unsigned long)link->bad[PM25_LINK_BAD_CHECKSUM], (unsigned long)link->resync_bytes,
+                       (unsigned long)link->resets, last_good);
+            }
+            publish_diagnostics(&diag);
+            for (int i = 0; i < sensor_count; i++) {
+                publish_sensor_link((uint8_t)i, &pm25_sensors[i], now_us);
+            }
+            last_diag_ms = now_ms;
+        }
+        archive_service();
+
+        // Stretch the wait while air is stable; park the sensors if the gap allows a full warm-up
+        clock_policy_set_phase(CLOCK_PHASE_IDLE);
+        uint32_t interval_ms = adaptive_rate_interval_ms(&sample_rate);
+        if (adaptive_rate_sensor_can_sleep(&sample_rate, PMS_WAKEUP_STABLE_MS)) {
+            for (int i = 0; i < sensor_count; i++) {
+                pm25_sensor_set_sleep(&pm25_sensors[i], true);
+            }
+            mark_sensors_awake(false);
+            // Parked sensors send nothing, so only the timer may end a sleep
+            power_mgr_set_rx_wake(false);
+            loop_sleep_ms(interval_ms - PMS_WAKEUP_STABLE_MS);
+            for (int i = 0; i < sensor_count; i++) {
+                pm25_sensor_set_sleep(&pm25_sensors[i], false);
+            }
+            power_mgr_set_rx_wake(true);
+            loop_sleep_ms(PMS_WAKEUP_STABLE_MS);
+            mark_sensors_awake(true);
         } else {
-            printf("Failed to read PM2.5 data\n");
+            loop_sleep_ms(interval_ms);
         }
-        sleep_ms(1000);
     }
 }
@@ -0,0 +1,50 @@
+/**
+ * File: bench_fmt_size.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Flash size probe for payload formatting. Built twice by the top-level CMakeLists.txt: with
+ * FMT_BENCH_SNPRINTF the report payload is built with snprintf, otherwise with the integer-only emitters (fmt.h).
+ * stdio is disabled in both images so the size difference is the formatter alone.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "fmt.h"
+
+static volatile uint32_t inputs[4];
+static volatile char sink[320];
+
+static size_t build_payload(char *buf, size_t size) {
+#ifdef FMT_BENCH_SNPRINTF
+    int len = snprintf(buf, size, "{\"seq\":%lu,\"ts\":%lu,\"pm2_5_atm\":%u,\"nowcast\":%ld.%02ld}",
+                       (unsigned long)inputs[0], (unsigned long)inputs[1], (unsigned)inputs[2],
+                       (long)inputs[3] / 100, (long)inputs[3] % 100);
+    return (len < 0) ? 0 : (size_t)len;
+#else
+    fmt_buf_t b;
+    fmt_init(&b, buf, size);
+    fmt_json_object_begin(&b, NULL);
+    fmt_json_u32(&b, "seq", inputs[0]);
+    fmt_json_u32(&b, "ts", inputs[1]);
+    fmt_json_u32(&b, "pm2_5_atm", inputs[2]);
+    fmt_json_fixed(&b, "nowcast", (int32_t)inputs[3], 2);
+    fmt_json_object_end(&b);
+    return fmt_finish(&b);
+#endif
+}
+
+int main(void) {
+    char buf[sizeof(sink)];
+    while (true) {
+        size_t len = build_payload(buf, sizeof(buf));
+        for (size_t i = 0; i < len; i++) {
+            sink[i] = buf[i];
+        }
+        sleep_ms(1000);
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * File: bench_pm25_hal.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: On-target benchmark of the PM2.5 HAL dispatch. Built twice by the top-level CMakeLists.txt, once with
+ * the runtime pm25_hal_t table and once with PM25_HAL_STATIC, and prints the cost of pm25_sensor_read() on a full
+ * frame in system clock cycles. The sensor UART runs in internal loopback (UARTCR.LBE) with its pins detached: each
+ * iteration writes a valid frame, waits until all of it sits in the RX FIFO, and times only the read, so the
+ * figure is the driver and HAL path (readable check, three blocking reads, checksum, parse) and not the wire.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/uart.h"
+#include "hardware/structs/systick.h"
+#include "pm2_5.h"
+#include "pm2_5_hal.h"
+
+#define BENCH_ITERATIONS    10000u
+#define BENCH_BAUD_RATE     1000000u    // Only shortens the untimed frame fill
+
+#ifdef PM25_HAL_STATIC
+#define BENCH_VARIANT "static"
+#else
+#define BENCH_VARIANT "dynamic"
+#endif
+
+// Valid PMS7003 data frame with a checksum over the rest
+static void make_frame(uint8_t frame[PMS_FRAME_LENGTH]) {
+    frame[0] = PMS_FRAME_START1;
+    frame[1] = PMS_FRAME_START2;
+    frame[2] = 0;
+    frame[3] = PMS_DATA_FRAME_LEN;
+    for (int i = 4; i < PMS_FRAME_LENGTH - 2; i++) {
+        frame[i] = (uint8_t)(i * 7);
+    }
+    uint16_t checksum = 0;
+    for (int i = 0; i < PMS_FRAME_LENGTH - 2; i++) {
+        checksum += frame[i];
+    }
+    frame[PMS_FRAME_LENGTH - 2] = (uint8_t)(checksum >> 8);
+    frame[PMS_FRAME_LENGTH - 1] = (uint8_t)checksum;
+}
+
+int main(void) {
+    stdio_init_all();
+    sleep_ms(2000);
+
+    pm25_sensor_t sensor;
+    pm25_sensor_init(&sensor, NULL, pm25_get_default_hal());
+    uart_inst_t *uart = sensor.config.uart;
+
+    // Keep the sensor out of it: frames loop back inside the UART
+    gpio_set_function(sensor.config.tx_pin, GPIO_FUNC_NULL);
+    gpio_set_function(sensor.config.rx_pin, GPIO_FUNC_NULL);
+    uart_set_baudrate(uart, BENCH_BAUD_RATE);
+    hw_set_bits(&uart_get_hw(uart)->cr, UART_UARTCR_LBE_BITS);
+    while (uart_is_readable(uart)) {
+        (void)uart_getc(uart);
+    }
+
+    // SysTick as a 24-bit down-counter at clk_sys; one read is far below its period
+    systick_hw->rvr = 0x00FFFFFFu;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5u;     // Enable, processor clock
+
+    uint8_t frame[PMS_FRAME_LENGTH];
+    make_frame(frame);
+    pm25_data_t data;
+    uint64_t total = 0;
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+    uint32_t failed = 0;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        uart_write_blocking(uart, frame, sizeof(frame));
+        // The RX FIFO is as deep as a frame
+        while ((uart_get_hw(uart)->fr & UART_UARTFR_RXFF_BITS) == 0) {
+            tight_loop_contents();
+        }
+        uint32_t start = systick_hw->cvr;
+        bool ok = pm25_sensor_read(&sensor, &data);
+        uint32_t cycles = (start - systick_hw->cvr) & 0x00FFFFFFu;
+        if (!ok) {
+            failed++;
+            continue;
+        }
+        total += cycles;
+        min = (cycles < min) ? cycles : min;
+        max = (cycles > max) ? cycles : max;
+    }
+    hw_clear_bits(&uart_get_hw(uart)->cr, UART_UARTCR_LBE_BITS);
+
+    uint32_t good = BENCH_ITERATIONS - failed;
+    if (good == 0) {
+        printf("pm25 read %s: no frame read back\n", BENCH_VARIANT);
+    } else {
+        printf("pm25 read %s: %lu frames at %lu Hz, %llu.%02llu cycles/read (min %lu, max %lu), %lu failed\n",
+               BENCH_VARIANT, (unsigned long)good, (unsigned long)clock_get_hz(clk_sys),
+               (unsigned long long)(total / good), (unsigned long long)((total % good) * 100u / good),
+               (unsigned long)min, (unsigned long)max, (unsigned long)failed);
+    }
+
+    while (true) {
+        tight_loop_contents();
+    }
+}
@@ -0,0 +1,26 @@
+/**
+ * @file archive_config.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief On-flash sample archive configuration
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs Company. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages
+ */
+
+#ifndef ARCHIVE_CONFIG_H
+#define ARCHIVE_CONFIG_H
+
+// Archive region: ARCHIVE_FLASH_SIZE bytes right below the TLS session sector (MQTT_SESSION_FLASH_OFFSET).
+// The archive is disabled at run time if the program image reaches into it.
+#define ARCHIVE_FLASH_SIZE          (1024u * 1024u)
+#define ARCHIVE_FLASH_END           (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#define ARCHIVE_FLASH_OFFSET        (ARCHIVE_FLASH_END - ARCHIVE_FLASH_SIZE)
+
+// Retrieval: a decimal block sequence number on MQTT_TOPIC_ARCHIVE_GET requests the stored blocks from there on;
+// they are published raw on MQTT_TOPIC_ARCHIVE, at most ARCHIVE_SEND_MAX per request
+#define ARCHIVE_SEND_MAX            8
+#define ARCHIVE_SEND_QUEUE_MAX      4       // Bulk messages queued before the next block is sent
+
+#endif // ARCHIVE_CONFIG_H
@@ -0,0 +1,29 @@
+/**
+ * @file http_config.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief Local HTTP metrics endpoint configuration
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs Company. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages
+ */
+
+#ifndef HTTP_CONFIG_H
+#define HTTP_CONFIG_H
+
+#define HTTP_PORT                   80
+#define HTTP_MAX_CONNS              2       // Connections served at once; more are refused
+#define HTTP_REQUEST_LINE_MAX       64      // Longer request lines are answered with 400
+#define HTTP_IDLE_TIMEOUT_MS        5000    // Close a connection that sends or acknowledges nothing for this long
+
+// Sensors shown on the endpoints; must cover 1 + PMS_PIO_SENSOR_COUNT
+#ifndef HTTP_MAX_SENSORS
+#define HTTP_MAX_SENSORS            1
+#endif
+
+// Response buffers, HTTP headers included, sized for the longest values; HTTP_MAX_CONNS + 1 of each
+#define HTTP_METRICS_BUFFER         (1280 + 800 * HTTP_MAX_SENSORS)     // /metrics (Prometheus text)
+#define HTTP_LATEST_BUFFER          (256 + 256 * HTTP_MAX_SENSORS)      // /latest (JSON)
+
+#endif // HTTP_CONFIG_H
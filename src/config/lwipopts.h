@@ -0,0 +1,57 @@
+/**
+ * @file lwipopts.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief lwIP options for the Pico W (threadsafe background mode) with the altcp (TCP/TLS) MQTT transport
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs Company. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages
+ */
+
+#ifndef LWIPOPTS_H
+#define LWIPOPTS_H
+
+#include "mqtt_config.h"
+
+#define NO_SYS                      1
+#define LWIP_SOCKET                 0
+#define LWIP_NETCONN                0
+#define MEM_LIBC_MALLOC             0
+#define MEM_ALIGNMENT               4
+#define MEM_SIZE                    8000
+#define MEMP_NUM_TCP_SEG            32
+#define MEMP_NUM_ARP_QUEUE          10
+#define PBUF_POOL_SIZE              24
+#define LWIP_ARP                    1
+#define LWIP_ETHERNET               1
+#define LWIP_ICMP                   1
+#define LWIP_RAW                    1
+#define TCP_MSS                     1460
+#define TCP_WND                     (8 * TCP_MSS)
+#define TCP_SND_BUF                 (8 * TCP_MSS)
+#define TCP_SND_QUEUELEN            ((4 * (TCP_SND_BUF) + (TCP_MSS - 1)) / (TCP_MSS))
+#define LWIP_NETIF_STATUS_CALLBACK  1
+#define LWIP_NETIF_LINK_CALLBACK    1
+#define LWIP_NETIF_HOSTNAME         1
+#define LWIP_NETIF_TX_SINGLE_PBUF   1
+#define DHCP_DOES_ARP_CHECK         0
+#define LWIP_DHCP_DOES_ACD_CHECK    0
+#define MEM_STATS                   0
+#define SYS_STATS                   0
+#define MEMP_STATS                  0
+#define LINK_STATS                  0
+#define LWIP_CHKSUM_ALGORITHM       3
+#define LWIP_DHCP                   1
+#define LWIP_IPV4                   1
+#define LWIP_TCP                    1
+#define LWIP_UDP                    1
+#define LWIP_DNS                    1
+#define LWIP_TCP_KEEPALIVE          1
+
+// MQTT runs on an altcp connection (mqtt_client.c); TLS through lwIP's mbedTLS port
+#define LWIP_ALTCP                  1
+#define LWIP_ALTCP_TLS              MQTT_USE_TLS
+#define LWIP_ALTCP_TLS_MBEDTLS      MQTT_USE_TLS
+
+#endif // LWIPOPTS_H
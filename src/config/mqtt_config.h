@@ -0,0 +1,65 @@
+/**
+ * @file mqtt_config.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief MQTT broker, topic and outbound queue configuration
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs Company. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages
+ */
+
+#ifndef MQTT_CONFIG_H
+#define MQTT_CONFIG_H
+
+#define MQTT_BROKER_ADDR            "192.168.1.10"  // Broker IPv4 address
+#define MQTT_BROKER_HOST            "broker.local"  // Name in the broker certificate (SNI and verification)
+#define MQTT_USE_TLS                1
+#if MQTT_USE_TLS
+#define MQTT_BROKER_PORT            8883
+#else
+#define MQTT_BROKER_PORT            1883
+#endif
+#define MQTT_CLIENT_ID              "airsense-01"
+#define MQTT_KEEP_ALIVE_S           120     // Pings are sent in publish windows only (radio_sched.h)
+
+// Broker CA certificate in PEM form; must be provided for TLS builds (e.g. -DMQTT_TLS_CA_CERT=...)
+#ifndef MQTT_TLS_CA_CERT
+#define MQTT_TLS_CA_CERT            ""
+#endif
+
+// Connection reuse (mqtt_session.h)
+#define MQTT_PERSISTENT_SESSION     1       // Connect with clean session off; skip re-subscribing when the broker kept it
+#define MQTT_TLS_SESSION_LIFETIME_MS (24u * 3600u * 1000u)  // Stop offering a cached TLS session after this age
+#define MQTT_TLS_SESSION_FLASH      0       // Also keep the TLS session in flash so it survives a reboot
+#define MQTT_TLS_SESSION_SAVE_MS    (6u * 3600u * 1000u)    // Minimum time between flash writes of a renewed session
+#define MQTT_SESSION_FLASH_OFFSET   (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)   // Last flash sector
+
+#define MQTT_TOPIC_BASE             "airsense/" MQTT_CLIENT_ID
+#define MQTT_TOPIC_PM25             MQTT_TOPIC_BASE "/pm25"
+#define MQTT_TOPIC_AQI              MQTT_TOPIC_BASE "/aqi"
+#define MQTT_TOPIC_ALERT            MQTT_TOPIC_BASE "/alert"
+#define MQTT_TOPIC_DIAG             MQTT_TOPIC_BASE "/diag"
+#define MQTT_TOPIC_DIAG_PMS         MQTT_TOPIC_BASE "/diag/pms"     // Sensor link health, one message per sensor
+#define MQTT_TOPIC_BOOT             MQTT_TOPIC_BASE "/boot"
+#define MQTT_TOPIC_ARCHIVE          MQTT_TOPIC_BASE "/archive"      // Raw archive blocks (sample_archive.h)
+#define MQTT_TOPIC_ARCHIVE_GET      MQTT_TOPIC_BASE "/archive/get"  // Archive block requests
+#define MQTT_TOPIC_CONFIG           MQTT_TOPIC_BASE "/config"       // Retained runtime configuration (runtime_config.h)
+#define MQTT_TOPIC_CONFIG_STATUS    MQTT_TOPIC_BASE "/config/status"    // Active configuration version, retained
+
+#define MQTT_BULK_RATE_BPS          512     // Bulk lane shaping, bytes per second
+#define MQTT_BULK_BURST_BYTES       2048    // Bulk lane burst allowance
+#define MQTT_MAX_IN_FLIGHT          1       // Publishes handed to lwIP and not yet complete; bounds alert wait
+#define MQTT_MAX_SUBSCRIPTIONS      4       // Topics kept for (re-)subscribing
+#define MQTT_RX_BUFFER_SIZE         1024    // Largest incoming packet
+#define MQTT_TX_BUFFER_SIZE         (MQTT_QUEUE_TOPIC_MAX + MQTT_QUEUE_PAYLOAD_MAX + 8)    // Largest outgoing packet
+#define MQTT_RECONNECT_MS           10000   // Delay between connection attempts
+#define MQTT_SERVICE_MS             100     // Queue service period while the main loop waits in a publish window
+#define MQTT_DIAG_INTERVAL_MS       60000   // Memory diagnostics publish period
+
+// Radio power save (radio_sched.h): the radio is active only during publish windows
+#define MQTT_PUBLISH_WINDOW_MS      30000   // Window period; 0 keeps the radio active
+#define MQTT_WINDOW_MAX_MS          5000    // Longest window, also bounds reconnect attempts
+#define MQTT_WINDOW_LINGER_MS       500     // Stay active after the last traffic for acks and PINGRESP
+
+#endif // MQTT_CONFIG_H
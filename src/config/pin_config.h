@@ -15,9 +15,12 @@
 // For test builds, use integer values instead of hardware pointers
 #ifdef PM25_HAL_MOCK_BUILD
 #define PMS_UART ((uart_inst_t *)0x1)  // Dummy UART pointer for tests
+#define SENSOR_I2C ((i2c_inst_t *)0x1)  // Dummy I2C pointer for tests
 #else
 #include "hardware/uart.h"
+#include "hardware/i2c.h"
 #define PMS_UART uart1                  // UART instance for PMS7003
+#define SENSOR_I2C i2c0                 // I2C instance shared by the I2C sensors
 #endif
 
 #define PMS_TX_PIN 0              // GPIO pin of Pico W for PMS7003 TX
@@ -25,4 +28,19 @@
 #define PMS_SET_PIN 2             // GPIO pin of Pico W for PMS7003 SET
 #define PMS_RESET_PIN 3           // GPIO pin of Pico W for PMS7003 RESET
 
+#define SENSOR_I2C_SDA_PIN 20     // GPIO pin of Pico W for the sensor bus SDA
+#define SENSOR_I2C_SCL_PIN 21     // GPIO pin of Pico W for the sensor bus SCL
+#define SENSOR_I2C_BAUD 100000    // Standard-mode I2C
+#define SHT3X_I2C_ADDR 0x44       // SHT3x with ADDR pin low
+
+// Additional PMS7003 units on PIO-based UARTs (up to PM25_PIO_UART_MAX, 0 to disable)
+#define PMS_PIO_SENSOR_COUNT 0
+// Pins of each PIO-attached unit: { TX, RX, SET, RESET }
+#define PMS_PIO_SENSOR_PINS { \
+    { 4, 5, 6, 7 },           \
+    { 8, 9, 10, 11 },         \
+    { 12, 13, 14, 15 },       \
+    { 16, 17, 18, 19 },       \
+}
+
 #endif // PIN_CONFIG_H
\ No newline at end of file
@@ -0,0 +1,33 @@
+/**
+ * @file wifi_config.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief Wi-Fi network and boot timing configuration
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs Company. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages
+ */
+
+#ifndef WIFI_CONFIG_H
+#define WIFI_CONFIG_H
+
+// Network credentials; must be provided at build time (e.g. -DWIFI_SSID=... -DWIFI_PASSWORD=...)
+#ifndef WIFI_SSID
+#define WIFI_SSID                   ""
+#endif
+#ifndef WIFI_PASSWORD
+#define WIFI_PASSWORD               ""
+#endif
+#define WIFI_AUTH                   CYW43_AUTH_WPA2_AES_PSK
+#define WIFI_COUNTRY                CYW43_COUNTRY_WORLDWIDE
+
+// Boot phase timeouts (boot_seq.h); a phase that runs out skips the phases after it
+#define WIFI_JOIN_TIMEOUT_MS        20000   // Scan, association and key exchange
+#define WIFI_DHCP_TIMEOUT_MS        10000   // Address lease after association
+#define WIFI_MQTT_TIMEOUT_MS        15000   // TCP connect, TLS handshake and CONNACK
+// After boot, a network that is not up is joined again, doubling the gap between attempts up to the maximum
+#define WIFI_RETRY_MIN_MS           (WIFI_JOIN_TIMEOUT_MS + WIFI_DHCP_TIMEOUT_MS)
+#define WIFI_RETRY_MAX_MS           300000
+
+#endif // WIFI_CONFIG_H
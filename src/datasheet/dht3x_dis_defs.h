@@ -77,6 +77,14 @@ const uint8_t SHT3X_CMD_CLEAR_STATUS[SHT3X_CMD_LEN]          = {0x30, 0x41};
 #define SHT3X_STATUS_CMD_STATUS         (1 << 1)
 #define SHT3X_STATUS_WRITE_CRC_FAIL     (1 << 0)
 
+// Measurement duration, maximum (datasheet table 4), in ms
+#define SHT3X_MEAS_HIGH_MS              16
+#define SHT3X_MEAS_MED_MS               7
+#define SHT3X_MEAS_LOW_MS               5
+
+// Measurement result: T msb, T lsb, T crc, RH msb, RH lsb, RH crc
+#define SHT3X_DATA_LEN                  6
+
 // CRC Calculation Properties (for 8-bit CRC)
 #define SHT3X_CRC_POLYNOMIAL            0x31  // x^8 + x^5 + x^4 + 1
 #define SHT3X_CRC_INIT                  0xFF
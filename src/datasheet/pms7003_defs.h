@@ -22,6 +22,7 @@
 #define PMS_STD_VOLUME 0.1f             // Standard Volume (L)
 #define PMS_SINGLE_RESPONSE_TIME 1      // Single Response Time (< s)
 #define PMS_TOTAL_RESPONSE_TIME 10      // Total Response Time (≤ s)
+#define PMS_WAKEUP_STABLE_MS 30000      // Data is stable 30 s after wake-up (fan spin-up)
 #define PMS_DC_POWER_TYP 5.0f           // DC Power Supply Typical (V)
 #define PMS_DC_POWER_MIN 4.5f           // DC Power Supply Min (V)
 #define PMS_DC_POWER_MAX 5.5f           // DC Power Supply Max (V)
@@ -0,0 +1,198 @@
+/**
+ * File: i2c_bus.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the shared I2C bus manager with an asynchronous transaction queue.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "i2c_bus.h"
+
+#include <string.h>
+
+static uint64_t bus_now(const i2c_bus_t *bus) {
+    return (bus->hal->time_us != NULL) ? bus->hal->time_us() : 0;
+}
+
+void i2c_bus_init(i2c_bus_t *bus, i2c_inst_t *i2c, uint32_t baudrate, const i2c_bus_hal_t *hal) {
+    if (bus == NULL) {
+        return;
+    }
+    memset(bus, 0, sizeof(*bus));
+    bus->hal = (hal != NULL) ? hal : i2c_bus_get_default_hal();
+    bus->i2c = i2c;
+    if (bus->hal->init != NULL) {
+        bus->hal->init(bus, i2c, baudrate);
+    }
+}
+
+bool i2c_bus_submit(i2c_bus_t *bus, i2c_txn_t *txn) {
+    if (bus == NULL || txn == NULL || txn->dev == NULL || (txn->write_len == 0 && txn->read_len == 0) ||
+        (txn->write_len > 0 && txn->write == NULL) || (txn->read_len > 0 && txn->read == NULL)) {
+        return false;
+    }
+    i2c_txn_t **link = &bus->head;
+    while (*link != NULL) {
+        if (*link == txn) {
+            return false;
+        }
+        link = &(*link)->next;
+    }
+
+    txn->status = I2C_BUS_PENDING;
+    txn->not_before_us = 0;
+    txn->retries_left = txn->read_retries;
+    txn->read_phase = false;
+    txn->next = NULL;
+    *link = txn;
+    return true;
+}
+
+static void unlink_txn(i2c_bus_t *bus, i2c_txn_t *txn) {
+    for (i2c_txn_t **link = &bus->head; *link != NULL; link = &(*link)->next) {
+        if (*link == txn) {
+            *link = txn->next;
+            txn->next = NULL;
+            return;
+        }
+    }
+}
+
+static void finish_txn(i2c_bus_t *bus, i2c_txn_t *txn, i2c_bus_status_t status, uint64_t time_us) {
+    unlink_txn(bus, txn);
+    txn->done_us = time_us;
+    txn->dev->last_done_us = time_us;
+    txn->dev->used = true;
+    if (status != I2C_BUS_OK) {
+        bus->errors++;
+    }
+    txn->status = status;
+    if (txn->cb != NULL) {
+        txn->cb(txn, txn->cb_arg);
+    }
+}
+
+// Write and read run as two transfers with the bus released in between
+static bool is_split(const i2c_txn_t *txn) {
+    return txn->read_delay_us > 0 && txn->write_len > 0 && txn->read_len > 0;
+}
+
+static void transfer_finished(i2c_bus_t *bus, i2c_bus_status_t status, uint64_t time_us) {
+    i2c_txn_t *txn = bus->active;
+    bus->active = NULL;
+    bus->transfers++;
+    bus->busy_us += time_us - bus->start_us;
+
+    if (status == I2C_BUS_OK && is_split(txn) && !txn->read_phase) {
+        // Command written; release the bus while the device converts
+        txn->read_phase = true;
+        txn->done_us = time_us;
+        txn->not_before_us = time_us + txn->read_delay_us;
+        return;
+    }
+    if (status == I2C_BUS_NACK && txn->read_phase && txn->retries_left > 0) {
+        // Device still busy: it NACKs its address until the result is ready
+        txn->retries_left--;
+        txn->not_before_us = time_us + I2C_BUS_DEFAULT_RETRY_US;
+        return;
+    }
+    finish_txn(bus, txn, status, time_us);
+}
+
+// True if no earlier queued transaction targets the same device
+static bool first_for_device(const i2c_bus_t *bus, const i2c_txn_t *txn) {
+    for (const i2c_txn_t *t = bus->head; t != txn; t = t->next) {
+        if (t->dev == txn->dev) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool eligible(const i2c_bus_t *bus, const i2c_txn_t *txn, uint64_t now) {
+    if (now < txn->not_before_us) {
+        return false;
+    }
+    if (txn->read_phase) {
+        return true;
+    }
+    const i2c_device_t *dev = txn->dev;
+    if (dev->used && now - dev->last_done_us < dev->min_interval_us) {
+        return false;
+    }
+    return first_for_device(bus, txn);
+}
+
+static void start_transfer(i2c_bus_t *bus, i2c_txn_t *txn, uint64_t now) {
+    const uint8_t *src = txn->write;
+    size_t write_len = txn->write_len;
+    uint8_t *dst = txn->read;
+    size_t read_len = txn->read_len;
+    if (txn->read_phase) {
+        src = NULL;
+        write_len = 0;
+    } else if (is_split(txn)) {
+        dst = NULL;
+        read_len = 0;
+    }
+
+    bus->done = false;
+    bus->active = txn;
+    bus->start_us = now;
+    bus->deadline_us = now + (txn->timeout_us ? txn->timeout_us : I2C_BUS_DEFAULT_TIMEOUT_US);
+    if (!bus->hal->start(bus, bus->i2c, txn->dev->addr, src, write_len, dst, read_len)) {
+        bus->active = NULL;
+        finish_txn(bus, txn, I2C_BUS_ERROR, now);
+    }
+}
+
+void i2c_bus_transfer_done(i2c_bus_t *bus, i2c_bus_status_t status, uint64_t time_us) {
+    if (bus == NULL) {
+        return;
+    }
+    bus->done_status = status;
+    bus->done_time_us = time_us;
+    bus->done = true;
+}
+
+bool i2c_bus_poll(i2c_bus_t *bus) {
+    if (bus == NULL) {
+        return false;
+    }
+    uint64_t now = bus_now(bus);
+
+    if (bus->active != NULL) {
+        if (bus->done) {
+            bus->done = false;
+            transfer_finished(bus, bus->done_status, bus->done_time_us);
+        } else if (now >= bus->deadline_us) {
+            bus->hal->abort(bus, bus->i2c);
+            transfer_finished(bus, I2C_BUS_TIMEOUT, now);
+        } else {
+            return true;
+        }
+    }
+
+    // Completion callbacks may have queued or finished transactions; start the first eligible one
+    for (i2c_txn_t *txn = bus->head; txn != NULL && bus->active == NULL; txn = txn->next) {
+        if (eligible(bus, txn, now)) {
+            start_transfer(bus, txn, now);
+            break;
+        }
+    }
+    return bus->head != NULL;
+}
+
+i2c_bus_status_t i2c_bus_wait(i2c_bus_t *bus, i2c_txn_t *txn) {
+    if (bus == NULL || txn == NULL) {
+        return I2C_BUS_ERROR;
+    }
+    while (txn->status == I2C_BUS_PENDING) {
+        i2c_bus_poll(bus);
+    }
+    return txn->status;
+}
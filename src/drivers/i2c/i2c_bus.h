@@ -0,0 +1,101 @@
+/**
+ * File: i2c_bus.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the shared I2C bus manager. Drivers queue transactions instead of calling blocking
+ * I2C functions; the manager runs them one transfer at a time through a non-blocking backend and reports each
+ * result through a completion callback. A transaction may split its write and read with a delay (SHT3x no-stretch
+ * conversion): the bus is released during the delay so other devices use it, and a NACKed read is retried while
+ * the device is still busy. Each device can demand a minimum interval between transactions.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef DRIVERS_I2C_BUS_H
+#define DRIVERS_I2C_BUS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "i2c_bus_hal.h"
+
+#define I2C_BUS_DEFAULT_TIMEOUT_US      25000u  // Per transfer; covers SHT3x clock stretching (max 15.5 ms)
+#define I2C_BUS_DEFAULT_RETRY_US        1000u   // Delay before retrying a NACKed delayed read
+
+typedef struct i2c_txn i2c_txn_t;
+
+// Completion callback, called from i2c_bus_poll() (thread context)
+typedef void (*i2c_txn_cb_t)(i2c_txn_t *txn, void *arg);
+
+// One device on the bus
+typedef struct {
+    uint8_t addr;                   // 7-bit address
+    uint32_t min_interval_us;       // Minimum time from the end of one transaction to the start of the next
+    uint64_t last_done_us;          // End of the last transaction (bus-owned)
+    bool used;                      // A transaction has completed (bus-owned)
+} i2c_device_t;
+
+// Transaction, owned by the caller and linked into the bus queue while pending
+struct i2c_txn {
+    i2c_device_t *dev;
+    const uint8_t *write;           // Bytes to write first (may be NULL)
+    size_t write_len;
+    uint8_t *read;                  // Buffer for the read (may be NULL)
+    size_t read_len;
+    uint32_t read_delay_us;         // 0: read follows the write with a repeated start (clock stretching);
+                                    // >0: write, release the bus, read after this delay (no stretching)
+    uint8_t read_retries;           // NACKed delayed reads retried this many times
+    uint32_t timeout_us;            // Per transfer, 0 selects I2C_BUS_DEFAULT_TIMEOUT_US
+    i2c_txn_cb_t cb;
+    void *cb_arg;
+
+    // Bus-owned state
+    volatile i2c_bus_status_t status;
+    uint64_t done_us;               // Completion time of the last transfer
+    uint64_t not_before_us;         // Earliest start of the next transfer
+    uint8_t retries_left;
+    bool read_phase;                // Write done, delayed read pending
+    i2c_txn_t *next;
+};
+
+struct i2c_bus {
+    const i2c_bus_hal_t *hal;
+    i2c_inst_t *i2c;
+    i2c_txn_t *head;                // Pending transactions in submission order
+    i2c_txn_t *active;              // Transaction whose transfer is running
+    uint64_t start_us;              // Start of the running transfer
+    uint64_t deadline_us;           // Timeout of the running transfer
+    volatile bool done;             // Set by i2c_bus_transfer_done()
+    volatile i2c_bus_status_t done_status;
+    volatile uint64_t done_time_us;
+    uint32_t transfers;             // Transfers completed
+    uint32_t errors;                // Transactions ended with an error
+    uint64_t busy_us;               // Time the bus spent in transfers
+};
+
+/**
+ * Initialize the bus manager and its backend. If hal is NULL, uses the default (hardware) backend.
+ */
+void i2c_bus_init(i2c_bus_t *bus, i2c_inst_t *i2c, uint32_t baudrate, const i2c_bus_hal_t *hal);
+
+/**
+ * Queue a transaction. Returns false if it is already pending or invalid.
+ */
+bool i2c_bus_submit(i2c_bus_t *bus, i2c_txn_t *txn);
+
+/**
+ * Advance the bus: finish the running transfer, start the next eligible one and run
+ * completion callbacks. Call often; returns true while transactions are pending.
+ */
+bool i2c_bus_poll(i2c_bus_t *bus);
+
+/**
+ * Poll until the transaction has completed and return its status.
+ */
+i2c_bus_status_t i2c_bus_wait(i2c_bus_t *bus, i2c_txn_t *txn);
+
+#endif // DRIVERS_I2C_BUS_H
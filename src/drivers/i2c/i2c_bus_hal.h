@@ -0,0 +1,64 @@
+/**
+ * @file i2c_bus_hal.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief Hardware Abstraction Layer of the shared I2C bus manager
+ * 
+ * A backend runs one transfer at a time without blocking: an optional write
+ * followed by an optional read (repeated start), ended by a STOP. When the
+ * transfer finishes it reports the result with i2c_bus_transfer_done(), which
+ * may be called from interrupt context. The real backend drives the RP2040 I2C
+ * block with DMA; host tests use a mock backend.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#ifndef I2C_BUS_HAL_H
+#define I2C_BUS_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef I2C_BUS_HAL_MOCK_BUILD
+#include "hardware/i2c.h"
+#else
+typedef struct i2c_inst i2c_inst_t;
+#endif
+
+typedef struct i2c_bus i2c_bus_t;
+
+// Result of a transfer or transaction
+typedef enum {
+    I2C_BUS_OK = 0,
+    I2C_BUS_PENDING,        // Queued or in progress
+    I2C_BUS_NACK,           // Address or data not acknowledged
+    I2C_BUS_TIMEOUT,        // Transfer did not finish in time (stuck bus, excessive clock stretching)
+    I2C_BUS_ERROR           // Backend could not start the transfer
+} i2c_bus_status_t;
+
+/**
+ * @brief I2C bus backend
+ * 
+ * Function pointers for non-blocking transfers. Can be implemented by real
+ * hardware or mock functions for testing.
+ */
+typedef struct {
+    void (*init)(i2c_bus_t *bus, i2c_inst_t *i2c, uint32_t baudrate);
+    // Start a transfer; completion is reported through i2c_bus_transfer_done()
+    bool (*start)(i2c_bus_t *bus, i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t write_len,
+                  uint8_t *dst, size_t read_len);
+    // Cancel the running transfer and recover the bus; no completion is reported
+    void (*abort)(i2c_bus_t *bus, i2c_inst_t *i2c);
+    uint64_t (*time_us)(void);
+} i2c_bus_hal_t;
+
+/**
+ * @brief Report the end of the running transfer (callable from an IRQ handler)
+ */
+void i2c_bus_transfer_done(i2c_bus_t *bus, i2c_bus_status_t status, uint64_t time_us);
+
+// Get the RP2040 I2C + DMA backend
+const i2c_bus_hal_t *i2c_bus_get_default_hal(void);
+
+#endif // I2C_BUS_HAL_H
@@ -0,0 +1,181 @@
+/**
+ * @file i2c_bus_hal_pico.c
+ * @author trung.la
+ * @date October 19 2026
+ * @brief RP2040 I2C + DMA implementation of the I2C bus HAL using Pico SDK
+ * 
+ * A transfer is laid out as IC_DATA_CMD words (write bytes, then read commands
+ * with RESTART on the first and STOP on the last) and fed to the controller by a
+ * TX DMA channel; received bytes are drained by an RX DMA channel. The STOP_DET
+ * and TX_ABRT interrupts report completion, so a transfer costs no CPU time
+ * between start and end. Clock stretching is handled by the controller; the bus
+ * manager's transfer timeout bounds it. The SCL divider is re-derived at the
+ * start of the first transfer after a clk_sys change, never mid-transfer.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#include "i2c_bus_hal.h"
+#include "hardware/i2c.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "pico/time.h"
+
+// Longest transfer (write + read bytes)
+#define I2C_BUS_PICO_MAX_CMDS   32
+
+typedef struct {
+    i2c_bus_t *bus;
+    i2c_hw_t *hw;
+    int tx_chan;
+    int rx_chan;
+    uint32_t baudrate;
+    uint32_t sys_hz;        // clk_sys the SCL divider was derived from
+    bool claimed;           // DMA channels claimed
+    volatile bool busy;
+    uint32_t cmds[I2C_BUS_PICO_MAX_CMDS];   // IC_DATA_CMD words of the running transfer
+} pico_i2c_port_t;
+
+static pico_i2c_port_t ports[NUM_I2CS];
+
+static void port_irq(pico_i2c_port_t *port) {
+    i2c_hw_t *hw = port->hw;
+    uint32_t stat = hw->intr_stat;
+    i2c_bus_status_t status = I2C_BUS_OK;
+
+    if (stat & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        uint32_t source = hw->tx_abrt_source;
+        (void)hw->clr_tx_abrt;
+        dma_channel_abort((uint)port->tx_chan);
+        dma_channel_abort((uint)port->rx_chan);
+        status = (source & (I2C_IC_TX_ABRT_SOURCE_ABRT_7B_ADDR_NOACK_BITS |
+                            I2C_IC_TX_ABRT_SOURCE_ABRT_TXDATA_NOACK_BITS)) ? I2C_BUS_NACK : I2C_BUS_ERROR;
+    } else if (stat & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+        // All bytes are in the RX FIFO once STOP is seen; the DMA drains them within a few cycles
+        while (dma_channel_is_busy((uint)port->rx_chan)) {
+            tight_loop_contents();
+        }
+    }
+    if (stat & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+        (void)hw->clr_stop_det;
+    }
+
+    // An abort is followed by its own STOP; report each transfer once
+    if (port->busy && (stat & (I2C_IC_INTR_STAT_R_TX_ABRT_BITS | I2C_IC_INTR_STAT_R_STOP_DET_BITS))) {
+        port->busy = false;
+        i2c_bus_transfer_done(port->bus, status, time_us_64());
+    }
+}
+
+static void i2c0_irq_handler(void) {
+    port_irq(&ports[0]);
+}
+
+static void i2c1_irq_handler(void) {
+    port_irq(&ports[1]);
+}
+
+static void pico_i2c_init(i2c_bus_t *bus, i2c_inst_t *i2c, uint32_t baudrate) {
+    uint idx = i2c_hw_index(i2c);
+    pico_i2c_port_t *port = &ports[idx];
+    port->bus = bus;
+    port->hw = i2c_get_hw(i2c);
+    port->busy = false;
+
+    i2c_init(i2c, baudrate);
+    port->baudrate = baudrate;
+    port->sys_hz = clock_get_hz(clk_sys);
+    port->hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS | I2C_IC_DMA_CR_RDMAE_BITS;
+    port->hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+
+    if (!port->claimed) {
+        port->tx_chan = dma_claim_unused_channel(true);
+        port->rx_chan = dma_claim_unused_channel(true);
+        port->claimed = true;
+    }
+
+    uint irq = idx ? I2C1_IRQ : I2C0_IRQ;
+    irq_set_exclusive_handler(irq, idx ? i2c1_irq_handler : i2c0_irq_handler);
+    irq_set_enabled(irq, true);
+}
+
+static bool pico_i2c_start(i2c_bus_t *bus, i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t write_len,
+                           uint8_t *dst, size_t read_len) {
+    pico_i2c_port_t *port = &ports[i2c_hw_index(i2c)];
+    size_t count = write_len + read_len;
+    if (port->busy || count == 0 || count > I2C_BUS_PICO_MAX_CMDS) {
+        return false;
+    }
+
+    for (size_t i = 0; i < write_len; i++) {
+        port->cmds[i] = src[i];
+    }
+    for (size_t i = 0; i < read_len; i++) {
+        port->cmds[write_len + i] = I2C_IC_DATA_CMD_CMD_BITS |
+                                    ((i == 0 && write_len > 0) ? I2C_IC_DATA_CMD_RESTART_BITS : 0);
+    }
+    port->cmds[count - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    // Clock policy changed clk_sys since the last transfer
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+    if (sys_hz != port->sys_hz) {
+        i2c_set_baudrate(i2c, port->baudrate);
+        port->sys_hz = sys_hz;
+    }
+
+    i2c_hw_t *hw = port->hw;
+    hw->enable = 0;
+    hw->tar = addr;
+    hw->enable = 1;
+    port->busy = true;
+
+    if (read_len > 0) {
+        dma_channel_config c = dma_channel_get_default_config((uint)port->rx_chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+        channel_config_set_dreq(&c, i2c_get_dreq(i2c, false));
+        dma_channel_configure((uint)port->rx_chan, &c, dst, &hw->data_cmd, read_len, true);
+    }
+
+    dma_channel_config c = dma_channel_get_default_config((uint)port->tx_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+    dma_channel_configure((uint)port->tx_chan, &c, &hw->data_cmd, port->cmds, count, true);
+    return true;
+}
+
+static void pico_i2c_abort(i2c_bus_t *bus, i2c_inst_t *i2c) {
+    pico_i2c_port_t *port = &ports[i2c_hw_index(i2c)];
+    port->busy = false;
+    dma_channel_abort((uint)port->tx_chan);
+    dma_channel_abort((uint)port->rx_chan);
+
+    // Controller abort issues a STOP and flushes the TX FIFO
+    i2c_hw_t *hw = port->hw;
+    hw->enable |= I2C_IC_ENABLE_ABORT_BITS;
+    absolute_time_t give_up = make_timeout_time_ms(2);
+    while ((hw->enable & I2C_IC_ENABLE_ABORT_BITS) && !time_reached(give_up)) {
+        tight_loop_contents();
+    }
+    (void)hw->clr_tx_abrt;
+    (void)hw->clr_stop_det;
+}
+
+static uint64_t pico_i2c_time_us(void) {
+    return time_us_64();
+}
+
+static const i2c_bus_hal_t pico_i2c_bus_hal = {
+    .init = pico_i2c_init,
+    .start = pico_i2c_start,
+    .abort = pico_i2c_abort,
+    .time_us = pico_i2c_time_us
+};
+
+const i2c_bus_hal_t *i2c_bus_get_default_hal(void) {
+    return &pico_i2c_bus_hal;
+}
@@ -13,19 +13,94 @@
 
 #include "temp_hum.h"
 #include "dht3x_dis_defs.h"
+#include "pin_config.h"
 
-bool init_temp_hum_sensor() {
-    // TODO: Implement actual I2C initialization code for the temperature and humidity sensor
-    return true; // Return true if initialization is successful
+#include <string.h>
+
+#define SHT3X_MIN_INTERVAL_US   2000    // Between commands; covers the soft reset time (max 1.5 ms)
+#define SHT3X_READ_RETRIES      5       // NACKed reads while the conversion is still running
+
+static i2c_bus_t *sht3x_bus = NULL;
+static i2c_device_t sht3x_dev;
+static i2c_txn_t sht3x_txn;
+static uint8_t sht3x_data[SHT3X_DATA_LEN];
+static bool measuring = false;
+
+static uint8_t sht3x_crc8(const uint8_t *data, int len) {
+    uint8_t crc = SHT3X_CRC_INIT;
+    for (int i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ SHT3X_CRC_POLYNOMIAL) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static void sht3x_prepare(const uint8_t cmd[SHT3X_CMD_LEN], uint8_t *read, size_t read_len, uint32_t read_delay_us) {
+    memset(&sht3x_txn, 0, sizeof(sht3x_txn));
+    sht3x_txn.dev = &sht3x_dev;
+    sht3x_txn.write = cmd;
+    sht3x_txn.write_len = SHT3X_CMD_LEN;
+    sht3x_txn.read = read;
+    sht3x_txn.read_len = read_len;
+    sht3x_txn.read_delay_us = read_delay_us;
+    sht3x_txn.read_retries = SHT3X_READ_RETRIES;
+}
+
+bool init_temp_hum_sensor(i2c_bus_t *bus) {
+    if (bus == NULL) {
+        return false;
+    }
+    sht3x_bus = bus;
+    memset(&sht3x_dev, 0, sizeof(sht3x_dev));
+    sht3x_dev.addr = SHT3X_I2C_ADDR;
+    sht3x_dev.min_interval_us = SHT3X_MIN_INTERVAL_US;
+    measuring = false;
+
+    sht3x_prepare(SHT3X_CMD_SOFT_RESET, NULL, 0, 0);
+    if (!i2c_bus_submit(bus, &sht3x_txn) || i2c_bus_wait(bus, &sht3x_txn) != I2C_BUS_OK) {
+        return false;
+    }
+    return true;
 }
 
-bool read_temp_hum_data(float *temperature, float *humidity) {
-    // TODO: Implement actual I2C read operations to get temperature and humidity data
+bool start_temp_hum_measurement() {
+    if (sht3x_bus == NULL || measuring) {
+        return false;
+    }
+    // No clock stretching: the bus is released while the sensor converts
+    sht3x_prepare(SHT3X_CMD_SINGLE_HIGH, sht3x_data, SHT3X_DATA_LEN, SHT3X_MEAS_HIGH_MS * 1000u);
+    measuring = i2c_bus_submit(sht3x_bus, &sht3x_txn);
+    i2c_bus_poll(sht3x_bus);    // Send the command now; the read is picked up by later polls
+    return measuring;
+}
+
+bool fetch_temp_hum_data(fx_centi_t *temperature, fx_centi_t *humidity, uint64_t *timestamp_us) {
+    if (!measuring) {
+        return false;
+    }
+    measuring = false;
+    if (i2c_bus_wait(sht3x_bus, &sht3x_txn) != I2C_BUS_OK) {
+        return false;
+    }
+    const uint8_t *buf = sht3x_data;
+    if (sht3x_crc8(&buf[0], 2) != buf[2] || sht3x_crc8(&buf[3], 2) != buf[5]) {
+        return false;
+    }
+
     if (temperature) {
-        *temperature = 25.0f; // Dummy temperature value
+        *temperature = fx_sht3x_temp_centi((uint16_t)((buf[0] << 8) | buf[1]));
     }
     if (humidity) {
-        *humidity = 50.0f; // Dummy humidity value
+        *humidity = fx_sht3x_hum_centi((uint16_t)((buf[3] << 8) | buf[4]));
+    }
+    if (timestamp_us) {
+        *timestamp_us = sht3x_txn.done_us;
     }
-    return true; // Return true if data read is successful
-}
\ No newline at end of file
+    return true;
+}
+
+bool read_temp_hum_data(fx_centi_t *temperature, fx_centi_t *humidity) {
+    return start_temp_hum_measurement() && fetch_temp_hum_data(temperature, humidity, NULL);
+}
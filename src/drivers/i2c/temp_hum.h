@@ -14,9 +14,24 @@
 #define TEMP_HUM_H
 
 #include <stdbool.h>
+#include <stdint.h>
+
+#include "fixed_point.h"
+#include "i2c_bus.h"
 
 // Function prototypes
-bool init_temp_hum_sensor();
-bool read_temp_hum_data(float *temperature, float *humidity);
+// Register the SHT3x on a shared I2C bus and soft-reset it
+bool init_temp_hum_sensor(i2c_bus_t *bus);
+
+// Read temperature (centi-°C) and relative humidity (centi-%RH) as fixed-point values
+bool read_temp_hum_data(fx_centi_t *temperature, fx_centi_t *humidity);
+
+// Trigger a single-shot measurement and return without waiting for it (~16 ms),
+// so the conversion can overlap other work such as a PMS7003 frame transfer
+bool start_temp_hum_measurement();
+
+// Fetch the result of start_temp_hum_measurement(), polling the bus until the transaction
+// has completed. timestamp_us (optional) receives the I2C completion time.
+bool fetch_temp_hum_data(fx_centi_t *temperature, fx_centi_t *humidity, uint64_t *timestamp_us);
 
 #endif // TEMP_HUM_H
@@ -12,84 +12,188 @@
 #include "pin_config.h"
 #include "pms7003_defs.h"
 #include <stdio.h>
+#include <string.h>
 
 const uint8_t PMS_PASSIVE_MODE_CMD[PMS_PASSIVE_MODE_CMD_LEN] = {0x42, 0x4D, 0xE1, 0x00, 0x00, 0x01, 0x70};
 
-// Static HAL instance - set during init
-static const pm25_hal_t *g_hal = NULL;
+pm25_sensor_config_t pm25_sensor_default_config(void) {
+    pm25_sensor_config_t config = {
+        .uart = PMS_UART,
+        .tx_pin = PMS_TX_PIN,
+        .rx_pin = PMS_RX_PIN,
+        .set_pin = PMS_SET_PIN,
+        .reset_pin = PMS_RESET_PIN
+    };
+    return config;
+}
+
+void pm25_sensor_init(pm25_sensor_t *sensor, const pm25_sensor_config_t *config, const pm25_hal_t *hal) {
+    if (sensor == NULL) {
+        printf("DEBUG: sensor is NULL\n");
+        return;
+    }
+
+    memset(sensor, 0, sizeof(*sensor));
+    sensor->config = (config != NULL) ? *config : pm25_sensor_default_config();
 
-void pm25_sensor_init(const pm25_hal_t *hal) {
     // Use provided HAL or default to real hardware
-    g_hal = (hal != NULL) ? hal : pm25_get_default_hal();
+    sensor->hal = (hal != NULL) ? hal : pm25_get_default_hal();
+    const pm25_sensor_config_t *cfg = &sensor->config;
     
     // Initialize UART with the configured baud rate
-    if (g_hal->uart != NULL) {
-        g_hal->uart->init(PMS_UART, PMS_BAUD_RATE);
+    if (PM25_HAL_HAS_UART(sensor)) {
+        PM25_HAL_UART_INIT(sensor, PMS_BAUD_RATE);
     } else {
         printf("DEBUG: UART HAL is NULL\n");
     }
     
-    if (g_hal->gpio != NULL) {
-        g_hal->gpio->set_function(PMS_TX_PIN, GPIO_FUNC_UART);
-        g_hal->gpio->set_function(PMS_RX_PIN, GPIO_FUNC_UART);
+    if (PM25_HAL_HAS_GPIO(sensor)) {
+        PM25_HAL_GPIO_SET_FUNCTION(sensor, cfg->tx_pin, GPIO_FUNC_UART);
+        PM25_HAL_GPIO_SET_FUNCTION(sensor, cfg->rx_pin, GPIO_FUNC_UART);
 
         // Initialize SET pin (for mode control)
-        g_hal->gpio->init(PMS_SET_PIN);
-        g_hal->gpio->set_dir(PMS_SET_PIN, true);  // Output
-        g_hal->gpio->put(PMS_SET_PIN, 1);         // Active mode
+        PM25_HAL_GPIO_INIT(sensor, cfg->set_pin);
+        PM25_HAL_GPIO_SET_DIR(sensor, cfg->set_pin, true);  // Output
+        PM25_HAL_GPIO_PUT(sensor, cfg->set_pin, 1);         // Active mode
 
         // Initialize RESET pin
-        g_hal->gpio->init(PMS_RESET_PIN);
-        g_hal->gpio->set_dir(PMS_RESET_PIN, true);  // Output
-        g_hal->gpio->put(PMS_RESET_PIN, 1);         // Not in reset
+        PM25_HAL_GPIO_INIT(sensor, cfg->reset_pin);
+        PM25_HAL_GPIO_SET_DIR(sensor, cfg->reset_pin, true);  // Output
+        PM25_HAL_GPIO_PUT(sensor, cfg->reset_pin, 1);         // Not in reset
     } else {
         printf("DEBUG: GPIO HAL is NULL\n");
     }
     
     // Send passive mode command
-    g_hal->uart->write_blocking(PMS_UART, PMS_PASSIVE_MODE_CMD, PMS_PASSIVE_MODE_CMD_LEN);
+    if (PM25_HAL_HAS_UART(sensor)) {
+        PM25_HAL_UART_WRITE_BLOCKING(sensor, PMS_PASSIVE_MODE_CMD, PMS_PASSIVE_MODE_CMD_LEN);
+    }
+    sensor->silence_since_us = PM25_HAL_TIME_US(sensor);
 }
 
-bool pm25_sensor_read(pm25_data_t *data) {
-    if (data == NULL || g_hal == NULL) {
-        printf("DEBUG: data=%p, g_hal=%p\n", (void*)data, (void*)g_hal);
-        return false;
+// Silence and error-rate windows start over, e.g. after a wake-up or a reset
+static void link_restart(pm25_sensor_t *sensor, uint64_t now_us) {
+    sensor->silence_since_us = now_us;
+    sensor->silent_reads = 0;
+    sensor->window_reads = 0;
+    sensor->window_errors = 0;
+}
+
+static void link_record(pm25_sensor_t *sensor, pm25_link_result_t result) {
+    sensor->last_result = result;
+    if (result == PM25_LINK_OK) {
+        sensor->link.good++;
+        sensor->link.last_good_us = sensor->frame_time_us;
+        sensor->silence_since_us = sensor->frame_time_us;
+        sensor->silent_reads = 0;
+        sensor->failed_resets = 0;
+    } else {
+        sensor->link.bad[result]++;
+        if (sensor->silent_reads < UINT8_MAX) {
+            sensor->silent_reads++;
+        }
+    }
+    // The error rate is over reads that received something; silence is handled on its own
+    if (result != PM25_LINK_NO_DATA && sensor->window_reads < PM25_LINK_WINDOW) {
+        sensor->window_reads++;
+        if (result != PM25_LINK_OK) {
+            sensor->window_errors++;
+        }
     }
+}
 
-    if (g_hal->uart == NULL) {
-        printf("DEBUG: UART HAL is NULL\n");
+bool pm25_sensor_check_link(pm25_sensor_t *sensor) {
+    if (sensor == NULL || sensor->hal == NULL || !PM25_HAL_HAS_GPIO(sensor)) {
         return false;
     }
-    
-    uint8_t frame[PMS_FRAME_LENGTH];
-    
-    // Check if data is available
-    if (!g_hal->uart->is_readable(PMS_UART)) {
-        printf("DEBUG: UART not readable\n");
+    uint64_t now_us = PM25_HAL_TIME_US(sensor);
+
+    switch (sensor->recovery) {
+    case PM25_RECOVERY_RESET:
+        if (now_us - sensor->recovery_since_us >= PM25_RESET_PULSE_MS * 1000ull) {
+            PM25_HAL_GPIO_PUT(sensor, sensor->config.reset_pin, 1);
+            sensor->recovery = PM25_RECOVERY_BOOT;
+            sensor->recovery_since_us = now_us;
+        }
+        return true;
+    case PM25_RECOVERY_BOOT:
+        if (now_us - sensor->recovery_since_us < PM25_RESET_BOOT_MS * 1000ull) {
+            return true;
+        }
+        // The sensor comes out of reset in active mode
+        if (PM25_HAL_HAS_UART(sensor)) {
+            PM25_HAL_UART_WRITE_BLOCKING(sensor, PMS_PASSIVE_MODE_CMD, PMS_PASSIVE_MODE_CMD_LEN);
+        }
+        sensor->recovery = PM25_RECOVERY_NONE;
+        sensor->resync = true;
+        link_restart(sensor, now_us);
         return false;
+    default:
+        break;
     }
-    
-    // Read start bytes
-    g_hal->uart->read_blocking(PMS_UART, &frame[0], 1);
-    printf("DEBUG: Start1: 0x%02X\n", frame[0]);
-    if (frame[0] != PMS_FRAME_START1) {
+
+    if (sensor->asleep) {
         return false;
     }
-    
-    g_hal->uart->read_blocking(PMS_UART, &frame[1], 1);
-    printf("DEBUG: Start2: 0x%02X\n", frame[1]);
-    if (frame[1] != PMS_FRAME_START2) {
+    uint8_t backoff = (sensor->failed_resets < PM25_LINK_BACKOFF_MAX) ? sensor->failed_resets : PM25_LINK_BACKOFF_MAX;
+    uint64_t silence_us = (PM25_LINK_SILENCE_MS * 1000ull) << backoff;
+
+    bool wedged = false;
+    if (sensor->window_reads >= PM25_LINK_WINDOW) {
+        wedged = sensor->window_errors >= PM25_LINK_MAX_ERRORS &&
+                 (sensor->link.resets == 0 || now_us - sensor->last_reset_us >= silence_us);
+        sensor->window_reads = 0;
+        sensor->window_errors = 0;
+    }
+    if (sensor->silent_reads >= PM25_LINK_SILENT_READS && now_us - sensor->silence_since_us >= silence_us) {
+        wedged = true;
+    }
+    if (!wedged) {
         return false;
     }
-    
-    // Read the rest of the frame
-    g_hal->uart->read_blocking(PMS_UART, &frame[2], PMS_FRAME_LENGTH - 2);
-    
+
+    PM25_HAL_GPIO_PUT(sensor, sensor->config.reset_pin, 0);
+    sensor->recovery = PM25_RECOVERY_RESET;
+    sensor->recovery_since_us = now_us;
+    sensor->last_reset_us = now_us;
+    sensor->link.resets++;
+    if (sensor->failed_resets < UINT8_MAX) {
+        sensor->failed_resets++;
+    }
+    return true;
+}
+
+void pm25_sensor_resync(pm25_sensor_t *sensor) {
+    if (sensor != NULL) {
+        sensor->resync = true;
+    }
+}
+
+void pm25_sensor_set_sleep(pm25_sensor_t *sensor, bool sleep) {
+    if (sensor == NULL || sensor->hal == NULL || !PM25_HAL_HAS_GPIO(sensor)) {
+        return;
+    }
+    // SET pin: high/floating = normal, low = sleep
+    PM25_HAL_GPIO_PUT(sensor, sensor->config.set_pin, !sleep);
+    if (sensor->asleep && !sleep) {
+        link_restart(sensor, PM25_HAL_TIME_US(sensor));
+    }
+    sensor->asleep = sleep;
+}
+
+pm25_link_result_t pm25_check_frame(const uint8_t frame[PMS_FRAME_LENGTH]) {
+    if (frame == NULL) {
+        return PM25_LINK_NO_DATA;
+    }
+
+    if (frame[0] != PMS_FRAME_START1 || frame[1] != PMS_FRAME_START2) {
+        return PM25_LINK_BAD_START;
+    }
+
     // Verify frame length
     uint16_t frame_len = (frame[2] << 8) | frame[3];
-    printf("DEBUG: Frame len: %u\n", frame_len);
     if (frame_len != PMS_DATA_FRAME_LEN) {
-        return false;
+        return PM25_LINK_BAD_LENGTH;
     }
     
     // Calculate and verify checksum
@@ -98,9 +202,14 @@ bool pm25_sensor_read(pm25_data_t *data) {
         checksum += frame[i];
     }
     uint16_t received_checksum = (frame[PMS_FRAME_LENGTH - 2] << 8) | frame[PMS_FRAME_LENGTH - 1];
-    
-    printf("DEBUG: Checksum calc=0x%04X recv=0x%04X\n", checksum, received_checksum);
     if (checksum != received_checksum) {
+        return PM25_LINK_BAD_CHECKSUM;
+    }
+    return PM25_LINK_OK;
+}
+
+bool pm25_parse_frame(const uint8_t frame[PMS_FRAME_LENGTH], pm25_data_t *data) {
+    if (frame == NULL || data == NULL || pm25_check_frame(frame) != PM25_LINK_OK) {
         return false;
     }
     
@@ -117,7 +226,68 @@ bool pm25_sensor_read(pm25_data_t *data) {
     data->count_2_5 = (frame[22] << 8) | frame[23];
     data->count_5_0 = (frame[24] << 8) | frame[25];
     data->count_10 = (frame[26] << 8) | frame[27];
+    return true;
+}
+
+bool pm25_sensor_read(pm25_sensor_t *sensor, pm25_data_t *data) {
+    if (sensor == NULL || data == NULL || sensor->hal == NULL) {
+        printf("DEBUG: sensor=%p, data=%p\n", (void*)sensor, (void*)data);
+        return false;
+    }
+
+    uint8_t *frame = sensor->frame;
+
+    if (!PM25_HAL_HAS_UART(sensor)) {
+        printf("DEBUG: UART HAL is NULL\n");
+        return false;
+    }
     
-    printf("DEBUG: Parse OK, pm1_0=%u\n", data->pm1_0_cf1);
+    // Held in reset: nothing to read, and nothing to count against the link
+    if (sensor->recovery != PM25_RECOVERY_NONE) {
+        sensor->last_result = PM25_LINK_NO_DATA;
+        return false;
+    }
+
+    // Check if data is available
+    if (!PM25_HAL_UART_IS_READABLE(sensor)) {
+        link_record(sensor, PM25_LINK_NO_DATA);
+        return false;
+    }
+    
+    // Read start bytes; while resynchronising, skip buffered bytes up to the next start byte
+    PM25_HAL_UART_READ_BLOCKING(sensor, &frame[0], 1);
+    while (sensor->resync && frame[0] != PMS_FRAME_START1 && PM25_HAL_UART_IS_READABLE(sensor)) {
+        sensor->link.resync_bytes++;
+        PM25_HAL_UART_READ_BLOCKING(sensor, &frame[0], 1);
+    }
+    if (frame[0] != PMS_FRAME_START1) {
+        // Out of step: find the next start byte on the following reads instead of failing byte by byte
+        sensor->resync = true;
+        link_record(sensor, PM25_LINK_BAD_START);
+        return false;
+    }
+    // Start-of-frame: the remaining 31 bytes take another ~32 ms at 9600 baud
+    uint64_t frame_time_us = PM25_HAL_TIME_US(sensor);
+    
+    PM25_HAL_UART_READ_BLOCKING(sensor, &frame[1], 1);
+    if (frame[1] != PMS_FRAME_START2) {
+        sensor->resync = true;
+        link_record(sensor, PM25_LINK_BAD_START);
+        return false;
+    }
+    
+    // Read the rest of the frame
+    PM25_HAL_UART_READ_BLOCKING(sensor, &frame[2], PMS_FRAME_LENGTH - 2);
+    
+    pm25_link_result_t result = pm25_check_frame(frame);
+    if (result != PM25_LINK_OK) {
+        sensor->resync = true;
+        link_record(sensor, result);
+        return false;
+    }
+    pm25_parse_frame(frame, data);
+    sensor->resync = false;
+    sensor->frame_time_us = frame_time_us;
+    link_record(sensor, PM25_LINK_OK);
     return true;
-}
\ No newline at end of file
+}
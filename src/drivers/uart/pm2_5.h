@@ -16,9 +16,12 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-// Forward declaration
+#include "pms7003_defs.h"
+
+// Forward declarations
 struct pm25_hal;
 typedef struct pm25_hal pm25_hal_t;
+typedef struct uart_inst uart_inst_t;
 
 // Structure to hold PM2.5 sensor data based on PMS7003 output format
 typedef struct {
@@ -36,12 +39,134 @@ typedef struct {
     uint16_t count_10;      // Number of particles >10μm in 0.1L air
 } pm25_data_t;
 
-// Initialize the pm2.5 sensor (PMS7003 via UART)
+// Field selectors for per-field processing of pm25_data_t (filters, deadbands, payloads)
+typedef enum {
+    PM25_FIELD_PM1_0_CF1 = 0,
+    PM25_FIELD_PM2_5_CF1,
+    PM25_FIELD_PM10_CF1,
+    PM25_FIELD_PM1_0_ATM,
+    PM25_FIELD_PM2_5_ATM,
+    PM25_FIELD_PM10_ATM,
+    PM25_FIELD_COUNT_0_3,
+    PM25_FIELD_COUNT_0_5,
+    PM25_FIELD_COUNT_1_0,
+    PM25_FIELD_COUNT_2_5,
+    PM25_FIELD_COUNT_5_0,
+    PM25_FIELD_COUNT_10,
+    PM25_FIELD_COUNT         // Number of fields
+} pm25_field_t;
+
+// Bit of a field in per-field masks
+#define PM25_FIELD_BIT(field)   (1u << (field))
+#define PM25_FIELD_MASK_ALL     ((1u << PM25_FIELD_COUNT) - 1u)
+
+// Wiring of a single PMS7003 unit. The uart handle is opaque to the driver and is
+// only passed through to the HAL, so it may name uart0/uart1 or a PIO-based UART.
+typedef struct {
+    uart_inst_t *uart;      // UART instance (or HAL-specific handle) the sensor is attached to
+    unsigned int tx_pin;    // GPIO pin of Pico W for PMS7003 TX
+    unsigned int rx_pin;    // GPIO pin of Pico W for PMS7003 RX
+    unsigned int set_pin;   // GPIO pin of Pico W for PMS7003 SET
+    unsigned int reset_pin; // GPIO pin of Pico W for PMS7003 RESET
+} pm25_sensor_config_t;
+
+// Link health: a wedged sensor is reset through its RESET pin when, while awake, at least
+// PM25_LINK_MAX_ERRORS of PM25_LINK_WINDOW frames are bad, or PM25_LINK_SILENT_READS reads in a row and
+// PM25_LINK_SILENCE_MS bring no good frame. Each reset that brings no good frame doubles the silence (and the
+// gap between resets) up to PM25_LINK_BACKOFF_MAX times, so a dead sensor is not reset forever at full rate.
+#define PM25_LINK_WINDOW            16
+#define PM25_LINK_MAX_ERRORS        8
+#define PM25_LINK_SILENT_READS      3
+#define PM25_LINK_SILENCE_MS        30000
+#define PM25_LINK_BACKOFF_MAX       4
+#define PM25_RESET_PULSE_MS         10      // RESET held low at least this long
+#define PM25_RESET_BOOT_MS          1000    // From the release of RESET to the mode command
+
+// Outcome of a read, for the per-cause counters
+typedef enum {
+    PM25_LINK_OK = 0,
+    PM25_LINK_NO_DATA,          // Nothing received
+    PM25_LINK_BAD_START,        // Start bytes missing (bytes lost or line noise)
+    PM25_LINK_BAD_LENGTH,       // Frame length field other than 28
+    PM25_LINK_BAD_CHECKSUM,
+    PM25_LINK_RESULT_COUNT
+} pm25_link_result_t;
+
+typedef enum {
+    PM25_RECOVERY_NONE = 0,
+    PM25_RECOVERY_RESET,        // RESET held low
+    PM25_RECOVERY_BOOT          // RESET released, sensor starting up
+} pm25_recovery_t;
+
+typedef struct {
+    uint32_t good;                          // Frames read
+    uint32_t bad[PM25_LINK_RESULT_COUNT];   // Failed reads by cause ([PM25_LINK_OK] unused)
+    uint32_t resync_bytes;                  // Bytes skipped looking for a start byte
+    uint32_t resets;                        // Recoveries through the RESET pin
+    uint64_t last_good_us;                  // Start-of-frame time of the last good frame, 0 if none yet
+} pm25_link_stats_t;
+
+// Per-sensor driver context. One instance per PMS7003; all fields are owned by the driver.
+typedef struct {
+    const pm25_hal_t *hal;              // HAL bound at init, NULL while uninitialized
+    pm25_sensor_config_t config;        // UART and pin assignment of this sensor
+    uint8_t frame[PMS_FRAME_LENGTH];    // Parser state: last frame received from this sensor
+    uint64_t frame_time_us;             // Start-of-frame time of the last frame, 0 without a HAL clock
+    bool resync;                        // Skip to the next start byte until a frame parses (after a wake-up)
+    // Link health
+    pm25_link_stats_t link;
+    pm25_link_result_t last_result;     // Outcome of the last read
+    bool asleep;                        // Parked through the SET pin: silence is expected
+    uint8_t window_reads;               // Reads that received bytes in the current error-rate window
+    uint8_t window_errors;              // Of those, bad frames
+    uint8_t silent_reads;               // Reads without a good frame since the last one
+    uint8_t failed_resets;              // Resets in a row without a good frame since
+    pm25_recovery_t recovery;
+    uint64_t recovery_since_us;         // Start of the current recovery step
+    uint64_t silence_since_us;          // Last good frame, wake-up or end of a reset, whichever is latest
+    uint64_t last_reset_us;
+} pm25_sensor_t;
+
+// Get the configuration of the on-board sensor described in pin_config.h
+pm25_sensor_config_t pm25_sensor_default_config(void);
+
+// Initialize one pm2.5 sensor (PMS7003 via UART)
+// If config is NULL, uses the on-board pin configuration
 // If hal is NULL, uses default (real hardware) HAL
-void pm25_sensor_init(const pm25_hal_t *hal);
+void pm25_sensor_init(pm25_sensor_t *sensor, const pm25_sensor_config_t *config, const pm25_hal_t *hal);
 
 // Read data from PM2.5 sensor
 // Return true on successful read with valid checksum, false otherwise
-bool pm25_sensor_read(pm25_data_t *data);
+bool pm25_sensor_read(pm25_sensor_t *sensor, pm25_data_t *data);
+
+// Resynchronise the frame parser after the receiver may have missed bytes (e.g. wake-up from deep sleep):
+// the next reads skip buffered bytes up to a start byte instead of failing one byte per call
+void pm25_sensor_resync(pm25_sensor_t *sensor);
+
+// Run the link recovery: start a reset when the link looks wedged and advance a reset in progress (RESET low,
+// release, then the passive mode command again). Call before each read; needs the HAL clock.
+// Return true while a reset is in progress: the sensor sends nothing useful, so skip the read
+bool pm25_sensor_check_link(pm25_sensor_t *sensor);
+
+// Put the sensor to sleep (fan and laser off) or wake it up, via the SET pin
+// After wake-up, data is stable only after PMS_WAKEUP_STABLE_MS
+void pm25_sensor_set_sleep(pm25_sensor_t *sensor, bool sleep);
+
+// Get / set one field of a sample by selector
+uint16_t pm25_data_get(const pm25_data_t *data, pm25_field_t field);
+void pm25_data_set(pm25_data_t *data, pm25_field_t field, uint16_t value);
+
+// Short field name, matching the pm25_data_t member name (e.g. "pm2_5_atm")
+const char *pm25_field_name(pm25_field_t field);
+
+// Check start bytes, length and checksum of a complete PMS7003 frame
+pm25_link_result_t pm25_check_frame(const uint8_t frame[PMS_FRAME_LENGTH]);
+
+// Short name of a read outcome (e.g. "checksum")
+const char *pm25_link_result_name(pm25_link_result_t result);
+
+// Decode a complete PMS7003 frame (start bytes, length and checksum are verified)
+// Return true if the frame is valid and data was filled, false otherwise
+bool pm25_parse_frame(const uint8_t frame[PMS_FRAME_LENGTH], pm25_data_t *data);
 
 #endif // PM25_SENSOR_H
\ No newline at end of file
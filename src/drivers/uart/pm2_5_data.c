@@ -0,0 +1,72 @@
+/**
+ * File: pm2_5_data.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Field accessors for PMS7003 samples, so processing stages can be configured per pm25_data_t field,
+ * and names of read outcomes for the link counters.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#include "pm2_5.h"
+#include <stddef.h>
+
+typedef struct {
+    size_t offset;
+    const char *name;
+} pm25_field_desc_t;
+
+#define PM25_FIELD_DESC(member) { offsetof(pm25_data_t, member), #member }
+
+static const pm25_field_desc_t PM25_FIELDS[PM25_FIELD_COUNT] = {
+    [PM25_FIELD_PM1_0_CF1] = PM25_FIELD_DESC(pm1_0_cf1),
+    [PM25_FIELD_PM2_5_CF1] = PM25_FIELD_DESC(pm2_5_cf1),
+    [PM25_FIELD_PM10_CF1]  = PM25_FIELD_DESC(pm10_cf1),
+    [PM25_FIELD_PM1_0_ATM] = PM25_FIELD_DESC(pm1_0_atm),
+    [PM25_FIELD_PM2_5_ATM] = PM25_FIELD_DESC(pm2_5_atm),
+    [PM25_FIELD_PM10_ATM]  = PM25_FIELD_DESC(pm10_atm),
+    [PM25_FIELD_COUNT_0_3] = PM25_FIELD_DESC(count_0_3),
+    [PM25_FIELD_COUNT_0_5] = PM25_FIELD_DESC(count_0_5),
+    [PM25_FIELD_COUNT_1_0] = PM25_FIELD_DESC(count_1_0),
+    [PM25_FIELD_COUNT_2_5] = PM25_FIELD_DESC(count_2_5),
+    [PM25_FIELD_COUNT_5_0] = PM25_FIELD_DESC(count_5_0),
+    [PM25_FIELD_COUNT_10]  = PM25_FIELD_DESC(count_10),
+};
+
+uint16_t pm25_data_get(const pm25_data_t *data, pm25_field_t field) {
+    if (data == NULL || (unsigned)field >= PM25_FIELD_COUNT) {
+        return 0;
+    }
+    return *(const uint16_t *)((const uint8_t *)data + PM25_FIELDS[field].offset);
+}
+
+void pm25_data_set(pm25_data_t *data, pm25_field_t field, uint16_t value) {
+    if (data == NULL || (unsigned)field >= PM25_FIELD_COUNT) {
+        return;
+    }
+    *(uint16_t *)((uint8_t *)data + PM25_FIELDS[field].offset) = value;
+}
+
+const char *pm25_field_name(pm25_field_t field) {
+    if ((unsigned)field >= PM25_FIELD_COUNT) {
+        return "";
+    }
+    return PM25_FIELDS[field].name;
+}
+
+const char *pm25_link_result_name(pm25_link_result_t result) {
+    switch (result) {
+    case PM25_LINK_OK:
+        return "ok";
+    case PM25_LINK_NO_DATA:
+        return "no_data";
+    case PM25_LINK_BAD_START:
+        return "start";
+    case PM25_LINK_BAD_LENGTH:
+        return "length";
+    case PM25_LINK_BAD_CHECKSUM:
+        return "checksum";
+    default:
+        return "?";
+    }
+}
@@ -63,15 +63,41 @@ typedef struct {
 /**
  * @brief Complete Hardware Abstraction Layer for PM2.5 driver
  * 
- * Contains both UART and GPIO HALs.
+ * Contains both UART and GPIO HALs, plus the microsecond clock used to
+ * timestamp frames (optional, may be NULL).
  */
 struct pm25_hal {
     const pm25_uart_hal_t *uart;
     const pm25_gpio_hal_t *gpio;
+    uint64_t (*time_us)(void);
 };
 typedef struct pm25_hal pm25_hal_t;
 
 // Get the default (real hardware) HAL implementation
 const pm25_hal_t* pm25_get_default_hal(void);
 
+/**
+ * @brief HAL call sites used by the driver, bound at build time
+ * 
+ * With PM25_HAL_STATIC (firmware builds) the calls resolve directly to the Pico SDK /
+ * PIO UART functions and can be inlined; see pm2_5_hal_static.h. Otherwise they go
+ * through the sensor's runtime pm25_hal_t table, which is what the mock build uses.
+ * The argument s is the pm25_sensor_t being driven.
+ */
+#if defined(PM25_HAL_STATIC) && !defined(PM25_HAL_MOCK_BUILD)
+#include "pm2_5_hal_static.h"
+#else
+#define PM25_HAL_HAS_UART(s)                    ((s)->hal->uart != NULL)
+#define PM25_HAL_HAS_GPIO(s)                    ((s)->hal->gpio != NULL)
+#define PM25_HAL_UART_INIT(s, baud)             ((s)->hal->uart->init((s)->config.uart, (baud)))
+#define PM25_HAL_UART_IS_READABLE(s)            ((s)->hal->uart->is_readable((s)->config.uart))
+#define PM25_HAL_UART_READ_BLOCKING(s, dst, n)  ((s)->hal->uart->read_blocking((s)->config.uart, (dst), (n)))
+#define PM25_HAL_UART_WRITE_BLOCKING(s, src, n) ((s)->hal->uart->write_blocking((s)->config.uart, (src), (n)))
+#define PM25_HAL_GPIO_INIT(s, pin)              ((s)->hal->gpio->init(pin))
+#define PM25_HAL_GPIO_SET_DIR(s, pin, out)      ((s)->hal->gpio->set_dir((pin), (out)))
+#define PM25_HAL_GPIO_PUT(s, pin, value)        ((s)->hal->gpio->put((pin), (value)))
+#define PM25_HAL_GPIO_SET_FUNCTION(s, pin, fn)  ((s)->hal->gpio->set_function((pin), (fn)))
+#define PM25_HAL_TIME_US(s)                     (((s)->hal->time_us != NULL) ? (s)->hal->time_us() : 0)
+#endif
+
 #endif // PM25_HAL_H
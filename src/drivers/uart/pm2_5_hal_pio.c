@@ -0,0 +1,316 @@
+/**
+ * @file pm2_5_hal_pio.c
+ * @author trung.la
+ * @date October 19 2026
+ * @brief PIO + DMA implementation of the PM2.5 UART HAL using Pico SDK
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#include "pm2_5_hal_pio.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+#include "pms_uart.pio.h"
+
+// DMA transfer count used for the RX channels; re-armed from the completion IRQ
+#define PIO_UART_DMA_COUNT      0xFFFFFFFFu
+
+// Shared TX state machine of one PIO block
+typedef struct {
+    int sm;                 // Claimed state machine, -1 if not loaded yet
+    uint offset;            // Program offset in instruction memory
+    uint baud;              // Baud rate the state machine is running at
+    int current_pin;        // TX pin the state machine currently drives
+} pio_uart_tx_t;
+
+typedef struct {
+    uint8_t *ring;          // Ring buffer written by DMA (ring-size aligned)
+    PIO pio;
+    uint sm;
+    int dma_chan;
+    uint tx_pin;
+    uint rx_pin;
+    uint baud;              // Baud rate the RX state machine is running at
+    bool claimed;
+    bool started;
+    uint32_t consumed;      // Total bytes handed to the driver
+    uint32_t overruns;      // Bytes lost because the reader fell behind
+    uint32_t max_fill;      // Most unread bytes seen in the ring
+} pio_uart_t;
+
+static pio_uart_t pio_uarts[PM25_PIO_UART_MAX];
+
+// DMA ring wrap requires each buffer to be aligned to its own size
+static uint8_t pio_uart_rings[PM25_PIO_UART_MAX][PM25_PIO_UART_RING_SIZE]
+    __attribute__((aligned(PM25_PIO_UART_RING_SIZE)));
+
+static pio_uart_tx_t pio_uart_tx[NUM_PIOS] = {
+    { .sm = -1 }, { .sm = -1 }
+};
+
+static int rx_program_offset[NUM_PIOS] = { -1, -1 };
+
+static pio_uart_t *to_pio_uart(uart_inst_t *uart) {
+    pio_uart_t *u = (pio_uart_t *)uart;
+    if (u < &pio_uarts[0] || u >= &pio_uarts[PM25_PIO_UART_MAX] || !u->claimed) {
+        return NULL;
+    }
+    return u;
+}
+
+// Total number of bytes the DMA channel has written since it was (re)armed
+static inline uint32_t rx_produced(const pio_uart_t *u) {
+    return PIO_UART_DMA_COUNT - dma_channel_hw_addr((uint)u->dma_chan)->transfer_count;
+}
+
+static void rx_dma_start(pio_uart_t *u) {
+    dma_channel_config c = dma_channel_get_default_config((uint)u->dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, PM25_PIO_UART_RING_BITS);
+    channel_config_set_dreq(&c, pio_get_dreq(u->pio, u->sm, false));
+
+    u->consumed = 0;
+    // Received byte sits in bits 31:24 of the FIFO word
+    dma_channel_configure((uint)u->dma_chan, &c, u->ring,
+                          (const volatile uint8_t *)&u->pio->rxf[u->sm] + 3,
+                          PIO_UART_DMA_COUNT, true);
+}
+
+// Re-arm channels that ran out of transfers (after ~2^32 bytes); never per byte
+static void rx_dma_irq_handler(void) {
+    for (int i = 0; i < PM25_PIO_UART_MAX; i++) {
+        pio_uart_t *u = &pio_uarts[i];
+        if (u->started && dma_irqn_get_channel_status(1, (uint)u->dma_chan)) {
+            dma_irqn_acknowledge_channel(1, (uint)u->dma_chan);
+            rx_dma_start(u);
+        }
+    }
+}
+
+uart_inst_t *pm25_pio_uart_claim(uint tx_pin, uint rx_pin) {
+    for (int i = 0; i < PM25_PIO_UART_MAX; i++) {
+        pio_uart_t *u = &pio_uarts[i];
+        if (u->claimed) {
+            continue;
+        }
+
+        // Prefer pio0, fall back to pio1 (the CYW43 driver may hold state machines too)
+        for (uint p = 0; p < NUM_PIOS; p++) {
+            PIO pio = pio_get_instance(p);
+            if (rx_program_offset[p] < 0) {
+                if (!pio_can_add_program(pio, &pms_uart_rx_program)) {
+                    continue;
+                }
+                rx_program_offset[p] = pio_add_program(pio, &pms_uart_rx_program);
+            }
+            int sm = pio_claim_unused_sm(pio, false);
+            if (sm < 0) {
+                continue;
+            }
+            int chan = dma_claim_unused_channel(false);
+            if (chan < 0) {
+                pio_sm_unclaim(pio, (uint)sm);
+                return NULL;
+            }
+
+            u->ring = pio_uart_rings[i];
+            u->pio = pio;
+            u->sm = (uint)sm;
+            u->dma_chan = chan;
+            u->tx_pin = tx_pin;
+            u->rx_pin = rx_pin;
+            u->claimed = true;
+            u->started = false;
+            u->consumed = 0;
+            u->overruns = 0;
+            u->max_fill = 0;
+            return (uart_inst_t *)u;
+        }
+        return NULL;
+    }
+    return NULL;
+}
+
+uint32_t pm25_pio_uart_overruns(uart_inst_t *uart) {
+    pio_uart_t *u = to_pio_uart(uart);
+    return (u != NULL) ? u->overruns : 0;
+}
+
+uint32_t pm25_pio_uart_max_fill(uart_inst_t *uart) {
+    pio_uart_t *u = to_pio_uart(uart);
+    return (u != NULL) ? u->max_fill : 0;
+}
+
+static bool tx_ensure_loaded(pio_uart_t *u, uint baud) {
+    uint p = pio_get_index(u->pio);
+    pio_uart_tx_t *tx = &pio_uart_tx[p];
+    if (tx->sm >= 0) {
+        return true;
+    }
+    if (!pio_can_add_program(u->pio, &pms_uart_tx_program)) {
+        return false;
+    }
+    int sm = pio_claim_unused_sm(u->pio, false);
+    if (sm < 0) {
+        return false;
+    }
+    tx->offset = pio_add_program(u->pio, &pms_uart_tx_program);
+    tx->sm = sm;
+    tx->baud = baud;
+    tx->current_pin = (int)u->tx_pin;
+    pms_uart_tx_program_init(u->pio, (uint)sm, tx->offset, u->tx_pin, baud);
+    return true;
+}
+
+// PIO UART implementation
+void pm25_pio_uart_init(uart_inst_t *uart, uint baudrate) {
+    pio_uart_t *u = to_pio_uart(uart);
+    if (u == NULL) {
+        return;
+    }
+
+    uint p = pio_get_index(u->pio);
+    u->baud = baudrate;
+    pms_uart_rx_program_init(u->pio, u->sm, (uint)rx_program_offset[p], u->rx_pin, baudrate);
+    tx_ensure_loaded(u, baudrate);
+
+    // Idle-high TX line while the shared TX state machine drives another sensor
+    gpio_pull_up(u->tx_pin);
+
+    static bool irq_installed = false;
+    if (!irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_1, rx_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_1, true);
+        irq_installed = true;
+    }
+    dma_irqn_set_channel_enabled(1, (uint)u->dma_chan, true);
+
+    rx_dma_start(u);
+    u->started = true;
+}
+
+void pm25_pio_uart_reclock(void) {
+    for (int i = 0; i < PM25_PIO_UART_MAX; i++) {
+        pio_uart_t *u = &pio_uarts[i];
+        if (u->started) {
+            pms_uart_program_set_baud(u->pio, u->sm, u->baud);
+        }
+    }
+    for (uint p = 0; p < NUM_PIOS; p++) {
+        if (pio_uart_tx[p].sm >= 0) {
+            pms_uart_program_set_baud(pio_get_instance(p), (uint)pio_uart_tx[p].sm, pio_uart_tx[p].baud);
+        }
+    }
+}
+
+bool pm25_pio_uart_is_readable(uart_inst_t *uart) {
+    pio_uart_t *u = to_pio_uart(uart);
+    return (u != NULL) && u->started && (rx_produced(u) != u->consumed);
+}
+
+void pm25_pio_uart_read_blocking(uart_inst_t *uart, uint8_t *dst, size_t len) {
+    pio_uart_t *u = to_pio_uart(uart);
+    if (u == NULL || !u->started) {
+        return;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        uint32_t produced;
+        while ((produced = rx_produced(u)) == u->consumed) {
+            tight_loop_contents();
+        }
+        // Reader fell more than a ring behind: skip to the oldest byte still buffered
+        if (produced - u->consumed > PM25_PIO_UART_RING_SIZE) {
+            u->overruns += produced - u->consumed - PM25_PIO_UART_RING_SIZE;
+            u->consumed = produced - PM25_PIO_UART_RING_SIZE;
+        }
+        if (produced - u->consumed > u->max_fill) {
+            u->max_fill = produced - u->consumed;
+        }
+        dst[i] = u->ring[u->consumed & (PM25_PIO_UART_RING_SIZE - 1)];
+        u->consumed++;
+    }
+}
+
+void pm25_pio_uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len) {
+    pio_uart_t *u = to_pio_uart(uart);
+    if (u == NULL) {
+        return;
+    }
+    pio_uart_tx_t *tx = &pio_uart_tx[pio_get_index(u->pio)];
+    if (tx->sm < 0) {
+        return;
+    }
+
+    if (tx->current_pin != (int)u->tx_pin) {
+        // Let the previous sensor's last byte leave the shifter before re-pointing
+        while (!pio_sm_is_tx_fifo_empty(u->pio, (uint)tx->sm)) {
+            tight_loop_contents();
+        }
+        busy_wait_us(11u * 1000000u / tx->baud);
+        pms_uart_tx_program_select_pin(u->pio, (uint)tx->sm, u->tx_pin);
+        tx->current_pin = (int)u->tx_pin;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        pio_sm_put_blocking(u->pio, (uint)tx->sm, (uint32_t)src[i]);
+    }
+}
+
+// GPIO implementation: plain SDK calls, except that UART pin muxing of PIO UART
+// pins is redirected to the PIO block that owns them
+static void pio_gpio_hal_init(uint gpio) {
+    gpio_init(gpio);
+}
+
+static void pio_gpio_hal_set_dir(uint gpio, bool out) {
+    gpio_set_dir(gpio, out);
+}
+
+static void pio_gpio_hal_put(uint gpio, bool value) {
+    gpio_put(gpio, value);
+}
+
+void pm25_pio_gpio_set_function(uint gpio, gpio_function_t fn) {
+    if (fn == GPIO_FUNC_UART) {
+        for (int i = 0; i < PM25_PIO_UART_MAX; i++) {
+            pio_uart_t *u = &pio_uarts[i];
+            if (u->claimed && (u->tx_pin == gpio || u->rx_pin == gpio)) {
+                pio_gpio_init(u->pio, gpio);
+                return;
+            }
+        }
+    }
+    gpio_set_function(gpio, fn);
+}
+
+// HAL instances
+static const pm25_uart_hal_t pio_uart_hal = {
+    .init = pm25_pio_uart_init,
+    .is_readable = pm25_pio_uart_is_readable,
+    .read_blocking = pm25_pio_uart_read_blocking,
+    .write_blocking = pm25_pio_uart_write_blocking
+};
+
+static const pm25_gpio_hal_t pio_gpio_hal = {
+    .init = pio_gpio_hal_init,
+    .set_dir = pio_gpio_hal_set_dir,
+    .put = pio_gpio_hal_put,
+    .set_function = pm25_pio_gpio_set_function
+};
+
+static const pm25_hal_t pio_hal = {
+    .uart = &pio_uart_hal,
+    .gpio = &pio_gpio_hal,
+    .time_us = time_us_64
+};
+
+const pm25_hal_t* pm25_get_pio_hal(void) {
+    return &pio_hal;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file pm2_5_hal_pio.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief PIO state-machine UART backend for additional PMS7003 sensors
+ * 
+ * Each PIO UART owns one RX state machine whose FIFO is drained by a DMA channel
+ * into a per-sensor ring buffer, so received bytes cost no CPU time. One TX state
+ * machine per PIO block is shared by all sensors on that block and re-pointed at
+ * the sensor's TX pin before each (rare) command write.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#ifndef PM25_HAL_PIO_H
+#define PM25_HAL_PIO_H
+
+#include "pm2_5_hal.h"
+
+// Maximum number of PIO-based UARTs that can be claimed
+#define PM25_PIO_UART_MAX           4
+
+// Per-sensor RX ring buffer size, as a power of two (DMA ring wrap needs size-aligned buffers)
+#define PM25_PIO_UART_RING_BITS     8
+#define PM25_PIO_UART_RING_SIZE     (1u << PM25_PIO_UART_RING_BITS)
+
+/**
+ * @brief Claim a PIO-based UART on the given pins
+ * 
+ * Reserves a PIO state machine and DMA channel. The returned handle is used as
+ * pm25_sensor_config_t.uart together with pm25_get_pio_hal(); the UART is started
+ * when the driver calls the HAL init function.
+ * 
+ * @return Opaque UART handle, or NULL if no PIO/DMA resources are left
+ */
+uart_inst_t *pm25_pio_uart_claim(uint tx_pin, uint rx_pin);
+
+/**
+ * @brief Number of received bytes dropped because the ring buffer overflowed
+ */
+uint32_t pm25_pio_uart_overruns(uart_inst_t *uart);
+
+/**
+ * @brief Most unread bytes the ring buffer has held (up to PM25_PIO_UART_RING_SIZE)
+ */
+uint32_t pm25_pio_uart_max_fill(uart_inst_t *uart);
+
+/**
+ * @brief Re-derive the state machine dividers of all started PIO UARTs from the current clk_sys
+ * 
+ * Call after every clk_sys change; a byte being received at that moment may be lost.
+ */
+void pm25_pio_uart_reclock(void);
+
+// PIO UART operations, also bound directly by the static HAL (pm2_5_hal_static.h)
+void pm25_pio_uart_init(uart_inst_t *uart, uint baudrate);
+bool pm25_pio_uart_is_readable(uart_inst_t *uart);
+void pm25_pio_uart_read_blocking(uart_inst_t *uart, uint8_t *dst, size_t len);
+void pm25_pio_uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len);
+
+// gpio_set_function() that routes UART muxing of claimed PIO UART pins to their PIO block
+void pm25_pio_gpio_set_function(uint gpio, gpio_function_t fn);
+
+// Get the PIO UART HAL (UART over PIO, GPIO over Pico SDK with PIO pin muxing)
+const pm25_hal_t* pm25_get_pio_hal(void);
+
+#endif // PM25_HAL_PIO_H
@@ -10,6 +10,7 @@
 #include "pm2_5_hal.h"
 #include "hardware/uart.h"
 #include "hardware/gpio.h"
+#include "pico/time.h"
 
 // Real UART implementation using Pico SDK
 static void real_uart_init(uart_inst_t *uart, uint baudrate) {
@@ -62,7 +63,8 @@ static const pm25_gpio_hal_t real_gpio_hal = {
 
 static const pm25_hal_t real_hal = {
     .uart = &real_uart_hal,
-    .gpio = &real_gpio_hal
+    .gpio = &real_gpio_hal,
+    .time_us = time_us_64
 };
 
 const pm25_hal_t* pm25_get_default_hal(void) {
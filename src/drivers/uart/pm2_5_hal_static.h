@@ -0,0 +1,84 @@
+/**
+ * @file pm2_5_hal_static.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief Build-time bound PM2.5 HAL for firmware builds (PM25_HAL_STATIC)
+ * 
+ * Replaces the double indirection through pm25_hal_t with direct Pico SDK calls
+ * the compiler can inline. When PIO UARTs are configured (PMS_PIO_SENSOR_COUNT > 0)
+ * UART calls pick the backend from the handle: uart0/uart1 go to the SDK, any other
+ * handle to the PIO UART functions. The sensor's hal pointer is only used to tell
+ * initialized sensors apart. Included by pm2_5_hal.h; do not include directly.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#ifndef PM25_HAL_STATIC_H
+#define PM25_HAL_STATIC_H
+
+#include "hardware/uart.h"
+#include "hardware/gpio.h"
+#include "pico/time.h"
+#include "pin_config.h"
+
+#if PMS_PIO_SENSOR_COUNT > 0
+#include "pm2_5_hal_pio.h"
+
+static inline bool pm25_static_is_hw_uart(uart_inst_t *uart) {
+    return uart == uart0 || uart == uart1;
+}
+
+static inline void pm25_static_uart_init(uart_inst_t *uart, uint baudrate) {
+    if (pm25_static_is_hw_uart(uart)) {
+        uart_init(uart, baudrate);
+    } else {
+        pm25_pio_uart_init(uart, baudrate);
+    }
+}
+
+static inline bool pm25_static_uart_is_readable(uart_inst_t *uart) {
+    return pm25_static_is_hw_uart(uart) ? uart_is_readable(uart) : pm25_pio_uart_is_readable(uart);
+}
+
+static inline void pm25_static_uart_read_blocking(uart_inst_t *uart, uint8_t *dst, size_t len) {
+    if (pm25_static_is_hw_uart(uart)) {
+        uart_read_blocking(uart, dst, len);
+    } else {
+        pm25_pio_uart_read_blocking(uart, dst, len);
+    }
+}
+
+static inline void pm25_static_uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len) {
+    if (pm25_static_is_hw_uart(uart)) {
+        uart_write_blocking(uart, src, len);
+    } else {
+        pm25_pio_uart_write_blocking(uart, src, len);
+    }
+}
+
+#define PM25_STATIC_UART_INIT           pm25_static_uart_init
+#define PM25_STATIC_UART_IS_READABLE    pm25_static_uart_is_readable
+#define PM25_STATIC_UART_READ_BLOCKING  pm25_static_uart_read_blocking
+#define PM25_STATIC_UART_WRITE_BLOCKING pm25_static_uart_write_blocking
+#define PM25_STATIC_GPIO_SET_FUNCTION   pm25_pio_gpio_set_function
+#else
+#define PM25_STATIC_UART_INIT           uart_init
+#define PM25_STATIC_UART_IS_READABLE    uart_is_readable
+#define PM25_STATIC_UART_READ_BLOCKING  uart_read_blocking
+#define PM25_STATIC_UART_WRITE_BLOCKING uart_write_blocking
+#define PM25_STATIC_GPIO_SET_FUNCTION   gpio_set_function
+#endif
+
+#define PM25_HAL_HAS_UART(s)                    (true)
+#define PM25_HAL_HAS_GPIO(s)                    (true)
+#define PM25_HAL_UART_INIT(s, baud)             PM25_STATIC_UART_INIT((s)->config.uart, (baud))
+#define PM25_HAL_UART_IS_READABLE(s)            PM25_STATIC_UART_IS_READABLE((s)->config.uart)
+#define PM25_HAL_UART_READ_BLOCKING(s, dst, n)  PM25_STATIC_UART_READ_BLOCKING((s)->config.uart, (dst), (n))
+#define PM25_HAL_UART_WRITE_BLOCKING(s, src, n) PM25_STATIC_UART_WRITE_BLOCKING((s)->config.uart, (src), (n))
+#define PM25_HAL_GPIO_INIT(s, pin)              gpio_init(pin)
+#define PM25_HAL_GPIO_SET_DIR(s, pin, out)      gpio_set_dir((pin), (out))
+#define PM25_HAL_GPIO_PUT(s, pin, value)        gpio_put((pin), (value))
+#define PM25_HAL_GPIO_SET_FUNCTION(s, pin, fn)  PM25_STATIC_GPIO_SET_FUNCTION((pin), (fn))
+#define PM25_HAL_TIME_US(s)                     time_us_64()
+
+#endif // PM25_HAL_STATIC_H
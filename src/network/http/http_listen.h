@@ -0,0 +1,43 @@
+/**
+ * @file http_listen.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief Transport of the local HTTP server: accepts TCP clients and moves bytes between them and the server core
+ * 
+ * Two implementations: http_listen_lwip.c (device, lwIP raw API) and http_listen_posix.c (host, sockets). Only one
+ * listener exists at a time.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#ifndef NETWORK_HTTP_LISTEN_H
+#define NETWORK_HTTP_LISTEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "http_server.h"
+
+/**
+ * Listen on a TCP port (0 picks a free one on the host) and serve clients with the server core.
+ * @return False if the port cannot be bound
+ */
+bool http_listen_start(http_server_t *server, uint16_t port);
+
+/**
+ * Port being listened on, 0 if not started.
+ */
+uint16_t http_listen_port(void);
+
+/**
+ * Serve the clients for up to timeout_ms. The host backend only works inside this call; on lwIP the server runs in
+ * the network context and this returns at once.
+ */
+void http_listen_poll(uint32_t timeout_ms);
+
+/**
+ * Close the listener and every open connection.
+ */
+void http_listen_stop(void);
+
+#endif // NETWORK_HTTP_LISTEN_H
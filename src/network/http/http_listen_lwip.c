@@ -0,0 +1,175 @@
+/**
+ * @file http_listen_lwip.c
+ * @author trung.la
+ * @date October 19 2026
+ * @brief lwIP raw-API transport of the local HTTP server
+ * 
+ * All callbacks run in the lwIP context. Responses are pinned in the metrics page until the connection closes, so
+ * they are handed to tcp_write() without a copy and in as many pieces as the send buffer takes. lwIP references that
+ * data until it is acked, so a connection is only closed gracefully once the whole response is acked; any other
+ * close aborts the pcb, which drops the queued segments, before the pin is released.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#include "http_listen.h"
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/tcp.h"
+
+#define HTTP_POLL_INTERVAL  2       // tcp_poll period in 500 ms ticks, for the idle timeout
+
+static http_server_t *server;
+static struct tcp_pcb *listen_pcb;
+static uint16_t listen_port;
+
+static uint32_t now_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+// Detach and close; returns ERR_ABRT if the pcb had to be aborted, which callbacks must pass on to lwIP
+static err_t conn_close(http_conn_t *conn, bool abort) {
+    struct tcp_pcb *pcb = (struct tcp_pcb *)conn->transport;
+    if (conn->acked != conn->queued) {
+        abort = true;
+    }
+    tcp_arg(pcb, NULL);
+    tcp_recv(pcb, NULL);
+    tcp_sent(pcb, NULL);
+    tcp_err(pcb, NULL);
+    tcp_poll(pcb, NULL, 0);
+    http_server_close(server, conn);
+    if (abort || tcp_close(pcb) != ERR_OK) {
+        tcp_abort(pcb);
+        return ERR_ABRT;
+    }
+    return ERR_OK;
+}
+
+static void send_more(http_conn_t *conn) {
+    struct tcp_pcb *pcb = (struct tcp_pcb *)conn->transport;
+    const char *data;
+    size_t n = http_server_pending(conn, &data);
+    u16_t room = tcp_sndbuf(pcb);
+    if (n > room) {
+        n = room;
+    }
+    // Short of memory the rest goes out from the sent or poll callback
+    if (n > 0 && tcp_write(pcb, data, (u16_t)n, 0) == ERR_OK) {
+        http_server_queued(conn, n, now_ms());
+        tcp_output(pcb);
+    }
+}
+
+static err_t on_sent(void *arg, struct tcp_pcb *pcb, u16_t len) {
+    http_conn_t *conn = (http_conn_t *)arg;
+    http_server_acked(conn, len, now_ms());
+    if (http_server_done(conn)) {
+        return conn_close(conn, false);
+    }
+    send_more(conn);
+    return ERR_OK;
+}
+
+static err_t on_recv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err) {
+    http_conn_t *conn = (http_conn_t *)arg;
+    if (p == NULL) {
+        // Client done sending. A response in flight stays pinned until on_sent sees it acked (or the idle timeout)
+        if (conn->state == HTTP_CONN_SENDING && !http_server_done(conn)) {
+            return ERR_OK;
+        }
+        return conn_close(conn, false);
+    }
+    for (struct pbuf *q = p; q != NULL; q = q->next) {
+        http_server_receive(server, conn, (const uint8_t *)q->payload, q->len, now_ms());
+    }
+    tcp_recved(pcb, p->tot_len);
+    pbuf_free(p);
+    if (conn->state == HTTP_CONN_SENDING && conn->queued == 0) {
+        send_more(conn);
+    }
+    return ERR_OK;
+}
+
+static err_t on_poll(void *arg, struct tcp_pcb *pcb) {
+    http_conn_t *conn = (http_conn_t *)arg;
+    if (http_server_timed_out(server, conn, now_ms())) {
+        return conn_close(conn, true);
+    }
+    send_more(conn);
+    return ERR_OK;
+}
+
+// The pcb is already gone
+static void on_err(void *arg, err_t err) {
+    http_conn_t *conn = (http_conn_t *)arg;
+    if (conn != NULL) {
+        http_server_close(server, conn);
+    }
+}
+
+static err_t on_accept(void *arg, struct tcp_pcb *pcb, err_t err) {
+    if (err != ERR_OK || pcb == NULL) {
+        return ERR_VAL;
+    }
+    http_conn_t *conn = http_server_open(server, pcb, now_ms());
+    if (conn == NULL) {
+        tcp_abort(pcb);
+        return ERR_ABRT;
+    }
+    // MQTT traffic goes first when memory is short
+    tcp_setprio(pcb, TCP_PRIO_MIN);
+    tcp_arg(pcb, conn);
+    tcp_recv(pcb, on_recv);
+    tcp_sent(pcb, on_sent);
+    tcp_err(pcb, on_err);
+    tcp_poll(pcb, on_poll, HTTP_POLL_INTERVAL);
+    return ERR_OK;
+}
+
+bool http_listen_start(http_server_t *srv, uint16_t port) {
+    if (srv == NULL || listen_pcb != NULL) {
+        return false;
+    }
+    server = srv;
+    cyw43_arch_lwip_begin();
+    struct tcp_pcb *pcb = tcp_new_ip_type(IPADDR_TYPE_ANY);
+    if (pcb != NULL && tcp_bind(pcb, IP_ANY_TYPE, port) == ERR_OK) {
+        listen_pcb = tcp_listen_with_backlog(pcb, HTTP_MAX_CONNS);
+    }
+    if (listen_pcb == NULL) {
+        if (pcb != NULL) {
+            tcp_close(pcb);
+        }
+    } else {
+        tcp_accept(listen_pcb, on_accept);
+        listen_port = port;
+    }
+    cyw43_arch_lwip_end();
+    return listen_pcb != NULL;
+}
+
+uint16_t http_listen_port(void) {
+    return listen_port;
+}
+
+void http_listen_poll(uint32_t timeout_ms) {
+    (void)timeout_ms;
+}
+
+void http_listen_stop(void) {
+    if (listen_pcb == NULL) {
+        return;
+    }
+    cyw43_arch_lwip_begin();
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        if (server->conns[i].state != HTTP_CONN_FREE) {
+            conn_close(&server->conns[i], true);
+        }
+    }
+    tcp_close(listen_pcb);
+    listen_pcb = NULL;
+    listen_port = 0;
+    cyw43_arch_lwip_end();
+}
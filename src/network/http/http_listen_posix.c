@@ -0,0 +1,181 @@
+/**
+ * @file http_listen_posix.c
+ * @author trung.la
+ * @date October 19 2026
+ * @brief POSIX socket transport of the local HTTP server, for host builds and loopback tests
+ * 
+ * Non-blocking sockets served from http_listen_poll() with poll(); listens on 127.0.0.1 only.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "http_listen.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+static http_server_t *server;
+static int listen_fd = -1;
+static uint16_t listen_port;
+static int conn_fd[HTTP_MAX_CONNS];
+
+static uint32_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000u + ts.tv_nsec / 1000000);
+}
+
+static void set_nonblocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+static void conn_close(int i) {
+    http_server_close(server, &server->conns[i]);
+    close(conn_fd[i]);
+    conn_fd[i] = -1;
+}
+
+static void accept_clients(void) {
+    for (;;) {
+        int fd = accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+        http_conn_t *conn = http_server_open(server, NULL, now_ms());
+        if (conn == NULL) {
+            close(fd);
+            continue;
+        }
+        set_nonblocking(fd);
+        conn_fd[conn - server->conns] = fd;
+    }
+}
+
+// The kernel copies what it takes, so queued bytes are acknowledged at once
+static void send_more(int i) {
+    http_conn_t *conn = &server->conns[i];
+    const char *data;
+    size_t n = http_server_pending(conn, &data);
+    while (n > 0) {
+        ssize_t sent = send(conn_fd[i], data, n, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                return;
+            }
+            conn_close(i);
+            return;
+        }
+        http_server_queued(conn, (size_t)sent, now_ms());
+        http_server_acked(conn, (size_t)sent, now_ms());
+        n = http_server_pending(conn, &data);
+    }
+    if (http_server_done(conn)) {
+        conn_close(i);
+    }
+}
+
+static void receive(int i) {
+    http_conn_t *conn = &server->conns[i];
+    uint8_t buf[256];
+    ssize_t n = recv(conn_fd[i], buf, sizeof(buf), 0);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+        conn_close(i);
+        return;
+    }
+    if (n > 0 && http_server_receive(server, conn, buf, (size_t)n, now_ms())) {
+        send_more(i);
+    }
+}
+
+bool http_listen_start(http_server_t *srv, uint16_t port) {
+    if (srv == NULL || listen_fd >= 0) {
+        return false;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    struct sockaddr_in addr = { 0 };
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    socklen_t addr_len = sizeof(addr);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, HTTP_MAX_CONNS) != 0 ||
+        getsockname(fd, (struct sockaddr *)&addr, &addr_len) != 0) {
+        close(fd);
+        return false;
+    }
+    set_nonblocking(fd);
+    server = srv;
+    listen_fd = fd;
+    listen_port = ntohs(addr.sin_port);
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        conn_fd[i] = -1;
+    }
+    return true;
+}
+
+uint16_t http_listen_port(void) {
+    return listen_port;
+}
+
+void http_listen_poll(uint32_t timeout_ms) {
+    if (listen_fd < 0) {
+        return;
+    }
+    struct pollfd fds[1 + HTTP_MAX_CONNS];
+    int index[1 + HTTP_MAX_CONNS];
+    nfds_t count = 0;
+    fds[count].fd = listen_fd;
+    fds[count].events = POLLIN;
+    index[count++] = -1;
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        if (conn_fd[i] >= 0) {
+            fds[count].fd = conn_fd[i];
+            fds[count].events = (server->conns[i].state == HTTP_CONN_SENDING) ? POLLOUT : POLLIN;
+            index[count++] = i;
+        }
+    }
+    if (poll(fds, count, (int)timeout_ms) < 0) {
+        return;
+    }
+    for (nfds_t k = 1; k < count; k++) {
+        int i = index[k];
+        if (fds[k].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            conn_close(i);
+        } else if (fds[k].revents & POLLIN) {
+            receive(i);
+        } else if (fds[k].revents & POLLOUT) {
+            send_more(i);
+        } else if (http_server_timed_out(server, &server->conns[i], now_ms())) {
+            conn_close(i);
+        }
+    }
+    if (fds[0].revents & POLLIN) {
+        accept_clients();
+    }
+}
+
+void http_listen_stop(void) {
+    if (listen_fd < 0) {
+        return;
+    }
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        if (conn_fd[i] >= 0) {
+            conn_close(i);
+        }
+    }
+    close(listen_fd);
+    listen_fd = -1;
+    listen_port = 0;
+}
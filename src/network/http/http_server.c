@@ -0,0 +1,180 @@
+/**
+ * File: http_server.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the local HTTP server core.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "http_server.h"
+
+#include <string.h>
+
+#define FIXED_RESPONSE(status) \
+    "HTTP/1.0 " status "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"
+
+static const char response_bad_request[] = FIXED_RESPONSE("400 Bad Request");
+static const char response_not_found[] = FIXED_RESPONSE("404 Not Found");
+static const char response_not_allowed[] = "HTTP/1.0 405 Method Not Allowed\r\nAllow: GET\r\n"
+                                           "Content-Length: 0\r\nConnection: close\r\n\r\n";
+static const char response_unavailable[] = FIXED_RESPONSE("503 Service Unavailable");
+
+static const struct {
+    const char *path;
+    metrics_page_id_t page;
+} routes[] = {
+    { "/metrics", METRICS_PAGE_METRICS },
+    { "/latest", METRICS_PAGE_LATEST }
+};
+
+void http_server_init(http_server_t *server, metrics_page_t *page) {
+    if (server == NULL) {
+        return;
+    }
+    memset(server, 0, sizeof(*server));
+    server->page = page;
+}
+
+http_conn_t *http_server_open(http_server_t *server, void *transport, uint32_t now_ms) {
+    if (server == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        http_conn_t *conn = &server->conns[i];
+        if (conn->state == HTTP_CONN_FREE) {
+            memset(conn, 0, sizeof(*conn));
+            conn->state = HTTP_CONN_READING;
+            conn->page = -1;
+            conn->slot = -1;
+            conn->last_ms = now_ms;
+            conn->transport = transport;
+            server->stats.accepted++;
+            return conn;
+        }
+    }
+    server->stats.refused++;
+    return NULL;
+}
+
+static void respond_fixed(http_server_t *server, http_conn_t *conn, const char *response, size_t len) {
+    conn->data = response;
+    conn->len = len;
+    server->stats.errors++;
+}
+
+// Route the request line: "GET <path>[?query] HTTP/1.x"
+static void respond(http_server_t *server, http_conn_t *conn) {
+    conn->state = HTTP_CONN_SENDING;
+    char *method = conn->line;
+    char *path = strchr(method, ' ');
+    char *version = (path != NULL) ? strchr(path + 1, ' ') : NULL;
+    if (conn->line_overflow || version == NULL || strncmp(version + 1, "HTTP/1.", 7) != 0) {
+        respond_fixed(server, conn, response_bad_request, sizeof(response_bad_request) - 1);
+        return;
+    }
+    *path++ = '\0';
+    *version = '\0';
+    path[strcspn(path, "?")] = '\0';
+    if (strcmp(method, "GET") != 0) {
+        respond_fixed(server, conn, response_not_allowed, sizeof(response_not_allowed) - 1);
+        return;
+    }
+    for (size_t i = 0; i < sizeof(routes) / sizeof(routes[0]); i++) {
+        if (strcmp(path, routes[i].path) != 0) {
+            continue;
+        }
+        conn->slot = metrics_page_acquire(server->page, routes[i].page, &conn->data, &conn->len);
+        if (conn->slot < 0) {
+            respond_fixed(server, conn, response_unavailable, sizeof(response_unavailable) - 1);
+            return;
+        }
+        conn->page = (int)routes[i].page;
+        server->stats.served++;
+        return;
+    }
+    respond_fixed(server, conn, response_not_found, sizeof(response_not_found) - 1);
+}
+
+bool http_server_receive(http_server_t *server, http_conn_t *conn, const uint8_t *data, size_t len, uint32_t now_ms) {
+    if (server == NULL || conn == NULL || conn->state == HTTP_CONN_FREE) {
+        return false;
+    }
+    conn->last_ms = now_ms;
+    for (size_t i = 0; i < len && conn->state == HTTP_CONN_READING; i++) {
+        char c = (char)data[i];
+        // Only the request line is kept; headers are skipped up to the empty line
+        if (!conn->line_done) {
+            if (c == '\r' || c == '\n') {
+                conn->line_done = true;
+            } else if (conn->line_len + 1u < sizeof(conn->line)) {
+                conn->line[conn->line_len++] = c;
+            } else {
+                conn->line_overflow = true;
+            }
+        }
+        if (c == '\n') {
+            if (conn->line_empty) {
+                conn->line[conn->line_len] = '\0';
+                respond(server, conn);
+            }
+            conn->line_empty = true;
+        } else if (c != '\r') {
+            conn->line_empty = false;
+        }
+    }
+    return conn->state == HTTP_CONN_SENDING;
+}
+
+size_t http_server_pending(const http_conn_t *conn, const char **data) {
+    if (conn == NULL || conn->state != HTTP_CONN_SENDING) {
+        return 0;
+    }
+    if (data != NULL) {
+        *data = conn->data + conn->queued;
+    }
+    return conn->len - conn->queued;
+}
+
+void http_server_queued(http_conn_t *conn, size_t n, uint32_t now_ms) {
+    if (conn != NULL && conn->queued + n <= conn->len) {
+        conn->queued += n;
+        conn->last_ms = now_ms;
+    }
+}
+
+void http_server_acked(http_conn_t *conn, size_t n, uint32_t now_ms) {
+    if (conn != NULL && conn->acked + n <= conn->queued) {
+        conn->acked += n;
+        conn->last_ms = now_ms;
+    }
+}
+
+bool http_server_done(const http_conn_t *conn) {
+    return conn != NULL && conn->state == HTTP_CONN_SENDING && conn->acked == conn->len;
+}
+
+bool http_server_timed_out(http_server_t *server, const http_conn_t *conn, uint32_t now_ms) {
+    if (server == NULL || conn == NULL || conn->state == HTTP_CONN_FREE ||
+        now_ms - conn->last_ms < HTTP_IDLE_TIMEOUT_MS) {
+        return false;
+    }
+    server->stats.timeouts++;
+    return true;
+}
+
+void http_server_close(http_server_t *server, http_conn_t *conn) {
+    if (server == NULL || conn == NULL || conn->state == HTTP_CONN_FREE) {
+        return;
+    }
+    if (conn->slot >= 0) {
+        metrics_page_release(server->page, (metrics_page_id_t)conn->page, conn->slot);
+    }
+    conn->state = HTTP_CONN_FREE;
+    conn->slot = -1;
+    conn->page = -1;
+    conn->transport = NULL;
+}
@@ -0,0 +1,108 @@
+/**
+ * File: http_server.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the local HTTP server core. It reads HTTP/1.0 and 1.1 GET requests, routes /metrics
+ * and /latest to their precomputed responses (metrics_page.h) and answers everything else with a fixed error
+ * response, then closes the connection. At most HTTP_MAX_CONNS connections are served; the rest are refused. The
+ * core owns no socket: a transport (http_listen.h) feeds it received bytes and sends what it returns, so the same
+ * code runs on lwIP on the device and on POSIX sockets on the host.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef NETWORK_HTTP_SERVER_H
+#define NETWORK_HTTP_SERVER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "http_config.h"
+#include "metrics_page.h"
+
+typedef enum {
+    HTTP_CONN_FREE = 0,
+    HTTP_CONN_READING,          // Waiting for the end of the request headers
+    HTTP_CONN_SENDING           // Response chosen; data/len are valid
+} http_conn_state_t;
+
+typedef struct {
+    http_conn_state_t state;
+    char line[HTTP_REQUEST_LINE_MAX];   // Request line
+    uint8_t line_len;
+    bool line_done;
+    bool line_overflow;
+    bool line_empty;            // No character but CR since the last LF
+    int page;                   // Pinned metrics_page_id_t, -1 for a fixed response
+    int slot;
+    const char *data;           // Response
+    size_t len;
+    size_t queued;              // Bytes handed to the transport
+    size_t acked;               // Bytes the transport is done with
+    uint32_t last_ms;           // Last activity, for the idle timeout
+    void *transport;            // Transport handle (socket, pcb)
+} http_conn_t;
+
+typedef struct {
+    uint32_t accepted;
+    uint32_t refused;           // Connections over HTTP_MAX_CONNS
+    uint32_t served;            // 200 responses
+    uint32_t errors;            // 4xx / 5xx responses
+    uint32_t timeouts;
+} http_stats_t;
+
+typedef struct {
+    metrics_page_t *page;
+    http_conn_t conns[HTTP_MAX_CONNS];
+    http_stats_t stats;
+} http_server_t;
+
+/**
+ * Initialize the server over the response page.
+ */
+void http_server_init(http_server_t *server, metrics_page_t *page);
+
+/**
+ * Take a connection slot for a new client.
+ * @return NULL if HTTP_MAX_CONNS connections are open; the transport then closes the client
+ */
+http_conn_t *http_server_open(http_server_t *server, void *transport, uint32_t now_ms);
+
+/**
+ * Feed received bytes. Once the request is complete the response is chosen (state HTTP_CONN_SENDING); bytes after
+ * the request are ignored.
+ * @return True if a response is ready to send
+ */
+bool http_server_receive(http_server_t *server, http_conn_t *conn, const uint8_t *data, size_t len, uint32_t now_ms);
+
+/**
+ * Bytes of the response not yet handed to the transport.
+ */
+size_t http_server_pending(const http_conn_t *conn, const char **data);
+
+/**
+ * Record that the transport took queued bytes, and that it is done with acked bytes (sent or copied).
+ */
+void http_server_queued(http_conn_t *conn, size_t n, uint32_t now_ms);
+void http_server_acked(http_conn_t *conn, size_t n, uint32_t now_ms);
+
+/**
+ * Whether the whole response has been acknowledged; the transport then closes the connection.
+ */
+bool http_server_done(const http_conn_t *conn);
+
+/**
+ * Whether the connection has been idle for HTTP_IDLE_TIMEOUT_MS; counted as a timeout.
+ */
+bool http_server_timed_out(http_server_t *server, const http_conn_t *conn, uint32_t now_ms);
+
+/**
+ * Release the connection slot and its pinned response.
+ */
+void http_server_close(http_server_t *server, http_conn_t *conn);
+
+#endif // NETWORK_HTTP_SERVER_H
@@ -0,0 +1,284 @@
+/**
+ * File: metrics_page.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the precomputed HTTP responses of the local endpoints.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "metrics_page.h"
+
+#include <string.h>
+
+#include "fmt.h"
+
+// Room kept in front of the body for the status line and headers, which need the body length
+#define HEADER_RESERVE          128
+
+typedef struct {
+    bool valid;
+    sample_cache_snapshot_t snapshot;
+} sensor_view_t;
+
+static const char *const content_types[METRICS_PAGE_COUNT] = {
+    "text/plain; version=0.0.4; charset=utf-8",
+    "application/json"
+};
+
+static char *slot_buffer(metrics_page_t *page, metrics_page_id_t id, int slot, size_t *size) {
+    if (id == METRICS_PAGE_METRICS) {
+        *size = HTTP_METRICS_BUFFER;
+        return page->metrics[slot];
+    }
+    *size = HTTP_LATEST_BUFFER;
+    return page->latest[slot];
+}
+
+void metrics_page_init(metrics_page_t *page) {
+    if (page == NULL) {
+        return;
+    }
+    memset(&page->stats, 0, sizeof(page->stats));
+    for (int id = 0; id < METRICS_PAGE_COUNT; id++) {
+        metrics_slots_t *s = &page->slots[id];
+        atomic_init(&s->current, -1);
+        for (int i = 0; i < METRICS_PAGE_SLOTS; i++) {
+            atomic_init(&s->pins[i], 0);
+            s->start[i] = 0;
+            s->len[i] = 0;
+        }
+    }
+}
+
+// A slot that is neither current nor being sent
+static int free_slot(metrics_slots_t *s) {
+    int current = atomic_load(&s->current);
+    for (int i = 0; i < METRICS_PAGE_SLOTS; i++) {
+        if (i != current && atomic_load(&s->pins[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Pins only change in the network context (or with it locked out), so a plain load and store is enough: the M0+
+// has no atomic read-modify-write. The update only reads them.
+static void pin(metrics_slots_t *s, int slot, unsigned int delta) {
+    atomic_store(&s->pins[slot], atomic_load_explicit(&s->pins[slot], memory_order_relaxed) + delta);
+}
+
+static void prom_family(fmt_buf_t *b, const char *name, const char *type, const char *help) {
+    fmt_str(b, "# HELP ");
+    fmt_str(b, name);
+    fmt_char(b, ' ');
+    fmt_str(b, help);
+    fmt_str(b, "\n# TYPE ");
+    fmt_str(b, name);
+    fmt_char(b, ' ');
+    fmt_str(b, type);
+    fmt_char(b, '\n');
+}
+
+// name{sensor="n"  -- the caller closes the label set
+static void prom_sensor(fmt_buf_t *b, const char *name, unsigned int sensor) {
+    fmt_str(b, name);
+    fmt_str(b, "{sensor=\"");
+    fmt_u32(b, sensor);
+    fmt_char(b, '"');
+}
+
+static void prom_fields(fmt_buf_t *b, const char *name, const sensor_view_t *views, unsigned int count,
+                        pm25_field_t first, pm25_field_t end) {
+    for (unsigned int i = 0; i < count; i++) {
+        if (!views[i].valid) {
+            continue;
+        }
+        for (int f = first; f < (int)end; f++) {
+            prom_sensor(b, name, i);
+            fmt_str(b, ",field=\"");
+            fmt_str(b, pm25_field_name((pm25_field_t)f));
+            fmt_str(b, "\"} ");
+            fmt_u32(b, pm25_data_get(&views[i].snapshot.data, (pm25_field_t)f));
+            fmt_char(b, '\n');
+        }
+    }
+}
+
+static void format_metrics(fmt_buf_t *b, const sensor_view_t *views, unsigned int count, uint64_t now_us,
+                           const aqi_report_t *aqi, uint32_t builds) {
+    prom_family(b, "airsense_pm_ugm3", "gauge", "Particulate mass concentration in ug/m3 (PMS7003 field)");
+    prom_fields(b, "airsense_pm_ugm3", views, count, PM25_FIELD_PM1_0_CF1, PM25_FIELD_COUNT_0_3);
+    prom_family(b, "airsense_particles_per_dl", "gauge", "Particles larger than the field size per 0.1 L of air");
+    prom_fields(b, "airsense_particles_per_dl", views, count, PM25_FIELD_COUNT_0_3, PM25_FIELD_COUNT);
+
+    prom_family(b, "airsense_sample_age_seconds", "gauge", "Age of the latest sample");
+    for (unsigned int i = 0; i < count; i++) {
+        if (views[i].valid) {
+            prom_sensor(b, "airsense_sample_age_seconds", i);
+            fmt_str(b, "} ");
+            uint32_t age_ms = views[i].snapshot.age_ms;
+            fmt_fixed(b, (int32_t)((age_ms < INT32_MAX) ? age_ms : INT32_MAX), 3);
+            fmt_char(b, '\n');
+        }
+    }
+    prom_family(b, "airsense_sample_stale", "gauge", "1 if the latest sample is older than the cache limit");
+    for (unsigned int i = 0; i < count; i++) {
+        if (views[i].valid) {
+            prom_sensor(b, "airsense_sample_stale", i);
+            fmt_str(b, views[i].snapshot.stale ? "} 1\n" : "} 0\n");
+        }
+    }
+
+    if (aqi != NULL) {
+        prom_family(b, "airsense_aqi", "gauge", "US EPA AQI of the latest PM2.5 sample");
+        fmt_str(b, "airsense_aqi ");
+        fmt_u32(b, aqi->aqi);
+        fmt_char(b, '\n');
+        if (aqi->nowcast_valid) {
+            prom_family(b, "airsense_nowcast_aqi", "gauge", "US EPA AQI of the PM2.5 NowCast");
+            fmt_str(b, "airsense_nowcast_aqi ");
+            fmt_u32(b, aqi->nowcast_aqi);
+            fmt_char(b, '\n');
+            prom_family(b, "airsense_nowcast_ugm3", "gauge", "PM2.5 NowCast concentration in ug/m3");
+            fmt_str(b, "airsense_nowcast_ugm3 ");
+            fmt_fixed(b, aqi->nowcast, 2);
+            fmt_char(b, '\n');
+        }
+    }
+
+    prom_family(b, "airsense_uptime_seconds", "counter", "Time since reset");
+    fmt_str(b, "airsense_uptime_seconds ");
+    fmt_u32(b, (uint32_t)(now_us / 1000000u));
+    fmt_char(b, '\n');
+    prom_family(b, "airsense_page_builds_total", "counter", "Responses formatted by the device");
+    fmt_str(b, "airsense_page_builds_total ");
+    fmt_u32(b, builds);
+    fmt_char(b, '\n');
+}
+
+static void format_latest(fmt_buf_t *b, const sensor_view_t *views, unsigned int count, uint64_t now_us,
+                          const aqi_report_t *aqi) {
+    fmt_json_object_begin(b, NULL);
+    fmt_json_u32(b, "uptime", (uint32_t)(now_us / 1000000u));
+    if (aqi != NULL) {
+        fmt_json_u32(b, "aqi", aqi->aqi);
+        if (aqi->nowcast_valid) {
+            fmt_json_u32(b, "nowcast_aqi", aqi->nowcast_aqi);
+            fmt_json_fixed(b, "nowcast", aqi->nowcast, 2);
+        }
+    }
+    fmt_json_array_begin(b, "sensors");
+    for (unsigned int i = 0; i < count; i++) {
+        if (!views[i].valid) {
+            continue;
+        }
+        fmt_json_object_begin(b, NULL);
+        fmt_json_u32(b, "id", i);
+        fmt_json_u32(b, "age_ms", views[i].snapshot.age_ms);
+        fmt_json_bool(b, "stale", views[i].snapshot.stale);
+        for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+            fmt_json_u32(b, pm25_field_name((pm25_field_t)f), pm25_data_get(&views[i].snapshot.data, (pm25_field_t)f));
+        }
+        fmt_json_object_end(b);
+    }
+    fmt_json_array_end(b);
+    fmt_json_object_end(b);
+}
+
+static bool build(metrics_page_t *page, metrics_page_id_t id, const sensor_view_t *views, unsigned int count,
+                  uint64_t now_us, const aqi_report_t *aqi) {
+    metrics_slots_t *s = &page->slots[id];
+    int slot = free_slot(s);
+    if (slot < 0) {
+        page->stats.skipped++;
+        return false;
+    }
+    size_t size;
+    char *buf = slot_buffer(page, id, slot, &size);
+
+    fmt_buf_t body;
+    fmt_init(&body, buf + HEADER_RESERVE, size - HEADER_RESERVE);
+    if (id == METRICS_PAGE_METRICS) {
+        format_metrics(&body, views, count, now_us, aqi, page->stats.builds + 1);
+    } else {
+        format_latest(&body, views, count, now_us, aqi);
+    }
+    size_t body_len = fmt_finish(&body);
+
+    char header[HEADER_RESERVE];
+    fmt_buf_t h;
+    fmt_init(&h, header, sizeof(header));
+    fmt_str(&h, "HTTP/1.0 200 OK\r\nContent-Type: ");
+    fmt_str(&h, content_types[id]);
+    fmt_str(&h, "\r\nContent-Length: ");
+    fmt_u32(&h, (uint32_t)body_len);
+    fmt_str(&h, "\r\nConnection: close\r\n\r\n");
+    size_t header_len = fmt_finish(&h);
+    if (body_len == 0 || header_len == 0) {
+        page->stats.overflows++;
+        return false;
+    }
+
+    // The header goes right in front of the body, so the response is one contiguous run
+    size_t start = HEADER_RESERVE - header_len;
+    memcpy(buf + start, header, header_len);
+    s->start[slot] = (uint16_t)start;
+    s->len[slot] = (uint16_t)(header_len + body_len);
+    atomic_store(&s->current, slot);
+
+    page->stats.builds++;
+    if (s->len[slot] > page->stats.max_len[id]) {
+        page->stats.max_len[id] = s->len[slot];
+    }
+    return true;
+}
+
+bool metrics_page_update(metrics_page_t *page, sample_cache_t *cache, unsigned int sensor_count, uint64_t now_us,
+                         const aqi_report_t *aqi) {
+    if (page == NULL || cache == NULL) {
+        return false;
+    }
+    if (sensor_count > HTTP_MAX_SENSORS) {
+        sensor_count = HTTP_MAX_SENSORS;
+    }
+    // Both responses show the same snapshot
+    sensor_view_t views[HTTP_MAX_SENSORS];
+    for (unsigned int i = 0; i < sensor_count; i++) {
+        views[i].valid = sample_cache_read(cache, i, now_us, &views[i].snapshot);
+    }
+    bool ok = build(page, METRICS_PAGE_METRICS, views, sensor_count, now_us, aqi);
+    return build(page, METRICS_PAGE_LATEST, views, sensor_count, now_us, aqi) && ok;
+}
+
+int metrics_page_acquire(metrics_page_t *page, metrics_page_id_t id, const char **data, size_t *len) {
+    if (page == NULL || (unsigned)id >= METRICS_PAGE_COUNT || data == NULL || len == NULL) {
+        return -1;
+    }
+    metrics_slots_t *s = &page->slots[id];
+    for (;;) {
+        int slot = atomic_load(&s->current);
+        if (slot < 0) {
+            return -1;
+        }
+        // An update may have moved on and started reusing the slot before the pin; then try the new one
+        pin(s, slot, 1u);
+        if (atomic_load(&s->current) == slot) {
+            size_t size;
+            *data = slot_buffer(page, id, slot, &size) + s->start[slot];
+            *len = s->len[slot];
+            return slot;
+        }
+        pin(s, slot, -1u);
+    }
+}
+
+void metrics_page_release(metrics_page_t *page, metrics_page_id_t id, int slot) {
+    if (page == NULL || (unsigned)id >= METRICS_PAGE_COUNT || slot < 0 || slot >= METRICS_PAGE_SLOTS) {
+        return;
+    }
+    pin(&page->slots[id], slot, -1u);
+}
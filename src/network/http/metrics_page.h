@@ -0,0 +1,84 @@
+/**
+ * File: metrics_page.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the precomputed HTTP responses of the local endpoints: /metrics (Prometheus text)
+ * and /latest (JSON). Each response, headers included, is formatted once when the aggregates change, into one of
+ * HTTP_MAX_CONNS + 1 buffers, and then made current. A connection pins the current buffer for as long as it sends
+ * it, so serving a request formats nothing and copies nothing, and an update never overwrites a buffer in use.
+ * Updates run in the main loop and requests in the network context; the handover is lock-free.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef NETWORK_HTTP_METRICS_PAGE_H
+#define NETWORK_HTTP_METRICS_PAGE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "http_config.h"
+#include "sample_cache.h"
+#include "aqi.h"
+
+#define METRICS_PAGE_SLOTS      (HTTP_MAX_CONNS + 1)
+
+typedef enum {
+    METRICS_PAGE_METRICS = 0,   // /metrics
+    METRICS_PAGE_LATEST,        // /latest
+    METRICS_PAGE_COUNT
+} metrics_page_id_t;
+
+// Buffers of one response
+typedef struct {
+    atomic_int current;                         // Slot served to new requests, -1 before the first update
+    atomic_uint pins[METRICS_PAGE_SLOTS];       // Connections sending the slot
+    uint16_t start[METRICS_PAGE_SLOTS];         // Offset of the response in the slot
+    uint16_t len[METRICS_PAGE_SLOTS];
+} metrics_slots_t;
+
+typedef struct {
+    uint32_t builds;            // Responses formatted
+    uint32_t skipped;           // Updates dropped: every other slot pinned
+    uint32_t overflows;         // Responses larger than their buffer
+    uint16_t max_len[METRICS_PAGE_COUNT];   // Largest response, for sizing the buffers
+} metrics_page_stats_t;
+
+typedef struct {
+    char metrics[METRICS_PAGE_SLOTS][HTTP_METRICS_BUFFER];
+    char latest[METRICS_PAGE_SLOTS][HTTP_LATEST_BUFFER];
+    metrics_slots_t slots[METRICS_PAGE_COUNT];
+    metrics_page_stats_t stats;
+} metrics_page_t;
+
+/**
+ * Initialize with no response: requests are answered 503 until the first update.
+ */
+void metrics_page_init(metrics_page_t *page);
+
+/**
+ * Format both responses from the latest samples of the first sensor_count sensors (at most HTTP_MAX_SENSORS) and
+ * the AQI (NULL if there is none yet), and make them current. Call whenever the aggregates change, from one context only.
+ * @return False if a response could not be updated (all other buffers pinned, or too large)
+ */
+bool metrics_page_update(metrics_page_t *page, sample_cache_t *cache, unsigned int sensor_count, uint64_t now_us,
+                         const aqi_report_t *aqi);
+
+/**
+ * Pin the current response of an endpoint for sending. Pins are counted without a read-modify-write, so acquire
+ * and release from one context only: the network context, or the main loop inside cyw43_arch_lwip_begin/end.
+ * @return Slot to release afterwards, or -1 if there is no response yet
+ */
+int metrics_page_acquire(metrics_page_t *page, metrics_page_id_t id, const char **data, size_t *len);
+
+/**
+ * Unpin a slot returned by metrics_page_acquire().
+ */
+void metrics_page_release(metrics_page_t *page, metrics_page_id_t id, int slot);
+
+#endif // NETWORK_HTTP_METRICS_PAGE_H
@@ -3,6 +3,15 @@
  * Author: trung.la
  * Date: November 08 2025
  * Description: Source file for MQTT client, implementing functions for MQTT interaction on Raspberry Pi Pico.
+ * Outgoing messages go through a priority-lane queue (mqtt_queue.h): alerts are handed to lwIP ahead of any
+ * telemetry, and telemetry is shaped to MQTT_BULK_RATE_BPS. At most MQTT_MAX_IN_FLIGHT publishes sit in lwIP at
+ * once, so a new alert only ever waits for that many messages to be sent. A QoS 1 publish keeps its buffer until
+ * PUBACK and is sent again after a reconnect (mqtt_inflight.h).
+ * MQTT 3.1.1 runs directly on an lwIP altcp connection (TLS when MQTT_USE_TLS is set) using mqtt_codec.h; the
+ * lwIP MQTT app cannot keep a persistent session. Reconnects resume the cached TLS session and, when the broker
+ * reports our session as present, skip re-subscribing (mqtt_session.h). Between publish windows the radio is in
+ * power-save mode and nothing is sent (radio_sched.h). TLS handshakes run with clk_sys at the burst level
+ * (clock_policy.h).
  * 
  * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
  * The reproduction, distribution and utilization of this document as well as the communication of its contents to
@@ -12,38 +21,903 @@
 
 #include "mqtt_client.h"
 
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/altcp.h"
+#include "lwip/altcp_tcp.h"
+#include "lwip/ip_addr.h"
+#include "lwip/pbuf.h"
+
+#include "mqtt_config.h"
+#include "mqtt_codec.h"
+#include "mqtt_session.h"
+#include "mqtt_inflight.h"
+#include "mqtt_payload.h"
+#include "radio_sched.h"
+#include "clock_policy.h"
+#include "power_mgr.h"
+#include "fmt.h"
+
+#if MQTT_USE_TLS
+#include "lwip/altcp_tls.h"
+#include "mbedtls/ssl.h"
+#if MQTT_TLS_SESSION_FLASH
+#include "mqtt_session_flash.h"
+#endif
+#endif
+
+typedef enum {
+    LINK_DOWN,
+    LINK_CONNECTING,        // TCP connect and TLS handshake
+    LINK_WAIT_CONNACK,
+    LINK_UP
+} link_state_t;
+
+_Static_assert(MQTT_MAX_IN_FLIGHT <= MQTT_INFLIGHT_MAX, "MQTT_MAX_IN_FLIGHT exceeds the in-flight window");
+
+static bool initialized = false;      // Queue ready: messages are accepted
+static bool started = false;          // Network side running: radio windows, connection
+static struct altcp_pcb *conn = NULL;
+static volatile link_state_t link_state = LINK_DOWN;
+static mqtt_queue_t out_queue;
+static mqtt_session_t session;
+static radio_sched_t radio;
+static mqtt_message_handler_t message_handler = NULL;
+
+// Updated from the lwIP callbacks
+static mqtt_inflight_t in_flight;
+static uint32_t tx_total = 0;           // Bytes written on the current connection
+static uint32_t acked_total = 0;        // Of those, acknowledged by the broker's TCP
+static volatile bool resubscribe_pending = false;
+static uint16_t subscribe_last_id = 0;  // SUBACK of this id completes the subscription list
+static uint32_t last_rx_ms = 0;
+
+static uint32_t last_connect_ms = 0;
+static uint32_t last_tx_ms = 0;
+static uint16_t next_packet_id = 0;
+static radio_sched_config_t radio_config = {
+    .interval_ms = MQTT_PUBLISH_WINDOW_MS,
+    .window_max_ms = MQTT_WINDOW_MAX_MS,
+    .linger_ms = MQTT_WINDOW_LINGER_MS,
+    .keep_alive_ms = MQTT_KEEP_ALIVE_S * 1000u
+};
+static uint32_t bulk_rate = MQTT_BULK_RATE_BPS;
+static char subscriptions[MQTT_MAX_SUBSCRIPTIONS][MQTT_QUEUE_TOPIC_MAX];
+
+static uint8_t rx_buf[MQTT_RX_BUFFER_SIZE];
+static size_t rx_len = 0;
+static uint8_t tx_buf[MQTT_TX_BUFFER_SIZE];
+
+#if MQTT_USE_TLS
+static struct altcp_tls_config *tls_config = NULL;
+static bool tls_cert_verified = false;
+static uint8_t tls_session_buf[MQTT_TLS_SESSION_MAX];
+#endif
+
+static uint32_t now_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+// The TLS handshake runs in lwIP callbacks; clk_sys is held at the burst level from connect until it has ended
+static void handshake_burst(bool hold) {
+#if MQTT_USE_TLS
+    static bool held = false;
+    if (hold != held) {
+        held = hold;
+        if (hold) {
+            clock_policy_burst_begin(CLOCK_BURST_TLS);
+        } else {
+            clock_policy_burst_end(CLOCK_BURST_TLS);
+        }
+    }
+#else
+    (void)hold;
+#endif
+}
+
+static uint16_t packet_id_next(void) {
+    if (++next_packet_id == 0) {
+        next_packet_id = 1;
+    }
+    return next_packet_id;
+}
+
+#if MQTT_USE_TLS
+static int tls_verify_cb(void *ctx, mbedtls_x509_crt *crt, int depth, uint32_t *flags) {
+    (void)ctx;
+    (void)crt;
+    (void)depth;
+    (void)flags;
+    // Only a full handshake carries the certificate chain; a resumed one never gets here
+    tls_cert_verified = true;
+    return 0;
+}
+
+// Offer the cached session before the handshake starts
+static void tls_prepare(struct altcp_pcb *pcb) {
+    mbedtls_ssl_context *ssl = (mbedtls_ssl_context *)altcp_tls_context(pcb);
+    mbedtls_ssl_set_hostname(ssl, MQTT_BROKER_HOST);
+    mbedtls_ssl_set_verify(ssl, tls_verify_cb, NULL);
+    tls_cert_verified = false;
+
+    size_t len;
+    const uint8_t *data = mqtt_session_tls_resume_data(&session, now_ms(), &len);
+    if (data == NULL) {
+        return;
+    }
+    mbedtls_ssl_session saved;
+    mbedtls_ssl_session_init(&saved);
+    if (mbedtls_ssl_session_load(&saved, data, len) != 0 || mbedtls_ssl_set_session(ssl, &saved) != 0) {
+        mqtt_session_tls_failed(&session);
+    }
+    mbedtls_ssl_session_free(&saved);
+}
+
+// Cache the session of the handshake that just completed
+static void tls_established(void) {
+    mbedtls_ssl_context *ssl = (mbedtls_ssl_context *)altcp_tls_context(conn);
+    mbedtls_ssl_session current;
+    mbedtls_ssl_session_init(&current);
+    size_t len = 0;
+    if (mbedtls_ssl_get_session(ssl, &current) != 0 ||
+        mbedtls_ssl_session_save(&current, tls_session_buf, sizeof(tls_session_buf), &len) != 0) {
+        len = 0;
+    }
+    mbedtls_ssl_session_free(&current);
+    mqtt_session_tls_established(&session, !tls_cert_verified, tls_session_buf, len, now_ms());
+}
+#endif
+
+// Forget per-connection state; called with the lwIP lock held or from lwIP callbacks
+static void link_reset(void) {
+    conn = NULL;
+    link_state = LINK_DOWN;
+    mqtt_inflight_link_down(&in_flight);    // QoS 1 publishes are sent again on the next connection
+    rx_len = 0;
+    subscribe_last_id = 0;
+    resubscribe_pending = false;
+}
+
+static void link_close(void) {
+    if (conn == NULL) {
+        link_reset();
+        return;
+    }
+    altcp_arg(conn, NULL);
+    altcp_recv(conn, NULL);
+    altcp_sent(conn, NULL);
+    altcp_err(conn, NULL);
+    if (altcp_close(conn) != ERR_OK) {
+        altcp_abort(conn);
+    }
+    link_reset();
+}
+
+static err_t link_write(const uint8_t *data, size_t len) {
+    if (conn == NULL) {
+        return ERR_CONN;
+    }
+    if (len == 0 || len > altcp_sndbuf(conn)) {
+        return ERR_MEM;
+    }
+    err_t err = altcp_write(conn, data, (u16_t)len, TCP_WRITE_FLAG_COPY);
+    if (err == ERR_OK) {
+        tx_total += (uint32_t)len;
+        last_tx_ms = now_ms();
+        altcp_output(conn);
+    }
+    return err;
+}
+
+static err_t link_sent(void *arg, struct altcp_pcb *pcb, u16_t len) {
+    (void)arg;
+    (void)pcb;
+    acked_total += len;
+    mqtt_inflight_tcp_acked(&in_flight, acked_total);
+    return ERR_OK;
+}
+
+// Handle one received packet; false drops the connection
+static bool handle_packet(const mqtt_packet_t *pkt) {
+    switch (pkt->type) {
+    case MQTT_PKT_CONNACK: {
+        bool session_present;
+        uint8_t rc;
+        if (link_state != LINK_WAIT_CONNACK || !mqtt_decode_connack(pkt, &session_present, &rc)) {
+            return false;
+        }
+        if (rc != MQTT_CONNACK_ACCEPTED) {
+            printf("MQTT connection refused, code %u\n", rc);
+            return false;
+        }
+        link_state = LINK_UP;
+        resubscribe_pending = mqtt_session_connack(&session, session_present);
+        mqtt_inflight_connack(&in_flight, session_present);
+        return true;
+    }
+    case MQTT_PKT_PUBACK: {
+        uint16_t id;
+        if (!mqtt_decode_ack(pkt, &id, NULL)) {
+            return false;
+        }
+        mqtt_inflight_puback(&in_flight, id);
+        return true;
+    }
+    case MQTT_PKT_SUBACK: {
+        uint16_t id;
+        uint8_t granted;
+        if (!mqtt_decode_ack(pkt, &id, &granted)) {
+            return false;
+        }
+        if (granted == MQTT_SUBACK_FAILURE) {
+            printf("MQTT subscription %u refused\n", id);
+        }
+        // Acknowledgements arrive in order: the last one completes the list
+        if (id == subscribe_last_id) {
+            subscribe_last_id = 0;
+            mqtt_session_subscribed(&session);
+        }
+        return true;
+    }
+    case MQTT_PKT_PUBLISH: {
+        mqtt_publish_t pub;
+        if (!mqtt_decode_publish(pkt, &pub) || pub.qos > 1) {
+            return false;
+        }
+        if (message_handler != NULL) {
+            message_handler(pub.topic, pub.topic_len, pub.payload, pub.payload_len, pub.retain);
+        }
+        if (pub.qos == 1) {
+            uint8_t ack[4];
+            size_t n = mqtt_encode_puback(ack, sizeof(ack), pub.packet_id);
+            return link_write(ack, n) == ERR_OK;
+        }
+        return true;
+    }
+    case MQTT_PKT_UNSUBACK:
+    case MQTT_PKT_PINGRESP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static err_t link_recv(void *arg, struct altcp_pcb *pcb, struct pbuf *p, err_t err) {
+    (void)arg;
+    if (p == NULL) {
+        printf("MQTT connection closed by broker\n");
+        link_close();
+        return ERR_OK;
+    }
+    if (err != ERR_OK || p->tot_len > sizeof(rx_buf) - rx_len) {
+        pbuf_free(p);
+        altcp_abort(pcb);
+        link_reset();
+        return ERR_ABRT;
+    }
+    pbuf_copy_partial(p, rx_buf + rx_len, p->tot_len, 0);
+    rx_len += p->tot_len;
+    altcp_recved(pcb, p->tot_len);
+    pbuf_free(p);
+    last_rx_ms = now_ms();
+
+    size_t pos = 0;
+    while (pos < rx_len) {
+        mqtt_packet_t pkt;
+        size_t n = mqtt_parse_packet(rx_buf + pos, rx_len - pos, &pkt);
+        if (n == MQTT_PARSE_INCOMPLETE) {
+            break;
+        }
+        if (n == MQTT_PARSE_MALFORMED || !handle_packet(&pkt)) {
+            altcp_abort(pcb);
+            link_reset();
+            return ERR_ABRT;
+        }
+        pos += n;
+    }
+    if (pos > 0) {
+        memmove(rx_buf, rx_buf + pos, rx_len - pos);
+        rx_len -= pos;
+    }
+    return ERR_OK;
+}
+
+static void link_err(void *arg, err_t err) {
+    (void)arg;
+    // lwIP has already freed the connection
+#if MQTT_USE_TLS
+    if (link_state == LINK_CONNECTING) {
+        mqtt_session_tls_failed(&session);
+    }
+#endif
+    printf("MQTT connection lost, err %d\n", (int)err);
+    link_reset();
+}
+
+// TCP connected and, with TLS, handshake completed
+static err_t link_connected(void *arg, struct altcp_pcb *pcb, err_t err) {
+    (void)arg;
+    if (err != ERR_OK) {
+        altcp_abort(pcb);
+        link_reset();
+        return ERR_ABRT;
+    }
+#if MQTT_USE_TLS
+    tls_established();
+#endif
+    mqtt_connect_opts_t opts = {
+        .client_id = MQTT_CLIENT_ID,
+        .keep_alive_s = MQTT_KEEP_ALIVE_S,
+        .clean_session = !MQTT_PERSISTENT_SESSION
+    };
+    uint8_t packet[64];
+    size_t n = mqtt_encode_connect(packet, sizeof(packet), &opts);
+    link_state = LINK_WAIT_CONNACK;
+    if (link_write(packet, n) != ERR_OK) {
+        altcp_abort(pcb);
+        link_reset();
+        return ERR_ABRT;
+    }
+    return ERR_OK;
+}
+
+static bool mqtt_connect(void) {
+    ip_addr_t broker;
+    if (!ipaddr_aton(MQTT_BROKER_ADDR, &broker)) {
+        return false;
+    }
+    last_connect_ms = now_ms();
+    last_rx_ms = last_connect_ms;
+    handshake_burst(true);
+
+    cyw43_arch_lwip_begin();
+#if MQTT_USE_TLS
+    struct altcp_pcb *pcb = altcp_tls_new(tls_config, IPADDR_TYPE_V4);
+    if (pcb != NULL) {
+        tls_prepare(pcb);
+    }
+#else
+    struct altcp_pcb *pcb = altcp_tcp_new_ip_type(IPADDR_TYPE_V4);
+#endif
+    err_t err = ERR_MEM;
+    if (pcb != NULL) {
+        conn = pcb;
+        link_state = LINK_CONNECTING;
+        tx_total = 0;
+        acked_total = 0;
+        altcp_recv(pcb, link_recv);
+        altcp_sent(pcb, link_sent);
+        altcp_err(pcb, link_err);
+        err = altcp_connect(pcb, &broker, MQTT_BROKER_PORT, link_connected);
+        if (err != ERR_OK) {
+            link_close();
+        }
+    }
+    cyw43_arch_lwip_end();
+    return err == ERR_OK;
+}
+
 bool init_mqtt_client() {
-    // TODO: Implement MQTT client initialization logic
-    return false;
+    mqtt_queue_init(&out_queue, bulk_rate, MQTT_BULK_BURST_BYTES, now_ms());
+    mqtt_inflight_init(&in_flight);
+    link_state = LINK_DOWN;
+
+#if MQTT_USE_TLS && MQTT_TLS_SESSION_FLASH
+    const mqtt_session_store_t *store = mqtt_session_flash_store();
+#else
+    const mqtt_session_store_t *store = NULL;
+#endif
+    mqtt_session_init(&session, store, MQTT_TLS_SESSION_LIFETIME_MS, MQTT_TLS_SESSION_SAVE_MS, now_ms());
+    initialized = true;
+    return true;
+}
+
+bool start_mqtt_client() {
+    if (!initialized) {
+        return false;
+    }
+    if (started) {
+        return true;
+    }
+    radio_sched_init(&radio, &radio_config, radio_get_cyw43_hal());
+
+#if MQTT_USE_TLS
+    if (sizeof(MQTT_TLS_CA_CERT) <= 1) {
+        printf("MQTT_TLS_CA_CERT not set\n");
+        return false;
+    }
+    cyw43_arch_lwip_begin();
+    tls_config = altcp_tls_create_config_client((const u8_t *)MQTT_TLS_CA_CERT, sizeof(MQTT_TLS_CA_CERT));
+    cyw43_arch_lwip_end();
+    if (tls_config == NULL) {
+        return false;
+    }
+#endif
+    started = true;
+    return mqtt_connect();
 }
 
 void deinit_mqtt_client() {
-    // TODO: Implement MQTT client deinitialization logic
+    if (!initialized) {
+        return;
+    }
+    initialized = false;
+    if (!started) {
+        return;
+    }
+    cyw43_arch_lwip_begin();
+    if (link_state == LINK_UP) {
+        // The broker keeps the persistent session after a clean DISCONNECT
+        uint8_t packet[2];
+        link_write(packet, mqtt_encode_empty(packet, sizeof(packet), MQTT_PKT_DISCONNECT));
+    }
+    link_close();
+#if MQTT_USE_TLS
+    altcp_tls_free_config(tls_config);
+    tls_config = NULL;
+#endif
+    cyw43_arch_lwip_end();
+    handshake_burst(false);
+    started = false;
+}
+
+// Send one SUBSCRIBE; called with the lwIP lock held
+static bool send_subscribe(const char *topic, uint16_t *packet_id) {
+    uint16_t id = packet_id_next();
+    size_t n = mqtt_encode_subscribe(tx_buf, sizeof(tx_buf), id, topic, 1);
+    if (link_write(tx_buf, n) != ERR_OK) {
+        return false;
+    }
+    *packet_id = id;
+    return true;
 }
 
 void topics_subscribe() {
-    // TODO: Implement MQTT topics subscription logic
+    if (link_state != LINK_UP) {
+        return;
+    }
+    resubscribe_pending = false;
+    uint16_t last_id = 0;
+    bool ok = true;
+    cyw43_arch_lwip_begin();
+    for (int i = 0; i < MQTT_MAX_SUBSCRIPTIONS && ok; i++) {
+        if (subscriptions[i][0] != '\0') {
+            ok = send_subscribe(subscriptions[i], &last_id);
+        }
+    }
+    if (!ok) {
+        // Retried on the next service call
+        resubscribe_pending = true;
+    } else if (last_id == 0) {
+        mqtt_session_subscribed(&session);
+    } else {
+        subscribe_last_id = last_id;
+    }
+    cyw43_arch_lwip_end();
 }
 
 void topics_unsubscribe() {
-    // TODO: Implement MQTT topics unsubscription logic
+    for (int i = 0; i < MQTT_MAX_SUBSCRIPTIONS; i++) {
+        if (subscriptions[i][0] != '\0') {
+            unsubscribe_topic(subscriptions[i]);
+        }
+    }
 }
 
 bool subscribe_topic(const char *topic) {
-    // TODO: Implement MQTT topic subscription logic
-    return false;
+    if (topic == NULL || topic[0] == '\0' || strlen(topic) >= MQTT_QUEUE_TOPIC_MAX) {
+        return false;
+    }
+    int slot = -1;
+    for (int i = 0; i < MQTT_MAX_SUBSCRIPTIONS; i++) {
+        if (strcmp(subscriptions[i], topic) == 0) {
+            return true;
+        }
+        if (slot < 0 && subscriptions[i][0] == '\0') {
+            slot = i;
+        }
+    }
+    if (slot < 0) {
+        return false;
+    }
+    strcpy(subscriptions[slot], topic);
+    // The broker's session does not have the new topic yet: the list is sent now or on the next connection
+    mqtt_session_reset_subscriptions(&session);
+    topics_subscribe();
+    return true;
 }
 
 bool unsubscribe_topic(const char *topic) {
-    // TODO: Implement MQTT topic unsubscription logic
+    if (topic == NULL || link_state != LINK_UP) {
+        return false;
+    }
+    for (int i = 0; i < MQTT_MAX_SUBSCRIPTIONS; i++) {
+        if (strcmp(subscriptions[i], topic) != 0) {
+            continue;
+        }
+        cyw43_arch_lwip_begin();
+        size_t n = mqtt_encode_unsubscribe(tx_buf, sizeof(tx_buf), packet_id_next(), topic);
+        bool sent = link_write(tx_buf, n) == ERR_OK;
+        cyw43_arch_lwip_end();
+        if (sent) {
+            subscriptions[i][0] = '\0';
+        }
+        return sent;
+    }
     return false;
 }
 
+void set_mqtt_message_handler(mqtt_message_handler_t handler) {
+    message_handler = handler;
+}
+
+void service_mqtt_client() {
+    if (!started) {
+        return;
+    }
+    uint32_t now = now_ms();
+    // Session store writes and pool releases happen here, never in the lwIP callbacks that request them
+    cyw43_arch_lwip_begin();
+    mqtt_session_flush(&session, now);
+    for (mqtt_msg_t *msg; (msg = mqtt_inflight_take(&in_flight)) != NULL;) {
+        mqtt_queue_release(&out_queue, msg);
+    }
+    cyw43_arch_lwip_end();
+    handshake_burst(link_state == LINK_CONNECTING || link_state == LINK_WAIT_CONNACK);
+
+    // The radio wakes for publish windows only: telemetry waits in the queue for the next one, alerts open one early
+    bool urgent = mqtt_queue_depth(&out_queue, MQTT_LANE_ALERT) > 0;
+    bool pending = urgent || mqtt_queue_depth(&out_queue, MQTT_LANE_BULK) > 0 || link_state != LINK_UP ||
+                   resubscribe_pending || subscribe_last_id != 0 || in_flight.count > 0;
+    if (!radio_sched_poll(&radio, pending, urgent)) {
+        return;
+    }
+
+    if (link_state == LINK_DOWN) {
+        // Keep queueing while offline; the backlog drains at the shaped rate once connected
+        if (now - last_connect_ms >= MQTT_RECONNECT_MS) {
+            mqtt_connect();
+        }
+        return;
+    }
+    if (link_state != LINK_UP) {
+        // Handshake or CONNACK overdue
+        if (now - last_connect_ms >= MQTT_RECONNECT_MS) {
+            printf("MQTT connect timed out\n");
+            cyw43_arch_lwip_begin();
+            link_close();
+            cyw43_arch_lwip_end();
+        }
+        return;
+    }
+
+    // Give up when the broker has been silent for 1.5 keep-alive periods
+    if (now - last_rx_ms >= MQTT_KEEP_ALIVE_S * 1500u) {
+        printf("MQTT broker not responding, reconnecting\n");
+        cyw43_arch_lwip_begin();
+        link_close();
+        cyw43_arch_lwip_end();
+        return;
+    }
+    // Ping in this window if the next one would come too late for the keep-alive
+    if (radio_sched_ping_due(&radio, last_tx_ms, last_rx_ms)) {
+        uint8_t packet[2];
+        cyw43_arch_lwip_begin();
+        link_write(packet, mqtt_encode_empty(packet, sizeof(packet), MQTT_PKT_PINGREQ));
+        cyw43_arch_lwip_end();
+    }
+
+    if (resubscribe_pending) {
+        topics_subscribe();
+    }
+
+    // QoS 1 publishes cut off by the last connection go first, in their original order
+    cyw43_arch_lwip_begin();
+    mqtt_inflight_entry_t *e;
+    while (link_state == LINK_UP && (e = mqtt_inflight_next_resend(&in_flight)) != NULL) {
+        const mqtt_msg_t *msg = e->msg;
+        size_t n = mqtt_encode_publish(tx_buf, sizeof(tx_buf), msg->topic, msg->payload, msg->len, msg->qos,
+                                       msg->retain, e->dup, e->packet_id);
+        if (link_write(tx_buf, n) != ERR_OK) {
+            break;
+        }
+        mqtt_inflight_resent(&in_flight, e, tx_total);
+    }
+    bool resend_pending = mqtt_inflight_next_resend(&in_flight) != NULL;
+    cyw43_arch_lwip_end();
+    if (resend_pending) {
+        return;
+    }
+
+    while (link_state == LINK_UP && in_flight.count < MQTT_MAX_IN_FLIGHT) {
+        mqtt_msg_t *msg = mqtt_queue_pop(&out_queue, now);
+        if (msg == NULL) {
+            break;
+        }
+        uint16_t id = (msg->qos > 0) ? packet_id_next() : 0;
+        size_t n = mqtt_encode_publish(tx_buf, sizeof(tx_buf), msg->topic, msg->payload, msg->len, msg->qos,
+                                       msg->retain, false, id);
+        cyw43_arch_lwip_begin();
+        err_t err = link_write(tx_buf, n);
+        if (err == ERR_OK) {
+            mqtt_inflight_add(&in_flight, msg, id, tx_total);
+        }
+        cyw43_arch_lwip_end();
+        if (err != ERR_OK) {
+            printf("MQTT publish to %s rejected, err %d\n", msg->topic, (int)err);
+            mqtt_queue_release(&out_queue, msg);
+            break;
+        }
+    }
+}
+
+void mqtt_sleep_ms(uint32_t ms) {
+    // Keep the queue moving while the main loop waits, so alert latency is not tied to the sample interval
+    uint32_t end = now_ms() + ms;
+    while ((int32_t)(end - now_ms()) > 0) {
+        service_mqtt_client();
+        clock_policy_poll();
+
+        // Between publish windows nothing is sent, so sleep through to the next one
+        uint32_t now = now_ms();
+        uint32_t wake = end;
+        if (started) {
+            uint32_t service = now + MQTT_SERVICE_MS;
+            radio_sched_next_window(&radio, &service);
+            if ((int32_t)(service - wake) < 0) {
+                wake = service;
+            }
+        }
+        // Wake for a pending clock drop, so the rest of the wait runs at the lower clock
+        uint32_t drop = 0;
+        if (clock_policy_drop_pending(&drop) && (int32_t)(drop - wake) < 0) {
+            wake = drop;
+        }
+        power_mgr_wait_until(wake);
+    }
+}
+
+static bool enqueue(mqtt_lane_t lane, const char *topic, fmt_buf_t *payload, uint8_t qos, bool retain) {
+    size_t len = fmt_finish(payload);
+    if (!initialized || len == 0) {
+        return false;
+    }
+    bool queued = mqtt_queue_push(&out_queue, lane, topic, (const uint8_t *)payload->buf, len, qos, retain, now_ms());
+    if (queued && lane == MQTT_LANE_ALERT) {
+        service_mqtt_client();
+    }
+    return queued;
+}
+
 void publish_pm25_sensor(pm25_data_t *data) {
-    // TODO: Implement MQTT publish logic for PM2.5 sensor data
+    if (data == NULL) {
+        return;
+    }
+    char payload[MQTT_QUEUE_PAYLOAD_MAX];
+    fmt_buf_t b;
+    fmt_init(&b, payload, sizeof(payload));
+    mqtt_payload_pm25(&b, data);
+    enqueue(MQTT_LANE_BULK, MQTT_TOPIC_PM25, &b, 0, false);
+}
+
+void publish_pm25_report(const rbe_report_t *report) {
+    if (report == NULL) {
+        return;
+    }
+    char payload[MQTT_QUEUE_PAYLOAD_MAX];
+    fmt_buf_t b;
+
+    if (report->reasons & RBE_REASON_THRESHOLD) {
+        // Short alert ahead of any queued telemetry
+        fmt_init(&b, payload, sizeof(payload));
+        mqtt_payload_pm25_alert(&b, report);
+        if (!enqueue(MQTT_LANE_ALERT, MQTT_TOPIC_ALERT, &b, 1, false)) {
+            printf("MQTT alert dropped\n");
+        }
+    }
+
+    fmt_init(&b, payload, sizeof(payload));
+    mqtt_payload_pm25_report(&b, report);
+    enqueue(MQTT_LANE_BULK, MQTT_TOPIC_PM25, &b, 0, false);
+}
+
+void publish_aqi(const aqi_report_t *report) {
+    if (report == NULL) {
+        return;
+    }
+    char payload[96];
+    fmt_buf_t b;
+    fmt_init(&b, payload, sizeof(payload));
+    fmt_json_object_begin(&b, NULL);
+    fmt_json_u32(&b, "aqi", report->aqi);
+    fmt_json_u32(&b, "nowcast_aqi", report->nowcast_aqi);
+    fmt_json_fixed(&b, "nowcast", report->nowcast, 2);
+    fmt_json_bool(&b, "valid", report->nowcast_valid);
+    fmt_json_object_end(&b);
+    enqueue(MQTT_LANE_BULK, MQTT_TOPIC_AQI, &b, 0, false);
+}
+
+void publish_diagnostics(const diag_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    char payload[MQTT_QUEUE_PAYLOAD_MAX];
+    fmt_buf_t b;
+    fmt_init(&b, payload, sizeof(payload));
+    fmt_json_object_begin(&b, NULL);
+    // Pairs are [used, size]; pools [in_use_max, blocks, exhausted]; rings [max, capacity]; radio duty in %;
+    // clock mhz is the mean clk_sys since boot; power sleep is the deep-sleep share in %
+    fmt_json_array_begin(&b, "stack");
+    for (int core = 0; core < DIAG_CORE_COUNT; core++) {
+        fmt_json_array_begin(&b, NULL);
+        fmt_json_u32(&b, NULL, stats->stack[core].used);
+        fmt_json_u32(&b, NULL, stats->stack[core].size);
+        fmt_json_array_end(&b);
+    }
+    fmt_json_array_end(&b);
+    fmt_json_u32(&b, "data", stats->data_bytes);
+    fmt_json_u32(&b, "bss", stats->bss_bytes);
+    fmt_json_u32(&b, "heap", stats->heap_bytes);
+    fmt_json_object_begin(&b, "pools");
+    for (uint16_t i = 0; i < stats->pool_count; i++) {
+        const mem_pool_stats_t *p = &stats->pools[i];
+        fmt_json_array_begin(&b, p->name);
+        fmt_json_u32(&b, NULL, p->high_water);
+        fmt_json_u32(&b, NULL, p->block_count);
+        fmt_json_u32(&b, NULL, p->exhausted);
+        fmt_json_array_end(&b);
+    }
+    fmt_json_object_end(&b);
+    fmt_json_object_begin(&b, "rings");
+    for (uint16_t i = 0; i < stats->ring_count; i++) {
+        const diag_ring_usage_t *r = &stats->rings[i];
+        fmt_json_array_begin(&b, r->name);
+        fmt_json_u32(&b, NULL, r->high_water);
+        fmt_json_u32(&b, NULL, r->capacity);
+        fmt_json_array_end(&b);
+    }
+    fmt_json_object_end(&b);
+    radio_sched_stats_t radio_stats;
+    radio_sched_get_stats(&radio, &radio_stats);
+    fmt_json_object_begin(&b, "radio");
+    fmt_json_fixed(&b, "duty", radio_stats.duty_permille, 1);
+    fmt_json_u32(&b, "windows", radio_stats.windows);
+    fmt_json_u32(&b, "urgent", radio_stats.urgent_windows);
+    fmt_json_u32(&b, "pings", radio_stats.keepalive_pings);
+    fmt_json_object_end(&b);
+    clock_policy_stats_t clock_stats;
+    clock_policy_get_stats(&clock_stats);
+    fmt_json_object_begin(&b, "clock");
+    fmt_json_fixed(&b, "mhz", (int32_t)(clock_stats.avg_khz / 10u), 2);
+    fmt_json_u32(&b, "bursts", clock_stats.bursts);
+    fmt_json_object_end(&b);
+    power_mgr_stats_t power_stats;
+    power_mgr_get_stats(&power_stats);
+    fmt_json_object_begin(&b, "power");
+    fmt_json_fixed(&b, "sleep", power_stats.sleep_permille, 1);
+    fmt_json_object_end(&b);
+    fmt_json_object_end(&b);
+    if (b.overflow) {
+        printf("MQTT diagnostics too large for one message\n");
+        return;
+    }
+    enqueue(MQTT_LANE_BULK, MQTT_TOPIC_DIAG, &b, 0, false);
+}
+
+void publish_sensor_link(uint8_t index, const pm25_sensor_t *sensor, uint64_t now_us) {
+    if (sensor == NULL) {
+        return;
+    }
+    // Since boot if the sensor never sent a good frame
+    uint64_t silent_ms = (now_us - sensor->link.last_good_us) / 1000u;
+    char payload[MQTT_QUEUE_PAYLOAD_MAX];
+    fmt_buf_t b;
+    fmt_init(&b, payload, sizeof(payload));
+    mqtt_payload_pm25_link(&b, index, &sensor->link, (silent_ms > UINT32_MAX) ? UINT32_MAX : (uint32_t)silent_ms);
+    enqueue(MQTT_LANE_BULK, MQTT_TOPIC_DIAG_PMS, &b, 0, false);
+}
+
+void publish_boot_report(const boot_seq_t *boot, uint32_t first_sample_ms) {
+    if (boot == NULL) {
+        return;
+    }
+    char payload[MQTT_QUEUE_PAYLOAD_MAX];
+    fmt_buf_t b;
+    fmt_init(&b, payload, sizeof(payload));
+    fmt_json_object_begin(&b, NULL);
+    // Times in ms since reset; phases are [start, end] of the tasks that completed
+    fmt_json_u32(&b, "first_sample", first_sample_ms);
+    fmt_json_u32(&b, "total", boot->end_ms);
+    fmt_json_object_begin(&b, "phases");
+    for (int i = 0; i < boot->count; i++) {
+        const boot_slot_t *slot = boot_seq_slot(boot, i);
+        if (slot->state == BOOT_TASK_DONE) {
+            fmt_json_array_begin(&b, slot->task.name);
+            fmt_json_u32(&b, NULL, slot->start_ms);
+            fmt_json_u32(&b, NULL, slot->end_ms);
+            fmt_json_array_end(&b);
+        }
+    }
+    fmt_json_object_end(&b);
+    fmt_json_array_begin(&b, "failed");
+    for (int i = 0; i < boot->count; i++) {
+        const boot_slot_t *slot = boot_seq_slot(boot, i);
+        if (slot->state != BOOT_TASK_DONE) {
+            fmt_json_str(&b, NULL, slot->task.name);
+        }
+    }
+    fmt_json_array_end(&b);
+    fmt_json_object_end(&b);
+    enqueue(MQTT_LANE_BULK, MQTT_TOPIC_BOOT, &b, 1, false);
+}
+
+void publish_config_status(const runtime_config_t *config, const runtime_config_status_t *status) {
+    if (config == NULL || status == NULL) {
+        return;
+    }
+    char payload[MQTT_QUEUE_PAYLOAD_MAX];
+    fmt_buf_t b;
+    fmt_init(&b, payload, sizeof(payload));
+    fmt_json_object_begin(&b, NULL);
+    // Active version and values, then the outcome of the last configuration message
+    fmt_json_u32(&b, "version", config->version);
+    fmt_json_u32(&b, "rate", config->sample_min_ms);
+    fmt_json_u32(&b, "slow", config->sample_max_ms);
+    fmt_json_u32(&b, "hb", config->heartbeat_ms);
+    fmt_json_u32(&b, "db", config->deadband_mass);
+    fmt_json_u32(&b, "dbn", config->deadband_count);
+    fmt_json_u32(&b, "dbp", config->deadband_pct_x10);
+    fmt_json_u32(&b, "win", config->window_ms);
+    fmt_json_u32(&b, "winmax", config->window_max_ms);
+    fmt_json_u32(&b, "bulk", config->bulk_rate_bps);
+    fmt_json_u32(&b, "received", status->received);
+    fmt_json_str(&b, "result", runtime_config_result_name(status->result));
+    fmt_json_u32(&b, "messages", status->messages);
+    fmt_json_object_end(&b);
+    // Retained, so the backend sees the version in force without waiting for the next change
+    enqueue(MQTT_LANE_ALERT, MQTT_TOPIC_CONFIG_STATUS, &b, 1, true);
+}
+
+bool publish_archive_block(const uint8_t *block, size_t len) {
+    if (!initialized || block == NULL || len == 0) {
+        return false;
+    }
+    return mqtt_queue_push(&out_queue, MQTT_LANE_BULK, MQTT_TOPIC_ARCHIVE, block, len, 1, false, now_ms());
+}
+
+const mqtt_lane_stats_t *get_mqtt_lane_stats(mqtt_lane_t lane) {
+    if ((unsigned)lane >= MQTT_LANE_COUNT) {
+        return NULL;
+    }
+    return &out_queue.stats[lane];
+}
+
+void set_mqtt_publish_rates(uint32_t window_ms, uint32_t window_max_ms, uint32_t bulk_rate_bps) {
+    // The queue and the radio schedule are also used from the lwIP callbacks
+    cyw43_arch_lwip_begin();
+    radio_config.interval_ms = window_ms;
+    radio_config.window_max_ms = window_max_ms;
+    bulk_rate = bulk_rate_bps;
+    if (started) {
+        radio_sched_set_config(&radio, &radio_config);
+    }
+    if (initialized) {
+        mqtt_queue_set_bulk_rate(&out_queue, bulk_rate, MQTT_BULK_BURST_BYTES, now_ms());
+    }
+    cyw43_arch_lwip_end();
+}
+
+void get_mqtt_radio_stats(radio_sched_stats_t *stats) {
+    radio_sched_get_stats(&radio, stats);
+}
+
+const mqtt_session_stats_t *get_mqtt_session_stats(void) {
+    return &session.stats;
 }
 
 bool is_mqtt_connected() {
-    // TODO: Implement MQTT connection status check
-    return false;
-}
\ No newline at end of file
+    return link_state == LINK_UP;
+}
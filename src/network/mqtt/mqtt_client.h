@@ -14,44 +14,146 @@
 #define NETWORK_MQTT_CLIENT_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "pm2_5.h"
+#include "aqi.h"
+#include "report_by_exception.h"
+#include "mqtt_queue.h"
+#include "diagnostics.h"
+#include "mqtt_session.h"
+#include "radio_sched.h"
+#include "boot_seq.h"
+#include "runtime_config.h"
 
 /**
- * Initialize the MQTT client.
+ * Handler for messages on subscribed topics. Runs in the lwIP context; topic is not terminated.
+ */
+typedef void (*mqtt_message_handler_t)(const char *topic, size_t topic_len, const uint8_t *payload, size_t len,
+                                       bool retain);
+
+/**
+ * Initialize the MQTT client. Messages published from here on wait in the
+ * outbound queue until start_mqtt_client() has connected.
  */
 bool init_mqtt_client();
 
+/**
+ * Start the network side once the station has an address: radio windows,
+ * TLS configuration and the first connection attempt (completed in the background).
+ */
+bool start_mqtt_client();
+
 /**
  * Deinitialize the MQTT client.
  */
 void deinit_mqtt_client();
 
 /**
- * Subscribe to necessary MQTT topics.
+ * Send the subscription list to the broker. Runs by itself after a connect
+ * unless the broker still holds our persistent session.
  */
 void topics_subscribe();
 
 /**
- * Unsubscribe from MQTT topics.
+ * Unsubscribe from all topics of the subscription list.
  */
 void topics_unsubscribe();
 
 /**
- * Subscribe to a specific MQTT topic.
+ * Add a topic (QoS 1) to the subscription list and subscribe to it once connected.
  */
 bool subscribe_topic(const char *topic);
 
 /**
- * Unsubscribe from a specific MQTT topic.
+ * Unsubscribe from a topic and remove it from the list. Requires a connection.
  */
 bool unsubscribe_topic(const char *topic);
 
+/**
+ * Set the handler for incoming messages (NULL to ignore them).
+ */
+void set_mqtt_message_handler(mqtt_message_handler_t handler);
+
+/**
+ * Hand queued messages to the broker: alerts first, then telemetry as the
+ * bandwidth shaping allows. Reconnects if the connection was lost.
+ */
+void service_mqtt_client();
+
+/**
+ * Sleep for the given time while servicing the outbound queue. The wait runs in deep sleep (power_mgr.h) and,
+ * between publish windows, without waking for the service period.
+ */
+void mqtt_sleep_ms(uint32_t ms);
+
 /**
  * Publish PM2.5 sensor data to MQTT broker.
  */
 void publish_pm25_sensor(pm25_data_t *data);
 
+/**
+ * Publish a PM2.5 sample selected by the report-by-exception stage,
+ * including its sequence number and report reasons. A threshold change
+ * also raises an alert on the alert lane.
+ */
+void publish_pm25_report(const rbe_report_t *report);
+
+/**
+ * Publish AQI and PM2.5 NowCast values to MQTT broker.
+ */
+void publish_aqi(const aqi_report_t *report);
+
+/**
+ * Publish a memory diagnostics snapshot (stack high-water marks, static RAM,
+ * pool and ring maxima) and the radio duty cycle to the diag topic.
+ */
+void publish_diagnostics(const diag_stats_t *stats);
+
+/**
+ * Publish the link health counters of one sensor, with the diagnostics.
+ */
+void publish_sensor_link(uint8_t index, const pm25_sensor_t *sensor, uint64_t now_us);
+
+/**
+ * Publish the boot timings: start and end of every boot phase, the failed
+ * phases and the time of the first sample.
+ */
+void publish_boot_report(const boot_seq_t *boot, uint32_t first_sample_ms);
+
+/**
+ * Publish a raw sample archive block to the archive topic (QoS 1, bulk lane).
+ * @return False if it could not be queued
+ */
+bool publish_archive_block(const uint8_t *block, size_t len);
+
+/**
+ * Publish the active runtime configuration and the outcome of the last configuration message, retained, on the
+ * alert lane.
+ */
+void publish_config_status(const runtime_config_t *config, const runtime_config_status_t *status);
+
+/**
+ * Change the publish window period (0: radio always active), the longest window and the bulk lane rate (0:
+ * unshaped) at run time. Queued messages and the connection are kept. Also valid before start_mqtt_client().
+ */
+void set_mqtt_publish_rates(uint32_t window_ms, uint32_t window_max_ms, uint32_t bulk_rate_bps);
+
+/**
+ * Outbound queue statistics of a lane.
+ */
+const mqtt_lane_stats_t *get_mqtt_lane_stats(mqtt_lane_t lane);
+
+/**
+ * Radio power-save statistics: publish windows, keep-alive pings and the active duty cycle.
+ */
+void get_mqtt_radio_stats(radio_sched_stats_t *stats);
+
+/**
+ * Connection reuse statistics: TLS handshakes (full / resumed) and persistent session hits.
+ */
+const mqtt_session_stats_t *get_mqtt_session_stats(void);
+
 /**
  * Check if MQTT client is connected to the broker.
  */
@@ -0,0 +1,271 @@
+/**
+ * File: mqtt_codec.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the MQTT 3.1.1 packet codec.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "mqtt_codec.h"
+
+#include <string.h>
+
+#define CONNECT_FLAG_CLEAN_SESSION  0x02
+#define CONNECT_FLAG_PASSWORD       0x40
+#define CONNECT_FLAG_USERNAME       0x80
+
+// Sequential writer over the caller buffer; overflow is checked once at the end
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t pos;
+    bool overflow;
+} writer_t;
+
+static void put_u8(writer_t *w, uint8_t v) {
+    if (w->pos >= w->size) {
+        w->overflow = true;
+        return;
+    }
+    w->buf[w->pos++] = v;
+}
+
+static void put_u16(writer_t *w, uint16_t v) {
+    put_u8(w, (uint8_t)(v >> 8));
+    put_u8(w, (uint8_t)v);
+}
+
+static void put_bytes(writer_t *w, const void *src, size_t n) {
+    if (n > w->size - w->pos) {
+        w->overflow = true;
+        return;
+    }
+    memcpy(w->buf + w->pos, src, n);
+    w->pos += n;
+}
+
+// Length-prefixed UTF-8 string
+static void put_str(writer_t *w, const char *s, size_t n) {
+    put_u16(w, (uint16_t)n);
+    put_bytes(w, s, n);
+}
+
+static void put_fixed_header(writer_t *w, uint8_t first, uint32_t remaining) {
+    put_u8(w, first);
+    do {
+        uint8_t digit = (uint8_t)(remaining & 0x7Fu);
+        remaining >>= 7;
+        put_u8(w, (uint8_t)(digit | ((remaining != 0) ? 0x80u : 0u)));
+    } while (remaining != 0);
+}
+
+static size_t finish(const writer_t *w) {
+    return w->overflow ? 0 : w->pos;
+}
+
+size_t mqtt_encode_connect(uint8_t *buf, size_t size, const mqtt_connect_opts_t *opts) {
+    if (buf == NULL || opts == NULL || opts->client_id == NULL || (opts->password != NULL && opts->username == NULL)) {
+        return 0;
+    }
+    size_t id_len = strlen(opts->client_id);
+    size_t user_len = (opts->username != NULL) ? strlen(opts->username) : 0;
+    size_t pass_len = (opts->password != NULL) ? strlen(opts->password) : 0;
+    if (id_len > UINT16_MAX || user_len > UINT16_MAX || pass_len > UINT16_MAX) {
+        return 0;
+    }
+
+    uint8_t flags = opts->clean_session ? CONNECT_FLAG_CLEAN_SESSION : 0;
+    uint32_t remaining = 10u + 2u + (uint32_t)id_len;
+    if (opts->username != NULL) {
+        flags |= CONNECT_FLAG_USERNAME;
+        remaining += 2u + (uint32_t)user_len;
+    }
+    if (opts->password != NULL) {
+        flags |= CONNECT_FLAG_PASSWORD;
+        remaining += 2u + (uint32_t)pass_len;
+    }
+
+    writer_t w = { buf, size, 0, false };
+    put_fixed_header(&w, MQTT_PKT_CONNECT << 4, remaining);
+    put_str(&w, "MQTT", 4);
+    put_u8(&w, 4);                      // Protocol level 3.1.1
+    put_u8(&w, flags);
+    put_u16(&w, opts->keep_alive_s);
+    put_str(&w, opts->client_id, id_len);
+    if (opts->username != NULL) {
+        put_str(&w, opts->username, user_len);
+    }
+    if (opts->password != NULL) {
+        put_str(&w, opts->password, pass_len);
+    }
+    return finish(&w);
+}
+
+size_t mqtt_encode_publish(uint8_t *buf, size_t size, const char *topic, const uint8_t *payload, size_t len,
+                           uint8_t qos, bool retain, bool dup, uint16_t packet_id) {
+    if (buf == NULL || topic == NULL || qos > 1 || (qos > 0 && packet_id == 0) || (len > 0 && payload == NULL)) {
+        return 0;
+    }
+    size_t topic_len = strlen(topic);
+    size_t remaining = 2u + topic_len + ((qos > 0) ? 2u : 0u) + len;
+    if (topic_len == 0 || topic_len > UINT16_MAX || remaining > MQTT_REMAINING_MAX) {
+        return 0;
+    }
+
+    uint8_t first = (uint8_t)((MQTT_PKT_PUBLISH << 4) | (dup ? 0x08 : 0) | (qos << 1) | (retain ? 0x01 : 0));
+    writer_t w = { buf, size, 0, false };
+    put_fixed_header(&w, first, (uint32_t)remaining);
+    put_str(&w, topic, topic_len);
+    if (qos > 0) {
+        put_u16(&w, packet_id);
+    }
+    if (len > 0) {
+        put_bytes(&w, payload, len);
+    }
+    return finish(&w);
+}
+
+size_t mqtt_encode_subscribe(uint8_t *buf, size_t size, uint16_t packet_id, const char *topic, uint8_t qos) {
+    if (buf == NULL || topic == NULL || packet_id == 0 || qos > 1) {
+        return 0;
+    }
+    size_t topic_len = strlen(topic);
+    if (topic_len == 0 || topic_len > UINT16_MAX) {
+        return 0;
+    }
+    writer_t w = { buf, size, 0, false };
+    put_fixed_header(&w, (MQTT_PKT_SUBSCRIBE << 4) | 0x02, (uint32_t)(2u + 2u + topic_len + 1u));
+    put_u16(&w, packet_id);
+    put_str(&w, topic, topic_len);
+    put_u8(&w, qos);
+    return finish(&w);
+}
+
+size_t mqtt_encode_unsubscribe(uint8_t *buf, size_t size, uint16_t packet_id, const char *topic) {
+    if (buf == NULL || topic == NULL || packet_id == 0) {
+        return 0;
+    }
+    size_t topic_len = strlen(topic);
+    if (topic_len == 0 || topic_len > UINT16_MAX) {
+        return 0;
+    }
+    writer_t w = { buf, size, 0, false };
+    put_fixed_header(&w, (MQTT_PKT_UNSUBSCRIBE << 4) | 0x02, (uint32_t)(2u + 2u + topic_len));
+    put_u16(&w, packet_id);
+    put_str(&w, topic, topic_len);
+    return finish(&w);
+}
+
+size_t mqtt_encode_puback(uint8_t *buf, size_t size, uint16_t packet_id) {
+    if (buf == NULL) {
+        return 0;
+    }
+    writer_t w = { buf, size, 0, false };
+    put_fixed_header(&w, MQTT_PKT_PUBACK << 4, 2);
+    put_u16(&w, packet_id);
+    return finish(&w);
+}
+
+size_t mqtt_encode_empty(uint8_t *buf, size_t size, uint8_t type) {
+    if (buf == NULL || (type != MQTT_PKT_PINGREQ && type != MQTT_PKT_DISCONNECT)) {
+        return 0;
+    }
+    writer_t w = { buf, size, 0, false };
+    put_fixed_header(&w, (uint8_t)(type << 4), 0);
+    return finish(&w);
+}
+
+size_t mqtt_parse_packet(const uint8_t *buf, size_t len, mqtt_packet_t *pkt) {
+    if (buf == NULL || pkt == NULL || len < 2) {
+        return MQTT_PARSE_INCOMPLETE;
+    }
+    uint32_t remaining = 0;
+    size_t pos = 1;
+    for (unsigned int shift = 0;; shift += 7) {
+        if (shift > 21) {
+            return MQTT_PARSE_MALFORMED;
+        }
+        if (pos >= len) {
+            return MQTT_PARSE_INCOMPLETE;
+        }
+        uint8_t digit = buf[pos++];
+        remaining |= (uint32_t)(digit & 0x7Fu) << shift;
+        if ((digit & 0x80u) == 0) {
+            break;
+        }
+    }
+    uint8_t type = buf[0] >> 4;
+    if (type == 0 || type == 15) {
+        return MQTT_PARSE_MALFORMED;
+    }
+    if (len - pos < remaining) {
+        return MQTT_PARSE_INCOMPLETE;
+    }
+    pkt->type = type;
+    pkt->flags = buf[0] & 0x0Fu;
+    pkt->body = buf + pos;
+    pkt->body_len = remaining;
+    return pos + remaining;
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(((uint16_t)p[0] << 8) | p[1]);
+}
+
+bool mqtt_decode_connack(const mqtt_packet_t *pkt, bool *session_present, uint8_t *return_code) {
+    if (pkt == NULL || pkt->type != MQTT_PKT_CONNACK || pkt->body_len != 2) {
+        return false;
+    }
+    if (session_present != NULL) {
+        *session_present = (pkt->body[0] & 0x01u) != 0;
+    }
+    if (return_code != NULL) {
+        *return_code = pkt->body[1];
+    }
+    return true;
+}
+
+bool mqtt_decode_ack(const mqtt_packet_t *pkt, uint16_t *packet_id, uint8_t *granted_qos) {
+    if (pkt == NULL || pkt->body_len < 2) {
+        return false;
+    }
+    if (pkt->type == MQTT_PKT_SUBACK) {
+        if (pkt->body_len < 3) {
+            return false;
+        }
+        if (granted_qos != NULL) {
+            *granted_qos = pkt->body[2];
+        }
+    } else if (pkt->type != MQTT_PKT_PUBACK && pkt->type != MQTT_PKT_UNSUBACK) {
+        return false;
+    }
+    if (packet_id != NULL) {
+        *packet_id = get_u16(pkt->body);
+    }
+    return true;
+}
+
+bool mqtt_decode_publish(const mqtt_packet_t *pkt, mqtt_publish_t *pub) {
+    if (pkt == NULL || pub == NULL || pkt->type != MQTT_PKT_PUBLISH || pkt->body_len < 2) {
+        return false;
+    }
+    uint8_t qos = (pkt->flags >> 1) & 0x03u;
+    uint16_t topic_len = get_u16(pkt->body);
+    uint32_t header = 2u + topic_len + ((qos > 0) ? 2u : 0u);
+    if (qos > 2 || header > pkt->body_len) {
+        return false;
+    }
+    pub->topic = (const char *)pkt->body + 2;
+    pub->topic_len = topic_len;
+    pub->qos = qos;
+    pub->retain = (pkt->flags & 0x01u) != 0;
+    pub->dup = (pkt->flags & 0x08u) != 0;
+    pub->packet_id = (qos > 0) ? get_u16(pkt->body + 2 + topic_len) : 0;
+    pub->payload = pkt->body + header;
+    pub->payload_len = pkt->body_len - header;
+    return true;
+}
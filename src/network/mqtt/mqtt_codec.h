@@ -0,0 +1,98 @@
+/**
+ * File: mqtt_codec.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the MQTT 3.1.1 packet codec. Encoders build complete control packets into a caller
+ * buffer; the parser splits a received byte stream into packets and decodes the ones a client receives. The codec
+ * has no transport or state of its own, so the device client (lwIP altcp, with or without TLS) and host tools use
+ * the same code.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef NETWORK_MQTT_CODEC_H
+#define NETWORK_MQTT_CODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Control packet types
+#define MQTT_PKT_CONNECT        1
+#define MQTT_PKT_CONNACK        2
+#define MQTT_PKT_PUBLISH        3
+#define MQTT_PKT_PUBACK         4
+#define MQTT_PKT_SUBSCRIBE      8
+#define MQTT_PKT_SUBACK         9
+#define MQTT_PKT_UNSUBSCRIBE    10
+#define MQTT_PKT_UNSUBACK       11
+#define MQTT_PKT_PINGREQ        12
+#define MQTT_PKT_PINGRESP       13
+#define MQTT_PKT_DISCONNECT     14
+
+#define MQTT_CONNACK_ACCEPTED   0
+#define MQTT_SUBACK_FAILURE     0x80
+
+#define MQTT_REMAINING_MAX      268435455u  // Largest remaining length the 4-byte encoding can carry
+
+#define MQTT_PARSE_INCOMPLETE   0
+#define MQTT_PARSE_MALFORMED    ((size_t)-1)
+
+typedef struct {
+    const char *client_id;
+    const char *username;       // NULL to omit
+    const char *password;       // NULL to omit (requires username)
+    uint16_t keep_alive_s;
+    bool clean_session;         // false: broker keeps subscriptions and QoS 1 state across connections
+} mqtt_connect_opts_t;
+
+// One packet located in a receive buffer; body points into that buffer
+typedef struct {
+    uint8_t type;
+    uint8_t flags;              // Low nibble of the first byte
+    const uint8_t *body;        // Variable header and payload
+    uint32_t body_len;
+} mqtt_packet_t;
+
+typedef struct {
+    const char *topic;          // Not terminated
+    uint16_t topic_len;
+    const uint8_t *payload;
+    uint32_t payload_len;
+    uint8_t qos;
+    bool retain;
+    bool dup;
+    uint16_t packet_id;         // 0 for QoS 0
+} mqtt_publish_t;
+
+/**
+ * Encoders. Each returns the packet length, or 0 if it does not fit in size bytes or the arguments are invalid.
+ */
+size_t mqtt_encode_connect(uint8_t *buf, size_t size, const mqtt_connect_opts_t *opts);
+size_t mqtt_encode_publish(uint8_t *buf, size_t size, const char *topic, const uint8_t *payload, size_t len,
+                           uint8_t qos, bool retain, bool dup, uint16_t packet_id);
+size_t mqtt_encode_subscribe(uint8_t *buf, size_t size, uint16_t packet_id, const char *topic, uint8_t qos);
+size_t mqtt_encode_unsubscribe(uint8_t *buf, size_t size, uint16_t packet_id, const char *topic);
+size_t mqtt_encode_puback(uint8_t *buf, size_t size, uint16_t packet_id);
+// PINGREQ or DISCONNECT (packets without variable header)
+size_t mqtt_encode_empty(uint8_t *buf, size_t size, uint8_t type);
+
+/**
+ * Locate the first packet in buf[0..len).
+ * Returns its total length, MQTT_PARSE_INCOMPLETE if more bytes are needed,
+ * or MQTT_PARSE_MALFORMED if the fixed header is invalid.
+ */
+size_t mqtt_parse_packet(const uint8_t *buf, size_t len, mqtt_packet_t *pkt);
+
+/**
+ * Decoders for received packets. Return false if the packet is not of that type or is malformed.
+ */
+bool mqtt_decode_connack(const mqtt_packet_t *pkt, bool *session_present, uint8_t *return_code);
+// PUBACK, UNSUBACK, or SUBACK (granted_qos receives the first return code, may be NULL)
+bool mqtt_decode_ack(const mqtt_packet_t *pkt, uint16_t *packet_id, uint8_t *granted_qos);
+bool mqtt_decode_publish(const mqtt_packet_t *pkt, mqtt_publish_t *pub);
+
+#endif // NETWORK_MQTT_CODEC_H
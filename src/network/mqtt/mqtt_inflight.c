@@ -0,0 +1,127 @@
+/**
+ * File: mqtt_inflight.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the window of publishes in flight on the MQTT connection.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "mqtt_inflight.h"
+
+#include <string.h>
+
+void mqtt_inflight_init(mqtt_inflight_t *f) {
+    if (f != NULL) {
+        memset(f, 0, sizeof(*f));
+    }
+}
+
+bool mqtt_inflight_add(mqtt_inflight_t *f, mqtt_msg_t *msg, uint16_t packet_id, uint32_t end) {
+    if (f == NULL || msg == NULL || f->count >= MQTT_INFLIGHT_MAX) {
+        return false;
+    }
+    mqtt_inflight_entry_t *e = &f->entries[f->count++];
+    memset(e, 0, sizeof(*e));
+    e->msg = msg;
+    e->packet_id = packet_id;
+    e->end = end;
+    return true;
+}
+
+bool mqtt_inflight_puback(mqtt_inflight_t *f, uint16_t packet_id) {
+    if (f == NULL || packet_id == 0) {
+        return false;
+    }
+    for (uint8_t i = 0; i < f->count; i++) {
+        mqtt_inflight_entry_t *e = &f->entries[i];
+        // A PUBACK for a copy still waiting to be resent completes it too
+        if (e->packet_id == packet_id && !e->done) {
+            e->done = true;
+            e->resend = false;
+            f->stats.completed++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void mqtt_inflight_tcp_acked(mqtt_inflight_t *f, uint32_t acked_total) {
+    if (f == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < f->count; i++) {
+        mqtt_inflight_entry_t *e = &f->entries[i];
+        if (e->packet_id == 0 && !e->done && (int32_t)(acked_total - e->end) >= 0) {
+            e->done = true;
+            f->stats.completed++;
+        }
+    }
+}
+
+void mqtt_inflight_link_down(mqtt_inflight_t *f) {
+    if (f == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < f->count; i++) {
+        mqtt_inflight_entry_t *e = &f->entries[i];
+        if (e->done) {
+            continue;
+        }
+        if (e->packet_id == 0) {
+            e->done = true;
+            f->stats.lost++;
+        } else {
+            e->resend = true;
+        }
+    }
+}
+
+void mqtt_inflight_connack(mqtt_inflight_t *f, bool session_present) {
+    if (f == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < f->count; i++) {
+        // Without our session the broker has no record of the id: the publish is new to it
+        f->entries[i].dup = session_present;
+    }
+}
+
+mqtt_inflight_entry_t *mqtt_inflight_next_resend(mqtt_inflight_t *f) {
+    if (f == NULL) {
+        return NULL;
+    }
+    for (uint8_t i = 0; i < f->count; i++) {
+        if (f->entries[i].resend) {
+            return &f->entries[i];
+        }
+    }
+    return NULL;
+}
+
+void mqtt_inflight_resent(mqtt_inflight_t *f, mqtt_inflight_entry_t *entry, uint32_t end) {
+    if (f == NULL || entry == NULL || !entry->resend) {
+        return;
+    }
+    entry->resend = false;
+    entry->end = end;
+    f->stats.resent++;
+}
+
+mqtt_msg_t *mqtt_inflight_take(mqtt_inflight_t *f) {
+    if (f == NULL) {
+        return NULL;
+    }
+    for (uint8_t i = 0; i < f->count; i++) {
+        if (f->entries[i].done) {
+            mqtt_msg_t *msg = f->entries[i].msg;
+            memmove(&f->entries[i], &f->entries[i + 1], (size_t)(f->count - i - 1) * sizeof(f->entries[0]));
+            f->count--;
+            return msg;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,97 @@
+/**
+ * File: mqtt_inflight.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the window of publishes handed to the connection and not yet complete. QoS 0
+ * completes once TCP has acknowledged its last byte, QoS 1 on PUBACK. The message buffer is kept until then, so a
+ * QoS 1 publish that loses its connection is sent again on the next one: with DUP set and its original packet id
+ * when the broker reports our session as present, as a new publish when the session is gone. QoS 0 publishes are
+ * lost with the connection. The module only decides; the client performs the I/O and returns completed buffers to
+ * the queue from the main loop.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef NETWORK_MQTT_INFLIGHT_H
+#define NETWORK_MQTT_INFLIGHT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mqtt_queue.h"
+
+#ifndef MQTT_INFLIGHT_MAX
+#define MQTT_INFLIGHT_MAX       4
+#endif
+
+typedef struct {
+    mqtt_msg_t *msg;            // Pool buffer, owned until the publish completes
+    uint16_t packet_id;         // 0 for QoS 0
+    uint32_t end;               // Output byte count at the end of the packet
+    bool done;                  // Complete or lost; the buffer waits for mqtt_inflight_take()
+    bool resend;                // Lost with a connection, to be written again
+    bool dup;                   // Resend as a duplicate: the broker kept our session
+} mqtt_inflight_entry_t;
+
+typedef struct {
+    uint32_t completed;         // QoS 1 PUBACKs and acknowledged QoS 0 publishes
+    uint32_t lost;              // QoS 0 publishes dropped with a connection
+    uint32_t resent;            // QoS 1 publishes written again after a reconnect
+} mqtt_inflight_stats_t;
+
+typedef struct {
+    mqtt_inflight_entry_t entries[MQTT_INFLIGHT_MAX];
+    uint8_t count;              // Entries in use, done ones included
+    mqtt_inflight_stats_t stats;
+} mqtt_inflight_t;
+
+void mqtt_inflight_init(mqtt_inflight_t *f);
+
+/**
+ * Record a publish that was written to the connection.
+ * @param end Output byte count of the connection after the packet
+ * @return False if the window is full
+ */
+bool mqtt_inflight_add(mqtt_inflight_t *f, mqtt_msg_t *msg, uint16_t packet_id, uint32_t end);
+
+/**
+ * Record a PUBACK.
+ * @return False if no QoS 1 publish waits for this id
+ */
+bool mqtt_inflight_puback(mqtt_inflight_t *f, uint16_t packet_id);
+
+/**
+ * Record TCP acknowledgements: QoS 0 publishes whose last byte is covered by acked_total are complete.
+ */
+void mqtt_inflight_tcp_acked(mqtt_inflight_t *f, uint32_t acked_total);
+
+/**
+ * Record the loss of the connection. QoS 0 publishes are lost; QoS 1 publishes wait for the next CONNACK.
+ */
+void mqtt_inflight_link_down(mqtt_inflight_t *f);
+
+/**
+ * Record an accepted CONNACK: decides whether the publishes to resend are duplicates.
+ */
+void mqtt_inflight_connack(mqtt_inflight_t *f, bool session_present);
+
+/**
+ * Next publish to write again after mqtt_inflight_connack(), oldest first, or NULL if none. Encode it with the
+ * entry's packet id and DUP flag, then call mqtt_inflight_resent().
+ */
+mqtt_inflight_entry_t *mqtt_inflight_next_resend(mqtt_inflight_t *f);
+
+/**
+ * Record that the entry from mqtt_inflight_next_resend() was written on the new connection.
+ */
+void mqtt_inflight_resent(mqtt_inflight_t *f, mqtt_inflight_entry_t *entry, uint32_t end);
+
+/**
+ * Remove one complete or lost publish and hand back its buffer for release, or NULL if none.
+ */
+mqtt_msg_t *mqtt_inflight_take(mqtt_inflight_t *f);
+
+#endif // NETWORK_MQTT_INFLIGHT_H
@@ -0,0 +1,57 @@
+/**
+ * File: mqtt_payload.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the MQTT telemetry payloads.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "mqtt_payload.h"
+
+static void format_pm25_fields(fmt_buf_t *b, const pm25_data_t *data) {
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        fmt_json_u32(b, pm25_field_name((pm25_field_t)f), pm25_data_get(data, (pm25_field_t)f));
+    }
+}
+
+void mqtt_payload_pm25(fmt_buf_t *b, const pm25_data_t *data) {
+    fmt_json_object_begin(b, NULL);
+    format_pm25_fields(b, data);
+    fmt_json_object_end(b);
+}
+
+void mqtt_payload_pm25_report(fmt_buf_t *b, const rbe_report_t *report) {
+    fmt_json_object_begin(b, NULL);
+    fmt_json_u32(b, "seq", report->seq);
+    fmt_json_u32(b, "ts", report->timestamp_ms);
+    fmt_json_u32(b, "reasons", report->reasons);
+    fmt_json_u32(b, "level", report->level);
+    format_pm25_fields(b, &report->data);
+    fmt_json_object_end(b);
+}
+
+void mqtt_payload_pm25_alert(fmt_buf_t *b, const rbe_report_t *report) {
+    fmt_json_object_begin(b, NULL);
+    fmt_json_u32(b, "seq", report->seq);
+    fmt_json_u32(b, "ts", report->timestamp_ms);
+    fmt_json_u32(b, "level", report->level);
+    fmt_json_u32(b, "pm2_5_atm", report->data.pm2_5_atm);
+    fmt_json_object_end(b);
+}
+
+void mqtt_payload_pm25_link(fmt_buf_t *b, uint8_t sensor, const pm25_link_stats_t *link, uint32_t silent_ms) {
+    fmt_json_object_begin(b, NULL);
+    fmt_json_u32(b, "sensor", sensor);
+    fmt_json_u32(b, "good", link->good);
+    for (int r = PM25_LINK_OK + 1; r < PM25_LINK_RESULT_COUNT; r++) {
+        fmt_json_u32(b, pm25_link_result_name((pm25_link_result_t)r), link->bad[r]);
+    }
+    fmt_json_u32(b, "resync_bytes", link->resync_bytes);
+    fmt_json_u32(b, "resets", link->resets);
+    fmt_json_u32(b, "silent_ms", silent_ms);
+    fmt_json_object_end(b);
+}
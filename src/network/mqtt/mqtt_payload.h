@@ -0,0 +1,42 @@
+/**
+ * File: mqtt_payload.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the MQTT telemetry payloads. The JSON bodies of the PM2.5 messages are built here,
+ * apart from the transport, so the firmware and the host tools (fleet load generator) send the same bytes.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef NETWORK_MQTT_PAYLOAD_H
+#define NETWORK_MQTT_PAYLOAD_H
+
+#include "pm2_5.h"
+#include "report_by_exception.h"
+#include "fmt.h"
+
+/**
+ * Raw sample: {"pm1_0_cf1":..,...} with every field.
+ */
+void mqtt_payload_pm25(fmt_buf_t *b, const pm25_data_t *data);
+
+/**
+ * Report by exception: {"seq","ts","reasons","level", every field}.
+ */
+void mqtt_payload_pm25_report(fmt_buf_t *b, const rbe_report_t *report);
+
+/**
+ * Threshold alert: {"seq","ts","level","pm2_5_atm"}; sent when the report has RBE_REASON_THRESHOLD.
+ */
+void mqtt_payload_pm25_alert(fmt_buf_t *b, const rbe_report_t *report);
+
+/**
+ * Sensor link health: {"sensor","good", failed reads by cause, "resync_bytes","resets","silent_ms"}; silent_ms is
+ * the time since the last good frame.
+ */
+void mqtt_payload_pm25_link(fmt_buf_t *b, uint8_t sensor, const pm25_link_stats_t *link, uint32_t silent_ms);
+
+#endif // NETWORK_MQTT_PAYLOAD_H
@@ -0,0 +1,182 @@
+/**
+ * File: mqtt_queue.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the priority-lane outbound MQTT message queue.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "mqtt_queue.h"
+
+#include <string.h>
+
+void mqtt_queue_init(mqtt_queue_t *q, uint32_t bulk_rate, uint32_t bulk_burst, uint32_t now_ms) {
+    if (q == NULL) {
+        return;
+    }
+    memset(q, 0, sizeof(*q));
+    mem_pool_init(&q->pool, "mqtt_msg", q->storage, sizeof(mqtt_msg_t), MQTT_QUEUE_POOL_SIZE);
+    q->bulk_rate = bulk_rate;
+    q->bulk_burst = bulk_burst;
+    q->tokens = bulk_burst;
+    q->refill_ms = now_ms;
+}
+
+static mqtt_msg_t *lane_unlink_head(mqtt_queue_t *q, mqtt_lane_t lane) {
+    mqtt_msg_t *msg = q->head[lane];
+    if (msg != NULL) {
+        q->head[lane] = msg->next;
+        if (q->head[lane] == NULL) {
+            q->tail[lane] = NULL;
+        }
+        q->stats[lane].depth--;
+    }
+    return msg;
+}
+
+bool mqtt_queue_push(mqtt_queue_t *q, mqtt_lane_t lane, const char *topic, const uint8_t *payload, size_t len,
+                     uint8_t qos, bool retain, uint32_t now_ms) {
+    if (q == NULL || topic == NULL || (unsigned)lane >= MQTT_LANE_COUNT) {
+        return false;
+    }
+    mqtt_lane_stats_t *st = &q->stats[lane];
+    size_t topic_len = strlen(topic);
+    if (len > MQTT_QUEUE_PAYLOAD_MAX || topic_len >= MQTT_QUEUE_TOPIC_MAX || (len > 0 && payload == NULL)) {
+        st->dropped++;
+        return false;
+    }
+
+    mqtt_msg_t *msg = NULL;
+    if (lane == MQTT_LANE_ALERT) {
+        msg = mem_pool_alloc(&q->pool);
+        if (msg == NULL) {
+            // Alerts never wait behind telemetry: evict the oldest bulk message
+            msg = lane_unlink_head(q, MQTT_LANE_BULK);
+            if (msg != NULL) {
+                q->stats[MQTT_LANE_BULK].dropped++;
+            }
+        }
+    } else if (mem_pool_available(&q->pool) > MQTT_QUEUE_ALERT_RESERVE) {
+        msg = mem_pool_alloc(&q->pool);
+    }
+    if (msg == NULL) {
+        st->dropped++;
+        return false;
+    }
+
+    memcpy(msg->topic, topic, topic_len + 1);
+    if (len > 0) {
+        memcpy(msg->payload, payload, len);
+    }
+    msg->len = (uint16_t)len;
+    msg->qos = qos;
+    msg->retain = retain;
+    msg->lane = (uint8_t)lane;
+    msg->enqueued_ms = now_ms;
+    msg->next = NULL;
+
+    if (q->tail[lane] == NULL) {
+        q->head[lane] = msg;
+    } else {
+        q->tail[lane]->next = msg;
+    }
+    q->tail[lane] = msg;
+
+    st->queued++;
+    st->depth++;
+    if (st->depth > st->max_depth) {
+        st->max_depth = st->depth;
+    }
+    return true;
+}
+
+static void bulk_refill(mqtt_queue_t *q, uint32_t now_ms) {
+    uint32_t elapsed = now_ms - q->refill_ms;
+    q->refill_ms = now_ms;
+    if (elapsed > 60000u) {
+        elapsed = 60000u;   // Bucket is full long before this; keeps the product in 32 bits
+    }
+    uint32_t byte_ms = elapsed * q->bulk_rate + q->refill_rem;
+    q->refill_rem = byte_ms % 1000u;
+    q->tokens += byte_ms / 1000u;
+    if (q->tokens >= q->bulk_burst) {
+        q->tokens = q->bulk_burst;
+        q->refill_rem = 0;
+    }
+}
+
+void mqtt_queue_set_bulk_rate(mqtt_queue_t *q, uint32_t bulk_rate, uint32_t bulk_burst, uint32_t now_ms) {
+    if (q == NULL) {
+        return;
+    }
+    // Credit the time so far at the old rate
+    if (q->bulk_rate != 0) {
+        bulk_refill(q, now_ms);
+    } else {
+        q->tokens = bulk_burst;
+        q->refill_rem = 0;
+    }
+    q->refill_ms = now_ms;
+    q->bulk_rate = bulk_rate;
+    q->bulk_burst = bulk_burst;
+    if (q->tokens > bulk_burst) {
+        q->tokens = bulk_burst;
+    }
+}
+
+static mqtt_msg_t *lane_pop(mqtt_queue_t *q, mqtt_lane_t lane, uint32_t now_ms) {
+    mqtt_msg_t *msg = lane_unlink_head(q, lane);
+    mqtt_lane_stats_t *st = &q->stats[lane];
+    uint32_t latency = now_ms - msg->enqueued_ms;
+    if (latency > st->max_latency_ms) {
+        st->max_latency_ms = latency;
+    }
+    st->sent++;
+    msg->next = NULL;
+    return msg;
+}
+
+mqtt_msg_t *mqtt_queue_pop(mqtt_queue_t *q, uint32_t now_ms) {
+    if (q == NULL) {
+        return NULL;
+    }
+    if (q->head[MQTT_LANE_ALERT] != NULL) {
+        return lane_pop(q, MQTT_LANE_ALERT, now_ms);
+    }
+
+    mqtt_msg_t *head = q->head[MQTT_LANE_BULK];
+    if (head == NULL) {
+        return NULL;
+    }
+    if (q->bulk_rate != 0) {
+        bulk_refill(q, now_ms);
+        uint32_t cost = head->len;
+        // A message larger than the bucket is let through once the bucket is full
+        if (cost > q->bulk_burst) {
+            cost = q->bulk_burst;
+        }
+        if (q->tokens < cost) {
+            return NULL;
+        }
+        q->tokens -= cost;
+    }
+    return lane_pop(q, MQTT_LANE_BULK, now_ms);
+}
+
+void mqtt_queue_release(mqtt_queue_t *q, mqtt_msg_t *msg) {
+    if (q == NULL) {
+        return;
+    }
+    mem_pool_free(&q->pool, msg);
+}
+
+uint16_t mqtt_queue_depth(const mqtt_queue_t *q, mqtt_lane_t lane) {
+    if (q == NULL || (unsigned)lane >= MQTT_LANE_COUNT) {
+        return 0;
+    }
+    return q->stats[lane].depth;
+}
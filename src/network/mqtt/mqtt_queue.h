@@ -0,0 +1,109 @@
+/**
+ * File: mqtt_queue.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the outbound MQTT message queue. Messages are stored in a fixed pool of buffers and
+ * queued on priority lanes: the alert lane (alerts, control replies) is always drained first and is never shaped,
+ * the bulk lane (telemetry, backfill) is rate-limited by a token bucket so it cannot saturate the link. A few
+ * buffers are reserved for the alert lane, and an alert may evict the oldest bulk message when the pool is full.
+ * Message buffers come from the queue's "mqtt_msg" memory pool (mem_pool.h).
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef NETWORK_MQTT_QUEUE_H
+#define NETWORK_MQTT_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mem_pool.h"
+
+#define MQTT_QUEUE_POOL_SIZE            16      // Message buffers in the pool
+#define MQTT_QUEUE_ALERT_RESERVE        2       // Buffers only the alert lane may use
+#define MQTT_QUEUE_TOPIC_MAX            48      // Including terminator
+#define MQTT_QUEUE_PAYLOAD_MAX          320
+
+#define MQTT_QUEUE_DEFAULT_BULK_RATE    512     // Bulk lane bytes per second
+#define MQTT_QUEUE_DEFAULT_BULK_BURST   2048    // Bulk lane token bucket depth in bytes
+
+typedef enum {
+    MQTT_LANE_ALERT = 0,    // Alerts and control, highest priority
+    MQTT_LANE_BULK,         // Telemetry and backfill, bandwidth-shaped
+    MQTT_LANE_COUNT
+} mqtt_lane_t;
+
+typedef struct mqtt_msg {
+    char topic[MQTT_QUEUE_TOPIC_MAX];
+    uint8_t payload[MQTT_QUEUE_PAYLOAD_MAX];
+    uint16_t len;
+    uint8_t qos;
+    bool retain;
+    uint8_t lane;
+    uint32_t enqueued_ms;   // Time of push, for latency accounting
+    struct mqtt_msg *next;  // Next message in the lane
+} mqtt_msg_t;
+
+typedef struct {
+    uint32_t queued;        // Messages accepted
+    uint32_t sent;          // Messages handed out by pop
+    uint32_t dropped;       // Messages refused or evicted
+    uint32_t max_latency_ms;// Longest push-to-pop time
+    uint16_t depth;         // Messages waiting now
+    uint16_t max_depth;     // High-water mark of depth
+} mqtt_lane_stats_t;
+
+typedef struct {
+    mem_pool_t pool;
+    uint8_t storage[MEM_POOL_STORAGE_SIZE(sizeof(mqtt_msg_t), MQTT_QUEUE_POOL_SIZE)]
+        __attribute__((aligned(MEM_POOL_ALIGN)));
+    mqtt_msg_t *head[MQTT_LANE_COUNT];
+    mqtt_msg_t *tail[MQTT_LANE_COUNT];
+    mqtt_lane_stats_t stats[MQTT_LANE_COUNT];
+    // Bulk lane token bucket
+    uint32_t bulk_rate;     // Bytes per second
+    uint32_t bulk_burst;    // Bucket depth in bytes
+    uint32_t tokens;        // Available bytes
+    uint32_t refill_ms;     // Last refill time
+    uint32_t refill_rem;    // Sub-byte remainder of the last refill, in byte-milliseconds
+} mqtt_queue_t;
+
+/**
+ * Initialize the queue. A bulk_rate of 0 disables shaping.
+ */
+void mqtt_queue_init(mqtt_queue_t *q, uint32_t bulk_rate, uint32_t bulk_burst, uint32_t now_ms);
+
+/**
+ * Change the bulk lane shaping; queued messages stay. The bucket keeps its tokens up to the new depth.
+ */
+void mqtt_queue_set_bulk_rate(mqtt_queue_t *q, uint32_t bulk_rate, uint32_t bulk_burst, uint32_t now_ms);
+
+/**
+ * Copy a message into a pool buffer and append it to a lane.
+ * Returns false if the message is too large or no buffer is available.
+ */
+bool mqtt_queue_push(mqtt_queue_t *q, mqtt_lane_t lane, const char *topic, const uint8_t *payload, size_t len,
+                     uint8_t qos, bool retain, uint32_t now_ms);
+
+/**
+ * Remove the next message to send: the alert lane head if any, else the bulk lane head if the
+ * token bucket allows it. Returns NULL if nothing may be sent now. The buffer stays owned by the
+ * caller until mqtt_queue_release().
+ */
+mqtt_msg_t *mqtt_queue_pop(mqtt_queue_t *q, uint32_t now_ms);
+
+/**
+ * Return a popped message buffer to the pool.
+ */
+void mqtt_queue_release(mqtt_queue_t *q, mqtt_msg_t *msg);
+
+/**
+ * Number of messages waiting on a lane.
+ */
+uint16_t mqtt_queue_depth(const mqtt_queue_t *q, mqtt_lane_t lane);
+
+#endif // NETWORK_MQTT_QUEUE_H
@@ -0,0 +1,158 @@
+/**
+ * File: mqtt_session.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for MQTT connection reuse (TLS session cache and persistent session state).
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "mqtt_session.h"
+
+#include <string.h>
+
+static void drop_tls(mqtt_session_t *session) {
+    session->tls_len = 0;
+    session->offered = false;
+    session->save_pending = false;
+    session->erase_pending = (session->store != NULL && session->store->erase != NULL);
+}
+
+void mqtt_session_init(mqtt_session_t *session, const mqtt_session_store_t *store, uint32_t lifetime_ms,
+                       uint32_t min_save_interval_ms, uint32_t now_ms) {
+    if (session == NULL) {
+        return;
+    }
+    memset(session, 0, sizeof(*session));
+    session->store = store;
+    session->lifetime_ms = lifetime_ms;
+    session->min_save_interval_ms = min_save_interval_ms;
+
+    if (store != NULL && store->load != NULL) {
+        size_t len = store->load(store->ctx, session->tls_data, sizeof(session->tls_data));
+        // The store cannot tell how old its session is; the age starts at load and the server rejects stale ones
+        session->tls_len = (len <= sizeof(session->tls_data)) ? len : 0;
+        session->tls_time_ms = now_ms;
+    }
+}
+
+const uint8_t *mqtt_session_tls_resume_data(mqtt_session_t *session, uint32_t now_ms, size_t *len) {
+    if (session == NULL || len == NULL) {
+        return NULL;
+    }
+    *len = 0;
+    session->offered = false;
+    if (session->tls_len == 0) {
+        return NULL;
+    }
+    if (session->lifetime_ms != 0 && now_ms - session->tls_time_ms >= session->lifetime_ms) {
+        drop_tls(session);
+        return NULL;
+    }
+    session->offered = true;
+    *len = session->tls_len;
+    return session->tls_data;
+}
+
+void mqtt_session_tls_established(mqtt_session_t *session, bool resumed, const uint8_t *data, size_t len,
+                                  uint32_t now_ms) {
+    if (session == NULL) {
+        return;
+    }
+    if (resumed) {
+        session->stats.resumed_handshakes++;
+    } else {
+        session->stats.full_handshakes++;
+        if (session->offered) {
+            session->stats.resume_rejected++;
+        }
+    }
+    session->offered = false;
+
+    if (data == NULL || len == 0 || len > sizeof(session->tls_data)) {
+        // Nothing reusable: keep offering the old session only if the server just accepted it
+        if (!resumed) {
+            drop_tls(session);
+        }
+        return;
+    }
+
+    bool changed = (len != session->tls_len) || (memcmp(session->tls_data, data, len) != 0);
+    memcpy(session->tls_data, data, len);
+    session->tls_len = len;
+    if (!resumed) {
+        // A full handshake starts a new session lifetime; a resumed one keeps the original
+        session->tls_time_ms = now_ms;
+    }
+
+    // A full handshake always replaces the stored session; renewed tickets are written at a bounded rate
+    const mqtt_session_store_t *store = session->store;
+    if (store == NULL || store->save == NULL || !changed) {
+        return;
+    }
+    if (resumed && session->saved && now_ms - session->last_save_ms < session->min_save_interval_ms) {
+        return;
+    }
+    session->save_pending = true;
+    session->erase_pending = false;
+}
+
+void mqtt_session_flush(mqtt_session_t *session, uint32_t now_ms) {
+    if (session == NULL || session->store == NULL) {
+        return;
+    }
+    const mqtt_session_store_t *store = session->store;
+    if (session->erase_pending) {
+        session->erase_pending = false;
+        store->erase(store->ctx);
+    }
+    if (session->save_pending) {
+        session->save_pending = false;
+        if (session->tls_len > 0 && store->save(store->ctx, session->tls_data, session->tls_len)) {
+            session->saved = true;
+            session->stats.store_saves++;
+        }
+        // A failed write is not retried before the next interval either
+        session->last_save_ms = now_ms;
+    }
+}
+
+void mqtt_session_tls_failed(mqtt_session_t *session) {
+    if (session == NULL || !session->offered) {
+        return;
+    }
+    drop_tls(session);
+}
+
+bool mqtt_session_connack(mqtt_session_t *session, bool session_present) {
+    if (session == NULL) {
+        return true;
+    }
+    session->stats.connects++;
+    if (session_present) {
+        session->stats.session_present++;
+    } else {
+        // The broker starts empty: whatever we subscribed before is gone
+        session->subscribed = false;
+    }
+    if (session->subscribed) {
+        return false;
+    }
+    session->stats.resubscribes++;
+    return true;
+}
+
+void mqtt_session_subscribed(mqtt_session_t *session) {
+    if (session != NULL) {
+        session->subscribed = true;
+    }
+}
+
+void mqtt_session_reset_subscriptions(mqtt_session_t *session) {
+    if (session != NULL) {
+        session->subscribed = false;
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * File: mqtt_session.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for MQTT connection reuse. Caches the serialized TLS session of the last successful
+ * handshake so the next connection can resume it (session ticket or session ID) instead of running a full
+ * handshake, and tracks whether the broker still holds our persistent MQTT session (clean session off) so
+ * reconnects skip re-subscribing. The module only decides and counts; the client performs the TLS and MQTT I/O.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef NETWORK_MQTT_SESSION_H
+#define NETWORK_MQTT_SESSION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Largest serialized TLS session (ticket included) that is cached. mbedTLS without
+// MBEDTLS_SSL_KEEP_PEER_CERTIFICATE keeps only a digest of the server certificate.
+#ifndef MQTT_TLS_SESSION_MAX
+#define MQTT_TLS_SESSION_MAX    512
+#endif
+
+/**
+ * Optional persistent store for the TLS session, so resumption survives a reboot.
+ * The blob holds the session master secret: only back it with storage that is as private as the device key.
+ */
+typedef struct {
+    size_t (*load)(void *ctx, uint8_t *buf, size_t size);           // Returns the stored length, 0 if none
+    bool (*save)(void *ctx, const uint8_t *data, size_t len);
+    void (*erase)(void *ctx);
+    void *ctx;
+} mqtt_session_store_t;
+
+typedef struct {
+    uint32_t connects;              // CONNACKs accepted
+    uint32_t full_handshakes;
+    uint32_t resumed_handshakes;
+    uint32_t resume_rejected;       // Cached session offered, server ran a full handshake
+    uint32_t session_present;       // CONNACKs that reported our persistent session
+    uint32_t resubscribes;          // Times the subscription list had to be sent
+    uint32_t store_saves;
+} mqtt_session_stats_t;
+
+typedef struct {
+    const mqtt_session_store_t *store;  // NULL: RAM only
+    uint32_t lifetime_ms;               // Stop offering a cached TLS session after this age
+    uint32_t min_save_interval_ms;      // Rate limit for store writes (flash wear)
+
+    uint8_t tls_data[MQTT_TLS_SESSION_MAX];
+    size_t tls_len;                     // 0: nothing cached
+    uint32_t tls_time_ms;               // When tls_data was obtained (or loaded)
+    bool offered;                       // tls_data was handed out for the current handshake
+    bool save_pending;                  // Store writes wait for mqtt_session_flush()
+    bool erase_pending;
+    bool saved;                         // Store holds at least one write from this boot
+    uint32_t last_save_ms;
+
+    bool subscribed;                    // Subscription list acknowledged within the broker's current session
+
+    mqtt_session_stats_t stats;
+} mqtt_session_t;
+
+/**
+ * Initialize the session state and load a previously stored TLS session.
+ * @param store Persistent store, or NULL to cache in RAM only
+ * @param lifetime_ms Maximum age of a cached TLS session; 0 for no limit (the server still enforces its own)
+ * @param min_save_interval_ms Minimum time between two store writes of a renewed session
+ */
+void mqtt_session_init(mqtt_session_t *session, const mqtt_session_store_t *store, uint32_t lifetime_ms,
+                       uint32_t min_save_interval_ms, uint32_t now_ms);
+
+/**
+ * TLS session to offer in the next handshake, or NULL for a full handshake.
+ * An expired session is dropped (and erased from the store) instead.
+ */
+const uint8_t *mqtt_session_tls_resume_data(mqtt_session_t *session, uint32_t now_ms, size_t *len);
+
+/**
+ * Record a completed handshake and cache the session it produced.
+ * @param resumed True if the server accepted the offered session (no certificate exchange took place)
+ * @param data Serialized session of this connection, or NULL/0 if it could not be exported
+ */
+void mqtt_session_tls_established(mqtt_session_t *session, bool resumed, const uint8_t *data, size_t len,
+                                  uint32_t now_ms);
+
+/**
+ * Carry out pending store writes and erases. The store may be slow (flash erase), so this is
+ * called from the main loop rather than from the network stack's callbacks.
+ */
+void mqtt_session_flush(mqtt_session_t *session, uint32_t now_ms);
+
+/**
+ * Record a failed handshake. A cached session that was offered is dropped, so a session the
+ * server cannot handle never blocks reconnects; losing it costs one full handshake.
+ */
+void mqtt_session_tls_failed(mqtt_session_t *session);
+
+/**
+ * Record an accepted CONNACK.
+ * @return True if the subscription list must be sent: the broker has no session for us,
+ *         or the previous subscribe never completed
+ */
+bool mqtt_session_connack(mqtt_session_t *session, bool session_present);
+
+/**
+ * Mark the subscription list as acknowledged by the broker.
+ */
+void mqtt_session_subscribed(mqtt_session_t *session);
+
+/**
+ * Forget the subscription state, forcing the next connection to re-subscribe.
+ */
+void mqtt_session_reset_subscriptions(mqtt_session_t *session);
+
+#endif // NETWORK_MQTT_SESSION_H
@@ -0,0 +1,102 @@
+/**
+ * File: mqtt_session_flash.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the flash-backed TLS session store.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "mqtt_session_flash.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "hardware/flash.h"
+#include "pico/flash.h"
+
+#include "mqtt_config.h"
+
+#define SESSION_FLASH_MAGIC     0x53534C54u     // "TLSS"
+#define SESSION_FLASH_TIMEOUT   100             // ms to wait for the other core to park
+
+typedef struct {
+    uint32_t magic;
+    uint32_t len;
+    uint32_t check;             // FNV-1a over the session bytes
+    uint8_t data[MQTT_TLS_SESSION_MAX];
+} session_record_t;
+
+// Programmed size: whole flash pages
+#define SESSION_RECORD_SIZE     ((sizeof(session_record_t) + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE)
+
+static_assert(MQTT_SESSION_FLASH_OFFSET % FLASH_SECTOR_SIZE == 0, "session record must start a flash sector");
+static_assert(SESSION_RECORD_SIZE <= FLASH_SECTOR_SIZE, "session record must fit one flash sector");
+
+// Staging buffer for programming (flash cannot be programmed from flash)
+static union {
+    session_record_t record;
+    uint8_t raw[SESSION_RECORD_SIZE];
+} staging;
+
+static uint32_t fnv1a(const uint8_t *data, size_t len) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ data[i]) * 16777619u;
+    }
+    return h;
+}
+
+static void flash_write_sector(void *param) {
+    bool program = (param != NULL);
+    flash_range_erase(MQTT_SESSION_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    if (program) {
+        flash_range_program(MQTT_SESSION_FLASH_OFFSET, staging.raw, SESSION_RECORD_SIZE);
+    }
+}
+
+static size_t flash_load(void *ctx, uint8_t *buf, size_t size) {
+    (void)ctx;
+    const session_record_t *record = (const session_record_t *)(XIP_BASE + MQTT_SESSION_FLASH_OFFSET);
+    if (record->magic != SESSION_FLASH_MAGIC || record->len == 0 || record->len > MQTT_TLS_SESSION_MAX ||
+        record->len > size || record->check != fnv1a(record->data, record->len)) {
+        return 0;
+    }
+    memcpy(buf, record->data, record->len);
+    return record->len;
+}
+
+static bool flash_save(void *ctx, const uint8_t *data, size_t len) {
+    (void)ctx;
+    if (len == 0 || len > MQTT_TLS_SESSION_MAX) {
+        return false;
+    }
+    memset(staging.raw, 0xFF, sizeof(staging.raw));
+    staging.record.magic = SESSION_FLASH_MAGIC;
+    staging.record.len = (uint32_t)len;
+    staging.record.check = fnv1a(data, len);
+    memcpy(staging.record.data, data, len);
+    return flash_safe_execute(flash_write_sector, &staging, SESSION_FLASH_TIMEOUT) == PICO_OK;
+}
+
+static void flash_erase(void *ctx) {
+    (void)ctx;
+    const session_record_t *record = (const session_record_t *)(XIP_BASE + MQTT_SESSION_FLASH_OFFSET);
+    if (record->magic == SESSION_FLASH_MAGIC) {
+        flash_safe_execute(flash_write_sector, NULL, SESSION_FLASH_TIMEOUT);
+    }
+}
+
+static const mqtt_session_store_t flash_store = {
+    .load = flash_load,
+    .save = flash_save,
+    .erase = flash_erase,
+    .ctx = NULL
+};
+
+const mqtt_session_store_t *mqtt_session_flash_store(void) {
+    return &flash_store;
+}
@@ -0,0 +1,26 @@
+/**
+ * File: mqtt_session_flash.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the flash-backed TLS session store. One record in the flash sector at
+ * MQTT_SESSION_FLASH_OFFSET keeps the last TLS session across reboots, so the first connection after power-up
+ * can resume as well.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef NETWORK_MQTT_SESSION_FLASH_H
+#define NETWORK_MQTT_SESSION_FLASH_H
+
+#include "mqtt_session.h"
+
+/**
+ * Store backed by the session flash sector. Every save erases and programs the sector, so
+ * mqtt_session_init() should be given a save interval that keeps the write rate low.
+ */
+const mqtt_session_store_t *mqtt_session_flash_store(void);
+
+#endif // NETWORK_MQTT_SESSION_FLASH_H
@@ -0,0 +1,65 @@
+/**
+ * File: rbe_reconstruct.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Host-side reconstruction of a full PM2.5 series from report-by-exception reports. Built for the
+ * ingestion side and host tests; not linked into the firmware.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "report_by_exception.h"
+
+#include <stddef.h>
+#include <string.h>
+
+void rbe_reconstruct_init(rbe_reconstructor_t *rc, const rbe_config_t *config) {
+    if (rc == NULL) {
+        return;
+    }
+    memset(rc, 0, sizeof(*rc));
+    if (config != NULL) {
+        rc->config = *config;
+    } else {
+        rbe_default_config(&rc->config);
+    }
+}
+
+void rbe_reconstruct_push(rbe_reconstructor_t *rc, const rbe_report_t *report) {
+    if (rc == NULL || report == NULL) {
+        return;
+    }
+    if (rc->has_last && report->seq > rc->last.seq + 1) {
+        rc->lost += report->seq - rc->last.seq - 1;
+    }
+    rc->last = *report;
+    rc->has_last = true;
+}
+
+bool rbe_reconstruct_at(const rbe_reconstructor_t *rc, uint32_t t_ms, pm25_data_t *data,
+                        uint16_t bound[PM25_FIELD_COUNT]) {
+    if (rc == NULL || !rc->has_last) {
+        return false;
+    }
+
+    uint32_t age = t_ms - rc->last.timestamp_ms;
+    if (age > rc->config.heartbeat_ms + rc->config.max_sample_interval_ms) {
+        // The device would have sent a heartbeat by now: this stretch is missing, not flat
+        return false;
+    }
+
+    if (data != NULL) {
+        *data = rc->last.data;
+    }
+    if (bound != NULL) {
+        for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+            // The sample at the report time is exact; held values are within the deadband
+            bound[f] = (age == 0) ? 0
+                : rbe_deadband(&rc->config, (pm25_field_t)f, pm25_data_get(&rc->last.data, (pm25_field_t)f));
+        }
+    }
+    return true;
+}
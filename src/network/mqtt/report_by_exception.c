@@ -0,0 +1,132 @@
+/**
+ * File: report_by_exception.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for report-by-exception publishing: shared semantics and the device-side filter.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "report_by_exception.h"
+
+#include <stddef.h>
+#include <string.h>
+
+void rbe_default_config(rbe_config_t *config) {
+    if (config == NULL) {
+        return;
+    }
+    memset(config, 0, sizeof(*config));
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        config->abs_deadband[f] = (f >= PM25_FIELD_COUNT_0_3) ? RBE_DEFAULT_DEADBAND_COUNT : RBE_DEFAULT_DEADBAND_MASS;
+        config->pct_deadband_x10[f] = RBE_DEFAULT_DEADBAND_PCT_X10;
+    }
+    config->heartbeat_ms = RBE_DEFAULT_HEARTBEAT_MS;
+    config->max_sample_interval_ms = RBE_DEFAULT_MAX_SAMPLE_MS;
+    config->threshold_field = PM25_FIELD_PM2_5_ATM;
+    config->thresholds[0] = 35;
+    config->thresholds[1] = 55;
+    config->thresholds[2] = 150;
+    config->threshold_count = 3;
+    config->hysteresis = 3;
+}
+
+uint16_t rbe_deadband(const rbe_config_t *config, pm25_field_t field, uint16_t reported) {
+    uint32_t pct = ((uint32_t)reported * config->pct_deadband_x10[field]) / 1000u;
+    uint32_t band = (pct > config->abs_deadband[field]) ? pct : config->abs_deadband[field];
+    return (band > UINT16_MAX) ? UINT16_MAX : (uint16_t)band;
+}
+
+uint8_t rbe_level(const rbe_config_t *config, uint8_t current, uint16_t value) {
+    uint8_t level = current;
+    // Up: every threshold at or below the value
+    while (level < config->threshold_count && value >= config->thresholds[level]) {
+        level++;
+    }
+    // Down: only once clearly below the threshold of the current level
+    while (level > 0) {
+        uint16_t thr = config->thresholds[level - 1];
+        uint16_t release = (thr > config->hysteresis) ? (uint16_t)(thr - config->hysteresis) : 0;
+        if (value >= release) {
+            break;
+        }
+        level--;
+    }
+    return level;
+}
+
+void rbe_filter_init(rbe_filter_t *filter, const rbe_config_t *config) {
+    if (filter == NULL) {
+        return;
+    }
+    memset(filter, 0, sizeof(*filter));
+    if (config != NULL) {
+        filter->config = *config;
+    } else {
+        rbe_default_config(&filter->config);
+    }
+}
+
+void rbe_filter_set_config(rbe_filter_t *filter, const rbe_config_t *config) {
+    if (filter != NULL && config != NULL) {
+        filter->config = *config;
+    }
+}
+
+static bool outside_deadband(const rbe_config_t *config, const pm25_data_t *reported, const pm25_data_t *data) {
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        uint16_t last = pm25_data_get(reported, (pm25_field_t)f);
+        uint16_t value = pm25_data_get(data, (pm25_field_t)f);
+        uint16_t diff = (value > last) ? (uint16_t)(value - last) : (uint16_t)(last - value);
+        if (diff > rbe_deadband(config, (pm25_field_t)f, last)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool rbe_filter_check(rbe_filter_t *filter, const pm25_data_t *data, uint32_t now_ms, rbe_report_t *report) {
+    if (filter == NULL || data == NULL) {
+        return false;
+    }
+
+    const rbe_config_t *cfg = &filter->config;
+    uint8_t reasons = 0;
+    uint8_t level = rbe_level(cfg, filter->has_last ? filter->last.level : 0,
+                              pm25_data_get(data, cfg->threshold_field));
+
+    if (!filter->has_last) {
+        reasons |= RBE_REASON_FIRST;
+    } else {
+        if (level != filter->last.level) {
+            reasons |= RBE_REASON_THRESHOLD;
+        }
+        if (outside_deadband(cfg, &filter->last.data, data)) {
+            reasons |= RBE_REASON_DEADBAND;
+        }
+        if (now_ms - filter->last.timestamp_ms >= cfg->heartbeat_ms) {
+            reasons |= RBE_REASON_HEARTBEAT;
+        }
+    }
+
+    if (reasons == 0) {
+        filter->suppressed++;
+        return false;
+    }
+
+    filter->last.seq = filter->has_last ? filter->last.seq + 1 : 0;
+    filter->last.timestamp_ms = now_ms;
+    filter->last.reasons = reasons;
+    filter->last.level = level;
+    filter->last.data = *data;
+    filter->has_last = true;
+    filter->sent++;
+
+    if (report != NULL) {
+        *report = filter->last;
+    }
+    return true;
+}
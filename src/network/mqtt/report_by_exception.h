@@ -0,0 +1,135 @@
+/**
+ * File: report_by_exception.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for report-by-exception (RBE) publishing of PM2.5 samples. The device side decides which
+ * samples are published; the host side rebuilds the full series from the published reports. Both sides share the
+ * configuration and the semantics defined here:
+ *
+ *  - A sample is reported when any field differs from the last *reported* value by more than its deadband,
+ *    max(abs_deadband, pct_deadband_x10 * last / 1000), when heartbeat_ms has elapsed since the last report,
+ *    or when the threshold level of threshold_field changes (up at >= threshold, down below threshold - hysteresis).
+ *  - Between two reports every field of the true signal stayed within its deadband of the earlier report.
+ *  - A heartbeat goes out with the first sample at or after heartbeat_ms since the last report, so a node is never
+ *    silent longer than heartbeat_ms + max_sample_interval_ms; a longer silence means lost data, not a flat signal.
+ *  - Reports carry a sequence number incremented per report, so lost reports can be detected.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef NETWORK_MQTT_REPORT_BY_EXCEPTION_H
+#define NETWORK_MQTT_REPORT_BY_EXCEPTION_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pm2_5.h"
+
+#define RBE_MAX_THRESHOLDS              4
+#define RBE_DEFAULT_HEARTBEAT_MS        (15u * 60u * 1000u)
+#define RBE_DEFAULT_MAX_SAMPLE_MS       (2u * 60u * 1000u)      // Slowest adaptive sampling interval
+#define RBE_DEFAULT_DEADBAND_MASS       2       // Absolute deadband of the PM mass fields, ug/m3
+#define RBE_DEFAULT_DEADBAND_COUNT      30      // Absolute deadband of the particle counts, per 0.1 L
+#define RBE_DEFAULT_DEADBAND_PCT_X10    100     // Relative deadband, 10 % of the last report
+
+// Why a report was sent (bit mask)
+#define RBE_REASON_FIRST                0x01    // First sample after init
+#define RBE_REASON_DEADBAND             0x02    // A field left its deadband
+#define RBE_REASON_HEARTBEAT            0x04    // Maximum silence reached
+#define RBE_REASON_THRESHOLD            0x08    // Threshold level of threshold_field changed
+
+typedef struct {
+    uint16_t abs_deadband[PM25_FIELD_COUNT];        // Absolute deadband per field, in field units
+    uint16_t pct_deadband_x10[PM25_FIELD_COUNT];    // Relative deadband per field, in 0.1 % of the last report
+    uint32_t heartbeat_ms;                          // Report at the first sample this long after the last one
+    uint32_t max_sample_interval_ms;                // Longest gap between two samples on the device
+    pm25_field_t threshold_field;                   // Field watched for alert thresholds
+    uint16_t thresholds[RBE_MAX_THRESHOLDS];        // Ascending alert thresholds
+    uint8_t threshold_count;
+    uint16_t hysteresis;                            // Drop below threshold - hysteresis to go down a level
+} rbe_config_t;
+
+// One published sample
+typedef struct {
+    uint32_t seq;               // Report sequence number
+    uint32_t timestamp_ms;      // Sample time
+    uint8_t reasons;            // RBE_REASON_* mask
+    uint8_t level;              // Threshold level of threshold_field (0 = below all thresholds)
+    pm25_data_t data;
+} rbe_report_t;
+
+// Device-side filter state
+typedef struct {
+    rbe_config_t config;
+    rbe_report_t last;          // Last report sent
+    bool has_last;
+    uint32_t sent;              // Reports sent
+    uint32_t suppressed;        // Samples not reported
+} rbe_filter_t;
+
+// Host-side reconstruction state
+typedef struct {
+    rbe_config_t config;
+    rbe_report_t last;          // Last report received
+    bool has_last;
+    uint32_t lost;              // Reports missing according to sequence numbers
+} rbe_reconstructor_t;
+
+/**
+ * Default configuration: 2 µg/m³ / 30 particles or 10 %, 15 min heartbeat,
+ * alerts on PM2.5 (atm) at 35, 55 and 150 µg/m³ with 3 µg/m³ hysteresis.
+ */
+void rbe_default_config(rbe_config_t *config);
+
+/**
+ * Deadband of a field around a reported value (shared by filter and reconstruction).
+ */
+uint16_t rbe_deadband(const rbe_config_t *config, pm25_field_t field, uint16_t reported);
+
+/**
+ * Threshold level of a value, given the current level (applies hysteresis on the way down).
+ */
+uint8_t rbe_level(const rbe_config_t *config, uint8_t current, uint16_t value);
+
+// --- Device side ---
+
+/**
+ * Initialize a filter. If config is NULL, uses the default configuration.
+ */
+void rbe_filter_init(rbe_filter_t *filter, const rbe_config_t *config);
+
+/**
+ * Replace the configuration; the last report stays the reference for the deadbands and the heartbeat.
+ */
+void rbe_filter_set_config(rbe_filter_t *filter, const rbe_config_t *config);
+
+/**
+ * Decide whether a sample must be published.
+ * Returns true and fills report if it must; the filter then treats it as sent.
+ */
+bool rbe_filter_check(rbe_filter_t *filter, const pm25_data_t *data, uint32_t now_ms, rbe_report_t *report);
+
+// --- Host side ---
+
+/**
+ * Initialize a reconstructor with the configuration the device uses.
+ */
+void rbe_reconstruct_init(rbe_reconstructor_t *rc, const rbe_config_t *config);
+
+/**
+ * Feed the next received report (in sequence order).
+ */
+void rbe_reconstruct_push(rbe_reconstructor_t *rc, const rbe_report_t *report);
+
+/**
+ * Rebuild the value at time t_ms (at or after the last pushed report).
+ * Fills data with the held value and, if bound is not NULL, the per-field error bound.
+ * Returns false if t_ms is past heartbeat_ms + max_sample_interval_ms, i.e. data was lost and the value is unknown.
+ */
+bool rbe_reconstruct_at(const rbe_reconstructor_t *rc, uint32_t t_ms, pm25_data_t *data,
+                        uint16_t bound[PM25_FIELD_COUNT]);
+
+#endif // NETWORK_MQTT_REPORT_BY_EXCEPTION_H
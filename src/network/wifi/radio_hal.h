@@ -0,0 +1,36 @@
+/**
+ * @file radio_hal.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief Hardware Abstraction Layer of the radio power-save scheduler
+ * 
+ * The scheduler only needs to switch the Wi-Fi power-management mode and read a
+ * millisecond clock. The real backend drives the CYW43 chip; host tests use a
+ * fake radio with a simulated clock.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#ifndef RADIO_HAL_H
+#define RADIO_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    RADIO_PM_ACTIVE = 0,    // Receiver on: lowest latency, highest current
+    RADIO_PM_POWERSAVE      // Radio sleeps between beacons; the AP buffers our traffic
+} radio_pm_t;
+
+/**
+ * @brief Radio backend
+ */
+typedef struct {
+    bool (*set_pm)(radio_pm_t mode);
+    uint32_t (*now_ms)(void);
+} radio_hal_t;
+
+// Get the CYW43 backend
+const radio_hal_t *radio_get_cyw43_hal(void);
+
+#endif // RADIO_HAL_H
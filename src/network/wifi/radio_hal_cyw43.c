@@ -0,0 +1,37 @@
+/**
+ * @file radio_hal_cyw43.c
+ * @author trung.la
+ * @date October 19 2026
+ * @brief CYW43 implementation of the radio HAL using Pico SDK
+ * 
+ * Active mode disables power save entirely so a publish window drains at full
+ * speed; power-save mode uses the aggressive PM2 setting, in which the chip only
+ * wakes for beacons and the AP buffers downlink frames (PINGRESP, PUBACK).
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#include "radio_hal.h"
+#include "pico/cyw43_arch.h"
+#include "pico/time.h"
+
+static bool cyw43_set_pm(radio_pm_t mode) {
+    uint32_t pm = (mode == RADIO_PM_ACTIVE) ? CYW43_NO_POWERSAVE_MODE : CYW43_AGGRESSIVE_PM;
+    cyw43_arch_lwip_begin();
+    int err = cyw43_wifi_pm(&cyw43_state, pm);
+    cyw43_arch_lwip_end();
+    return err == 0;
+}
+
+static uint32_t cyw43_now_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+static const radio_hal_t cyw43_hal = {
+    .set_pm = cyw43_set_pm,
+    .now_ms = cyw43_now_ms
+};
+
+const radio_hal_t *radio_get_cyw43_hal(void) {
+    return &cyw43_hal;
+}
@@ -0,0 +1,183 @@
+/**
+ * File: radio_sched.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the radio power-save scheduler.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "radio_sched.h"
+
+#include <string.h>
+
+radio_sched_config_t radio_sched_default_config(void) {
+    radio_sched_config_t config = {
+        .interval_ms = RADIO_SCHED_DEFAULT_INTERVAL_MS,
+        .window_max_ms = RADIO_SCHED_DEFAULT_WINDOW_MAX_MS,
+        .linger_ms = RADIO_SCHED_DEFAULT_LINGER_MS,
+        .keep_alive_ms = RADIO_SCHED_DEFAULT_KEEP_ALIVE_MS
+    };
+    return config;
+}
+
+// Close the time segment of the current mode and switch
+static void set_mode(radio_sched_t *sched, bool active, uint32_t now) {
+    uint32_t elapsed = now - sched->mode_since_ms;
+    if (sched->window_open) {
+        sched->stats.active_ms += elapsed;
+    } else {
+        sched->stats.powersave_ms += elapsed;
+    }
+    sched->mode_since_ms = now;
+    sched->window_open = active;
+    if (!sched->hal->set_pm(active ? RADIO_PM_ACTIVE : RADIO_PM_POWERSAVE)) {
+        sched->stats.pm_errors++;
+    }
+}
+
+void radio_sched_init(radio_sched_t *sched, const radio_sched_config_t *config, const radio_hal_t *hal) {
+    if (sched == NULL || hal == NULL) {
+        return;
+    }
+    memset(sched, 0, sizeof(*sched));
+    sched->config = (config != NULL) ? *config : radio_sched_default_config();
+    sched->hal = hal;
+
+    uint32_t now = hal->now_ms();
+    sched->mode_since_ms = now;
+    sched->window_open = true;
+    sched->window_start_ms = now;
+    sched->last_busy_ms = now;
+    sched->next_window_ms = now + sched->config.interval_ms;
+    sched->stats.windows = 1;
+    if (!hal->set_pm(RADIO_PM_ACTIVE)) {
+        sched->stats.pm_errors++;
+    }
+}
+
+void radio_sched_set_config(radio_sched_t *sched, const radio_sched_config_t *config) {
+    if (sched == NULL || sched->hal == NULL || config == NULL) {
+        return;
+    }
+    uint32_t now = sched->hal->now_ms();
+    bool was_off = sched->config.interval_ms == 0;
+    sched->config = *config;
+    if (config->interval_ms == 0) {
+        if (!sched->window_open) {
+            set_mode(sched, true, now);
+        }
+        return;
+    }
+    if (was_off || (int32_t)(sched->next_window_ms - (now + config->interval_ms)) > 0) {
+        sched->next_window_ms = now + config->interval_ms;
+    }
+    if (was_off && sched->window_open) {
+        // Close through the normal linger / maximum length rules, counted from now
+        sched->window_start_ms = now;
+        sched->last_busy_ms = now;
+    }
+}
+
+bool radio_sched_poll(radio_sched_t *sched, bool pending, bool urgent) {
+    if (sched == NULL || sched->hal == NULL) {
+        return true;
+    }
+    if (sched->config.interval_ms == 0) {
+        return true;
+    }
+    uint32_t now = sched->hal->now_ms();
+
+    if (!sched->window_open) {
+        bool regular = (int32_t)(now - sched->next_window_ms) >= 0;
+        if (!regular && !urgent) {
+            return false;
+        }
+        sched->stats.windows++;
+        if (regular) {
+            // Keep the cadence fixed; skip slots missed while the caller was busy
+            while ((int32_t)(now - sched->next_window_ms) >= 0) {
+                sched->next_window_ms += sched->config.interval_ms;
+            }
+        } else {
+            sched->stats.urgent_windows++;
+        }
+        sched->window_start_ms = now;
+        sched->last_busy_ms = now;
+        sched->ping_outstanding = false;
+        set_mode(sched, true, now);
+        return true;
+    }
+
+    if (pending) {
+        sched->last_busy_ms = now;
+    }
+    bool drained = !pending && now - sched->last_busy_ms >= sched->config.linger_ms;
+    bool expired = now - sched->window_start_ms >= sched->config.window_max_ms;
+    if (drained || expired) {
+        if (!drained) {
+            sched->stats.expired_windows++;
+        }
+        set_mode(sched, false, now);
+        return false;
+    }
+    return true;
+}
+
+bool radio_sched_ping_due(radio_sched_t *sched, uint32_t last_tx_ms, uint32_t last_rx_ms) {
+    if (sched == NULL || sched->hal == NULL || !sched->window_open) {
+        return false;
+    }
+    if (sched->ping_outstanding && last_rx_ms == sched->ping_rx_ms) {
+        return false;
+    }
+    sched->ping_outstanding = false;
+
+    uint32_t now = sched->hal->now_ms();
+    uint32_t idle_tx = now - last_tx_ms;
+    uint32_t idle_rx = now - last_rx_ms;
+    uint32_t idle = (idle_tx > idle_rx) ? idle_tx : idle_rx;
+    // Nothing can be sent before the next window; it may also run until its end
+    uint32_t wait = 0;
+    if (sched->config.interval_ms != 0) {
+        int32_t until_next = (int32_t)(sched->next_window_ms - now);
+        wait = ((until_next > 0) ? (uint32_t)until_next : 0) + sched->config.window_max_ms;
+    }
+    if (idle + wait < sched->config.keep_alive_ms) {
+        return false;
+    }
+    sched->ping_outstanding = true;
+    sched->ping_rx_ms = last_rx_ms;
+    sched->stats.keepalive_pings++;
+    return true;
+}
+
+bool radio_sched_next_window(const radio_sched_t *sched, uint32_t *at_ms) {
+    if (sched == NULL || sched->hal == NULL || sched->config.interval_ms == 0 || sched->window_open) {
+        return false;
+    }
+    if (at_ms != NULL) {
+        *at_ms = sched->next_window_ms;
+    }
+    return true;
+}
+
+void radio_sched_get_stats(const radio_sched_t *sched, radio_sched_stats_t *stats) {
+    if (sched == NULL || stats == NULL) {
+        return;
+    }
+    *stats = sched->stats;
+    if (sched->hal != NULL) {
+        uint32_t elapsed = sched->hal->now_ms() - sched->mode_since_ms;
+        if (sched->window_open) {
+            stats->active_ms += elapsed;
+        } else {
+            stats->powersave_ms += elapsed;
+        }
+    }
+    uint64_t total = stats->active_ms + stats->powersave_ms;
+    stats->duty_permille = (total > 0) ? (uint16_t)((stats->active_ms * 1000u + total / 2) / total) : 1000;
+}
@@ -0,0 +1,105 @@
+/**
+ * File: radio_sched.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the radio power-save scheduler. Outbound MQTT traffic is batched into publish
+ * windows: between windows the Wi-Fi radio stays in power-save mode and messages wait in the outbound queue; at a
+ * window the radio switches to active mode, the queue is flushed and, if the next window would come too late for
+ * the MQTT keep-alive, a PINGREQ is sent in the same wake-up. Alerts open a window at once.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef NETWORK_RADIO_SCHED_H
+#define NETWORK_RADIO_SCHED_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "radio_hal.h"
+
+#define RADIO_SCHED_DEFAULT_INTERVAL_MS     30000   // Start of one publish window to the next
+#define RADIO_SCHED_DEFAULT_WINDOW_MAX_MS   5000    // Longest a window stays open
+#define RADIO_SCHED_DEFAULT_LINGER_MS       500     // Stay active after the last traffic (acks, PINGRESP)
+#define RADIO_SCHED_DEFAULT_KEEP_ALIVE_MS   120000
+
+typedef struct {
+    uint32_t interval_ms;       // 0: no windows, radio always active
+    uint32_t window_max_ms;
+    uint32_t linger_ms;
+    uint32_t keep_alive_ms;     // MQTT keep-alive the pings have to satisfy
+} radio_sched_config_t;
+
+typedef struct {
+    uint32_t windows;           // Wake-ups (regular and urgent)
+    uint32_t urgent_windows;    // Opened early for an alert
+    uint32_t expired_windows;   // Closed by window_max_ms with traffic still pending
+    uint32_t keepalive_pings;
+    uint32_t pm_errors;         // Mode switches the backend refused
+    uint64_t active_ms;
+    uint64_t powersave_ms;
+    uint16_t duty_permille;     // Share of time in active mode
+} radio_sched_stats_t;
+
+typedef struct {
+    radio_sched_config_t config;
+    const radio_hal_t *hal;
+    bool window_open;
+    uint32_t window_start_ms;
+    uint32_t next_window_ms;    // Next regular window
+    uint32_t last_busy_ms;      // Last poll with traffic pending
+    uint32_t mode_since_ms;     // Start of the current radio mode, for the duty cycle
+    bool ping_outstanding;
+    uint32_t ping_rx_ms;        // Receive time seen when the ping was sent
+    radio_sched_stats_t stats;
+} radio_sched_t;
+
+/**
+ * Default configuration.
+ */
+radio_sched_config_t radio_sched_default_config(void);
+
+/**
+ * Initialize the scheduler. The radio starts active with a window open, so the first connection is made at once.
+ * @param config Configuration, or NULL for the defaults
+ */
+void radio_sched_init(radio_sched_t *sched, const radio_sched_config_t *config, const radio_hal_t *hal);
+
+/**
+ * Change the configuration at run time. Statistics and the open window are kept; a shorter period brings the next
+ * window forward, and turning windows off switches the radio to active at once.
+ */
+void radio_sched_set_config(radio_sched_t *sched, const radio_sched_config_t *config);
+
+/**
+ * Open or close the publish window and switch the radio mode accordingly.
+ * @param pending Traffic waiting: queued or unacknowledged messages, connection or subscription in progress
+ * @param urgent An alert is queued
+ * @return True if network I/O may happen now (window open)
+ */
+bool radio_sched_poll(radio_sched_t *sched, bool pending, bool urgent);
+
+/**
+ * Whether a PINGREQ must be sent in this window to keep the MQTT connection alive until the next one.
+ * Returns true at most once per ping; the next ping can only become due after a packet was received.
+ * @param last_tx_ms Time the last packet was sent
+ * @param last_rx_ms Time the last packet was received
+ */
+bool radio_sched_ping_due(radio_sched_t *sched, uint32_t last_tx_ms, uint32_t last_rx_ms);
+
+/**
+ * Start of the next regular window while the window is closed. Returns false while a window is open or windows are
+ * off: the caller keeps polling at its service period. Between windows it can sleep until at_ms, unless it queues
+ * an alert.
+ */
+bool radio_sched_next_window(const radio_sched_t *sched, uint32_t *at_ms);
+
+/**
+ * Statistics including the time spent in the current mode.
+ */
+void radio_sched_get_stats(const radio_sched_t *sched, radio_sched_stats_t *stats);
+
+#endif // NETWORK_RADIO_SCHED_H
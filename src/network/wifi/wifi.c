@@ -12,9 +12,62 @@
 
 #include "wifi.h"
 
+#include <stdio.h>
+
+#include "pico/cyw43_arch.h"
+#include "wifi_config.h"
+
+static bool powered = false;
+static bool join_started = false;
+
 bool init_wifi() {
-    // TODO: Implement Wi-Fi initialization logic
-    return false;
+    if (powered) {
+        return true;
+    }
+    if (cyw43_arch_init_with_country(WIFI_COUNTRY) != 0) {
+        return false;
+    }
+    cyw43_arch_enable_sta_mode();
+    powered = true;
+    return true;
+}
+
+bool wifi_connect_start() {
+    if (!powered || sizeof(WIFI_SSID) <= 1) {
+        return false;
+    }
+    if (join_started) {
+        // Retry: drop whatever is left of the previous attempt first
+        cyw43_arch_lwip_begin();
+        cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA);
+        cyw43_arch_lwip_end();
+    }
+    // The scan, join and DHCP run from the CYW43 and lwIP interrupts
+    join_started = cyw43_arch_wifi_connect_async(WIFI_SSID, WIFI_PASSWORD, WIFI_AUTH) == 0;
+    return join_started;
+}
+
+wifi_state_t wifi_get_state() {
+    if (!powered) {
+        return WIFI_STATE_OFF;
+    }
+    if (!join_started) {
+        return WIFI_STATE_IDLE;
+    }
+    cyw43_arch_lwip_begin();
+    int status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+    cyw43_arch_lwip_end();
+    switch (status) {
+        case CYW43_LINK_UP:
+            return WIFI_STATE_UP;
+        case CYW43_LINK_NOIP:
+            return WIFI_STATE_NO_IP;
+        case CYW43_LINK_JOIN:
+        case CYW43_LINK_DOWN:
+            return WIFI_STATE_JOINING;
+        default:
+            return WIFI_STATE_FAILED;
+    }
 }
 
 int start_wifi_scan() {
@@ -23,5 +76,6 @@ int start_wifi_scan() {
 }
 
 void wifi_status() {
-    // TODO: Implement Wi-Fi status reporting
+    static const char *const names[] = { "off", "idle", "joining", "no IP", "up", "failed" };
+    printf("Wi-Fi: %s\n", names[wifi_get_state()]);
 }
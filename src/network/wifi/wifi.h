@@ -16,11 +16,33 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+typedef enum {
+    WIFI_STATE_OFF = 0,         // Radio not powered up
+    WIFI_STATE_IDLE,            // Powered up, no join started
+    WIFI_STATE_JOINING,         // Scan, association and key exchange
+    WIFI_STATE_NO_IP,           // Associated, waiting for the DHCP lease
+    WIFI_STATE_UP,              // Associated with an address
+    WIFI_STATE_FAILED           // Network not found, bad credentials or other join error
+} wifi_state_t;
+
 /**
- * Initialize the Wi-Fi module.
+ * Initialize the Wi-Fi module: power up the radio and lwIP in station mode.
+ * Blocks while the chip firmware is loaded, but does not join a network.
  */
 bool init_wifi();
 
+/**
+ * Start joining WIFI_SSID. Returns at once; association and DHCP run in the
+ * background and are followed with wifi_get_state(). Called again, it leaves
+ * the network and starts over.
+ */
+bool wifi_connect_start();
+
+/**
+ * Current state of the station interface.
+ */
+wifi_state_t wifi_get_state();
+
 /**
  * Start scanning for available Wi-Fi networks.
  * Scan as periodic of 10 seconds.
@@ -0,0 +1,148 @@
+/**
+ * File: adaptive_rate.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the variability-adaptive sampling rate controller (integer-only).
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "adaptive_rate.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define Q8_SHIFT    8
+
+void adaptive_rate_default_config(adaptive_rate_config_t *config) {
+    if (config == NULL) {
+        return;
+    }
+    memset(config, 0, sizeof(*config));
+    config->min_interval_ms = ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS;
+    config->max_interval_ms = ADAPTIVE_RATE_DEFAULT_MAX_INTERVAL_MS;
+    config->stable_samples = ADAPTIVE_RATE_DEFAULT_STABLE_SAMPLES;
+    config->field_mask = PM25_FIELD_BIT(PM25_FIELD_PM2_5_ATM) | PM25_FIELD_BIT(PM25_FIELD_COUNT_0_3);
+    config->alpha_shift = ADAPTIVE_RATE_DEFAULT_ALPHA_SHIFT;
+    config->k_x10 = ADAPTIVE_RATE_DEFAULT_K_X10;
+    config->h_x10 = ADAPTIVE_RATE_DEFAULT_H_X10;
+    // Concentrations are a few µg/m³ noisy, counts a few tens of particles per 0.1 L
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        config->min_deviation[f] = (f >= PM25_FIELD_COUNT_0_3) ? 20 : 2;
+    }
+}
+
+void adaptive_rate_init(adaptive_rate_t *ar, const adaptive_rate_config_t *config) {
+    if (ar == NULL) {
+        return;
+    }
+    memset(ar, 0, sizeof(*ar));
+    if (config != NULL) {
+        ar->config = *config;
+    } else {
+        adaptive_rate_default_config(&ar->config);
+    }
+    if (ar->config.max_interval_ms < ar->config.min_interval_ms) {
+        ar->config.max_interval_ms = ar->config.min_interval_ms;
+    }
+    ar->interval_ms = ar->config.min_interval_ms;
+}
+
+// Returns true if the CUSUM of this channel crossed its decision threshold
+static bool channel_update(adaptive_rate_channel_t *ch, const adaptive_rate_config_t *cfg,
+                           uint16_t min_deviation, uint16_t value) {
+    int32_t x = (int32_t)value << Q8_SHIFT;
+    int32_t floor = (int32_t)min_deviation << Q8_SHIFT;
+
+    if (!ch->primed) {
+        ch->mean = x;
+        ch->deviation = floor;
+        ch->cusum_hi = 0;
+        ch->cusum_lo = 0;
+        ch->primed = true;
+        return false;
+    }
+
+    int32_t e = x - ch->mean;
+    int32_t sigma = (ch->deviation > floor) ? ch->deviation : floor;
+    int32_t k = (sigma / 10) * cfg->k_x10;
+    int32_t h = (sigma / 10) * cfg->h_x10;
+
+    ch->cusum_hi += e - k;
+    if (ch->cusum_hi < 0) {
+        ch->cusum_hi = 0;
+    }
+    ch->cusum_lo += -e - k;
+    if (ch->cusum_lo < 0) {
+        ch->cusum_lo = 0;
+    }
+
+    if (ch->cusum_hi > h || ch->cusum_lo > h) {
+        // Re-centre on the new level so the next samples are judged against it
+        ch->mean = x;
+        ch->cusum_hi = 0;
+        ch->cusum_lo = 0;
+        return true;
+    }
+
+    int32_t abs_e = (e < 0) ? -e : e;
+    ch->mean += e >> cfg->alpha_shift;
+    ch->deviation += (abs_e - ch->deviation) >> cfg->alpha_shift;
+    return false;
+}
+
+uint32_t adaptive_rate_update(adaptive_rate_t *ar, const pm25_data_t *data) {
+    if (ar == NULL) {
+        return ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS;
+    }
+    if (data == NULL) {
+        return ar->interval_ms;
+    }
+
+    const adaptive_rate_config_t *cfg = &ar->config;
+    bool changed = false;
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        if ((cfg->field_mask & PM25_FIELD_BIT(f)) == 0) {
+            continue;
+        }
+        // Update every channel even after a hit, so none of them goes stale
+        if (channel_update(&ar->channels[f], cfg, cfg->min_deviation[f], pm25_data_get(data, (pm25_field_t)f))) {
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        ar->changes++;
+        ar->stable_run = 0;
+        ar->interval_ms = cfg->min_interval_ms;
+    } else if (++ar->stable_run >= cfg->stable_samples) {
+        ar->stable_run = 0;
+        ar->interval_ms = (ar->interval_ms > cfg->max_interval_ms / 2) ? cfg->max_interval_ms : ar->interval_ms * 2;
+    }
+    return ar->interval_ms;
+}
+
+void adaptive_rate_set_limits(adaptive_rate_t *ar, uint32_t min_interval_ms, uint32_t max_interval_ms) {
+    if (ar == NULL || min_interval_ms == 0) {
+        return;
+    }
+    ar->config.min_interval_ms = min_interval_ms;
+    ar->config.max_interval_ms = (max_interval_ms < min_interval_ms) ? min_interval_ms : max_interval_ms;
+    if (ar->interval_ms < ar->config.min_interval_ms) {
+        ar->interval_ms = ar->config.min_interval_ms;
+    } else if (ar->interval_ms > ar->config.max_interval_ms) {
+        ar->interval_ms = ar->config.max_interval_ms;
+    }
+}
+
+uint32_t adaptive_rate_interval_ms(const adaptive_rate_t *ar) {
+    return (ar != NULL) ? ar->interval_ms : ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS;
+}
+
+bool adaptive_rate_sensor_can_sleep(const adaptive_rate_t *ar, uint32_t wake_time_ms) {
+    // Only worth it if the sensor sleeps at least as long as it needs to warm up
+    return ar != NULL && ar->interval_ms >= 2 * wake_time_ms;
+}
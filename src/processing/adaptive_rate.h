@@ -0,0 +1,90 @@
+/**
+ * File: adaptive_rate.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the variability-adaptive sampling rate controller. Monitored pm25_data_t fields are
+ * tracked with an EWMA mean / mean-absolute-deviation and a two-sided CUSUM. While readings are stable the sampling
+ * interval is doubled step by step up to a ceiling; a detected change snaps it back to the floor on the same frame.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef PROCESSING_ADAPTIVE_RATE_H
+#define PROCESSING_ADAPTIVE_RATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pm2_5.h"
+
+#define ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS   1000u       // Full rate: 1 Hz
+#define ADAPTIVE_RATE_DEFAULT_MAX_INTERVAL_MS   120000u     // Slowest: one sample per 2 minutes
+#define ADAPTIVE_RATE_DEFAULT_STABLE_SAMPLES    10          // Stable samples before each stretch
+#define ADAPTIVE_RATE_DEFAULT_ALPHA_SHIFT       3           // EWMA alpha = 1/8
+#define ADAPTIVE_RATE_DEFAULT_K_X10             5           // CUSUM slack: 0.5 x deviation
+#define ADAPTIVE_RATE_DEFAULT_H_X10             40          // CUSUM decision threshold: 4 x deviation
+
+typedef struct {
+    uint32_t min_interval_ms;                   // Floor of the interval (highest sampling rate)
+    uint32_t max_interval_ms;                   // Ceiling of the interval (lowest sampling rate)
+    uint16_t stable_samples;                    // Consecutive stable samples before doubling the interval
+    uint16_t field_mask;                        // PM25_FIELD_BIT() of monitored fields
+    uint8_t alpha_shift;                        // EWMA smoothing, alpha = 1 / 2^alpha_shift
+    uint8_t k_x10;                              // CUSUM slack in tenths of the deviation estimate
+    uint8_t h_x10;                              // CUSUM threshold in tenths of the deviation estimate
+    uint16_t min_deviation[PM25_FIELD_COUNT];   // Deviation floor per field, in field units
+} adaptive_rate_config_t;
+
+// Change-detection state of one monitored field, values in Q8
+typedef struct {
+    int32_t mean;
+    int32_t deviation;
+    int32_t cusum_hi;
+    int32_t cusum_lo;
+    bool primed;
+} adaptive_rate_channel_t;
+
+typedef struct {
+    adaptive_rate_config_t config;
+    adaptive_rate_channel_t channels[PM25_FIELD_COUNT];
+    uint32_t interval_ms;       // Current sampling interval
+    uint16_t stable_run;        // Stable samples since the last stretch or change
+    uint32_t changes;           // Detected changes since init
+} adaptive_rate_t;
+
+/**
+ * Default configuration: PM2.5 (atm) and >0.3 µm count monitored, 1 s .. 2 min.
+ */
+void adaptive_rate_default_config(adaptive_rate_config_t *config);
+
+/**
+ * Initialize the controller at full rate. If config is NULL, uses the default configuration.
+ */
+void adaptive_rate_init(adaptive_rate_t *ar, const adaptive_rate_config_t *config);
+
+/**
+ * Feed one sample and return the interval until the next one, in ms.
+ * A change on any monitored field returns min_interval_ms immediately.
+ */
+uint32_t adaptive_rate_update(adaptive_rate_t *ar, const pm25_data_t *data);
+
+/**
+ * Change the interval range without losing the change-detection state; the current interval is clamped into it.
+ */
+void adaptive_rate_set_limits(adaptive_rate_t *ar, uint32_t min_interval_ms, uint32_t max_interval_ms);
+
+/**
+ * Current sampling interval in ms.
+ */
+uint32_t adaptive_rate_interval_ms(const adaptive_rate_t *ar);
+
+/**
+ * True if the interval is long enough to put the sensor to sleep and still have
+ * `wake_time_ms` of warm-up before the next sample.
+ */
+bool adaptive_rate_sensor_can_sleep(const adaptive_rate_t *ar, uint32_t wake_time_ms);
+
+#endif // PROCESSING_ADAPTIVE_RATE_H
@@ -0,0 +1,205 @@
+/**
+ * File: aqi.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the US-EPA AQI and NowCast engine (integer-only).
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "aqi.h"
+
+#include <stddef.h>
+#include <string.h>
+
+// One segment of the piecewise-linear AQI function
+typedef struct {
+    uint16_t c_lo;      // Concentration breakpoints, in table units
+    uint16_t c_hi;
+    uint16_t i_lo;      // Index breakpoints
+    uint16_t i_hi;
+} aqi_breakpoint_t;
+
+// PM2.5 24-hour breakpoints (EPA, 2024 revision), concentrations in 0.1 µg/m³
+static const aqi_breakpoint_t AQI_PM25_TABLE[] = {
+    {    0,   90,   0,  50 },
+    {   91,  354,  51, 100 },
+    {  355,  554, 101, 150 },
+    {  555, 1254, 151, 200 },
+    { 1255, 2254, 201, 300 },
+    { 2255, 3254, 301, 500 },
+};
+
+// PM10 24-hour breakpoints (EPA), concentrations in 1 µg/m³
+static const aqi_breakpoint_t AQI_PM10_TABLE[] = {
+    {   0,  54,   0,  50 },
+    {  55, 154,  51, 100 },
+    { 155, 254, 101, 150 },
+    { 255, 354, 151, 200 },
+    { 355, 424, 201, 300 },
+    { 425, 604, 301, 500 },
+};
+
+#define TABLE_LEN(t)            (sizeof(t) / sizeof((t)[0]))
+
+// NowCast weight factor floor for particulate matter (0.5 in Q16)
+#define NOWCAST_MIN_WEIGHT_Q16  32768u
+#define Q16_ONE                 65536u
+
+static uint16_t aqi_from_table(const aqi_breakpoint_t *table, size_t len, int32_t c) {
+    if (c <= 0) {
+        return 0;
+    }
+    for (size_t i = 0; i < len; i++) {
+        const aqi_breakpoint_t *bp = &table[i];
+        if (c <= bp->c_hi) {
+            uint32_t span_i = bp->i_hi - bp->i_lo;
+            uint32_t span_c = bp->c_hi - bp->c_lo;
+            // Rounded linear interpolation: (2 * a * b + d) / (2 * d)
+            uint32_t num = 2u * span_i * (uint32_t)(c - bp->c_lo) + span_c;
+            return (uint16_t)(bp->i_lo + num / (2u * span_c));
+        }
+    }
+    return AQI_MAX;
+}
+
+uint16_t aqi_from_pm25(fx_centi_t concentration) {
+    return aqi_from_table(AQI_PM25_TABLE, TABLE_LEN(AQI_PM25_TABLE), concentration / 10);
+}
+
+uint16_t aqi_from_pm10(fx_centi_t concentration) {
+    return aqi_from_table(AQI_PM10_TABLE, TABLE_LEN(AQI_PM10_TABLE), concentration / FX_CENTI_SCALE);
+}
+
+void aqi_nowcast_init(aqi_nowcast_t *nc) {
+    if (nc == NULL) {
+        return;
+    }
+    memset(nc, 0, sizeof(*nc));
+    nc->newest = AQI_NOWCAST_HOURS - 1;
+}
+
+// Hourly average of the bucket `age` hours before the newest completed one, -1 if missing
+static int32_t hour_average(const aqi_nowcast_t *nc, uint8_t age) {
+    if (age >= nc->filled) {
+        return -1;
+    }
+    const aqi_hour_bucket_t *b = &nc->hours[(nc->newest + AQI_NOWCAST_HOURS - age) % AQI_NOWCAST_HOURS];
+    if (b->count == 0) {
+        return -1;
+    }
+    return (b->sum_centi + b->count / 2) / b->count;
+}
+
+// Runs once per closed hour over a fixed 12-entry window
+static void nowcast_recompute(aqi_nowcast_t *nc) {
+    int32_t avg[AQI_NOWCAST_HOURS];
+    int32_t c_min = INT32_MAX;
+    int32_t c_max = 0;
+    uint8_t recent_valid = 0;
+
+    for (uint8_t age = 0; age < AQI_NOWCAST_HOURS; age++) {
+        avg[age] = hour_average(nc, age);
+        if (avg[age] < 0) {
+            continue;
+        }
+        if (age < 3) {
+            recent_valid++;
+        }
+        if (avg[age] < c_min) {
+            c_min = avg[age];
+        }
+        if (avg[age] > c_max) {
+            c_max = avg[age];
+        }
+    }
+
+    // EPA data requirement: 2 of the 3 most recent hours
+    nc->nowcast_valid = (recent_valid >= 2);
+    if (!nc->nowcast_valid) {
+        return;
+    }
+
+    uint32_t w = Q16_ONE;
+    if (c_max > 0) {
+        w = (uint32_t)(((uint64_t)c_min << 16) / (uint32_t)c_max);
+        if (w < NOWCAST_MIN_WEIGHT_Q16) {
+            w = NOWCAST_MIN_WEIGHT_Q16;
+        }
+    }
+
+    uint64_t num = 0;
+    uint64_t den = 0;
+    uint32_t weight = Q16_ONE;
+    for (uint8_t age = 0; age < AQI_NOWCAST_HOURS; age++) {
+        if (avg[age] >= 0) {
+            num += (uint64_t)weight * (uint32_t)avg[age];
+            den += weight;
+        }
+        weight = (uint32_t)(((uint64_t)weight * w) >> 16);
+    }
+    nc->nowcast = (fx_centi_t)((num + den / 2) / den);
+}
+
+static void push_hour(aqi_nowcast_t *nc, const aqi_hour_bucket_t *bucket) {
+    nc->newest = (uint8_t)((nc->newest + 1) % AQI_NOWCAST_HOURS);
+    nc->hours[nc->newest] = *bucket;
+    if (nc->filled < AQI_NOWCAST_HOURS) {
+        nc->filled++;
+    }
+}
+
+void aqi_nowcast_add(aqi_nowcast_t *nc, uint32_t timestamp_s, fx_centi_t concentration) {
+    if (nc == NULL) {
+        return;
+    }
+
+    uint32_t hour = timestamp_s / AQI_SECONDS_PER_HOUR;
+    if (!nc->started) {
+        nc->started = true;
+        nc->current_hour = hour;
+    } else if (hour > nc->current_hour) {
+        // Close the current hour, then record hours without samples as gaps
+        const aqi_hour_bucket_t empty = { 0, 0 };
+        uint32_t gap = hour - nc->current_hour - 1;
+        push_hour(nc, &nc->current);
+        if (gap > AQI_NOWCAST_HOURS) {
+            gap = AQI_NOWCAST_HOURS;
+        }
+        while (gap-- > 0) {
+            push_hour(nc, &empty);
+        }
+        nc->current = empty;
+        nc->current_hour = hour;
+        nowcast_recompute(nc);
+    }
+    // A timestamp from an earlier hour (clock step back) is folded into the current hour
+
+    if (concentration < 0) {
+        concentration = 0;
+    }
+    nc->current.sum_centi += concentration;
+    nc->current.count++;
+}
+
+bool aqi_nowcast_get(const aqi_nowcast_t *nc, fx_centi_t *concentration) {
+    if (nc == NULL || !nc->nowcast_valid) {
+        return false;
+    }
+    if (concentration != NULL) {
+        *concentration = nc->nowcast;
+    }
+    return true;
+}
+
+void aqi_report_pm25(const aqi_nowcast_t *nc, uint16_t pm2_5_atm, aqi_report_t *report) {
+    if (report == NULL) {
+        return;
+    }
+    report->aqi = aqi_from_pm25(FX_FROM_INT(pm2_5_atm));
+    report->nowcast_valid = aqi_nowcast_get(nc, &report->nowcast);
+    report->nowcast_aqi = report->nowcast_valid ? aqi_from_pm25(report->nowcast) : 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * File: aqi.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the US-EPA Air Quality Index engine: piecewise-linear AQI from a constant breakpoint
+ * table and the 12-hour PM NowCast, maintained incrementally from hourly buckets. All math is integer-only.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef PROCESSING_AQI_H
+#define PROCESSING_AQI_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "fixed_point.h"
+
+#define AQI_MAX                 500     // Index is capped at the top of the scale
+#define AQI_NOWCAST_HOURS       12      // NowCast window
+#define AQI_SECONDS_PER_HOUR    3600u
+
+// Sum and count of the samples that fell into one clock hour
+typedef struct {
+    int32_t sum_centi;      // Sum of concentrations in centi-µg/m³
+    uint16_t count;         // Number of samples, 0 if the hour has no data
+} aqi_hour_bucket_t;
+
+// Incremental NowCast state for one pollutant
+typedef struct {
+    aqi_hour_bucket_t hours[AQI_NOWCAST_HOURS]; // Completed hours, ring buffer
+    uint8_t newest;                             // Index of the most recent completed hour
+    uint8_t filled;                             // Number of completed hours in the ring
+    aqi_hour_bucket_t current;                  // Hour being accumulated
+    uint32_t current_hour;                      // Hour number (timestamp / 3600) of current
+    bool started;                               // At least one sample has been added
+    fx_centi_t nowcast;                         // Cached NowCast concentration, centi-µg/m³
+    bool nowcast_valid;                         // Cached value meets the data requirements
+} aqi_nowcast_t;
+
+// AQI values for consumers (display, publish path)
+typedef struct {
+    uint16_t aqi;               // Instantaneous AQI of the latest PM2.5 sample
+    uint16_t nowcast_aqi;       // AQI of the PM2.5 NowCast (valid if nowcast_valid)
+    fx_centi_t nowcast;         // PM2.5 NowCast concentration in centi-µg/m³
+    bool nowcast_valid;
+} aqi_report_t;
+
+/**
+ * AQI for a PM2.5 concentration (centi-µg/m³, truncated to 0.1 µg/m³ as per EPA rules).
+ */
+uint16_t aqi_from_pm25(fx_centi_t concentration);
+
+/**
+ * AQI for a PM10 concentration (centi-µg/m³, truncated to 1 µg/m³ as per EPA rules).
+ */
+uint16_t aqi_from_pm10(fx_centi_t concentration);
+
+/**
+ * Reset a NowCast accumulator.
+ */
+void aqi_nowcast_init(aqi_nowcast_t *nc);
+
+/**
+ * Add one sample. O(1): the sample only updates the current hourly bucket; the NowCast
+ * is recomputed over the 12 buckets once per hour when the bucket is closed.
+ */
+void aqi_nowcast_add(aqi_nowcast_t *nc, uint32_t timestamp_s, fx_centi_t concentration);
+
+/**
+ * Get the NowCast concentration of the completed hours.
+ * Returns false if 2 of the 3 most recent hours have no data.
+ */
+bool aqi_nowcast_get(const aqi_nowcast_t *nc, fx_centi_t *concentration);
+
+/**
+ * Fill a report from a PM2.5 sample and its NowCast accumulator.
+ */
+void aqi_report_pm25(const aqi_nowcast_t *nc, uint16_t pm2_5_atm, aqi_report_t *report);
+
+#endif // PROCESSING_AQI_H
@@ -0,0 +1,157 @@
+/**
+ * File: running_median.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the double-heap sliding-window running median.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "running_median.h"
+
+#include <stddef.h>
+#include <string.h>
+
+// Heap positions run from -(window / 2) to (window - 1) / 2; shift them into the array
+#define HEAP(rm, i)         ((rm)->heap[(i) + RUNNING_MEDIAN_MAX_WINDOW / 2])
+#define MIN_COUNT(rm)       (((rm)->count - 1) / 2)    // Samples in the min-heap (above median)
+#define MAX_COUNT(rm)       ((rm)->count / 2)          // Samples in the max-heap (below median)
+
+static bool heap_less(const running_median_t *rm, int i, int j) {
+    return rm->data[HEAP(rm, i)] < rm->data[HEAP(rm, j)];
+}
+
+static void heap_swap(running_median_t *rm, int i, int j) {
+    int8_t t = HEAP(rm, i);
+    HEAP(rm, i) = HEAP(rm, j);
+    HEAP(rm, j) = t;
+    rm->pos[HEAP(rm, i)] = (int8_t)i;
+    rm->pos[HEAP(rm, j)] = (int8_t)j;
+}
+
+// Swap i and j if heap[i] < heap[j]; returns whether they were swapped
+static bool heap_cmp_swap(running_median_t *rm, int i, int j) {
+    if (heap_less(rm, i, j)) {
+        heap_swap(rm, i, j);
+        return true;
+    }
+    return false;
+}
+
+// Restore the min-heap property from position i (whose parent is i / 2) downwards
+static void min_sort_down(running_median_t *rm, int i) {
+    for (; i <= MIN_COUNT(rm); i *= 2) {
+        if (i > 1 && i < MIN_COUNT(rm) && heap_less(rm, i + 1, i)) {
+            i++;
+        }
+        if (!heap_cmp_swap(rm, i, i / 2)) {
+            break;
+        }
+    }
+}
+
+// Restore the max-heap property from position i (negative, parent i / 2) downwards
+static void max_sort_down(running_median_t *rm, int i) {
+    for (; i >= -MAX_COUNT(rm); i *= 2) {
+        if (i < -1 && i > -MAX_COUNT(rm) && heap_less(rm, i, i - 1)) {
+            i--;
+        }
+        if (!heap_cmp_swap(rm, i / 2, i)) {
+            break;
+        }
+    }
+}
+
+// Returns true if the item bubbled up to the median slot
+static bool min_sort_up(running_median_t *rm, int i) {
+    while (i > 0 && heap_cmp_swap(rm, i, i / 2)) {
+        i /= 2;
+    }
+    return i == 0;
+}
+
+static bool max_sort_up(running_median_t *rm, int i) {
+    while (i < 0 && heap_cmp_swap(rm, i / 2, i)) {
+        i /= 2;
+    }
+    return i == 0;
+}
+
+void running_median_init(running_median_t *rm, uint8_t window) {
+    if (rm == NULL) {
+        return;
+    }
+    memset(rm, 0, sizeof(*rm));
+    if (window == 0) {
+        window = 1;
+    } else if (window > RUNNING_MEDIAN_MAX_WINDOW) {
+        window = RUNNING_MEDIAN_MAX_WINDOW;
+    }
+    rm->window = window;
+
+    // Initial fill pattern of heap slots: median, max, min, max, min, ...
+    for (int k = window - 1; k >= 0; k--) {
+        int p = ((k + 1) / 2) * ((k & 1) ? -1 : 1);
+        rm->pos[k] = (int8_t)p;
+        HEAP(rm, p) = (int8_t)k;
+    }
+}
+
+void running_median_insert(running_median_t *rm, uint16_t value) {
+    if (rm == NULL || rm->window == 0) {
+        return;
+    }
+
+    bool is_new = (rm->count < rm->window);
+    int p = rm->pos[rm->idx];
+    uint16_t old = rm->data[rm->idx];
+
+    rm->data[rm->idx] = value;
+    rm->idx = (uint8_t)((rm->idx + 1) % rm->window);
+    if (is_new) {
+        rm->count++;
+    }
+
+    if (p > 0) {
+        // Slot is in the min-heap
+        if (!is_new && old < value) {
+            min_sort_down(rm, p * 2);
+        } else if (min_sort_up(rm, p)) {
+            max_sort_down(rm, -1);
+        }
+    } else if (p < 0) {
+        // Slot is in the max-heap
+        if (!is_new && value < old) {
+            max_sort_down(rm, p * 2);
+        } else if (max_sort_up(rm, p)) {
+            min_sort_down(rm, 1);
+        }
+    } else {
+        // Slot is the median
+        if (MAX_COUNT(rm)) {
+            max_sort_down(rm, -1);
+        }
+        if (MIN_COUNT(rm)) {
+            min_sort_down(rm, 1);
+        }
+    }
+}
+
+uint16_t running_median_get(const running_median_t *rm) {
+    if (rm == NULL || rm->count == 0) {
+        return 0;
+    }
+    uint16_t v = rm->data[HEAP(rm, 0)];
+    if ((rm->count & 1) == 0) {
+        uint16_t below = rm->data[HEAP(rm, -1)];
+        v = (uint16_t)(((uint32_t)v + below) / 2);
+    }
+    return v;
+}
+
+bool running_median_full(const running_median_t *rm) {
+    return rm != NULL && rm->count >= rm->window;
+}
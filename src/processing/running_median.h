@@ -0,0 +1,52 @@
+/**
+ * File: running_median.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for a sliding-window running median over uint16_t samples. The window is kept in a
+ * double heap (max-heap below the median, min-heap above) indexed from a ring of samples, so replacing the oldest
+ * sample costs O(log w) and the median is read in O(1).
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef PROCESSING_RUNNING_MEDIAN_H
+#define PROCESSING_RUNNING_MEDIAN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define RUNNING_MEDIAN_MAX_WINDOW   15
+
+typedef struct {
+    uint16_t data[RUNNING_MEDIAN_MAX_WINDOW];   // Ring of samples, oldest at idx once full
+    int8_t pos[RUNNING_MEDIAN_MAX_WINDOW];      // Heap position of each sample (<0 max-heap, 0 median, >0 min-heap)
+    int8_t heap[RUNNING_MEDIAN_MAX_WINDOW];     // Sample index at each heap position, offset by MAX_WINDOW / 2
+    uint8_t window;                             // Window length
+    uint8_t idx;                                // Next ring slot to overwrite
+    uint8_t count;                              // Samples in the window
+} running_median_t;
+
+/**
+ * Initialize with a window of 1..RUNNING_MEDIAN_MAX_WINDOW samples (clamped).
+ */
+void running_median_init(running_median_t *rm, uint8_t window);
+
+/**
+ * Insert a sample, evicting the oldest one once the window is full.
+ */
+void running_median_insert(running_median_t *rm, uint16_t value);
+
+/**
+ * Median of the window (mean of the two middle samples for an even count), 0 if empty.
+ */
+uint16_t running_median_get(const running_median_t *rm);
+
+/**
+ * True once the window holds `window` samples.
+ */
+bool running_median_full(const running_median_t *rm);
+
+#endif // PROCESSING_RUNNING_MEDIAN_H
@@ -0,0 +1,117 @@
+/**
+ * File: sample_assembly.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for time-aligned joint sample assembly of PMS7003 and SHT3x readings.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "sample_assembly.h"
+
+#include <stddef.h>
+#include <string.h>
+
+void sample_assembly_default_config(sample_assembly_config_t *config) {
+    if (config == NULL) {
+        return;
+    }
+    config->align_window_us = SAMPLE_ASSEMBLY_DEFAULT_WINDOW_US;
+    config->max_interp_gap_us = SAMPLE_ASSEMBLY_DEFAULT_MAX_INTERP_GAP_US;
+}
+
+void sample_assembly_init(sample_assembly_t *sa, const sample_assembly_config_t *config) {
+    if (sa == NULL) {
+        return;
+    }
+    memset(sa, 0, sizeof(*sa));
+    if (config != NULL) {
+        sa->config = *config;
+    } else {
+        sample_assembly_default_config(&sa->config);
+    }
+}
+
+void sample_assembly_add_env(sample_assembly_t *sa, uint64_t timestamp_us, fx_centi_t temperature,
+                             fx_centi_t humidity) {
+    if (sa == NULL) {
+        return;
+    }
+    sample_env_t *env = &sa->env[sa->env_head];
+    env->timestamp_us = timestamp_us;
+    env->temperature = temperature;
+    env->humidity = humidity;
+    sa->env_head = (uint8_t)((sa->env_head + 1) % SAMPLE_ASSEMBLY_ENV_HISTORY);
+    if (sa->env_count < SAMPLE_ASSEMBLY_ENV_HISTORY) {
+        sa->env_count++;
+    }
+}
+
+// Linear interpolation of a at ta and b at tb, evaluated at t (ta <= t <= tb), rounded to nearest
+static fx_centi_t lerp(fx_centi_t a, fx_centi_t b, uint64_t ta, uint64_t tb, uint64_t t) {
+    if (tb == ta) {
+        return a;
+    }
+    int64_t span = (int64_t)(tb - ta);
+    int64_t num = (int64_t)(b - a) * (int64_t)(t - ta);
+    int64_t step = (num >= 0) ? (num + span / 2) / span : (num - span / 2) / span;
+    return a + (fx_centi_t)step;
+}
+
+bool sample_assembly_join(const sample_assembly_t *sa, uint64_t pm_timestamp_us, const pm25_data_t *pm,
+                          joint_sample_t *out) {
+    if (out == NULL) {
+        return false;
+    }
+    memset(out, 0, sizeof(*out));
+    out->timestamp_us = pm_timestamp_us;
+    if (pm != NULL) {
+        out->pm = *pm;
+    }
+    if (sa == NULL || sa->env_count == 0) {
+        return false;
+    }
+
+    // Latest reading at or before the frame, earliest reading after it
+    const sample_env_t *before = NULL;
+    const sample_env_t *after = NULL;
+    for (int i = 0; i < sa->env_count; i++) {
+        const sample_env_t *env = &sa->env[i];
+        if (env->timestamp_us <= pm_timestamp_us) {
+            if (before == NULL || env->timestamp_us > before->timestamp_us) {
+                before = env;
+            }
+        } else if (after == NULL || env->timestamp_us < after->timestamp_us) {
+            after = env;
+        }
+    }
+
+    uint64_t d_before = (before != NULL) ? pm_timestamp_us - before->timestamp_us : UINT64_MAX;
+    uint64_t d_after = (after != NULL) ? after->timestamp_us - pm_timestamp_us : UINT64_MAX;
+
+    if (before != NULL && after != NULL &&
+        after->timestamp_us - before->timestamp_us <= sa->config.max_interp_gap_us) {
+        out->temperature = lerp(before->temperature, after->temperature, before->timestamp_us,
+                                after->timestamp_us, pm_timestamp_us);
+        out->humidity = lerp(before->humidity, after->humidity, before->timestamp_us, after->timestamp_us,
+                             pm_timestamp_us);
+        out->interpolated = true;
+        out->skew_us = (uint32_t)((d_before < d_after) ? d_before : d_after);
+        out->has_env = true;
+        return true;
+    }
+
+    const sample_env_t *nearest = (d_before <= d_after) ? before : after;
+    uint64_t skew = (d_before <= d_after) ? d_before : d_after;
+    if (nearest == NULL || skew > sa->config.align_window_us) {
+        return false;
+    }
+    out->temperature = nearest->temperature;
+    out->humidity = nearest->humidity;
+    out->skew_us = (uint32_t)skew;
+    out->has_env = true;
+    return true;
+}
@@ -0,0 +1,81 @@
+/**
+ * File: sample_assembly.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for joint sample assembly. PMS7003 frames (timestamped at start-of-frame) and SHT3x
+ * readings (timestamped at I2C completion) arrive at unrelated times; this stage pairs each PM frame with the
+ * temperature/humidity at the same instant. A PM frame bracketed by two SHT3x readings gets a linear interpolation
+ * between them; otherwise the nearest reading is used if it lies inside the alignment window.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef PROCESSING_SAMPLE_ASSEMBLY_H
+#define PROCESSING_SAMPLE_ASSEMBLY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pm2_5.h"
+#include "fixed_point.h"
+
+#define SAMPLE_ASSEMBLY_ENV_HISTORY                 4       // SHT3x readings kept for pairing
+#define SAMPLE_ASSEMBLY_DEFAULT_WINDOW_US           500000u // Nearest reading accepted within 0.5 s
+#define SAMPLE_ASSEMBLY_DEFAULT_MAX_INTERP_GAP_US   150000000u  // Interpolate across at most 2.5 min
+
+typedef struct {
+    uint32_t align_window_us;       // Max distance to the nearest SHT3x reading when not interpolating
+    uint32_t max_interp_gap_us;     // Max distance between the two readings bracketing a PM frame
+} sample_assembly_config_t;
+
+// One SHT3x reading
+typedef struct {
+    uint64_t timestamp_us;
+    fx_centi_t temperature;         // centi-°C
+    fx_centi_t humidity;            // centi-%RH
+} sample_env_t;
+
+// Fused PM + temperature/humidity record at the PM frame time
+typedef struct {
+    uint64_t timestamp_us;          // PMS7003 start-of-frame time
+    pm25_data_t pm;
+    fx_centi_t temperature;         // centi-°C, valid if has_env
+    fx_centi_t humidity;            // centi-%RH, valid if has_env
+    bool has_env;                   // An SHT3x reading could be paired
+    bool interpolated;              // Env values interpolated between two readings
+    uint32_t skew_us;               // Distance to the SHT3x reading used (nearest of the two if interpolated)
+} joint_sample_t;
+
+typedef struct {
+    sample_assembly_config_t config;
+    sample_env_t env[SAMPLE_ASSEMBLY_ENV_HISTORY];  // Ring of recent readings, in arrival order
+    uint8_t env_head;               // Next slot to write
+    uint8_t env_count;
+} sample_assembly_t;
+
+/**
+ * Get the default configuration.
+ */
+void sample_assembly_default_config(sample_assembly_config_t *config);
+
+/**
+ * Initialize the assembler. If config is NULL, uses the default configuration.
+ */
+void sample_assembly_init(sample_assembly_t *sa, const sample_assembly_config_t *config);
+
+/**
+ * Record an SHT3x reading. Readings must be added in time order.
+ */
+void sample_assembly_add_env(sample_assembly_t *sa, uint64_t timestamp_us, fx_centi_t temperature,
+                             fx_centi_t humidity);
+
+/**
+ * Build the joint record of a PM frame. Always fills out; returns out->has_env.
+ */
+bool sample_assembly_join(const sample_assembly_t *sa, uint64_t pm_timestamp_us, const pm25_data_t *pm,
+                          joint_sample_t *out);
+
+#endif // PROCESSING_SAMPLE_ASSEMBLY_H
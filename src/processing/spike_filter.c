@@ -0,0 +1,83 @@
+/**
+ * File: spike_filter.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the streaming Hampel spike filter for PMS7003 samples.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "spike_filter.h"
+
+#include <stddef.h>
+#include <string.h>
+
+void spike_filter_default_config(spike_filter_config_t *config) {
+    if (config == NULL) {
+        return;
+    }
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        config->fields[f].enabled = true;
+        config->fields[f].window = SPIKE_FILTER_DEFAULT_WINDOW;
+        config->fields[f].k_x10 = SPIKE_FILTER_DEFAULT_K_X10;
+        config->fields[f].min_deviation = SPIKE_FILTER_DEFAULT_MIN_DEV;
+    }
+}
+
+void spike_filter_init(spike_filter_t *filter, const spike_filter_config_t *config) {
+    if (filter == NULL) {
+        return;
+    }
+    memset(filter, 0, sizeof(*filter));
+    if (config != NULL) {
+        filter->config = *config;
+    } else {
+        spike_filter_default_config(&filter->config);
+    }
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        running_median_init(&filter->median[f], filter->config.fields[f].window);
+        running_median_init(&filter->deviation[f], filter->config.fields[f].window);
+    }
+}
+
+// Hampel threshold: k * 1.4826 * MAD, with 1.4826 approximated as 95/64 to stay in 32 bits
+static uint32_t hampel_threshold(const spike_filter_field_config_t *cfg, uint16_t mad) {
+    uint32_t scaled = ((uint32_t)mad * cfg->k_x10 * 95u) / 64u;
+    uint32_t threshold = (scaled + 5u) / 10u;
+    return (threshold > cfg->min_deviation) ? threshold : cfg->min_deviation;
+}
+
+uint16_t spike_filter_apply(spike_filter_t *filter, pm25_data_t *data) {
+    if (filter == NULL || data == NULL) {
+        return 0;
+    }
+
+    uint16_t mask = 0;
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        const spike_filter_field_config_t *cfg = &filter->config.fields[f];
+        if (!cfg->enabled) {
+            continue;
+        }
+
+        uint16_t value = pm25_data_get(data, (pm25_field_t)f);
+        running_median_insert(&filter->median[f], value);
+        uint16_t median = running_median_get(&filter->median[f]);
+        uint16_t dev = (value > median) ? (uint16_t)(value - median) : (uint16_t)(median - value);
+        running_median_insert(&filter->deviation[f], dev);
+
+        if (!running_median_full(&filter->median[f])) {
+            continue;
+        }
+
+        uint16_t mad = running_median_get(&filter->deviation[f]);
+        if (dev > hampel_threshold(cfg, mad)) {
+            pm25_data_set(data, (pm25_field_t)f, median);
+            filter->suppressed[f]++;
+            mask |= (uint16_t)PM25_FIELD_BIT(f);
+        }
+    }
+    return mask;
+}
@@ -0,0 +1,66 @@
+/**
+ * File: spike_filter.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the streaming Hampel spike filter applied to PMS7003 samples between frame decode
+ * and aggregation. Each enabled pm25_data_t field keeps a trailing-window running median and a running median of
+ * absolute deviations (MAD); a sample further than k * 1.4826 * MAD from the median is replaced by the median and
+ * flagged as suppressed.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef PROCESSING_SPIKE_FILTER_H
+#define PROCESSING_SPIKE_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pm2_5.h"
+#include "running_median.h"
+
+#define SPIKE_FILTER_DEFAULT_WINDOW     7
+#define SPIKE_FILTER_DEFAULT_K_X10      30      // k = 3.0
+#define SPIKE_FILTER_DEFAULT_MIN_DEV    5       // Deviations up to this are never spikes
+
+// Per-field filter settings
+typedef struct {
+    bool enabled;               // Filter this field
+    uint8_t window;             // Trailing window length (1..RUNNING_MEDIAN_MAX_WINDOW)
+    uint8_t k_x10;              // Hampel threshold k in tenths
+    uint16_t min_deviation;     // Absolute deviation floor, keeps a flat signal (MAD = 0) from flagging noise
+} spike_filter_field_config_t;
+
+typedef struct {
+    spike_filter_field_config_t fields[PM25_FIELD_COUNT];
+} spike_filter_config_t;
+
+// Filter state for one sensor
+typedef struct {
+    spike_filter_config_t config;
+    running_median_t median[PM25_FIELD_COUNT];      // Median of raw values
+    running_median_t deviation[PM25_FIELD_COUNT];   // Median of |value - median|
+    uint32_t suppressed[PM25_FIELD_COUNT];          // Suppressed samples per field since init
+} spike_filter_t;
+
+/**
+ * Default configuration: all fields enabled with the default window, k and floor.
+ */
+void spike_filter_default_config(spike_filter_config_t *config);
+
+/**
+ * Initialize filter state. If config is NULL, uses the default configuration.
+ */
+void spike_filter_init(spike_filter_t *filter, const spike_filter_config_t *config);
+
+/**
+ * Filter one sample in place. Suppressed fields are replaced by their window median.
+ * Returns a mask of PM25_FIELD_BIT() of the fields that were suppressed, 0 if none.
+ * Fields are not flagged until their window is full.
+ */
+uint16_t spike_filter_apply(spike_filter_t *filter, pm25_data_t *data);
+
+#endif // PROCESSING_SPIKE_FILTER_H
@@ -0,0 +1,38 @@
+/**
+ * @file archive_flash_hal.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief Hardware Abstraction Layer of the sample archive flash region
+ * 
+ * Addresses are offsets into the archive region, which is a whole number of
+ * erase sectors. Pages are programmed once after their sector was erased. The
+ * real backend uses the QSPI flash below the TLS session sector; host tests use
+ * a RAM image with the same erase/program rules.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#ifndef ARCHIVE_FLASH_HAL_H
+#define ARCHIVE_FLASH_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define ARCHIVE_PAGE_SIZE       256u        // Program unit, one archive block
+#define ARCHIVE_SECTOR_SIZE     4096u       // Erase unit
+
+/**
+ * @brief Flash backend of the archive
+ */
+typedef struct {
+    uint32_t (*size)(void);                                         // Region size, 0 if there is no room
+    bool (*read)(uint32_t addr, uint8_t *buf, size_t len);
+    bool (*program_page)(uint32_t addr, const uint8_t *page);      // ARCHIVE_PAGE_SIZE bytes
+    bool (*erase_sector)(uint32_t addr);
+} archive_flash_hal_t;
+
+// Get the QSPI flash backend
+const archive_flash_hal_t *archive_get_pico_flash(void);
+
+#endif // ARCHIVE_FLASH_HAL_H
@@ -0,0 +1,91 @@
+/**
+ * @file archive_flash_pico.c
+ * @author trung.la
+ * @date October 19 2026
+ * @brief QSPI flash implementation of the archive flash HAL using Pico SDK
+ * 
+ * The region ends below the TLS session sector. Reads go through XIP; erase and
+ * program run with flash_safe_execute(), like the session store, so the other
+ * core and interrupts stay off the flash meanwhile.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#include "archive_flash_hal.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "hardware/flash.h"
+#include "pico/flash.h"
+
+#include "archive_config.h"
+#include "mqtt_config.h"
+
+#define ARCHIVE_FLASH_TIMEOUT   100     // ms to wait for the other core to park
+
+static_assert(ARCHIVE_PAGE_SIZE == FLASH_PAGE_SIZE, "archive blocks are flash pages");
+static_assert(ARCHIVE_SECTOR_SIZE == FLASH_SECTOR_SIZE, "archive erase unit is a flash sector");
+static_assert(ARCHIVE_FLASH_OFFSET % FLASH_SECTOR_SIZE == 0, "archive must start a flash sector");
+static_assert(ARCHIVE_FLASH_END <= MQTT_SESSION_FLASH_OFFSET, "archive must stay below the TLS session sector");
+
+// End of the program image, from the linker script
+extern char __flash_binary_end;
+
+typedef struct {
+    uint32_t offset;
+    const uint8_t *data;
+} flash_op_t;
+
+static void flash_do_erase(void *param) {
+    const flash_op_t *op = (const flash_op_t *)param;
+    flash_range_erase(op->offset, FLASH_SECTOR_SIZE);
+}
+
+static void flash_do_program(void *param) {
+    const flash_op_t *op = (const flash_op_t *)param;
+    flash_range_program(op->offset, op->data, FLASH_PAGE_SIZE);
+}
+
+static uint32_t pico_archive_size(void) {
+    uintptr_t image_end = (uintptr_t)&__flash_binary_end - XIP_BASE;
+    return (image_end <= ARCHIVE_FLASH_OFFSET) ? ARCHIVE_FLASH_SIZE : 0;
+}
+
+static bool pico_archive_read(uint32_t addr, uint8_t *buf, size_t len) {
+    if (addr + len > ARCHIVE_FLASH_SIZE) {
+        return false;
+    }
+    memcpy(buf, (const uint8_t *)(XIP_BASE + ARCHIVE_FLASH_OFFSET + addr), len);
+    return true;
+}
+
+static bool pico_archive_program_page(uint32_t addr, const uint8_t *page) {
+    if (addr % FLASH_PAGE_SIZE != 0 || addr >= ARCHIVE_FLASH_SIZE) {
+        return false;
+    }
+    // Flash cannot be programmed from data that lives in flash
+    static uint8_t staging[FLASH_PAGE_SIZE];
+    memcpy(staging, page, sizeof(staging));
+    flash_op_t op = { .offset = ARCHIVE_FLASH_OFFSET + addr, .data = staging };
+    return flash_safe_execute(flash_do_program, &op, ARCHIVE_FLASH_TIMEOUT) == PICO_OK;
+}
+
+static bool pico_archive_erase_sector(uint32_t addr) {
+    if (addr % FLASH_SECTOR_SIZE != 0 || addr >= ARCHIVE_FLASH_SIZE) {
+        return false;
+    }
+    flash_op_t op = { .offset = ARCHIVE_FLASH_OFFSET + addr, .data = NULL };
+    return flash_safe_execute(flash_do_erase, &op, ARCHIVE_FLASH_TIMEOUT) == PICO_OK;
+}
+
+static const archive_flash_hal_t pico_flash = {
+    .size = pico_archive_size,
+    .read = pico_archive_read,
+    .program_page = pico_archive_program_page,
+    .erase_sector = pico_archive_erase_sector
+};
+
+const archive_flash_hal_t *archive_get_pico_flash(void) {
+    return &pico_flash;
+}
@@ -0,0 +1,333 @@
+/**
+ * File: sample_archive.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the compressed on-flash sample archive (encoder, block store and header
+ * parsing).
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "sample_archive.h"
+
+#include <string.h>
+
+#define ARCHIVE_MAGIC           0x5341u     // "AS"
+#define PAGES_PER_SECTOR        (ARCHIVE_SECTOR_SIZE / ARCHIVE_PAGE_SIZE)
+
+// Raw size of one record: timestamp plus pm25_data_t
+#define RAW_RECORD_SIZE         (sizeof(uint32_t) + sizeof(pm25_data_t))
+
+static void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+    put_u16(p, (uint16_t)v);
+    put_u16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+static uint32_t fnv1a(uint32_t h, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ data[i]) * 16777619u;
+    }
+    return h;
+}
+
+// Checksum over the first 16 header bytes and the payload
+static uint32_t block_check(const uint8_t *block, uint8_t len) {
+    uint32_t h = fnv1a(2166136261u, block, 16);
+    return fnv1a(h, block + ARCHIVE_HEADER_SIZE, len);
+}
+
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static size_t put_varint(uint8_t *p, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80u) {
+        p[n++] = (uint8_t)(v | 0x80u);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+// Header fields without the checksum, for the mount scan (reads 20 bytes per block instead of 256)
+static bool header_fields(const uint8_t *raw, archive_header_t *header) {
+    if (get_u16(raw) != ARCHIVE_MAGIC || raw[2] != ARCHIVE_VERSION || raw[14] == 0 ||
+        raw[15] > ARCHIVE_PAYLOAD_MAX) {
+        return false;
+    }
+    header->source = raw[3];
+    header->seq = get_u32(raw + 4);
+    header->first_ms = get_u32(raw + 8);
+    header->boot = get_u16(raw + 12);
+    header->count = raw[14];
+    header->len = raw[15];
+    return true;
+}
+
+bool archive_parse_header(const uint8_t *block, size_t len, archive_header_t *header) {
+    archive_header_t h;
+    if (block == NULL || len < ARCHIVE_HEADER_SIZE || !header_fields(block, &h) ||
+        ARCHIVE_HEADER_SIZE + (size_t)h.len > len || get_u32(block + 16) != block_check(block, h.len)) {
+        return false;
+    }
+    if (header != NULL) {
+        *header = h;
+    }
+    return true;
+}
+
+static uint32_t page_addr(const sample_archive_t *archive, uint32_t seq) {
+    return (seq % archive->block_count) * ARCHIVE_PAGE_SIZE;
+}
+
+static bool page_blank(const sample_archive_t *archive, uint32_t seq) {
+    uint8_t page[ARCHIVE_PAGE_SIZE];
+    if (!archive->hal->read(page_addr(archive, seq), page, sizeof(page))) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(page); i++) {
+        if (page[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sample_archive_init(sample_archive_t *archive, const archive_flash_hal_t *hal) {
+    if (archive == NULL) {
+        return false;
+    }
+    memset(archive, 0, sizeof(*archive));
+    uint32_t size = (hal != NULL) ? hal->size() : 0;
+    if (size < ARCHIVE_SECTOR_SIZE || size % ARCHIVE_SECTOR_SIZE != 0) {
+        return false;
+    }
+    archive->hal = hal;
+    archive->block_count = size / ARCHIVE_PAGE_SIZE;
+
+    // Stored range and last boot number from the headers; blocks not in their own page belong to another layout
+    bool found = false;
+    uint32_t min_seq = 0;
+    uint32_t max_seq = 0;
+    uint16_t max_boot = 0;
+    for (uint32_t page = 0; page < archive->block_count; page++) {
+        uint8_t raw[ARCHIVE_HEADER_SIZE];
+        archive_header_t h;
+        if (!hal->read(page * ARCHIVE_PAGE_SIZE, raw, sizeof(raw)) || !header_fields(raw, &h) ||
+            h.seq % archive->block_count != page) {
+            continue;
+        }
+        if (!found || h.seq < min_seq) {
+            min_seq = h.seq;
+        }
+        if (!found || h.seq > max_seq) {
+            max_seq = h.seq;
+        }
+        if (!found || (int16_t)(h.boot - max_boot) > 0) {
+            max_boot = h.boot;
+        }
+        found = true;
+    }
+    if (found) {
+        archive->next_seq = max_seq + 1;
+        archive->oldest_seq = min_seq;
+        archive->boot = (uint16_t)(max_boot + 1);
+    }
+
+    // A write cut short by a reset leaves a page that cannot be programmed again before its sector is erased
+    while (archive->next_seq % PAGES_PER_SECTOR != 0 && !page_blank(archive, archive->next_seq)) {
+        archive->next_seq++;
+    }
+    return true;
+}
+
+static bool program_block(sample_archive_t *archive, uint8_t source) {
+    archive_writer_t *w = &archive->writers[source];
+    uint8_t *block = w->block;
+    put_u16(block, ARCHIVE_MAGIC);
+    block[2] = ARCHIVE_VERSION;
+    block[3] = source;
+    put_u32(block + 4, archive->next_seq);
+    put_u32(block + 8, w->first_ms);
+    put_u16(block + 12, archive->boot);
+    block[14] = w->count;
+    block[15] = (uint8_t)w->len;
+    put_u32(block + 16, block_check(block, (uint8_t)w->len));
+    memset(block + ARCHIVE_HEADER_SIZE + w->len, 0xFF, ARCHIVE_PAYLOAD_MAX - w->len);
+
+    uint32_t seq = archive->next_seq++;
+    uint32_t records = w->count;
+    w->count = 0;
+    w->len = 0;
+
+    // Entering a sector: erase it, which drops the oldest blocks of the ring
+    bool ok = true;
+    if (seq % PAGES_PER_SECTOR == 0) {
+        ok = archive->hal->erase_sector(page_addr(archive, seq));
+        archive->stats.erases++;
+        uint32_t end = seq + PAGES_PER_SECTOR;
+        if (end > archive->block_count && end - archive->block_count > archive->oldest_seq) {
+            archive->oldest_seq = end - archive->block_count;
+        }
+    }
+    ok = ok && archive->hal->program_page(page_addr(archive, seq), block);
+    if (!ok) {
+        archive->stats.errors++;
+        return false;
+    }
+    archive->stats.blocks++;
+    archive->stats.encoded_bytes += ARCHIVE_BLOCK_SIZE;
+    archive->stats.raw_bytes += records * RAW_RECORD_SIZE;
+    return true;
+}
+
+// Encode a record against the writer state; the first record of a block is encoded against zero
+static size_t encode_record(const archive_writer_t *w, uint32_t ts_ms, const pm25_data_t *data, uint8_t *out) {
+    size_t n = 0;
+    pm25_data_t zero;
+    const pm25_data_t *prev = data;
+    if (w->count == 0) {
+        memset(&zero, 0, sizeof(zero));
+        prev = &zero;
+    } else {
+        int32_t delta = (int32_t)(ts_ms - w->last_ms);
+        n += put_varint(out, zigzag(delta - w->last_delta));
+        prev = &w->last;
+    }
+
+    // Unchanged fields cost one mask bit, changed ones their delta
+    uint32_t mask = 0;
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        if (pm25_data_get(data, (pm25_field_t)f) != pm25_data_get(prev, (pm25_field_t)f)) {
+            mask |= 1u << f;
+        }
+    }
+    n += put_varint(out + n, mask);
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        if (mask & (1u << f)) {
+            int32_t delta = (int32_t)pm25_data_get(data, (pm25_field_t)f) -
+                            (int32_t)pm25_data_get(prev, (pm25_field_t)f);
+            n += put_varint(out + n, zigzag(delta));
+        }
+    }
+    return n;
+}
+
+bool sample_archive_append(sample_archive_t *archive, uint8_t source, uint32_t ts_ms, const pm25_data_t *data) {
+    if (archive == NULL || archive->hal == NULL || data == NULL || source >= ARCHIVE_MAX_SOURCES) {
+        return false;
+    }
+    archive_writer_t *w = &archive->writers[source];
+    uint8_t record[ARCHIVE_RECORD_MAX];
+    size_t n = encode_record(w, ts_ms, data, record);
+    bool ok = true;
+    if (w->count == UINT8_MAX || w->len + n > ARCHIVE_PAYLOAD_MAX) {
+        ok = program_block(archive, source);
+        n = encode_record(w, ts_ms, data, record);
+    }
+
+    if (w->count == 0) {
+        w->first_ms = ts_ms;
+        w->last_delta = 0;
+    } else {
+        w->last_delta = (int32_t)(ts_ms - w->last_ms);
+    }
+    memcpy(w->block + ARCHIVE_HEADER_SIZE + w->len, record, n);
+    w->len += (uint16_t)n;
+    w->count++;
+    w->last_ms = ts_ms;
+    w->last = *data;
+    archive->stats.records++;
+    return ok;
+}
+
+bool sample_archive_flush(sample_archive_t *archive) {
+    if (archive == NULL || archive->hal == NULL) {
+        return false;
+    }
+    bool ok = true;
+    for (uint8_t s = 0; s < ARCHIVE_MAX_SOURCES; s++) {
+        if (archive->writers[s].count > 0 && !program_block(archive, s)) {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool sample_archive_read_block(const sample_archive_t *archive, uint32_t seq, uint8_t block[ARCHIVE_BLOCK_SIZE]) {
+    if (archive == NULL || archive->hal == NULL || block == NULL ||
+        seq < archive->oldest_seq || seq >= archive->next_seq) {
+        return false;
+    }
+    archive_header_t h;
+    return archive->hal->read(page_addr(archive, seq), block, ARCHIVE_BLOCK_SIZE) &&
+           archive_parse_header(block, ARCHIVE_BLOCK_SIZE, &h) && h.seq == seq;
+}
+
+// Header of the first block of the source at or after seq (before end), ARCHIVE_SEQ_NONE if there is none
+static uint32_t next_of_source(const sample_archive_t *archive, uint8_t source, uint32_t seq, uint32_t end,
+                               archive_header_t *header) {
+    for (; seq < end; seq++) {
+        uint8_t raw[ARCHIVE_HEADER_SIZE];
+        if (archive->hal->read(page_addr(archive, seq), raw, sizeof(raw)) && header_fields(raw, header) &&
+            header->seq == seq && header->source == source) {
+            return seq;
+        }
+    }
+    return ARCHIVE_SEQ_NONE;
+}
+
+static bool after(const archive_header_t *h, uint16_t boot, uint32_t ts_ms) {
+    int16_t boots = (int16_t)(h->boot - boot);
+    return boots > 0 || (boots == 0 && (int32_t)(h->first_ms - ts_ms) > 0);
+}
+
+uint32_t sample_archive_seek(const sample_archive_t *archive, uint8_t source, uint16_t boot, uint32_t ts_ms) {
+    if (archive == NULL || archive->hal == NULL) {
+        return ARCHIVE_SEQ_NONE;
+    }
+    // The blocks of one sensor are in time order; blocks of other sensors in between are stepped over
+    uint32_t lo = archive->oldest_seq;
+    uint32_t hi = archive->next_seq;
+    archive_header_t h;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint32_t seq = next_of_source(archive, source, mid, hi, &h);
+        if (seq == ARCHIVE_SEQ_NONE || after(&h, boot, ts_ms)) {
+            hi = mid;
+        } else {
+            lo = seq + 1;
+        }
+    }
+    // lo is the first block starting after the time; the one before it holds the time
+    for (uint32_t seq = lo; seq-- > archive->oldest_seq;) {
+        if (next_of_source(archive, source, seq, seq + 1, &h) == seq) {
+            return seq;
+        }
+    }
+    return next_of_source(archive, source, lo, archive->next_seq, &h);
+}
+
+void sample_archive_get_stats(const sample_archive_t *archive, archive_stats_t *stats) {
+    if (archive == NULL || stats == NULL) {
+        return;
+    }
+    *stats = archive->stats;
+}
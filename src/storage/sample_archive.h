@@ -0,0 +1,137 @@
+/**
+ * File: sample_archive.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the compressed on-flash sample archive. Samples are packed into blocks of one flash
+ * page: a 20-byte index header (sensor, block sequence number, boot number, first timestamp, record count,
+ * checksum) followed by records. A record holds the timestamp as a zig-zag varint delta-of-delta, a varint mask of
+ * the fields that changed and, for those fields only, the zig-zag varint delta to the previous record. Each block
+ * starts from zero, so every block decodes on its own. Blocks fill the archive region as a ring, block n in page
+ * n % pages, so a sequence number locates its block without a search and a time is found by bisecting the
+ * headers. Each sensor has one open block in RAM, programmed when full; the open blocks are lost on a reset.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef STORAGE_SAMPLE_ARCHIVE_H
+#define STORAGE_SAMPLE_ARCHIVE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pm2_5.h"
+#include "archive_flash_hal.h"
+
+#ifndef ARCHIVE_MAX_SOURCES
+#define ARCHIVE_MAX_SOURCES         4       // Sensors with an open block each
+#endif
+
+#define ARCHIVE_BLOCK_SIZE          ARCHIVE_PAGE_SIZE
+#define ARCHIVE_HEADER_SIZE         20
+#define ARCHIVE_PAYLOAD_MAX         (ARCHIVE_BLOCK_SIZE - ARCHIVE_HEADER_SIZE)
+#define ARCHIVE_RECORD_MAX          (5 + 3 + PM25_FIELD_COUNT * 3)  // Largest encoded record
+#define ARCHIVE_VERSION             1
+#define ARCHIVE_SEQ_NONE            0xFFFFFFFFu
+
+// Block index header, as stored (little endian)
+typedef struct {
+    uint8_t source;             // Sensor index
+    uint8_t count;              // Records in the block
+    uint8_t len;                // Payload bytes
+    uint16_t boot;              // Boot number; timestamps are ms since that boot
+    uint32_t seq;               // Block sequence number, consecutive over the whole archive
+    uint32_t first_ms;          // Timestamp of the first record
+} archive_header_t;
+
+typedef struct {
+    uint32_t ts_ms;
+    pm25_data_t data;
+} archive_record_t;
+
+// Open block of one sensor
+typedef struct {
+    uint8_t block[ARCHIVE_BLOCK_SIZE];
+    uint16_t len;               // Payload bytes used
+    uint8_t count;
+    uint32_t first_ms;
+    uint32_t last_ms;
+    int32_t last_delta;         // Previous timestamp delta, for the delta-of-delta
+    pm25_data_t last;
+} archive_writer_t;
+
+typedef struct {
+    uint32_t records;           // Records appended
+    uint32_t blocks;            // Blocks programmed
+    uint32_t erases;            // Sectors erased
+    uint32_t errors;            // Failed flash operations
+    uint64_t encoded_bytes;     // Bytes of programmed blocks, headers included
+    uint64_t raw_bytes;         // The same records as timestamp plus raw pm25_data_t
+} archive_stats_t;
+
+typedef struct {
+    const archive_flash_hal_t *hal;
+    uint32_t block_count;       // Pages in the region
+    uint32_t next_seq;          // Sequence number of the next block programmed
+    uint32_t oldest_seq;        // Oldest block still stored (== next_seq when empty)
+    uint16_t boot;
+    archive_writer_t writers[ARCHIVE_MAX_SOURCES];
+    archive_stats_t stats;
+} sample_archive_t;
+
+// --- Device side ---
+
+/**
+ * Mount the archive: scan the block headers for the stored range and start a new boot number.
+ * @return False if the backend has no region
+ */
+bool sample_archive_init(sample_archive_t *archive, const archive_flash_hal_t *hal);
+
+/**
+ * Append one sample of a sensor; programs the sensor's block when it is full.
+ */
+bool sample_archive_append(sample_archive_t *archive, uint8_t source, uint32_t ts_ms, const pm25_data_t *data);
+
+/**
+ * Program all open blocks, partly filled ones included (e.g. before a planned reboot).
+ */
+bool sample_archive_flush(sample_archive_t *archive);
+
+/**
+ * Copy the stored block with the given sequence number.
+ * @return False if it is no longer (or not yet) stored or fails its checksum
+ */
+bool sample_archive_read_block(const sample_archive_t *archive, uint32_t seq, uint8_t block[ARCHIVE_BLOCK_SIZE]);
+
+/**
+ * Sequence number of the stored block of a sensor that holds (boot, ts_ms), found by bisecting the headers: the
+ * last block starting at or before that time, or the oldest block if all start after it.
+ * @return ARCHIVE_SEQ_NONE if no block of the sensor is stored
+ */
+uint32_t sample_archive_seek(const sample_archive_t *archive, uint8_t source, uint16_t boot, uint32_t ts_ms);
+
+/**
+ * Copy the archive statistics.
+ */
+void sample_archive_get_stats(const sample_archive_t *archive, archive_stats_t *stats);
+
+// --- Shared ---
+
+/**
+ * Parse and verify a block header (magic, version, length, checksum over header and payload).
+ */
+bool archive_parse_header(const uint8_t *block, size_t len, archive_header_t *header);
+
+// --- Host side ---
+
+/**
+ * Decode a block received from the device or read from a flash dump.
+ * @return Number of records written to records (at most max), or -1 if the block is invalid
+ */
+int archive_decode_block(const uint8_t *block, size_t len, archive_header_t *header, archive_record_t *records,
+                         int max);
+
+#endif // STORAGE_SAMPLE_ARCHIVE_H
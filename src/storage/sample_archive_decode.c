@@ -0,0 +1,89 @@
+/**
+ * File: sample_archive_decode.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Host-side decoder of sample archive blocks, as published on the archive topic or read from a flash
+ * dump. Built for the ingestion side and host tests; not linked into the firmware.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "sample_archive.h"
+
+#include <string.h>
+
+static int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1u);
+}
+
+// Read one varint of up to 32 bits; false if it runs past end
+static bool get_varint(const uint8_t **p, const uint8_t *end, uint32_t *value) {
+    uint32_t v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (*p >= end) {
+            return false;
+        }
+        uint8_t byte = *(*p)++;
+        v |= (uint32_t)(byte & 0x7Fu) << shift;
+        if ((byte & 0x80u) == 0) {
+            *value = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+int archive_decode_block(const uint8_t *block, size_t len, archive_header_t *header, archive_record_t *records,
+                         int max) {
+    archive_header_t h;
+    if (!archive_parse_header(block, len, &h)) {
+        return -1;
+    }
+    if (header != NULL) {
+        *header = h;
+    }
+
+    const uint8_t *p = block + ARCHIVE_HEADER_SIZE;
+    const uint8_t *end = p + h.len;
+    archive_record_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.ts_ms = h.first_ms;
+    int32_t delta = 0;
+    int n = 0;
+    for (int i = 0; i < h.count; i++) {
+        uint32_t v;
+        if (i > 0) {
+            if (!get_varint(&p, end, &v)) {
+                return -1;
+            }
+            delta += unzigzag(v);
+            rec.ts_ms += (uint32_t)delta;
+        }
+        uint32_t mask;
+        if (!get_varint(&p, end, &mask) || (mask >> PM25_FIELD_COUNT) != 0) {
+            return -1;
+        }
+        for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+            if ((mask & (1u << f)) == 0) {
+                continue;
+            }
+            if (!get_varint(&p, end, &v)) {
+                return -1;
+            }
+            int32_t value = (int32_t)pm25_data_get(&rec.data, (pm25_field_t)f) + unzigzag(v);
+            pm25_data_set(&rec.data, (pm25_field_t)f, (uint16_t)value);
+        }
+        if (records != NULL && n < max) {
+            records[n] = rec;
+        }
+        n++;
+    }
+    // Trailing bytes mean the block does not match its header
+    if (p != end) {
+        return -1;
+    }
+    return (n < max) ? n : max;
+}
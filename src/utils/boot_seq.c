@@ -0,0 +1,123 @@
+/**
+ * File: boot_seq.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the boot sequencer.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "boot_seq.h"
+
+#include <stddef.h>
+#include <string.h>
+
+static void finish(boot_seq_t *seq, boot_slot_t *slot, boot_task_state_t state, uint32_t now_ms) {
+    slot->state = state;
+    slot->end_ms = now_ms;
+    seq->open--;
+    seq->end_ms = now_ms;
+}
+
+static void step(boot_seq_t *seq, boot_slot_t *slot, uint32_t now_ms) {
+    uint32_t elapsed = now_ms - slot->start_ms;
+    boot_step_t result = (slot->task.poll != NULL) ? slot->task.poll(slot->task.ctx, elapsed) : BOOT_STEP_DONE;
+    if (result == BOOT_STEP_DONE) {
+        finish(seq, slot, BOOT_TASK_DONE, now_ms);
+    } else if (result == BOOT_STEP_FAILED) {
+        finish(seq, slot, BOOT_TASK_FAILED, now_ms);
+    } else if (slot->task.timeout_ms != 0 && elapsed >= slot->task.timeout_ms) {
+        finish(seq, slot, BOOT_TASK_FAILED, now_ms);
+    }
+}
+
+void boot_seq_init(boot_seq_t *seq) {
+    if (seq != NULL) {
+        memset(seq, 0, sizeof(*seq));
+    }
+}
+
+int boot_seq_add(boot_seq_t *seq, const boot_task_t *task) {
+    if (seq == NULL || task == NULL || seq->count >= BOOT_SEQ_MAX_TASKS) {
+        return -1;
+    }
+    if ((task->deps >> seq->count) != 0) {
+        return -1;
+    }
+    boot_slot_t *slot = &seq->slots[seq->count];
+    memset(slot, 0, sizeof(*slot));
+    slot->task = *task;
+    slot->state = BOOT_TASK_PENDING;
+    seq->open++;
+    return seq->count++;
+}
+
+bool boot_seq_poll(boot_seq_t *seq, uint32_t now_ms) {
+    if (seq == NULL) {
+        return true;
+    }
+    // Dependencies always have lower ids, so one pass in id order sees every state change it causes
+    for (uint8_t i = 0; i < seq->count; i++) {
+        boot_slot_t *slot = &seq->slots[i];
+        if (slot->state == BOOT_TASK_PENDING) {
+            bool blocked = false;
+            bool broken = false;
+            for (uint8_t d = 0; d < i; d++) {
+                if ((slot->task.deps & BOOT_DEP(d)) == 0) {
+                    continue;
+                }
+                boot_task_state_t dep = seq->slots[d].state;
+                if (dep == BOOT_TASK_FAILED || dep == BOOT_TASK_SKIPPED) {
+                    broken = true;
+                } else if (dep != BOOT_TASK_DONE) {
+                    blocked = true;
+                }
+            }
+            if (broken) {
+                slot->start_ms = now_ms;
+                finish(seq, slot, BOOT_TASK_SKIPPED, now_ms);
+                continue;
+            }
+            if (blocked) {
+                continue;
+            }
+            slot->start_ms = now_ms;
+            slot->state = BOOT_TASK_RUNNING;
+            if (slot->task.start != NULL && !slot->task.start(slot->task.ctx)) {
+                finish(seq, slot, BOOT_TASK_FAILED, now_ms);
+                continue;
+            }
+        }
+        if (slot->state == BOOT_TASK_RUNNING) {
+            step(seq, slot, now_ms);
+        }
+    }
+    return seq->open == 0;
+}
+
+bool boot_seq_ready(const boot_seq_t *seq, uint16_t mask) {
+    if (seq == NULL) {
+        return false;
+    }
+    for (uint8_t i = 0; i < seq->count; i++) {
+        if ((mask & BOOT_DEP(i)) != 0 && seq->slots[i].state != BOOT_TASK_DONE) {
+            return false;
+        }
+    }
+    return (mask >> seq->count) == 0;
+}
+
+boot_task_state_t boot_seq_state(const boot_seq_t *seq, int id) {
+    const boot_slot_t *slot = boot_seq_slot(seq, id);
+    return (slot != NULL) ? slot->state : BOOT_TASK_SKIPPED;
+}
+
+const boot_slot_t *boot_seq_slot(const boot_seq_t *seq, int id) {
+    if (seq == NULL || id < 0 || id >= seq->count) {
+        return NULL;
+    }
+    return &seq->slots[id];
+}
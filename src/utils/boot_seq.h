@@ -0,0 +1,104 @@
+/**
+ * File: boot_seq.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the boot sequencer. Start-up is a graph of init tasks: each task names the tasks it
+ * depends on, is started as soon as they are done and then polled until it finishes, so tasks that do not depend on
+ * each other (sensor warm-up, Wi-Fi association, DHCP, TLS) run at the same time. A task kicks its work off and
+ * returns; the work itself runs in hardware or interrupts. When a task fails or times out, the tasks that depend on
+ * it are skipped and the others carry on. Start and end time of every task are kept for the boot report.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef UTILS_BOOT_SEQ_H
+#define UTILS_BOOT_SEQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BOOT_SEQ_MAX_TASKS  8
+
+// Dependency mask bit of a task id
+#define BOOT_DEP(id)        ((uint16_t)(1u << (id)))
+
+typedef enum {
+    BOOT_TASK_PENDING = 0,      // Waiting for its dependencies
+    BOOT_TASK_RUNNING,
+    BOOT_TASK_DONE,
+    BOOT_TASK_FAILED,           // Start or poll failed, or the timeout passed
+    BOOT_TASK_SKIPPED           // A dependency failed or was skipped
+} boot_task_state_t;
+
+typedef enum {
+    BOOT_STEP_PENDING = 0,
+    BOOT_STEP_DONE,
+    BOOT_STEP_FAILED
+} boot_step_t;
+
+// Kick the task off and return at once; false if it cannot start
+typedef bool (*boot_start_fn)(void *ctx);
+
+// Check on a running task; elapsed_ms is the time since it was started
+typedef boot_step_t (*boot_poll_fn)(void *ctx, uint32_t elapsed_ms);
+
+typedef struct {
+    const char *name;
+    boot_start_fn start;        // NULL: nothing to start
+    boot_poll_fn poll;          // NULL: done once started
+    void *ctx;
+    uint16_t deps;              // BOOT_DEP() of the tasks that must be done first
+    uint32_t timeout_ms;        // Fail a task still running after this long; 0 for none
+} boot_task_t;
+
+typedef struct {
+    boot_task_t task;
+    boot_task_state_t state;
+    uint32_t start_ms;
+    uint32_t end_ms;
+} boot_slot_t;
+
+typedef struct {
+    boot_slot_t slots[BOOT_SEQ_MAX_TASKS];
+    uint8_t count;
+    uint8_t open;               // Tasks not finished yet
+    uint32_t end_ms;            // Time the last task finished
+} boot_seq_t;
+
+/**
+ * Initialize an empty sequence.
+ */
+void boot_seq_init(boot_seq_t *seq);
+
+/**
+ * Add a task. Dependencies must have been added before, so the graph has no cycles.
+ * @return Task id, or -1 if the sequence is full or a dependency does not exist
+ */
+int boot_seq_add(boot_seq_t *seq, const boot_task_t *task);
+
+/**
+ * Start every task whose dependencies are done and poll the running ones. A chain of tasks that complete when
+ * started finishes in one call.
+ * @return True once every task has finished (done, failed or skipped)
+ */
+bool boot_seq_poll(boot_seq_t *seq, uint32_t now_ms);
+
+/**
+ * Whether every task in the mask is done.
+ */
+bool boot_seq_ready(const boot_seq_t *seq, uint16_t mask);
+
+/**
+ * State of a task (BOOT_TASK_SKIPPED for an unknown id).
+ */
+boot_task_state_t boot_seq_state(const boot_seq_t *seq, int id);
+
+/**
+ * Task slot with its name, state and start/end times, or NULL for an unknown id.
+ */
+const boot_slot_t *boot_seq_slot(const boot_seq_t *seq, int id);
+
+#endif // UTILS_BOOT_SEQ_H
@@ -0,0 +1,32 @@
+/**
+ * @file clock_hal.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief Hardware Abstraction Layer of the clock policy
+ * 
+ * The policy only needs to set the core voltage, set clk_sys and read a
+ * millisecond clock. The real backend drives the RP2040 regulator and PLL; host
+ * tests use a fake with a simulated clock that records the order of the steps.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#ifndef CLOCK_HAL_H
+#define CLOCK_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Clock backend
+ */
+typedef struct {
+    bool (*set_voltage_mv)(uint32_t mv);    // Returns once the regulator has settled
+    bool (*set_sys_khz)(uint32_t khz);      // False if the frequency cannot be generated
+    uint32_t (*now_ms)(void);
+} clock_hal_t;
+
+// Get the RP2040 backend
+const clock_hal_t *clock_get_pico_hal(void);
+
+#endif // CLOCK_HAL_H
@@ -0,0 +1,51 @@
+/**
+ * @file clock_hal_pico.c
+ * @author trung.la
+ * @date October 19 2026
+ * @brief RP2040 implementation of the clock HAL using Pico SDK
+ * 
+ * set_sys_clock_khz() relocks pll_sys and moves clk_peri along with clk_sys, so
+ * UART and PIO dividers go stale on every change; the clock policy listeners
+ * re-derive them. The 1 us timer tick comes from clk_ref (XOSC), which is left
+ * alone, so alarms, sleep_ms() and time_us_64() keep their timing.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#include "clock_hal.h"
+#include "hardware/clocks.h"
+#include "hardware/vreg.h"
+#include "pico/time.h"
+
+// Regulator settling time after a voltage step, before the clock may go up
+#ifndef CLOCK_VREG_SETTLE_US
+#define CLOCK_VREG_SETTLE_US    1000
+#endif
+
+static bool pico_set_voltage_mv(uint32_t mv) {
+    // The RP2040 regulator has 50 mV steps from 0.85 V to 1.30 V with consecutive codes
+    if (mv < 850 || mv > 1300 || (mv - 850) % 50 != 0) {
+        return false;
+    }
+    vreg_set_voltage((enum vreg_voltage)(VREG_VOLTAGE_0_85 + (mv - 850) / 50));
+    busy_wait_us(CLOCK_VREG_SETTLE_US);
+    return true;
+}
+
+static bool pico_set_sys_khz(uint32_t khz) {
+    return set_sys_clock_khz(khz, false);
+}
+
+static uint32_t pico_now_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+static const clock_hal_t pico_hal = {
+    .set_voltage_mv = pico_set_voltage_mv,
+    .set_sys_khz = pico_set_sys_khz,
+    .now_ms = pico_now_ms
+};
+
+const clock_hal_t *clock_get_pico_hal(void) {
+    return &pico_hal;
+}
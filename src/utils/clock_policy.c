@@ -0,0 +1,216 @@
+/**
+ * File: clock_policy.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the clock policy.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "clock_policy.h"
+
+#include <string.h>
+
+typedef struct {
+    clock_listener_fn fn;
+    void *ctx;
+} clock_listener_t;
+
+static struct {
+    clock_policy_config_t config;
+    const clock_hal_t *hal;
+    clock_level_t level;            // Level applied to the hardware
+    uint32_t sys_khz;               // clk_sys as set
+    uint32_t vreg_mv;               // Core voltage as set
+    clock_phase_t phase;
+    uint8_t held[CLOCK_BURST_COUNT];
+    uint16_t held_total;
+    bool lower_pending;             // Target below the current level since lower_since_ms
+    uint32_t lower_since_ms;
+    uint32_t level_since_ms;        // Start of the current level, for the residency
+    uint64_t khz_ms;                // Integral of clk_sys over time, for the mean
+    clock_listener_t listeners[CLOCK_POLICY_MAX_LISTENERS];
+    uint8_t listener_count;
+    clock_policy_stats_t stats;
+} policy;
+
+clock_policy_config_t clock_policy_default_config(void) {
+    clock_policy_config_t config = {
+        .levels = {
+            [CLOCK_LEVEL_IDLE] = { CLOCK_POLICY_DEFAULT_IDLE_KHZ, CLOCK_POLICY_DEFAULT_IDLE_MV },
+            [CLOCK_LEVEL_ACQUIRE] = { CLOCK_POLICY_DEFAULT_ACQUIRE_KHZ, CLOCK_POLICY_DEFAULT_ACQUIRE_MV },
+            [CLOCK_LEVEL_BURST] = { CLOCK_POLICY_DEFAULT_BURST_KHZ, CLOCK_POLICY_DEFAULT_BURST_MV }
+        },
+        .lower_delay_ms = CLOCK_POLICY_DEFAULT_LOWER_DELAY_MS
+    };
+    return config;
+}
+
+// Close the time segment of the current level
+static void account(uint32_t now) {
+    uint32_t elapsed = now - policy.level_since_ms;
+    policy.stats.residency_ms[policy.level] += elapsed;
+    policy.khz_ms += (uint64_t)policy.sys_khz * elapsed;
+    policy.level_since_ms = now;
+}
+
+static bool set_voltage(uint32_t mv) {
+    if (!policy.hal->set_voltage_mv(mv)) {
+        policy.stats.errors++;
+        return false;
+    }
+    policy.vreg_mv = mv;
+    return true;
+}
+
+// Voltage up before the clock, down after it; the level only changes once clk_sys has
+static void apply(clock_level_t level, uint32_t now) {
+    const clock_point_t *point = &policy.config.levels[level];
+    if (point->vreg_mv > policy.vreg_mv && !set_voltage(point->vreg_mv)) {
+        return;
+    }
+    if (point->sys_khz != policy.sys_khz) {
+        if (!policy.hal->set_sys_khz(point->sys_khz)) {
+            policy.stats.errors++;
+            return;
+        }
+        account(now);
+        policy.sys_khz = point->sys_khz;
+        policy.stats.transitions++;
+        for (uint8_t i = 0; i < policy.listener_count; i++) {
+            policy.listeners[i].fn(point->sys_khz * 1000u, policy.listeners[i].ctx);
+        }
+    } else {
+        account(now);
+    }
+    policy.level = level;
+    // A refused voltage drop leaves the core at the higher, safe voltage
+    if (point->vreg_mv < policy.vreg_mv) {
+        set_voltage(point->vreg_mv);
+    }
+}
+
+static clock_level_t target_level(void) {
+    if (policy.held_total > 0) {
+        return CLOCK_LEVEL_BURST;
+    }
+    return (policy.phase == CLOCK_PHASE_ACQUIRE) ? CLOCK_LEVEL_ACQUIRE : CLOCK_LEVEL_IDLE;
+}
+
+static void update(void) {
+    if (policy.hal == NULL) {
+        return;
+    }
+    uint32_t now = policy.hal->now_ms();
+    clock_level_t target = target_level();
+    if (target > policy.level) {
+        policy.lower_pending = false;
+        apply(target, now);
+    } else if (target < policy.level) {
+        if (!policy.lower_pending) {
+            policy.lower_pending = true;
+            policy.lower_since_ms = now;
+        }
+        if (now - policy.lower_since_ms >= policy.config.lower_delay_ms) {
+            policy.lower_pending = false;
+            apply(target, now);
+        }
+    } else {
+        policy.lower_pending = false;
+    }
+}
+
+bool clock_policy_init(const clock_policy_config_t *config, const clock_hal_t *hal) {
+    memset(&policy, 0, sizeof(policy));
+    if (hal == NULL) {
+        return false;
+    }
+    policy.config = (config != NULL) ? *config : clock_policy_default_config();
+    policy.hal = hal;
+
+    // Boot operating point
+    policy.level = CLOCK_LEVEL_BURST;
+    policy.sys_khz = policy.config.levels[CLOCK_LEVEL_BURST].sys_khz;
+    policy.vreg_mv = policy.config.levels[CLOCK_LEVEL_BURST].vreg_mv;
+    policy.level_since_ms = hal->now_ms();
+
+    policy.phase = CLOCK_PHASE_ACQUIRE;
+    apply(CLOCK_LEVEL_ACQUIRE, policy.level_since_ms);
+    return policy.level == CLOCK_LEVEL_ACQUIRE;
+}
+
+bool clock_policy_add_listener(clock_listener_fn fn, void *ctx) {
+    if (fn == NULL || policy.listener_count >= CLOCK_POLICY_MAX_LISTENERS) {
+        return false;
+    }
+    policy.listeners[policy.listener_count].fn = fn;
+    policy.listeners[policy.listener_count].ctx = ctx;
+    policy.listener_count++;
+    return true;
+}
+
+void clock_policy_set_phase(clock_phase_t phase) {
+    policy.phase = phase;
+    update();
+}
+
+void clock_policy_burst_begin(clock_burst_t burst) {
+    if ((unsigned)burst >= CLOCK_BURST_COUNT || policy.held[burst] == UINT8_MAX) {
+        return;
+    }
+    if (policy.held_total == 0 && policy.hal != NULL) {
+        policy.stats.bursts++;
+    }
+    policy.held[burst]++;
+    policy.held_total++;
+    update();
+}
+
+void clock_policy_burst_end(clock_burst_t burst) {
+    if ((unsigned)burst >= CLOCK_BURST_COUNT || policy.held[burst] == 0) {
+        return;
+    }
+    policy.held[burst]--;
+    policy.held_total--;
+    update();
+}
+
+void clock_policy_poll(void) {
+    update();
+}
+
+bool clock_policy_drop_pending(uint32_t *at_ms) {
+    if (!policy.lower_pending) {
+        return false;
+    }
+    if (at_ms != NULL) {
+        *at_ms = policy.lower_since_ms + policy.config.lower_delay_ms;
+    }
+    return true;
+}
+
+clock_level_t clock_policy_level(void) {
+    return policy.level;
+}
+
+uint32_t clock_policy_sys_khz(void) {
+    return policy.sys_khz;
+}
+
+void clock_policy_get_stats(clock_policy_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    if (policy.hal != NULL) {
+        account(policy.hal->now_ms());
+    }
+    *stats = policy.stats;
+    uint64_t total_ms = 0;
+    for (int i = 0; i < CLOCK_LEVEL_COUNT; i++) {
+        total_ms += stats->residency_ms[i];
+    }
+    stats->avg_khz = (total_ms > 0) ? (uint32_t)(policy.khz_ms / total_ms) : policy.sys_khz;
+}
@@ -0,0 +1,131 @@
+/**
+ * File: clock_policy.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the clock policy. The firmware spends almost all of its time waiting for the next
+ * sample or moving a few UART bytes, which needs a small fraction of the RP2040's full clock. The policy runs clk_sys
+ * and the core voltage at a low level while idle or acquiring and raises both only while a burst is held (TLS
+ * handshake, payload compression, display flush). Raising happens at once, so bursts see no added latency; lowering
+ * waits CLOCK_POLICY_DEFAULT_LOWER_DELAY_MS so back-to-back bursts do not thrash the PLL. The voltage goes up before
+ * the clock and down after it. Listeners re-derive peripheral dividers after every clk_sys change. The boot operating
+ * point is taken to be the burst level (Pico SDK default: 125 MHz at 1.10 V). Call from thread context only.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef UTILS_CLOCK_POLICY_H
+#define UTILS_CLOCK_POLICY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "clock_hal.h"
+
+// Operating points; 24 and 48 MHz come straight from pll_sys (VCO 1176 / 1440 MHz)
+#define CLOCK_POLICY_DEFAULT_IDLE_KHZ       24000
+#define CLOCK_POLICY_DEFAULT_IDLE_MV        950
+#define CLOCK_POLICY_DEFAULT_ACQUIRE_KHZ    48000
+#define CLOCK_POLICY_DEFAULT_ACQUIRE_MV     1000
+#define CLOCK_POLICY_DEFAULT_BURST_KHZ      125000
+#define CLOCK_POLICY_DEFAULT_BURST_MV       1100
+#define CLOCK_POLICY_DEFAULT_LOWER_DELAY_MS 250
+
+#define CLOCK_POLICY_MAX_LISTENERS          4
+
+typedef enum {
+    CLOCK_LEVEL_IDLE = 0,
+    CLOCK_LEVEL_ACQUIRE,
+    CLOCK_LEVEL_BURST,
+    CLOCK_LEVEL_COUNT
+} clock_level_t;
+
+// What the main loop is doing when no burst is held
+typedef enum {
+    CLOCK_PHASE_IDLE = 0,       // Waiting for the next sample
+    CLOCK_PHASE_ACQUIRE         // Reading and filtering sensor frames
+} clock_phase_t;
+
+// Work that needs the full clock; each kind is reference counted
+typedef enum {
+    CLOCK_BURST_TLS = 0,
+    CLOCK_BURST_COMPRESS,
+    CLOCK_BURST_DISPLAY,
+    CLOCK_BURST_COUNT
+} clock_burst_t;
+
+typedef struct {
+    uint32_t sys_khz;
+    uint32_t vreg_mv;
+} clock_point_t;
+
+typedef struct {
+    clock_point_t levels[CLOCK_LEVEL_COUNT];
+    uint32_t lower_delay_ms;    // Time the lower target must hold before the clock drops
+} clock_policy_config_t;
+
+typedef struct {
+    uint32_t transitions;       // clk_sys changes
+    uint32_t bursts;            // Bursts begun while none was held
+    uint32_t errors;            // Steps the backend refused
+    uint64_t residency_ms[CLOCK_LEVEL_COUNT];
+    uint32_t avg_khz;           // Time-weighted mean clk_sys
+} clock_policy_stats_t;
+
+// Called after every clk_sys change with the new frequency
+typedef void (*clock_listener_fn)(uint32_t sys_hz, void *ctx);
+
+/**
+ * Default configuration.
+ */
+clock_policy_config_t clock_policy_default_config(void);
+
+/**
+ * Initialize the policy and switch to the acquire level. Call before the peripherals are set up, so they derive
+ * their dividers from the new clock; listeners registered later are only told about later changes.
+ * @param config Configuration, or NULL for the defaults
+ * @return False if the backend refused the initial level
+ */
+bool clock_policy_init(const clock_policy_config_t *config, const clock_hal_t *hal);
+
+/**
+ * Register a listener. Returns false if CLOCK_POLICY_MAX_LISTENERS are registered.
+ */
+bool clock_policy_add_listener(clock_listener_fn fn, void *ctx);
+
+/**
+ * Set the phase of the main loop. A higher level applies at once, a lower one after the lower delay.
+ */
+void clock_policy_set_phase(clock_phase_t phase);
+
+/**
+ * Hold or release a burst. Begin raises to the burst level before returning; unmatched ends are ignored.
+ */
+void clock_policy_burst_begin(clock_burst_t burst);
+void clock_policy_burst_end(clock_burst_t burst);
+
+/**
+ * Apply a pending drop whose lower delay has passed. Call periodically while waiting.
+ */
+void clock_policy_poll(void);
+
+/**
+ * Whether a drop to a lower level is waiting for the lower delay, and when it will apply. Callers that sleep
+ * should wake by then and call clock_policy_poll(), so the wait itself runs at the lower clock.
+ */
+bool clock_policy_drop_pending(uint32_t *at_ms);
+
+/**
+ * Current level and clk_sys frequency.
+ */
+clock_level_t clock_policy_level(void);
+uint32_t clock_policy_sys_khz(void);
+
+/**
+ * Snapshot of the counters, with the residency of the current level up to now.
+ */
+void clock_policy_get_stats(clock_policy_stats_t *stats);
+
+#endif // UTILS_CLOCK_POLICY_H
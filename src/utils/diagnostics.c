@@ -0,0 +1,93 @@
+/**
+ * File: diagnostics.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the memory diagnostics.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "diagnostics.h"
+
+#include <stddef.h>
+#include <string.h>
+
+typedef struct {
+    const char *name;
+    uint32_t capacity;
+    diag_high_water_fn high_water;
+    void *ctx;
+} diag_ring_t;
+
+static diag_ring_t rings[DIAG_MAX_RINGS];
+static uint16_t ring_count;
+
+void diag_stack_paint(uint32_t *bottom, uint32_t *top) {
+    for (volatile uint32_t *p = bottom; p < top; p++) {
+        *p = DIAG_STACK_PAINT_WORD;
+    }
+}
+
+uint32_t diag_stack_high_water(const uint32_t *bottom, const uint32_t *top) {
+    const volatile uint32_t *p = bottom;
+    while (p < top && *p == DIAG_STACK_PAINT_WORD) {
+        p++;
+    }
+    return (uint32_t)((uintptr_t)top - (uintptr_t)p);
+}
+
+void diag_init(void) {
+    uintptr_t sp = diag_platform_stack_pointer();
+    for (unsigned int core = 0; core < DIAG_CORE_COUNT; core++) {
+        diag_stack_region_t region;
+        if (!diag_platform_stack_region(core, &region)) {
+            continue;
+        }
+        uint32_t *top = region.top;
+        // Do not paint over the frames we are running on
+        if (sp > (uintptr_t)region.bottom && sp <= (uintptr_t)region.top) {
+            uintptr_t limit = (sp - DIAG_STACK_PAINT_MARGIN) & ~(uintptr_t)3u;
+            top = (limit > (uintptr_t)region.bottom) ? (uint32_t *)limit : region.bottom;
+        }
+        diag_stack_paint(region.bottom, top);
+    }
+}
+
+bool diag_register_ring(const char *name, uint32_t capacity, diag_high_water_fn high_water, void *ctx) {
+    if (name == NULL || high_water == NULL || ring_count >= DIAG_MAX_RINGS) {
+        return false;
+    }
+    rings[ring_count++] = (diag_ring_t){ name, capacity, high_water, ctx };
+    return true;
+}
+
+void diag_get_stats(diag_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    for (unsigned int core = 0; core < DIAG_CORE_COUNT; core++) {
+        diag_stack_region_t region;
+        if (diag_platform_stack_region(core, &region)) {
+            stats->stack[core].size = (uint32_t)((uintptr_t)region.top - (uintptr_t)region.bottom);
+            stats->stack[core].used = diag_stack_high_water(region.bottom, region.top);
+        }
+    }
+
+    diag_platform_sections(&stats->data_bytes, &stats->bss_bytes, &stats->heap_bytes);
+
+    for (size_t i = 0; i < mem_pool_count() && stats->pool_count < MEM_POOL_MAX_POOLS; i++) {
+        mem_pool_get_stats(mem_pool_at(i), &stats->pools[stats->pool_count++]);
+    }
+
+    for (uint16_t i = 0; i < ring_count; i++) {
+        diag_ring_usage_t *r = &stats->rings[stats->ring_count++];
+        r->name = rings[i].name;
+        r->capacity = rings[i].capacity;
+        r->high_water = rings[i].high_water(rings[i].ctx);
+    }
+}
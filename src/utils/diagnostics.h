@@ -0,0 +1,103 @@
+/**
+ * File: diagnostics.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the memory diagnostics. At boot the core0 and core1 stacks are painted with a known
+ * word; the high-water mark of each stack is the lowest word that no longer holds it. Together with the static
+ * .data/.bss footprint from the linker symbols, the usage counters of every registered memory pool and the
+ * occupancy maxima of registered rings and queues, this gives one snapshot of how close the firmware is to running
+ * out of RAM. The per-module breakdown of .data/.bss is produced at build time from the linker map
+ * (scripts/map_usage.py).
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef UTILS_DIAGNOSTICS_H
+#define UTILS_DIAGNOSTICS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mem_pool.h"
+
+#define DIAG_STACK_PAINT_WORD       0x5AC5C0DEu
+#define DIAG_STACK_PAINT_MARGIN     64u     // Bytes left unpainted below the live stack pointer
+#define DIAG_CORE_COUNT             2
+#define DIAG_MAX_RINGS              8
+
+typedef struct {
+    uint32_t size;              // Bytes reserved for the stack
+    uint32_t used;              // High-water mark in bytes; size means the paint is gone (possible overflow)
+} diag_stack_usage_t;
+
+// Returns the most entries a ring or queue has held since boot
+typedef uint32_t (*diag_high_water_fn)(void *ctx);
+
+typedef struct {
+    const char *name;
+    uint32_t capacity;
+    uint32_t high_water;
+} diag_ring_usage_t;
+
+typedef struct {
+    diag_stack_usage_t stack[DIAG_CORE_COUNT];
+    uint32_t data_bytes;        // Initialized static data
+    uint32_t bss_bytes;         // Zero-initialized static data
+    uint32_t heap_bytes;        // RAM left between the end of .bss and the stacks
+    uint16_t pool_count;
+    mem_pool_stats_t pools[MEM_POOL_MAX_POOLS];
+    uint16_t ring_count;
+    diag_ring_usage_t rings[DIAG_MAX_RINGS];
+} diag_stats_t;
+
+/**
+ * Paint both stacks. Call first thing in main(), before core1 is launched; the part of the core0
+ * stack in use (plus DIAG_STACK_PAINT_MARGIN) is left alone.
+ */
+void diag_init(void);
+
+/**
+ * Register a ring or queue whose occupancy maximum is reported. Returns false if the table is full.
+ */
+bool diag_register_ring(const char *name, uint32_t capacity, diag_high_water_fn high_water, void *ctx);
+
+/**
+ * Take a snapshot of all memory figures.
+ */
+void diag_get_stats(diag_stats_t *stats);
+
+/**
+ * Fill [bottom, top) with DIAG_STACK_PAINT_WORD.
+ */
+void diag_stack_paint(uint32_t *bottom, uint32_t *top);
+
+/**
+ * Bytes of a downward-growing stack [bottom, top) that have been written since it was painted.
+ */
+uint32_t diag_stack_high_water(const uint32_t *bottom, const uint32_t *top);
+
+// Platform layer (diagnostics_pico.c on target, a mock in host tests)
+typedef struct {
+    uint32_t *bottom;           // Lowest word of the stack
+    uint32_t *top;              // One past the highest word
+} diag_stack_region_t;
+
+/**
+ * Stack region of a core. Returns false if the core has no stack of its own.
+ */
+bool diag_platform_stack_region(unsigned int core, diag_stack_region_t *region);
+
+/**
+ * Current stack pointer of the calling core.
+ */
+uintptr_t diag_platform_stack_pointer(void);
+
+/**
+ * Static RAM footprint from the linker symbols.
+ */
+void diag_platform_sections(uint32_t *data_bytes, uint32_t *bss_bytes, uint32_t *heap_bytes);
+
+#endif // UTILS_DIAGNOSTICS_H
@@ -0,0 +1,53 @@
+/**
+ * File: diagnostics_pico.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: RP2040 platform layer of the memory diagnostics, based on the Pico SDK linker script symbols
+ * (memmap_default.ld): core0 runs on the stack at the top of SCRATCH_Y, core1 on the one in SCRATCH_X.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "diagnostics.h"
+
+extern uint32_t __StackBottom;
+extern uint32_t __StackTop;
+extern uint32_t __StackOneBottom;
+extern uint32_t __StackOneTop;
+extern uint8_t __data_start__;
+extern uint8_t __data_end__;
+extern uint8_t __bss_start__;
+extern uint8_t __bss_end__;
+extern uint8_t __end__;
+extern uint8_t __HeapLimit;
+
+bool diag_platform_stack_region(unsigned int core, diag_stack_region_t *region) {
+    if (region == NULL) {
+        return false;
+    }
+    if (core == 0) {
+        region->bottom = &__StackBottom;
+        region->top = &__StackTop;
+    } else if (core == 1) {
+        region->bottom = &__StackOneBottom;
+        region->top = &__StackOneTop;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+uintptr_t diag_platform_stack_pointer(void) {
+    uintptr_t sp;
+    __asm volatile ("mov %0, sp" : "=r" (sp));
+    return sp;
+}
+
+void diag_platform_sections(uint32_t *data_bytes, uint32_t *bss_bytes, uint32_t *heap_bytes) {
+    *data_bytes = (uint32_t)(&__data_end__ - &__data_start__);
+    *bss_bytes = (uint32_t)(&__bss_end__ - &__bss_start__);
+    *heap_bytes = (uint32_t)(&__HeapLimit - &__end__);
+}
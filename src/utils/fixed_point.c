@@ -0,0 +1,48 @@
+/**
+ * File: fixed_point.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for integer-only fixed-point helpers used by the sample processing pipeline.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "fixed_point.h"
+#include "fmt.h"
+
+#define SHT3X_RAW_FULL_SCALE    65535u
+
+fx_centi_t fx_sht3x_temp_centi(uint16_t raw) {
+    // 17500 * 65535 fits in 32 bits, so no 64-bit math is needed
+    uint32_t scaled = (17500u * raw + SHT3X_RAW_FULL_SCALE / 2) / SHT3X_RAW_FULL_SCALE;
+    return (fx_centi_t)scaled - 4500;
+}
+
+fx_centi_t fx_sht3x_hum_centi(uint16_t raw) {
+    return (fx_centi_t)((10000u * raw + SHT3X_RAW_FULL_SCALE / 2) / SHT3X_RAW_FULL_SCALE);
+}
+
+fx_centi_t fx_pm25_humidity_correct(uint16_t pm2_5_cf1, fx_centi_t humidity_centi) {
+    // pm2_5_cf1 is whole µg/m³: 0.524 * pm in centi-units is pm * 524 / 10
+    int32_t pm_term = ((int32_t)pm2_5_cf1 * FX_PM25_CORR_PM_PER_MILLE + 5) / 10;
+    int32_t rh_term = (humidity_centi * FX_PM25_CORR_RH_PER_10K + 5000) / 10000;
+    int32_t corrected = pm_term - rh_term + FX_PM25_CORR_OFFSET_CENTI;
+    return (corrected > 0) ? corrected : 0;
+}
+
+int32_t fx_round(fx_centi_t value) {
+    if (value >= 0) {
+        return (value + FX_CENTI_SCALE / 2) / FX_CENTI_SCALE;
+    }
+    return -((-value + FX_CENTI_SCALE / 2) / FX_CENTI_SCALE);
+}
+
+size_t fx_format_centi(char *buf, size_t len, fx_centi_t value) {
+    fmt_buf_t b;
+    fmt_init(&b, buf, len);
+    fmt_fixed(&b, value, 2);
+    return fmt_finish(&b);
+}
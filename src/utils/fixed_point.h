@@ -0,0 +1,64 @@
+/**
+ * File: fixed_point.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Integer-only fixed-point helpers for the sample processing pipeline. The RP2040 has no FPU, so
+ * temperature, humidity and derived PM values are carried as centi-units (value x 100) in an int32_t.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef UTILS_FIXED_POINT_H
+#define UTILS_FIXED_POINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Value in hundredths of its unit: 2537 == 25.37 °C / %RH / µg/m³
+typedef int32_t fx_centi_t;
+
+#define FX_CENTI_SCALE              100
+#define FX_FROM_INT(v)              ((fx_centi_t)(v) * FX_CENTI_SCALE)
+
+// Humidity correction for PMS-family PM2.5 (CF=1), US-EPA fit:
+// PM2.5 = 0.524 * PM2.5_cf1 - 0.0862 * RH + 5.75
+#define FX_PM25_CORR_PM_PER_MILLE   524     // 0.524 in 1/1000
+#define FX_PM25_CORR_RH_PER_10K     862     // 0.0862 in 1/10000
+#define FX_PM25_CORR_OFFSET_CENTI   575     // 5.75 µg/m³
+
+// Longest string produced by fx_format_centi(): "-21474836.48" plus terminator
+#define FX_FORMAT_CENTI_MAX         13
+
+/**
+ * Convert a raw SHT3x temperature reading to centi-degrees Celsius.
+ * T = -45 + 175 * raw / 65535
+ */
+fx_centi_t fx_sht3x_temp_centi(uint16_t raw);
+
+/**
+ * Convert a raw SHT3x humidity reading to centi-percent relative humidity.
+ * RH = 100 * raw / 65535
+ */
+fx_centi_t fx_sht3x_hum_centi(uint16_t raw);
+
+/**
+ * Apply the humidity correction to a PM2.5 (CF=1) concentration.
+ * Result is clamped to zero.
+ */
+fx_centi_t fx_pm25_humidity_correct(uint16_t pm2_5_cf1, fx_centi_t humidity_centi);
+
+/**
+ * Round a centi-unit value to the nearest whole unit (half away from zero).
+ */
+int32_t fx_round(fx_centi_t value);
+
+/**
+ * Format a centi-unit value as a decimal string with two fraction digits ("-3.05").
+ * Returns the string length, or 0 if the buffer is too small.
+ */
+size_t fx_format_centi(char *buf, size_t len, fx_centi_t value);
+
+#endif // UTILS_FIXED_POINT_H
@@ -0,0 +1,171 @@
+/**
+ * File: fmt.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the integer-only text formatter.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "fmt.h"
+
+#include <string.h>
+
+// Digits of UINT32_MAX
+#define U32_DIGITS_MAX  10
+
+void fmt_init(fmt_buf_t *b, char *buf, size_t size) {
+    b->buf = buf;
+    b->size = size;
+    b->len = 0;
+    b->overflow = (buf == NULL || size == 0);
+    b->need_comma = false;
+}
+
+size_t fmt_finish(fmt_buf_t *b) {
+    if (b->buf == NULL || b->size == 0) {
+        return 0;
+    }
+    // Room for the terminator is always kept free by the emitters
+    b->buf[b->len] = '\0';
+    return b->overflow ? 0 : b->len;
+}
+
+static void put(fmt_buf_t *b, const char *s, size_t n) {
+    if (b->overflow) {
+        return;
+    }
+    if (n >= b->size - b->len) {
+        b->overflow = true;
+        return;
+    }
+    memcpy(b->buf + b->len, s, n);
+    b->len += n;
+}
+
+void fmt_char(fmt_buf_t *b, char c) {
+    put(b, &c, 1);
+}
+
+void fmt_str(fmt_buf_t *b, const char *s) {
+    put(b, s, strlen(s));
+}
+
+// Writes the digits of value right-aligned ending at end, at least min_digits of them; returns the first one
+static char *u32_digits(char *end, uint32_t value, unsigned int min_digits) {
+    char *p = end;
+    unsigned int n = 0;
+    do {
+        *--p = (char)('0' + value % 10u);
+        value /= 10u;
+        n++;
+    } while (value != 0u || n < min_digits);
+    return p;
+}
+
+void fmt_u32(fmt_buf_t *b, uint32_t value) {
+    char tmp[U32_DIGITS_MAX];
+    char *p = u32_digits(tmp + sizeof(tmp), value, 1);
+    put(b, p, (size_t)(tmp + sizeof(tmp) - p));
+}
+
+void fmt_i32(fmt_buf_t *b, int32_t value) {
+    char tmp[U32_DIGITS_MAX + 1];
+    // Magnitude as unsigned so INT32_MIN does not overflow
+    uint32_t mag = (value < 0) ? (uint32_t)(-(value + 1)) + 1u : (uint32_t)value;
+    char *p = u32_digits(tmp + sizeof(tmp), mag, 1);
+    if (value < 0) {
+        *--p = '-';
+    }
+    put(b, p, (size_t)(tmp + sizeof(tmp) - p));
+}
+
+void fmt_fixed(fmt_buf_t *b, int32_t value, uint8_t decimals) {
+    if (decimals > FMT_FIXED_MAX_DECIMALS) {
+        b->overflow = true;
+        return;
+    }
+    if (decimals == 0) {
+        fmt_i32(b, value);
+        return;
+    }
+    char tmp[U32_DIGITS_MAX + 3];  // Sign, leading zero and point
+    uint32_t mag = (value < 0) ? (uint32_t)(-(value + 1)) + 1u : (uint32_t)value;
+    uint32_t scale = 1;
+    for (uint8_t i = 0; i < decimals; i++) {
+        scale *= 10u;
+    }
+    char *end = tmp + sizeof(tmp);
+    char *p = u32_digits(end, mag % scale, decimals);
+    *--p = '.';
+    p = u32_digits(p, mag / scale, 1);
+    if (value < 0) {
+        *--p = '-';
+    }
+    put(b, p, (size_t)(end - p));
+}
+
+// Comma and "key": in front of a JSON value
+static void json_key(fmt_buf_t *b, const char *key) {
+    if (b->need_comma) {
+        put(b, ",", 1);
+    }
+    if (key != NULL) {
+        put(b, "\"", 1);
+        fmt_str(b, key);
+        put(b, "\":", 2);
+    }
+    b->need_comma = true;
+}
+
+void fmt_json_object_begin(fmt_buf_t *b, const char *key) {
+    json_key(b, key);
+    put(b, "{", 1);
+    b->need_comma = false;
+}
+
+void fmt_json_object_end(fmt_buf_t *b) {
+    put(b, "}", 1);
+    b->need_comma = true;
+}
+
+void fmt_json_array_begin(fmt_buf_t *b, const char *key) {
+    json_key(b, key);
+    put(b, "[", 1);
+    b->need_comma = false;
+}
+
+void fmt_json_array_end(fmt_buf_t *b) {
+    put(b, "]", 1);
+    b->need_comma = true;
+}
+
+void fmt_json_u32(fmt_buf_t *b, const char *key, uint32_t value) {
+    json_key(b, key);
+    fmt_u32(b, value);
+}
+
+void fmt_json_i32(fmt_buf_t *b, const char *key, int32_t value) {
+    json_key(b, key);
+    fmt_i32(b, value);
+}
+
+void fmt_json_fixed(fmt_buf_t *b, const char *key, int32_t value, uint8_t decimals) {
+    json_key(b, key);
+    fmt_fixed(b, value, decimals);
+}
+
+void fmt_json_bool(fmt_buf_t *b, const char *key, bool value) {
+    json_key(b, key);
+    fmt_str(b, value ? "true" : "false");
+}
+
+void fmt_json_str(fmt_buf_t *b, const char *key, const char *value) {
+    json_key(b, key);
+    put(b, "\"", 1);
+    fmt_str(b, value);
+    put(b, "\"", 1);
+}
@@ -0,0 +1,73 @@
+/**
+ * File: fmt.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the integer-only text formatter. Emitters append unsigned, signed and fixed-decimal
+ * numbers, strings and JSON fields to a caller-provided buffer without going through printf, so payload generation
+ * neither parses a format string nor links the float printf path. Once an emitter runs out of room the buffer is
+ * marked as overflowed and every later emitter is a no-op; the result is checked once at the end.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef UTILS_FMT_H
+#define UTILS_FMT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FMT_FIXED_MAX_DECIMALS  9
+
+typedef struct {
+    char *buf;
+    size_t size;                // Capacity including the terminator
+    size_t len;                 // Characters written so far
+    bool overflow;              // An emitter did not fit
+    bool need_comma;            // Next JSON value is not the first of its object/array
+} fmt_buf_t;
+
+/**
+ * Start writing into buf (size bytes, including the terminator).
+ */
+void fmt_init(fmt_buf_t *b, char *buf, size_t size);
+
+/**
+ * Terminate the string. Returns its length, or 0 if anything overflowed.
+ */
+size_t fmt_finish(fmt_buf_t *b);
+
+void fmt_char(fmt_buf_t *b, char c);
+void fmt_str(fmt_buf_t *b, const char *s);
+void fmt_u32(fmt_buf_t *b, uint32_t value);
+void fmt_i32(fmt_buf_t *b, int32_t value);
+
+/**
+ * Fixed-point decimal: value / 10^decimals with exactly `decimals` fraction digits.
+ * fmt_fixed(b, -305, 2) -> "-3.05". decimals above FMT_FIXED_MAX_DECIMALS mark an overflow.
+ */
+void fmt_fixed(fmt_buf_t *b, int32_t value, uint8_t decimals);
+
+/**
+ * JSON containers. key is NULL at the top level and for array elements.
+ * Commas between values are inserted automatically.
+ */
+void fmt_json_object_begin(fmt_buf_t *b, const char *key);
+void fmt_json_object_end(fmt_buf_t *b);
+void fmt_json_array_begin(fmt_buf_t *b, const char *key);
+void fmt_json_array_end(fmt_buf_t *b);
+
+/**
+ * JSON values, as "key":value fields or (key NULL) array elements.
+ * Strings are not escaped: keys and string values must be plain ASCII without quotes or backslashes.
+ */
+void fmt_json_u32(fmt_buf_t *b, const char *key, uint32_t value);
+void fmt_json_i32(fmt_buf_t *b, const char *key, int32_t value);
+void fmt_json_fixed(fmt_buf_t *b, const char *key, int32_t value, uint8_t decimals);
+void fmt_json_bool(fmt_buf_t *b, const char *key, bool value);
+void fmt_json_str(fmt_buf_t *b, const char *key, const char *value);
+
+#endif // UTILS_FMT_H
@@ -0,0 +1,181 @@
+/**
+ * File: mem_pool.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the fixed-block memory pool.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "mem_pool.h"
+
+#include <string.h>
+
+#ifndef MEM_POOL_HOST_LOCK
+#include "hardware/sync.h"
+#endif
+
+static mem_pool_t *pool_registry[MEM_POOL_MAX_POOLS];
+static size_t pool_registered;
+
+#ifdef MEM_POOL_HOST_LOCK
+typedef int pool_irq_state_t;
+
+static pool_irq_state_t pool_lock(mem_pool_t *pool) {
+    while (atomic_flag_test_and_set_explicit(&pool->lock, memory_order_acquire)) {
+    }
+    return 0;
+}
+
+static void pool_unlock(mem_pool_t *pool, pool_irq_state_t state) {
+    (void)state;
+    atomic_flag_clear_explicit(&pool->lock, memory_order_release);
+}
+#else
+typedef uint32_t pool_irq_state_t;
+
+// Disables interrupts on this core and takes the spin lock against the other core
+static pool_irq_state_t pool_lock(mem_pool_t *pool) {
+    return spin_lock_blocking(spin_lock_instance(pool->lock_num));
+}
+
+static void pool_unlock(mem_pool_t *pool, pool_irq_state_t state) {
+    spin_unlock(spin_lock_instance(pool->lock_num), state);
+}
+#endif
+
+bool mem_pool_init(mem_pool_t *pool, const char *name, void *storage, size_t block_size, uint16_t block_count) {
+    if (pool == NULL || storage == NULL || block_size == 0 || block_count == 0 || block_count > MEM_POOL_MAX_BLOCKS ||
+        ((uintptr_t)storage % MEM_POOL_ALIGN) != 0) {
+        return false;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    pool->name = (name != NULL) ? name : "?";
+    pool->storage = storage;
+    pool->stride = MEM_POOL_BLOCK_STRIDE(block_size);
+    pool->block_size = block_size;
+    pool->block_count = block_count;
+#ifdef MEM_POOL_HOST_LOCK
+    atomic_flag_clear(&pool->lock);
+#else
+    pool->lock_num = next_striped_spin_lock_num();
+#endif
+
+    // Thread the free list in address order so fresh pools hand out blocks front to back
+    for (uint16_t i = 0; i < block_count; i++) {
+        uint8_t *block = pool->storage + (size_t)i * pool->stride;
+        *(void **)block = (i + 1u < block_count) ? block + pool->stride : NULL;
+    }
+    pool->free_head = pool->storage;
+
+    // Re-initializing a pool keeps its registry slot
+    for (size_t i = 0; i < pool_registered; i++) {
+        if (pool_registry[i] == pool) {
+            return true;
+        }
+    }
+    if (pool_registered < MEM_POOL_MAX_POOLS) {
+        pool_registry[pool_registered++] = pool;
+    }
+    return true;
+}
+
+// Allocation bit of a block of the pool
+static uint32_t *block_word(mem_pool_t *pool, const void *block, uint32_t *bit) {
+    size_t index = (size_t)((const uint8_t *)block - pool->storage) / pool->stride;
+    *bit = 1u << (index % 32u);
+    return &pool->allocated[index / 32u];
+}
+
+void *mem_pool_alloc(mem_pool_t *pool) {
+    if (pool == NULL || pool->storage == NULL) {
+        return NULL;
+    }
+    pool_irq_state_t state = pool_lock(pool);
+    void *block = pool->free_head;
+    if (block != NULL) {
+        pool->free_head = *(void **)block;
+        uint32_t bit;
+        *block_word(pool, block, &bit) |= bit;
+        pool->in_use++;
+        pool->allocs++;
+        if (pool->in_use > pool->high_water) {
+            pool->high_water = pool->in_use;
+        }
+    } else {
+        pool->exhausted++;
+    }
+    pool_unlock(pool, state);
+    return block;
+}
+
+bool mem_pool_owns(const mem_pool_t *pool, const void *block) {
+    if (pool == NULL || pool->storage == NULL || block == NULL) {
+        return false;
+    }
+    uintptr_t start = (uintptr_t)pool->storage;
+    uintptr_t addr = (uintptr_t)block;
+    return addr >= start && addr < start + pool->stride * pool->block_count && (addr - start) % pool->stride == 0;
+}
+
+void mem_pool_free(mem_pool_t *pool, void *block) {
+    if (pool == NULL || block == NULL) {
+        return;
+    }
+    bool valid = mem_pool_owns(pool, block);
+    pool_irq_state_t state = pool_lock(pool);
+    uint32_t bit = 0;
+    uint32_t *word = valid ? block_word(pool, block, &bit) : NULL;
+    // A block that is already free is on the list; linking it again would hand it out twice
+    if (word != NULL && (*word & bit) != 0) {
+        *word &= ~bit;
+        *(void **)block = pool->free_head;
+        pool->free_head = block;
+        pool->in_use--;
+    } else {
+        pool->invalid_frees++;
+    }
+    pool_unlock(pool, state);
+}
+
+uint16_t mem_pool_available(mem_pool_t *pool) {
+    if (pool == NULL) {
+        return 0;
+    }
+    pool_irq_state_t state = pool_lock(pool);
+    uint16_t available = (uint16_t)(pool->block_count - pool->in_use);
+    pool_unlock(pool, state);
+    return available;
+}
+
+void mem_pool_get_stats(mem_pool_t *pool, mem_pool_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (pool == NULL) {
+        return;
+    }
+    pool_irq_state_t state = pool_lock(pool);
+    stats->name = pool->name;
+    stats->block_size = pool->block_size;
+    stats->block_count = pool->block_count;
+    stats->in_use = pool->in_use;
+    stats->high_water = pool->high_water;
+    stats->allocs = pool->allocs;
+    stats->exhausted = pool->exhausted;
+    stats->invalid_frees = pool->invalid_frees;
+    pool_unlock(pool, state);
+}
+
+size_t mem_pool_count(void) {
+    return pool_registered;
+}
+
+mem_pool_t *mem_pool_at(size_t index) {
+    return (index < pool_registered) ? pool_registry[index] : NULL;
+}
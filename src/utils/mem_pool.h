@@ -0,0 +1,126 @@
+/**
+ * File: mem_pool.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the fixed-block memory pool. Each pool hands out blocks of one size from storage
+ * reserved at build time, so subsystems get O(1) allocation with no heap use and no fragmentation however long the
+ * device runs. Free blocks are kept on an intrusive free list, and a bitmap of allocated blocks turns a double free
+ * into a counted, ignored invalid free instead of a corrupted list. Every pool is named and keeps its own usage
+ * counters (blocks in use, high-water mark, exhaustion and invalid-free counts); initialized pools are registered so
+ * diagnostics can walk all of them. Allocation and release take a hardware spin lock with interrupts disabled and
+ * may be called from either core and from interrupt handlers.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef UTILS_MEM_POOL_H
+#define UTILS_MEM_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(PICO_ON_DEVICE) && !PICO_ON_DEVICE
+#include <stdatomic.h>
+#define MEM_POOL_HOST_LOCK      1       // Host builds (tests) spin on an atomic flag instead
+#endif
+
+#define MEM_POOL_ALIGN          8u      // Block alignment, enough for any scalar type
+#define MEM_POOL_MAX_POOLS      8       // Pools the registry can list
+#define MEM_POOL_MAX_BLOCKS     64      // Blocks per pool, bounded by the allocation bitmap
+
+// Size of one block once rounded up to the pool alignment
+#define MEM_POOL_BLOCK_STRIDE(block_size) \
+    ((((block_size) < sizeof(void *) ? sizeof(void *) : (block_size)) + MEM_POOL_ALIGN - 1u) & ~(size_t)(MEM_POOL_ALIGN - 1u))
+
+// Bytes of storage needed for block_count blocks of block_size
+#define MEM_POOL_STORAGE_SIZE(block_size, block_count)  (MEM_POOL_BLOCK_STRIDE(block_size) * (block_count))
+
+/**
+ * Reserve the storage of a pool as a static array; pass it to mem_pool_init().
+ * Example: MEM_POOL_STORAGE(log_lines, 96, 8);  mem_pool_init(&pool, "log", log_lines, 96, 8);
+ */
+#define MEM_POOL_STORAGE(var, block_size, block_count) \
+    static uint8_t var[MEM_POOL_STORAGE_SIZE(block_size, block_count)] __attribute__((aligned(MEM_POOL_ALIGN)))
+
+typedef struct {
+    const char *name;           // Shown in diagnostics
+    uint8_t *storage;
+    size_t stride;              // Block size rounded up to MEM_POOL_ALIGN
+    size_t block_size;          // Requested block size
+    uint16_t block_count;
+    void *free_head;            // Intrusive free list through the first word of free blocks
+    uint32_t allocated[(MEM_POOL_MAX_BLOCKS + 31) / 32];    // Bit per block handed out
+    uint16_t in_use;            // Blocks handed out now
+    uint16_t high_water;        // Most blocks ever in use at once
+    uint32_t allocs;            // Successful allocations
+    uint32_t exhausted;         // Allocations refused because the pool was empty
+    uint32_t invalid_frees;     // Frees of pointers that are not a block of this pool, or of a free block
+#ifdef MEM_POOL_HOST_LOCK
+    atomic_flag lock;
+#else
+    uint32_t lock_num;          // Striped hardware spin lock
+#endif
+} mem_pool_t;
+
+// Usage counters of one pool, copied under its lock
+typedef struct {
+    const char *name;
+    size_t block_size;
+    uint16_t block_count;
+    uint16_t in_use;
+    uint16_t high_water;
+    uint32_t allocs;
+    uint32_t exhausted;
+    uint32_t invalid_frees;
+} mem_pool_stats_t;
+
+/**
+ * Initialize a pool over caller-provided storage of at least MEM_POOL_STORAGE_SIZE(block_size, block_count)
+ * bytes, aligned to MEM_POOL_ALIGN, and register it. All blocks start free and the counters are cleared.
+ * block_count is at most MEM_POOL_MAX_BLOCKS.
+ * Must not race with other calls on the same pool.
+ * Returns false on invalid arguments or misaligned storage.
+ */
+bool mem_pool_init(mem_pool_t *pool, const char *name, void *storage, size_t block_size, uint16_t block_count);
+
+/**
+ * Take a block. Returns NULL (and counts an exhaustion) if none is free.
+ */
+void *mem_pool_alloc(mem_pool_t *pool);
+
+/**
+ * Give a block back. NULL is ignored; pointers outside the pool or not at a block start, and blocks that are
+ * already free (double free), are counted as invalid frees and ignored.
+ */
+void mem_pool_free(mem_pool_t *pool, void *block);
+
+/**
+ * Number of free blocks.
+ */
+uint16_t mem_pool_available(mem_pool_t *pool);
+
+/**
+ * True if block is a block of this pool (free or not).
+ */
+bool mem_pool_owns(const mem_pool_t *pool, const void *block);
+
+/**
+ * Copy the usage counters of a pool.
+ */
+void mem_pool_get_stats(mem_pool_t *pool, mem_pool_stats_t *stats);
+
+/**
+ * Number of registered pools. Pools beyond MEM_POOL_MAX_POOLS still work but are not listed.
+ */
+size_t mem_pool_count(void);
+
+/**
+ * Registered pool by index, in initialization order. Returns NULL if out of range.
+ */
+mem_pool_t *mem_pool_at(size_t index);
+
+#endif // UTILS_MEM_POOL_H
@@ -0,0 +1,40 @@
+/**
+ * @file power_hal.h
+ * @author trung.la
+ * @date October 19 2026
+ * @brief Hardware Abstraction Layer of the power manager
+ * 
+ * Two ways to wait: idle (core waits for an event, all clocks running) and
+ * deep sleep (unused peripheral clocks gated, including the PMS7003 UART, until
+ * a timer alarm or an RX start bit). The real backend drives the RP2040; host
+ * tests use a fake with a simulated clock and scheduled RX edges.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#ifndef POWER_HAL_H
+#define POWER_HAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    POWER_WAKE_TIMER = 0,   // Deadline reached
+    POWER_WAKE_UART_RX      // Start bit on the sensor RX line
+} power_wake_t;
+
+/**
+ * @brief Power backend
+ */
+typedef struct {
+    // Wait with all clocks running until deadline_ms
+    void (*idle_until)(uint32_t deadline_ms);
+    // Deep sleep until deadline_ms or, if rx_wake, an RX start bit; peripheral state is restored on return
+    power_wake_t (*sleep_until)(uint32_t deadline_ms, bool rx_wake);
+    uint32_t (*now_ms)(void);
+} power_hal_t;
+
+// Get the RP2040 backend
+const power_hal_t *power_get_pico_hal(void);
+
+#endif // POWER_HAL_H
@@ -0,0 +1,127 @@
+/**
+ * @file power_hal_pico.c
+ * @author trung.la
+ * @date October 19 2026
+ * @brief RP2040 implementation of the power HAL using Pico SDK
+ * 
+ * Deep sleep sets SLEEPDEEP and narrows the SLEEP_EN masks, so while the core
+ * sleeps in WFI the clocks of unused blocks and of both UARTs are stopped. PIO,
+ * DMA, GPIO and the timer keep running: the CYW43 link, lwIP timers and the PIO
+ * UART rings carry on in their interrupts, after which the core goes back to
+ * sleep. A hardware alarm ends the sleep at the deadline; a falling edge on the
+ * PMS7003 RX pin (start bit) ends it early so the UART is clocked again before
+ * the frame arrives. Dormant mode is not used: it stops the crystal and with it
+ * the timer, the Wi-Fi link and every time base of the firmware.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ */
+
+#include "power_hal.h"
+#include "pin_config.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "hardware/structs/scb.h"
+#include "pico/time.h"
+
+// Clocks stopped in deep sleep on top of the ones the core gates itself
+#define SLEEP_GATED_EN0 (CLOCKS_SLEEP_EN0_CLK_SYS_SPI1_BITS | CLOCKS_SLEEP_EN0_CLK_PERI_SPI1_BITS | \
+                         CLOCKS_SLEEP_EN0_CLK_SYS_SPI0_BITS | CLOCKS_SLEEP_EN0_CLK_PERI_SPI0_BITS | \
+                         CLOCKS_SLEEP_EN0_CLK_SYS_RTC_BITS | CLOCKS_SLEEP_EN0_CLK_RTC_RTC_BITS | \
+                         CLOCKS_SLEEP_EN0_CLK_SYS_PWM_BITS | CLOCKS_SLEEP_EN0_CLK_SYS_JTAG_BITS | \
+                         CLOCKS_SLEEP_EN0_CLK_SYS_ADC_BITS | CLOCKS_SLEEP_EN0_CLK_ADC_ADC_BITS)
+#define SLEEP_GATED_EN1 (CLOCKS_SLEEP_EN1_CLK_USB_USBCTRL_BITS | CLOCKS_SLEEP_EN1_CLK_SYS_USBCTRL_BITS | \
+                         CLOCKS_SLEEP_EN1_CLK_SYS_UART1_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_UART1_BITS | \
+                         CLOCKS_SLEEP_EN1_CLK_SYS_UART0_BITS | CLOCKS_SLEEP_EN1_CLK_PERI_UART0_BITS | \
+                         CLOCKS_SLEEP_EN1_CLK_SYS_TBMAN_BITS)
+
+static int alarm_num = -1;
+static bool rx_irq_installed = false;
+static volatile bool timer_fired;
+static volatile bool rx_edge;
+
+static uint32_t pico_now_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+static void sleep_alarm_cb(uint alarm) {
+    (void)alarm;
+    timer_fired = true;
+}
+
+static void rx_edge_irq(void) {
+    if (gpio_get_irq_event_mask(PMS_RX_PIN) & GPIO_IRQ_EDGE_FALL) {
+        gpio_acknowledge_irq(PMS_RX_PIN, GPIO_IRQ_EDGE_FALL);
+        gpio_set_irq_enabled(PMS_RX_PIN, GPIO_IRQ_EDGE_FALL, false);
+        rx_edge = true;
+    }
+}
+
+static void pico_idle_until(uint32_t deadline_ms) {
+    int32_t left = (int32_t)(deadline_ms - pico_now_ms());
+    if (left > 0) {
+        sleep_ms((uint32_t)left);
+    }
+}
+
+static power_wake_t pico_sleep_until(uint32_t deadline_ms, bool rx_wake) {
+    int32_t left = (int32_t)(deadline_ms - pico_now_ms());
+    if (left <= 0) {
+        return POWER_WAKE_TIMER;
+    }
+    if (alarm_num < 0) {
+        alarm_num = hardware_alarm_claim_unused(true);
+        hardware_alarm_set_callback((uint)alarm_num, sleep_alarm_cb);
+    }
+    timer_fired = false;
+    rx_edge = false;
+    if (hardware_alarm_set_target((uint)alarm_num, make_timeout_time_ms((uint32_t)left))) {
+        return POWER_WAKE_TIMER;
+    }
+    if (rx_wake) {
+        if (!rx_irq_installed) {
+            gpio_add_raw_irq_handler(PMS_RX_PIN, rx_edge_irq);
+            irq_set_enabled(IO_IRQ_BANK0, true);
+            rx_irq_installed = true;
+        }
+        gpio_acknowledge_irq(PMS_RX_PIN, GPIO_IRQ_EDGE_FALL);
+        gpio_set_irq_enabled(PMS_RX_PIN, GPIO_IRQ_EDGE_FALL, true);
+    }
+
+    uint32_t sleep_en0 = clocks_hw->sleep_en0;
+    uint32_t sleep_en1 = clocks_hw->sleep_en1;
+    clocks_hw->sleep_en0 = sleep_en0 & ~SLEEP_GATED_EN0;
+    clocks_hw->sleep_en1 = sleep_en1 & ~SLEEP_GATED_EN1;
+    scb_hw->scr |= M0PLUS_SCR_SLEEPDEEP_BITS;
+
+    // Interrupts stay masked between the flag check and WFI, so a wake-up in between is not lost;
+    // other interrupts (Wi-Fi, lwIP, PIO UART DMA) run in the gap and the core goes back to sleep
+    uint32_t save = save_and_disable_interrupts();
+    while (!timer_fired && !rx_edge) {
+        __wfi();
+        restore_interrupts(save);
+        save = save_and_disable_interrupts();
+    }
+    restore_interrupts(save);
+
+    scb_hw->scr &= ~M0PLUS_SCR_SLEEPDEEP_BITS;
+    clocks_hw->sleep_en0 = sleep_en0;
+    clocks_hw->sleep_en1 = sleep_en1;
+    hardware_alarm_cancel((uint)alarm_num);
+    if (rx_wake) {
+        gpio_set_irq_enabled(PMS_RX_PIN, GPIO_IRQ_EDGE_FALL, false);
+    }
+    return rx_edge ? POWER_WAKE_UART_RX : POWER_WAKE_TIMER;
+}
+
+static const power_hal_t pico_hal = {
+    .idle_until = pico_idle_until,
+    .sleep_until = pico_sleep_until,
+    .now_ms = pico_now_ms
+};
+
+const power_hal_t *power_get_pico_hal(void) {
+    return &pico_hal;
+}
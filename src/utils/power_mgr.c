@@ -0,0 +1,118 @@
+/**
+ * File: power_mgr.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the power manager.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "power_mgr.h"
+
+#include <string.h>
+
+typedef struct {
+    power_wake_fn fn;
+    void *ctx;
+} power_listener_t;
+
+static struct {
+    power_mgr_config_t config;
+    const power_hal_t *hal;
+    bool rx_wake;
+    uint32_t run_since_ms;          // End of the last wait
+    power_listener_t listeners[POWER_MGR_MAX_LISTENERS];
+    uint8_t listener_count;
+    power_mgr_stats_t stats;
+} power;
+
+power_mgr_config_t power_mgr_default_config(void) {
+    power_mgr_config_t config = {
+        .min_sleep_ms = POWER_MGR_DEFAULT_MIN_SLEEP_MS,
+        .rx_hold_ms = POWER_MGR_DEFAULT_RX_HOLD_MS
+    };
+    return config;
+}
+
+bool power_mgr_init(const power_mgr_config_t *config, const power_hal_t *hal) {
+    memset(&power, 0, sizeof(power));
+    if (hal == NULL) {
+        return false;
+    }
+    power.config = (config != NULL) ? *config : power_mgr_default_config();
+    power.hal = hal;
+    power.run_since_ms = hal->now_ms();
+    return true;
+}
+
+bool power_mgr_add_listener(power_wake_fn fn, void *ctx) {
+    if (fn == NULL || power.listener_count >= POWER_MGR_MAX_LISTENERS) {
+        return false;
+    }
+    power.listeners[power.listener_count].fn = fn;
+    power.listeners[power.listener_count].ctx = ctx;
+    power.listener_count++;
+    return true;
+}
+
+void power_mgr_set_rx_wake(bool enable) {
+    power.rx_wake = enable;
+}
+
+static void idle_until(uint32_t deadline_ms) {
+    uint32_t from = power.hal->now_ms();
+    power.hal->idle_until(deadline_ms);
+    power.stats.residency_ms[POWER_STATE_IDLE] += power.hal->now_ms() - from;
+}
+
+void power_mgr_wait_until(uint32_t deadline_ms) {
+    if (power.hal == NULL) {
+        return;
+    }
+    power.stats.residency_ms[POWER_STATE_RUN] += power.hal->now_ms() - power.run_since_ms;
+    int32_t left;
+    while ((left = (int32_t)(deadline_ms - power.hal->now_ms())) > 0) {
+        if ((uint32_t)left < power.config.min_sleep_ms) {
+            power.stats.short_waits++;
+            idle_until(deadline_ms);
+            continue;
+        }
+
+        uint32_t from = power.hal->now_ms();
+        power_wake_t cause = power.hal->sleep_until(deadline_ms, power.rx_wake);
+        uint32_t to = power.hal->now_ms();
+        power.stats.residency_ms[POWER_STATE_SLEEP] += to - from;
+        power.stats.sleeps++;
+        if (cause == POWER_WAKE_UART_RX) {
+            power.stats.rx_wakes++;
+            // Keep the UART clocked until the frame is in, then resynchronise before anyone parses it
+            uint32_t hold_end = to + power.config.rx_hold_ms;
+            idle_until(((int32_t)(hold_end - deadline_ms) < 0) ? hold_end : deadline_ms);
+        } else {
+            power.stats.timer_wakes++;
+        }
+        for (uint8_t i = 0; i < power.listener_count; i++) {
+            power.listeners[i].fn(cause, power.listeners[i].ctx);
+        }
+    }
+    power.run_since_ms = power.hal->now_ms();
+}
+
+void power_mgr_get_stats(power_mgr_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    *stats = power.stats;
+    if (power.hal != NULL) {
+        stats->residency_ms[POWER_STATE_RUN] += power.hal->now_ms() - power.run_since_ms;
+    }
+    uint64_t total = 0;
+    for (int i = 0; i < POWER_STATE_COUNT; i++) {
+        total += stats->residency_ms[i];
+    }
+    stats->sleep_permille = (total > 0) ?
+        (uint16_t)((stats->residency_ms[POWER_STATE_SLEEP] * 1000u + total / 2) / total) : 0;
+}
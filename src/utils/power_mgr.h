@@ -0,0 +1,85 @@
+/**
+ * File: power_mgr.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the power manager. Waits between scheduled tasks are spent in deep sleep instead of
+ * an idle loop with every clock running. Waits shorter than the sleep overhead stay idle. A start bit from the
+ * PMS7003 ends a deep sleep early: the manager then idles for the length of a frame so the UART receives it, tells
+ * the listeners (which resynchronise the frame parser, since the first byte may have been missed) and sleeps again
+ * until the deadline. Time spent running, idle and in deep sleep is accounted separately. Call from thread context
+ * only.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef UTILS_POWER_MGR_H
+#define UTILS_POWER_MGR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "power_hal.h"
+
+#define POWER_MGR_DEFAULT_MIN_SLEEP_MS  5   // Shorter waits are not worth entering deep sleep
+#define POWER_MGR_DEFAULT_RX_HOLD_MS    40  // One PMS7003 frame at 9600 baud plus margin
+#define POWER_MGR_MAX_LISTENERS         2
+
+typedef enum {
+    POWER_STATE_RUN = 0,
+    POWER_STATE_IDLE,           // Waiting, all clocks running
+    POWER_STATE_SLEEP,          // Deep sleep, peripheral clocks gated
+    POWER_STATE_COUNT
+} power_state_t;
+
+typedef struct {
+    uint32_t min_sleep_ms;
+    uint32_t rx_hold_ms;        // Idle time after an RX wake-up
+} power_mgr_config_t;
+
+typedef struct {
+    uint64_t residency_ms[POWER_STATE_COUNT];
+    uint32_t sleeps;            // Deep sleeps entered
+    uint32_t timer_wakes;
+    uint32_t rx_wakes;
+    uint32_t short_waits;       // Waits spent idle because they were too short to sleep
+    uint16_t sleep_permille;    // Share of time in deep sleep
+} power_mgr_stats_t;
+
+// Called after a deep sleep ended with the given cause
+typedef void (*power_wake_fn)(power_wake_t cause, void *ctx);
+
+/**
+ * Default configuration.
+ */
+power_mgr_config_t power_mgr_default_config(void);
+
+/**
+ * Initialize the manager; time from here on is accounted.
+ * @param config Configuration, or NULL for the defaults
+ */
+bool power_mgr_init(const power_mgr_config_t *config, const power_hal_t *hal);
+
+/**
+ * Register a wake listener. Returns false if POWER_MGR_MAX_LISTENERS are registered.
+ */
+bool power_mgr_add_listener(power_wake_fn fn, void *ctx);
+
+/**
+ * Let RX start bits end a deep sleep. Enable while the sensors stream frames, disable while they are parked.
+ */
+void power_mgr_set_rx_wake(bool enable);
+
+/**
+ * Wait until deadline_ms in the lowest power state that fits. Returns at the deadline.
+ */
+void power_mgr_wait_until(uint32_t deadline_ms);
+
+/**
+ * Snapshot of the counters, with the time up to now.
+ */
+void power_mgr_get_stats(power_mgr_stats_t *stats);
+
+#endif // UTILS_POWER_MGR_H
@@ -0,0 +1,315 @@
+/**
+ * File: runtime_config.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the runtime configuration.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "runtime_config.h"
+#include "seqlock.h"
+#include "adaptive_rate.h"
+#include "report_by_exception.h"
+#include "mqtt_config.h"
+
+#include <string.h>
+
+// Value limits; the checks across keys are in validate()
+#define SAMPLE_MIN_MS       1000u               // The PMS7003 sends one frame per second at most
+#define SAMPLE_MAX_MS       (24u * 3600u * 1000u)
+#define HEARTBEAT_MAX_MS    (24u * 3600u * 1000u)
+#define DEADBAND_MASS_MAX   1000u
+#define DEADBAND_PCT_MAX    1000u               // 100 %
+#define WINDOW_MIN_MS       1000u
+// Pings go out in publish windows only, so a longer period would let the broker drop the session between two
+#define WINDOW_PERIOD_MAX_MS    (MQTT_KEEP_ALIVE_S * 1000u)
+#define WINDOW_OPEN_MIN_MS  100u
+#define BULK_RATE_MIN       64u                 // Below this one diagnostics message takes several seconds
+#define BULK_RATE_MAX       65535u
+
+typedef enum {
+    KEY_VERSION,
+    KEY_RATE,
+    KEY_SLOW,
+    KEY_HEARTBEAT,
+    KEY_DEADBAND,
+    KEY_DEADBAND_COUNT,
+    KEY_DEADBAND_PCT,
+    KEY_WINDOW,
+    KEY_WINDOW_MAX,
+    KEY_BULK,
+    KEY_COUNT
+} config_key_t;
+
+static const char *const KEY_NAMES[KEY_COUNT] = {
+    [KEY_VERSION] = "v",
+    [KEY_RATE] = "rate",
+    [KEY_SLOW] = "slow",
+    [KEY_HEARTBEAT] = "hb",
+    [KEY_DEADBAND] = "db",
+    [KEY_DEADBAND_COUNT] = "dbn",
+    [KEY_DEADBAND_PCT] = "dbp",
+    [KEY_WINDOW] = "win",
+    [KEY_WINDOW_MAX] = "winmax",
+    [KEY_BULK] = "bulk"
+};
+
+void runtime_config_default(runtime_config_t *config) {
+    if (config == NULL) {
+        return;
+    }
+    memset(config, 0, sizeof(*config));
+    config->sample_min_ms = ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS;
+    config->sample_max_ms = ADAPTIVE_RATE_DEFAULT_MAX_INTERVAL_MS;
+    config->heartbeat_ms = RBE_DEFAULT_HEARTBEAT_MS;
+    config->deadband_mass = RBE_DEFAULT_DEADBAND_MASS;
+    config->deadband_count = RBE_DEFAULT_DEADBAND_COUNT;
+    config->deadband_pct_x10 = RBE_DEFAULT_DEADBAND_PCT_X10;
+    config->window_ms = MQTT_PUBLISH_WINDOW_MS;
+    config->window_max_ms = MQTT_WINDOW_MAX_MS;
+    config->bulk_rate_bps = MQTT_BULK_RATE_BPS;
+}
+
+static int find_key(const char *name, size_t len) {
+    for (int k = 0; k < KEY_COUNT; k++) {
+        if (strlen(KEY_NAMES[k]) == len && memcmp(KEY_NAMES[k], name, len) == 0) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+static runtime_config_result_t set_key(runtime_config_t *c, config_key_t key, uint32_t v) {
+    switch (key) {
+    case KEY_VERSION:
+        c->version = v;
+        break;
+    case KEY_RATE:
+        c->sample_min_ms = v;
+        break;
+    case KEY_SLOW:
+        c->sample_max_ms = v;
+        break;
+    case KEY_HEARTBEAT:
+        c->heartbeat_ms = v;
+        break;
+    case KEY_DEADBAND:
+        if (v > DEADBAND_MASS_MAX) {
+            return RUNTIME_CONFIG_RANGE;
+        }
+        c->deadband_mass = (uint16_t)v;
+        break;
+    case KEY_DEADBAND_COUNT:
+        if (v > UINT16_MAX) {
+            return RUNTIME_CONFIG_RANGE;
+        }
+        c->deadband_count = (uint16_t)v;
+        break;
+    case KEY_DEADBAND_PCT:
+        if (v > DEADBAND_PCT_MAX) {
+            return RUNTIME_CONFIG_RANGE;
+        }
+        c->deadband_pct_x10 = (uint16_t)v;
+        break;
+    case KEY_WINDOW:
+        c->window_ms = v;
+        break;
+    case KEY_WINDOW_MAX:
+        c->window_max_ms = v;
+        break;
+    case KEY_BULK:
+        c->bulk_rate_bps = v;
+        break;
+    default:
+        return RUNTIME_CONFIG_UNKNOWN_KEY;
+    }
+    return RUNTIME_CONFIG_OK;
+}
+
+static runtime_config_result_t validate(const runtime_config_t *c) {
+    if (c->version == 0) {
+        return RUNTIME_CONFIG_NO_VERSION;
+    }
+    if (c->sample_min_ms < SAMPLE_MIN_MS || c->sample_max_ms > SAMPLE_MAX_MS ||
+        c->sample_max_ms < c->sample_min_ms) {
+        return RUNTIME_CONFIG_RANGE;
+    }
+    if (c->heartbeat_ms > HEARTBEAT_MAX_MS) {
+        return RUNTIME_CONFIG_RANGE;
+    }
+    if (c->window_ms != 0) {
+        if (c->window_ms < WINDOW_MIN_MS || c->window_ms > WINDOW_PERIOD_MAX_MS ||
+            c->window_max_ms < WINDOW_OPEN_MIN_MS || c->window_max_ms > c->window_ms) {
+            return RUNTIME_CONFIG_RANGE;
+        }
+    }
+    if (c->bulk_rate_bps != 0 && (c->bulk_rate_bps < BULK_RATE_MIN || c->bulk_rate_bps > BULK_RATE_MAX)) {
+        return RUNTIME_CONFIG_RANGE;
+    }
+    return RUNTIME_CONFIG_OK;
+}
+
+runtime_config_result_t runtime_config_parse(const char *text, size_t len, runtime_config_t *config) {
+    if (text == NULL || config == NULL || len == 0 || len > RUNTIME_CONFIG_TEXT_MAX) {
+        return RUNTIME_CONFIG_SYNTAX;
+    }
+    runtime_config_t c;
+    runtime_config_default(&c);
+    uint16_t seen = 0;
+
+    size_t i = 0;
+    while (i < len) {
+        if (text[i] == ' ' || text[i] == ',') {
+            i++;
+            continue;
+        }
+        // key
+        size_t key_start = i;
+        while (i < len && text[i] >= 'a' && text[i] <= 'z') {
+            i++;
+        }
+        if (i == key_start || i >= len || text[i] != '=') {
+            return RUNTIME_CONFIG_SYNTAX;
+        }
+        int key = find_key(&text[key_start], i - key_start);
+        i++;
+        // value: decimal, at most 10 digits and no overflow
+        uint64_t v = 0;
+        size_t digits = 0;
+        while (i < len && text[i] >= '0' && text[i] <= '9') {
+            v = v * 10u + (uint64_t)(text[i] - '0');
+            if (++digits > 10) {
+                return RUNTIME_CONFIG_SYNTAX;
+            }
+            i++;
+        }
+        if (digits == 0 || (i < len && text[i] != ' ' && text[i] != ',')) {
+            return RUNTIME_CONFIG_SYNTAX;
+        }
+        if (key < 0) {
+            return RUNTIME_CONFIG_UNKNOWN_KEY;
+        }
+        if (v > UINT32_MAX) {
+            return RUNTIME_CONFIG_RANGE;
+        }
+        if ((seen & (1u << key)) != 0) {
+            return RUNTIME_CONFIG_SYNTAX;   // Repeated key
+        }
+        seen |= (uint16_t)(1u << key);
+        runtime_config_result_t result = set_key(&c, (config_key_t)key, (uint32_t)v);
+        if (result != RUNTIME_CONFIG_OK) {
+            return result;
+        }
+    }
+
+    runtime_config_result_t result = validate(&c);
+    if (result == RUNTIME_CONFIG_OK) {
+        *config = c;
+    }
+    return result;
+}
+
+const char *runtime_config_result_name(runtime_config_result_t result) {
+    switch (result) {
+    case RUNTIME_CONFIG_OK:
+        return "ok";
+    case RUNTIME_CONFIG_STALE:
+        return "stale";
+    case RUNTIME_CONFIG_SYNTAX:
+        return "syntax";
+    case RUNTIME_CONFIG_UNKNOWN_KEY:
+        return "unknown_key";
+    case RUNTIME_CONFIG_RANGE:
+        return "range";
+    case RUNTIME_CONFIG_NO_VERSION:
+        return "no_version";
+    default:
+        return "?";
+    }
+}
+
+void runtime_config_store_init(runtime_config_store_t *store) {
+    if (store == NULL) {
+        return;
+    }
+    memset(store, 0, sizeof(*store));
+    seqlock_init(&store->seq);
+    runtime_config_default(&store->config);
+}
+
+// Version field of a message, for the status even when the message is rejected
+static uint32_t message_version(const char *text, size_t len) {
+    uint32_t v = 0;
+    if (text == NULL) {
+        return 0;
+    }
+    for (size_t i = 0; i + 2 < len; i++) {
+        if (text[i] == 'v' && text[i + 1] == '=' && (i == 0 || text[i - 1] == ' ' || text[i - 1] == ',')) {
+            for (size_t j = i + 2; j < len && text[j] >= '0' && text[j] <= '9' && v < UINT32_MAX / 10u; j++) {
+                v = v * 10u + (uint32_t)(text[j] - '0');
+            }
+            break;
+        }
+    }
+    return v;
+}
+
+runtime_config_result_t runtime_config_store_update(runtime_config_store_t *store, const char *text, size_t len) {
+    if (store == NULL) {
+        return RUNTIME_CONFIG_SYNTAX;
+    }
+    runtime_config_t next;
+    runtime_config_result_t result = runtime_config_parse(text, len, &next);
+    uint32_t received = (result == RUNTIME_CONFIG_OK) ? next.version : message_version(text, len);
+    bool swap = false;
+    if (result == RUNTIME_CONFIG_OK) {
+        // The writer owns the store, so the active version needs no seqlock read
+        if (next.version < store->config.version) {
+            result = RUNTIME_CONFIG_STALE;
+        } else {
+            swap = next.version > store->config.version;
+        }
+    }
+
+    unsigned int seq = seqlock_write_begin(&store->seq);
+    if (swap) {
+        store->config = next;
+        store->status.applied++;
+    }
+    store->status.messages++;
+    store->status.received = received;
+    store->status.result = result;
+
+    seqlock_write_end(&store->seq, seq);
+    return result;
+}
+
+bool runtime_config_store_read(runtime_config_store_t *store, runtime_config_t *config,
+                               runtime_config_status_t *status) {
+    if (store == NULL) {
+        return false;
+    }
+    for (int attempt = 0; attempt < RUNTIME_CONFIG_READ_RETRIES; attempt++) {
+        unsigned int begin;
+        if (!seqlock_read_begin(&store->seq, &begin)) {
+            continue;
+        }
+        runtime_config_t c = store->config;
+        runtime_config_status_t s = store->status;
+        if (!seqlock_read_end(&store->seq, begin)) {
+            continue;
+        }
+        if (config != NULL) {
+            *config = c;
+        }
+        if (status != NULL) {
+            *status = s;
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,107 @@
+/**
+ * File: runtime_config.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the runtime configuration. Sampling range, report-by-exception deadbands and
+ * heartbeat, radio publish windows and bulk shaping can be changed over MQTT without reflashing. The broker keeps
+ * the configuration as a retained message of the form
+ *
+ *     v=7 rate=1000 slow=120000 hb=900000 db=2 dbn=30 dbp=100 win=30000 winmax=5000 bulk=512
+ *
+ * (keys separated by spaces or commas, all values decimal; "v" is required, omitted keys take their built-in
+ * default, so every message describes a whole configuration). A message is parsed in full before anything changes
+ * and is applied only if every key is known and in range and its version is newer than the active one. The store
+ * is a seqlock: the MQTT handler is the only writer, and the main loop copies a consistent configuration between
+ * samples, so a change never lands in the middle of an acquisition.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef UTILS_RUNTIME_CONFIG_H
+#define UTILS_RUNTIME_CONFIG_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define RUNTIME_CONFIG_TEXT_MAX         160     // Longest accepted message
+// A reader interrupting the writer on the same core would otherwise spin forever
+#define RUNTIME_CONFIG_READ_RETRIES     64
+
+typedef enum {
+    RUNTIME_CONFIG_OK = 0,
+    RUNTIME_CONFIG_STALE,           // Version not newer than the active one; nothing changed
+    RUNTIME_CONFIG_SYNTAX,          // Not key=value pairs, or too long
+    RUNTIME_CONFIG_UNKNOWN_KEY,
+    RUNTIME_CONFIG_RANGE,           // A value out of range, or inconsistent with another
+    RUNTIME_CONFIG_NO_VERSION       // "v" missing or 0
+} runtime_config_result_t;
+
+typedef struct {
+    uint32_t version;               // 0: built-in defaults
+    // Scheduler
+    uint32_t sample_min_ms;         // rate: fastest adaptive sampling interval
+    uint32_t sample_max_ms;         // slow: slowest adaptive sampling interval (sensors park when it allows)
+    // Publisher: report by exception
+    uint32_t heartbeat_ms;          // hb: longest silence between reports
+    uint16_t deadband_mass;         // db: absolute deadband of the PM mass fields, ug/m3
+    uint16_t deadband_count;        // dbn: absolute deadband of the particle counts, per 0.1 L
+    uint16_t deadband_pct_x10;      // dbp: relative deadband of every field, 0.1 % of the last report
+    // Publisher: radio and bandwidth
+    uint32_t window_ms;             // win: publish window period, at most the MQTT keep-alive; 0 radio always on
+    uint32_t window_max_ms;         // winmax: longest window, caps the radio duty cycle
+    uint32_t bulk_rate_bps;         // bulk: telemetry lane shaping in bytes per second; 0 unshaped
+} runtime_config_t;
+
+typedef struct {
+    uint32_t messages;              // Configuration messages received
+    uint32_t applied;               // Of those, accepted and swapped in
+    uint32_t received;              // Version of the last message (0 if it had none)
+    runtime_config_result_t result; // Outcome of the last message
+} runtime_config_status_t;
+
+typedef struct {
+    atomic_uint seq;                // Odd while the writer is updating
+    runtime_config_t config;
+    runtime_config_status_t status;
+} runtime_config_store_t;
+
+/**
+ * Built-in configuration (version 0): the compile-time defaults of the modules it tunes.
+ */
+void runtime_config_default(runtime_config_t *config);
+
+/**
+ * Parse a configuration message into config; omitted keys take their default. config is written only on success.
+ */
+runtime_config_result_t runtime_config_parse(const char *text, size_t len, runtime_config_t *config);
+
+/**
+ * Short name of a result for the status topic.
+ */
+const char *runtime_config_result_name(runtime_config_result_t result);
+
+/**
+ * Initialize the store with the built-in configuration.
+ */
+void runtime_config_store_init(runtime_config_store_t *store);
+
+/**
+ * Parse a message and, if it is valid and newer, swap it in. Single writer. A message with the active version is
+ * accepted without a change, so a retained configuration delivered again is harmless.
+ * @return Result, also recorded in the store status
+ */
+runtime_config_result_t runtime_config_store_update(runtime_config_store_t *store, const char *text, size_t len);
+
+/**
+ * Consistent copy of the active configuration and the status of the last message (either may be NULL).
+ * @return False if the writer kept the store busy for RUNTIME_CONFIG_READ_RETRIES attempts
+ */
+bool runtime_config_store_read(runtime_config_store_t *store, runtime_config_t *config,
+                               runtime_config_status_t *status);
+
+#endif // UTILS_RUNTIME_CONFIG_H
@@ -0,0 +1,74 @@
+/**
+ * File: sample_cache.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Implementation file for the seqlock-protected latest-sample cache.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "sample_cache.h"
+#include "seqlock.h"
+
+#include <string.h>
+
+void sample_cache_init(sample_cache_t *cache, uint32_t max_age_ms) {
+    if (cache == NULL) {
+        return;
+    }
+    memset(cache, 0, sizeof(*cache));
+    for (int i = 0; i < SAMPLE_CACHE_MAX_ENTRIES; i++) {
+        seqlock_init(&cache->entries[i].seq);
+    }
+    cache->max_age_ms = (max_age_ms != 0) ? max_age_ms : SAMPLE_CACHE_DEFAULT_MAX_AGE_MS;
+}
+
+void sample_cache_publish(sample_cache_t *cache, unsigned int index, const pm25_data_t *data,
+                          uint64_t timestamp_us) {
+    if (cache == NULL || data == NULL || index >= SAMPLE_CACHE_MAX_ENTRIES) {
+        return;
+    }
+    sample_cache_entry_t *entry = &cache->entries[index];
+
+    unsigned int seq = seqlock_write_begin(&entry->seq);
+    entry->data = *data;
+    entry->timestamp_us = timestamp_us;
+    entry->valid = true;
+    seqlock_write_end(&entry->seq, seq);
+}
+
+bool sample_cache_read(sample_cache_t *cache, unsigned int index, uint64_t now_us,
+                       sample_cache_snapshot_t *snapshot) {
+    if (cache == NULL || snapshot == NULL || index >= SAMPLE_CACHE_MAX_ENTRIES) {
+        return false;
+    }
+    sample_cache_entry_t *entry = &cache->entries[index];
+
+    for (int attempt = 0; attempt < SAMPLE_CACHE_READ_RETRIES; attempt++) {
+        unsigned int begin;
+        if (!seqlock_read_begin(&entry->seq, &begin)) {
+            continue;
+        }
+        pm25_data_t data = entry->data;
+        uint64_t timestamp_us = entry->timestamp_us;
+        bool valid = entry->valid;
+        if (!seqlock_read_end(&entry->seq, begin)) {
+            continue;
+        }
+
+        if (!valid) {
+            return false;
+        }
+        uint64_t age_us = (now_us > timestamp_us) ? now_us - timestamp_us : 0;
+        uint64_t age_ms = age_us / 1000u;
+        snapshot->data = data;
+        snapshot->timestamp_us = timestamp_us;
+        snapshot->age_ms = (age_ms > UINT32_MAX) ? UINT32_MAX : (uint32_t)age_ms;
+        snapshot->stale = age_ms > cache->max_age_ms;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,70 @@
+/**
+ * File: sample_cache.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Header file for the latest-sample cache. The acquisition path publishes each new PM sample into a
+ * per-sensor entry; any number of consumers (display, MQTT, local endpoints) on either core read it without locks.
+ * Every entry is guarded by a sequence counter (seqlock): the writer makes it odd while it copies the sample and
+ * even again when done, readers retry if it was odd or changed under them. Readers never block the writer and
+ * never see a torn sample.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef UTILS_SAMPLE_CACHE_H
+#define UTILS_SAMPLE_CACHE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "pm2_5.h"
+
+#define SAMPLE_CACHE_MAX_ENTRIES        5       // On-board sensor plus PM25_PIO_UART_MAX
+#define SAMPLE_CACHE_DEFAULT_MAX_AGE_MS (5u * 60u * 1000u)
+// A reader interrupting the writer on the same core would otherwise spin forever
+#define SAMPLE_CACHE_READ_RETRIES       64
+
+typedef struct {
+    atomic_uint seq;            // Odd while the writer is updating the entry
+    pm25_data_t data;
+    uint64_t timestamp_us;      // Acquisition time of data
+    bool valid;                 // A sample has been published
+} sample_cache_entry_t;
+
+typedef struct {
+    sample_cache_entry_t entries[SAMPLE_CACHE_MAX_ENTRIES];
+    uint32_t max_age_ms;        // Older samples are reported as stale
+} sample_cache_t;
+
+// Consistent copy of an entry handed to a consumer
+typedef struct {
+    pm25_data_t data;
+    uint64_t timestamp_us;
+    uint32_t age_ms;            // Age at read time
+    bool stale;                 // age_ms exceeds the cache max age
+} sample_cache_snapshot_t;
+
+/**
+ * Initialize the cache. A max_age_ms of 0 selects SAMPLE_CACHE_DEFAULT_MAX_AGE_MS.
+ */
+void sample_cache_init(sample_cache_t *cache, uint32_t max_age_ms);
+
+/**
+ * Publish a new sample for a sensor. Each entry must have a single writer.
+ */
+void sample_cache_publish(sample_cache_t *cache, unsigned int index, const pm25_data_t *data,
+                          uint64_t timestamp_us);
+
+/**
+ * Read the latest sample of a sensor.
+ * Returns false if nothing was published yet, or if the writer kept the entry busy for
+ * SAMPLE_CACHE_READ_RETRIES attempts.
+ */
+bool sample_cache_read(sample_cache_t *cache, unsigned int index, uint64_t now_us,
+                       sample_cache_snapshot_t *snapshot);
+
+#endif // UTILS_SAMPLE_CACHE_H
@@ -0,0 +1,59 @@
+/**
+ * File: seqlock.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Sequence lock for data with a single writer and readers in another context (interrupt, lwIP callback
+ * or the other core). The writer makes the count odd, writes the data and makes it even again; a reader copies the
+ * data between two loads of the count and retries if it was odd or changed. The writer never waits and uses plain
+ * loads and stores only, since the Cortex-M0+ has no atomic read-modify-write.
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef UTILS_SEQLOCK_H
+#define UTILS_SEQLOCK_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+static inline void seqlock_init(atomic_uint *seq) {
+    atomic_init(seq, 0u);
+}
+
+/**
+ * Start an update. Single writer only.
+ * @return Count to hand to seqlock_write_end()
+ */
+static inline unsigned int seqlock_write_begin(atomic_uint *seq) {
+    unsigned int begin = atomic_load_explicit(seq, memory_order_relaxed);
+    atomic_store_explicit(seq, begin + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);      // Odd count visible before any data store
+    return begin;
+}
+
+static inline void seqlock_write_end(atomic_uint *seq, unsigned int begin) {
+    atomic_store_explicit(seq, begin + 2, memory_order_release);
+}
+
+/**
+ * Start a read attempt.
+ * @return False while the writer is updating; try again
+ */
+static inline bool seqlock_read_begin(atomic_uint *seq, unsigned int *begin) {
+    *begin = atomic_load_explicit(seq, memory_order_acquire);
+    return (*begin & 1u) == 0;
+}
+
+/**
+ * End a read attempt.
+ * @return True if the copy is consistent, false if the writer got in between
+ */
+static inline bool seqlock_read_end(atomic_uint *seq, unsigned int begin) {
+    atomic_thread_fence(memory_order_acquire);      // Data loads complete before the re-check
+    return atomic_load_explicit(seq, memory_order_relaxed) == begin;
+}
+
+#endif // UTILS_SEQLOCK_H
@@ -0,0 +1,70 @@
+/**
+ * File: bench_fixed_point.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Host benchmark comparing the float and fixed-point sample processing paths
+ * (SHT3x conversion, PM2.5 humidity correction and text formatting).
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "fixed_point.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_ITERATIONS 2000000u
+
+static volatile uint32_t sink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Reference float path, as a driver returning float would do it
+static void float_path(uint16_t raw_t, uint16_t raw_rh, uint16_t pm, char *buf, size_t len) {
+    float t = -45.0f + 175.0f * (float)raw_t / 65535.0f;
+    float rh = 100.0f * (float)raw_rh / 65535.0f;
+    float corr = 0.524f * (float)pm - 0.0862f * rh + 5.75f;
+    if (corr < 0.0f) {
+        corr = 0.0f;
+    }
+    int n = snprintf(buf, len, "%.2f,%.2f,%.2f", t, rh, corr);
+    sink += (uint32_t)n;
+}
+
+static void fixed_path(uint16_t raw_t, uint16_t raw_rh, uint16_t pm, char *buf, size_t len) {
+    fx_centi_t t = fx_sht3x_temp_centi(raw_t);
+    fx_centi_t rh = fx_sht3x_hum_centi(raw_rh);
+    fx_centi_t corr = fx_pm25_humidity_correct(pm, rh);
+    size_t n = fx_format_centi(buf, len, t);
+    buf[n++] = ',';
+    n += fx_format_centi(buf + n, len - n, rh);
+    buf[n++] = ',';
+    n += fx_format_centi(buf + n, len - n, corr);
+    sink += (uint32_t)n;
+}
+
+static double run(void (*path)(uint16_t, uint16_t, uint16_t, char *, size_t)) {
+    char buf[64];
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        path((uint16_t)(i * 7u), (uint16_t)(i * 13u), (uint16_t)(i & 0x3FFu), buf, sizeof(buf));
+    }
+    return (double)(now_ns() - start) / BENCH_ITERATIONS;
+}
+
+int main(void) {
+    double float_ns = run(float_path);
+    double fixed_ns = run(fixed_path);
+
+    printf("float path: %8.1f ns/sample\n", float_ns);
+    printf("fixed path: %8.1f ns/sample\n", fixed_ns);
+    printf("speedup:    %8.2fx\n", float_ns / fixed_ns);
+    return 0;
+}
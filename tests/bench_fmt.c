@@ -0,0 +1,93 @@
+/**
+ * File: bench_fmt.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Host benchmark comparing snprintf with the integer-only formatter on the MQTT report payload
+ * (sequence, timestamp, flags and the twelve PM fields as JSON).
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "fmt.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_ITERATIONS 1000000u
+#define FIELD_COUNT      12
+
+static const char *const field_names[FIELD_COUNT] = {
+    "pm1_0_cf1", "pm2_5_cf1", "pm10_cf1", "pm1_0_atm", "pm2_5_atm", "pm10_atm",
+    "count_0_3", "count_0_5", "count_1_0", "count_2_5", "count_5_0", "count_10"
+};
+
+static volatile uint32_t sink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static size_t snprintf_path(char *buf, size_t size, uint32_t seq, const uint16_t *fields) {
+    int len = snprintf(buf, size, "{\"seq\":%lu,\"ts\":%lu,\"reasons\":%u,\"level\":%u",
+                       (unsigned long)seq, (unsigned long)(seq * 1000u), 3u, seq & 3u);
+    for (int f = 0; f < FIELD_COUNT; f++) {
+        len += snprintf(buf + len, size - (size_t)len, ",\"%s\":%u", field_names[f], fields[f]);
+    }
+    len += snprintf(buf + len, size - (size_t)len, "}");
+    return (size_t)len;
+}
+
+static size_t fmt_path(char *buf, size_t size, uint32_t seq, const uint16_t *fields) {
+    fmt_buf_t b;
+    fmt_init(&b, buf, size);
+    fmt_json_object_begin(&b, NULL);
+    fmt_json_u32(&b, "seq", seq);
+    fmt_json_u32(&b, "ts", seq * 1000u);
+    fmt_json_u32(&b, "reasons", 3u);
+    fmt_json_u32(&b, "level", seq & 3u);
+    for (int f = 0; f < FIELD_COUNT; f++) {
+        fmt_json_u32(&b, field_names[f], fields[f]);
+    }
+    fmt_json_object_end(&b);
+    return fmt_finish(&b);
+}
+
+static double run(size_t (*path)(char *, size_t, uint32_t, const uint16_t *)) {
+    char buf[320];
+    uint16_t fields[FIELD_COUNT];
+    uint64_t start = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        for (int f = 0; f < FIELD_COUNT; f++) {
+            fields[f] = (uint16_t)(i * (uint32_t)(f + 3));
+        }
+        sink += (uint32_t)path(buf, sizeof(buf), i, fields);
+    }
+    return (double)(now_ns() - start) / BENCH_ITERATIONS;
+}
+
+int main(void) {
+    // Both paths must produce the same payload
+    char a[320];
+    char b[320];
+    uint16_t fields[FIELD_COUNT] = { 10, 25, 50, 10, 25, 50, 100, 50, 20, 10, 5, 65535 };
+    snprintf_path(a, sizeof(a), 4242, fields);
+    fmt_path(b, sizeof(b), 4242, fields);
+    if (strcmp(a, b) != 0) {
+        printf("payload mismatch:\n  %s\n  %s\n", a, b);
+        return 1;
+    }
+
+    double snprintf_ns = run(snprintf_path);
+    double fmt_ns = run(fmt_path);
+
+    printf("snprintf: %8.1f ns/payload\n", snprintf_ns);
+    printf("fmt:      %8.1f ns/payload\n", fmt_ns);
+    printf("speedup:  %8.2fx\n", snprintf_ns / fmt_ns);
+    return 0;
+}
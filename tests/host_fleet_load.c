@@ -0,0 +1,843 @@
+/**
+ * File: host_fleet_load.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Fleet load generator for the broker and the ingestion pipeline. Simulates thousands of devices on
+ * one Linux host, each with its own MQTT connection, multiplexed over epoll. Every device runs the firmware's data
+ * path: PMS7003 frames (synthetic, or replayed from a raw UART capture) are fed through a replay UART into the real
+ * pm25_sensor_read(), filtered by report by exception and sent as the same JSON (mqtt_payload.h) and the same MQTT
+ * packets (mqtt_codec.h) as the device. Only the transport differs: a non-blocking socket instead of lwIP.
+ * Reports publish throughput and, for QoS 1, the sample-to-PUBACK latency percentiles.
+ *
+ *     mosquitto -p 1883 &
+ *     ./host_fleet_load -n 10000 -r 1 -t 60
+ *     ./host_fleet_load -n 2000 -f pms7003_capture.bin -a -q 0
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#define _GNU_SOURCE
+
+#include "pm2_5.h"
+#include "pm2_5_hal.h"
+#include "pms7003_defs.h"
+#include "report_by_exception.h"
+#include "mqtt_codec.h"
+#include "mqtt_payload.h"
+#include "mqtt_queue.h"
+#include "mqtt_config.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SIM_UART_BUF        256     // Replay UART receive buffer per device (8 frames)
+#define SIM_RX_BUF          512
+#define SIM_TX_BUF          2048
+#define SIM_WINDOW          32      // QoS 1 publishes awaiting PUBACK per device
+#define SIM_CONNECTING_MAX  256     // Connects in progress at once, so the broker's accept queue keeps up
+#define SIM_EVENTS          1024
+#define SIM_DRAIN_MS        3000    // Wait for outstanding PUBACKs after the run
+#define SIM_ID_MAX          24
+#define SIM_READ_ATTEMPTS   4       // Sensor reads per sample, to get past noise in a recorded stream
+
+typedef enum {
+    DEV_IDLE = 0,
+    DEV_CONNECTING,
+    DEV_WAIT_CONNACK,
+    DEV_UP,
+    DEV_CLOSED
+} dev_state_t;
+
+typedef struct {
+    int fd;
+    dev_state_t state;
+    char client_id[SIM_ID_MAX];
+    // Replay UART: bytes the sensor has sent and the driver has not read yet
+    uint8_t uart[SIM_UART_BUF];
+    uint16_t uart_head;
+    uint16_t uart_len;
+    size_t replay_pos;          // Position in the recorded stream
+    uint32_t rng;               // Synthetic stream state
+    pm25_data_t level;
+    pm25_sensor_t sensor;
+    rbe_filter_t rbe;
+    uint64_t next_sample_us;
+    uint64_t last_tx_us;
+    uint16_t packet_id;
+    uint16_t window_id[SIM_WINDOW];     // 0: free
+    uint64_t window_us[SIM_WINDOW];     // Sample time of the publish
+    uint8_t in_flight;
+    uint8_t rx[SIM_RX_BUF];
+    size_t rx_len;
+    uint8_t tx[SIM_TX_BUF];
+    size_t tx_off;
+    size_t tx_len;
+    bool want_out;              // EPOLLOUT armed
+} sim_device_t;
+
+typedef struct {
+    uint64_t samples;           // Sensor reads
+    uint64_t frames;            // Frames streamed into the replay UARTs
+    uint64_t decoded;           // Frames pm25_sensor_read() accepted
+    uint64_t decode_errors;
+    uint64_t uart_overruns;     // Bytes dropped because the driver did not keep up
+    uint64_t reports;           // Samples that passed report by exception
+    uint64_t published;
+    uint64_t published_bytes;
+    uint64_t acked;
+    uint64_t offline;           // Reports while the device was not connected
+    uint64_t window_full;       // Reports dropped with SIM_WINDOW publishes unacknowledged
+    uint64_t tx_full;           // Reports dropped because the socket did not drain
+    uint32_t connected;
+    uint32_t connect_failed;
+    uint32_t disconnects;
+} sim_stats_t;
+
+typedef struct {
+    const char *host;
+    uint16_t port;
+    uint32_t devices;
+    double rate_hz;             // Samples per second per device
+    uint32_t seconds;
+    uint8_t qos;                // QoS of the telemetry; alerts are QoS 1 as on the device
+    const char *replay_file;
+    bool all_samples;           // Heartbeat 0: every sample is reported
+} sim_options_t;
+
+static sim_options_t opts = {
+    .host = "127.0.0.1",
+    .port = 1883,
+    .devices = 100,
+    .rate_hz = 1.0,
+    .seconds = 10,
+    .qos = 1
+};
+static sim_device_t *devices;
+static sim_stats_t stats;
+static int epoll_fd = -1;
+static struct sockaddr_in broker;
+static uint8_t *replay;
+static size_t replay_len;
+static uint64_t start_us;
+static uint32_t connecting;     // Devices between connect() and CONNACK
+static uint32_t in_flight;      // QoS 1 publishes awaiting PUBACK, all devices
+static uint32_t *latency_us;
+static size_t latency_count;
+static size_t latency_cap;
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+// --- Replay UART: the driver's uart handle is the device itself ---
+
+static sim_device_t *uart_device(uart_inst_t *uart) {
+    return (sim_device_t *)(void *)uart;
+}
+
+static void sim_uart_init(uart_inst_t *uart, uint baudrate) {
+    (void)uart;
+    (void)baudrate;
+}
+
+static bool sim_uart_is_readable(uart_inst_t *uart) {
+    return uart_device(uart)->uart_len > 0;
+}
+
+static void stream_next(sim_device_t *dev);
+
+// A real UART blocks until the sensor has sent the bytes: an underrun streams the next frame in
+static void sim_uart_read_blocking(uart_inst_t *uart, uint8_t *dst, size_t len) {
+    sim_device_t *dev = uart_device(uart);
+    for (size_t i = 0; i < len; i++) {
+        if (dev->uart_len == 0) {
+            stream_next(dev);
+        }
+        dst[i] = dev->uart[dev->uart_head];
+        dev->uart_head = (uint16_t)((dev->uart_head + 1) % SIM_UART_BUF);
+        dev->uart_len--;
+    }
+}
+
+static void sim_uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len) {
+    // Mode commands: the replayed sensor streams regardless
+    (void)uart;
+    (void)src;
+    (void)len;
+}
+
+static void sim_gpio_init(uint gpio) {
+    (void)gpio;
+}
+
+static void sim_gpio_set_dir(uint gpio, bool out) {
+    (void)gpio;
+    (void)out;
+}
+
+static void sim_gpio_put(uint gpio, bool value) {
+    (void)gpio;
+    (void)value;
+}
+
+static void sim_gpio_set_function(uint gpio, gpio_function_t fn) {
+    (void)gpio;
+    (void)fn;
+}
+
+static const pm25_uart_hal_t sim_uart_hal = {
+    .init = sim_uart_init,
+    .is_readable = sim_uart_is_readable,
+    .read_blocking = sim_uart_read_blocking,
+    .write_blocking = sim_uart_write_blocking
+};
+
+static const pm25_gpio_hal_t sim_gpio_hal = {
+    .init = sim_gpio_init,
+    .set_dir = sim_gpio_set_dir,
+    .put = sim_gpio_put,
+    .set_function = sim_gpio_set_function
+};
+
+static const pm25_hal_t sim_hal = {
+    .uart = &sim_uart_hal,
+    .gpio = &sim_gpio_hal,
+    .time_us = now_us
+};
+
+const pm25_hal_t *pm25_get_default_hal(void) {
+    return &sim_hal;
+}
+
+static void uart_feed(sim_device_t *dev, const uint8_t *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (dev->uart_len == SIM_UART_BUF) {
+            stats.uart_overruns++;
+            continue;
+        }
+        dev->uart[(dev->uart_head + dev->uart_len) % SIM_UART_BUF] = src[i];
+        dev->uart_len++;
+    }
+}
+
+// --- Sensor streams ---
+
+static uint32_t xorshift(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+// Random walk of PM2.5 with the other fields derived from it, encoded as a PMS7003 data frame
+static void synth_frame(sim_device_t *dev, uint8_t frame[PMS_FRAME_LENGTH]) {
+    int32_t pm = dev->level.pm2_5_atm + (int32_t)(xorshift(&dev->rng) % 7) - 3;
+    if (pm < 0) {
+        pm = 0;
+    } else if (pm > PMS_RANGE_PM25_STD_MAX) {
+        pm = PMS_RANGE_PM25_STD_MAX;
+    }
+    pm25_data_t *d = &dev->level;
+    d->pm2_5_atm = (uint16_t)pm;
+    d->pm1_0_atm = (uint16_t)(pm * 7 / 10);
+    d->pm10_atm = (uint16_t)(pm * 13 / 10);
+    d->pm1_0_cf1 = d->pm1_0_atm;
+    d->pm2_5_cf1 = d->pm2_5_atm;
+    d->pm10_cf1 = d->pm10_atm;
+    d->count_0_3 = (uint16_t)(pm * 60 + 300);
+    d->count_0_5 = (uint16_t)(pm * 18 + 90);
+    d->count_1_0 = (uint16_t)(pm * 4 + 15);
+    d->count_2_5 = (uint16_t)(pm / 2);
+    d->count_5_0 = (uint16_t)(pm / 10);
+    d->count_10 = (uint16_t)(pm / 30);
+
+    memset(frame, 0, PMS_FRAME_LENGTH);
+    frame[0] = PMS_FRAME_START1;
+    frame[1] = PMS_FRAME_START2;
+    frame[3] = PMS_DATA_FRAME_LEN;
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        uint16_t v = pm25_data_get(d, (pm25_field_t)f);
+        frame[4 + 2 * f] = (uint8_t)(v >> 8);
+        frame[5 + 2 * f] = (uint8_t)v;
+    }
+    uint16_t sum = 0;
+    for (int i = 0; i < PMS_FRAME_LENGTH - 2; i++) {
+        sum += frame[i];
+    }
+    frame[PMS_FRAME_LENGTH - 2] = (uint8_t)(sum >> 8);
+    frame[PMS_FRAME_LENGTH - 1] = (uint8_t)sum;
+}
+
+// The next frame's worth of bytes of the recorded stream, wrapping at the end
+static void replay_bytes(sim_device_t *dev, uint8_t out[PMS_FRAME_LENGTH]) {
+    for (int i = 0; i < PMS_FRAME_LENGTH; i++) {
+        out[i] = replay[dev->replay_pos];
+        dev->replay_pos = (dev->replay_pos + 1) % replay_len;
+    }
+}
+
+// The sensor sends its next frame: synthetic, or the next frame's worth of bytes of the capture
+static void stream_next(sim_device_t *dev) {
+    uint8_t bytes[PMS_FRAME_LENGTH];
+    if (replay != NULL) {
+        replay_bytes(dev, bytes);
+    } else {
+        synth_frame(dev, bytes);
+    }
+    uart_feed(dev, bytes, sizeof(bytes));
+    stats.frames++;
+}
+
+// --- Connection ---
+
+static void watch(sim_device_t *dev, bool out) {
+    struct epoll_event ev = { .events = EPOLLIN | (out ? EPOLLOUT : 0), .data.ptr = dev };
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, dev->fd, &ev) == 0) {
+        dev->want_out = out;
+    }
+}
+
+static void dev_close(sim_device_t *dev) {
+    if (dev->fd >= 0) {
+        close(dev->fd);     // Also removes it from the epoll set
+        dev->fd = -1;
+    }
+    if (dev->state == DEV_UP) {
+        stats.connected--;
+        stats.disconnects++;
+    } else if (dev->state == DEV_CONNECTING || dev->state == DEV_WAIT_CONNACK) {
+        stats.connect_failed++;
+        connecting--;
+    }
+    dev->state = DEV_CLOSED;
+    in_flight -= dev->in_flight;
+    dev->in_flight = 0;
+    memset(dev->window_id, 0, sizeof(dev->window_id));
+}
+
+static void dev_flush(sim_device_t *dev) {
+    while (dev->tx_len > 0) {
+        ssize_t n = send(dev->fd, dev->tx + dev->tx_off, dev->tx_len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            dev_close(dev);
+            return;
+        }
+        dev->tx_off += (size_t)n;
+        dev->tx_len -= (size_t)n;
+    }
+    if (dev->tx_len == 0) {
+        dev->tx_off = 0;
+    }
+    if (dev->want_out != (dev->tx_len > 0)) {
+        watch(dev, dev->tx_len > 0);
+    }
+}
+
+// Room for a packet at the end of the output buffer, or NULL
+static uint8_t *dev_tx_space(sim_device_t *dev, size_t need) {
+    if (dev->tx_off + dev->tx_len + need > SIM_TX_BUF && dev->tx_off > 0) {
+        memmove(dev->tx, dev->tx + dev->tx_off, dev->tx_len);
+        dev->tx_off = 0;
+    }
+    if (dev->tx_off + dev->tx_len + need > SIM_TX_BUF) {
+        return NULL;
+    }
+    return dev->tx + dev->tx_off + dev->tx_len;
+}
+
+static void dev_send(sim_device_t *dev, size_t len, uint64_t now) {
+    dev->tx_len += len;
+    dev->last_tx_us = now;
+    dev_flush(dev);
+}
+
+static bool dev_connect(sim_device_t *dev) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (fd < 0) {
+        return false;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(fd, (struct sockaddr *)&broker, sizeof(broker)) < 0 && errno != EINPROGRESS) {
+        close(fd);
+        return false;
+    }
+    struct epoll_event ev = { .events = EPOLLIN | EPOLLOUT, .data.ptr = dev };
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        close(fd);
+        return false;
+    }
+    dev->fd = fd;
+    dev->state = DEV_CONNECTING;
+    dev->want_out = true;
+    connecting++;
+    return true;
+}
+
+static void dev_connected(sim_device_t *dev, uint64_t now) {
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (getsockopt(dev->fd, SOL_SOCKET, SO_ERROR, &err, &len) < 0 || err != 0) {
+        dev_close(dev);
+        return;
+    }
+    mqtt_connect_opts_t connect = {
+        .client_id = dev->client_id,
+        .keep_alive_s = MQTT_KEEP_ALIVE_S,
+        .clean_session = true
+    };
+    uint8_t *buf = dev_tx_space(dev, 128);
+    size_t n = (buf != NULL) ? mqtt_encode_connect(buf, 128, &connect) : 0;
+    if (n == 0) {
+        dev_close(dev);
+        return;
+    }
+    dev->state = DEV_WAIT_CONNACK;
+    dev_send(dev, n, now);
+}
+
+static void record_latency(uint64_t us) {
+    if (latency_count == latency_cap) {
+        size_t cap = (latency_cap != 0) ? latency_cap * 2 : 65536;
+        uint32_t *grown = realloc(latency_us, cap * sizeof(*grown));
+        if (grown == NULL) {
+            return;
+        }
+        latency_us = grown;
+        latency_cap = cap;
+    }
+    latency_us[latency_count++] = (us > UINT32_MAX) ? UINT32_MAX : (uint32_t)us;
+}
+
+static void handle_packet(sim_device_t *dev, const mqtt_packet_t *pkt, uint64_t now) {
+    if (pkt->type == MQTT_PKT_CONNACK) {
+        bool present = false;
+        uint8_t rc = 0xFF;
+        if (dev->state != DEV_WAIT_CONNACK || !mqtt_decode_connack(pkt, &present, &rc) ||
+            rc != MQTT_CONNACK_ACCEPTED) {
+            dev_close(dev);
+            return;
+        }
+        dev->state = DEV_UP;
+        stats.connected++;
+        connecting--;
+    } else if (pkt->type == MQTT_PKT_PUBACK) {
+        uint16_t id = 0;
+        if (!mqtt_decode_ack(pkt, &id, NULL)) {
+            return;
+        }
+        for (int i = 0; i < SIM_WINDOW; i++) {
+            if (dev->window_id[i] == id) {
+                dev->window_id[i] = 0;
+                dev->in_flight--;
+                in_flight--;
+                stats.acked++;
+                record_latency(now - dev->window_us[i]);
+                break;
+            }
+        }
+    }
+}
+
+static void dev_receive(sim_device_t *dev, uint64_t now) {
+    for (;;) {
+        ssize_t n = recv(dev->fd, dev->rx + dev->rx_len, SIM_RX_BUF - dev->rx_len, 0);
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+            dev_close(dev);
+            return;
+        }
+        if (n < 0) {
+            return;
+        }
+        dev->rx_len += (size_t)n;
+        size_t off = 0;
+        for (;;) {
+            mqtt_packet_t pkt;
+            size_t used = mqtt_parse_packet(dev->rx + off, dev->rx_len - off, &pkt);
+            if (used == MQTT_PARSE_MALFORMED) {
+                dev_close(dev);
+                return;
+            }
+            if (used == MQTT_PARSE_INCOMPLETE) {
+                break;
+            }
+            handle_packet(dev, &pkt, now);
+            if (dev->state == DEV_CLOSED) {
+                return;
+            }
+            off += used;
+        }
+        memmove(dev->rx, dev->rx + off, dev->rx_len - off);
+        dev->rx_len -= off;
+        if (dev->rx_len == SIM_RX_BUF) {
+            dev_close(dev);     // A packet larger than anything the broker sends us
+            return;
+        }
+    }
+}
+
+// --- Publishing, as mqtt_client.c does it ---
+
+static void publish(sim_device_t *dev, const char *suffix, fmt_buf_t *payload, uint8_t qos, uint64_t sample_us,
+                    uint64_t now) {
+    size_t len = fmt_finish(payload);
+    if (len == 0) {
+        return;
+    }
+    if (dev->state != DEV_UP) {
+        stats.offline++;
+        return;
+    }
+    int slot = -1;
+    if (qos > 0) {
+        for (int i = 0; i < SIM_WINDOW && slot < 0; i++) {
+            if (dev->window_id[i] == 0) {
+                slot = i;
+            }
+        }
+        if (slot < 0) {
+            stats.window_full++;
+            return;
+        }
+    }
+    // Same topic layout as MQTT_TOPIC_BASE, with the simulated client id
+    char topic[MQTT_QUEUE_TOPIC_MAX];
+    snprintf(topic, sizeof(topic), "airsense/%s/%s", dev->client_id, suffix);
+    size_t need = MQTT_QUEUE_TOPIC_MAX + MQTT_QUEUE_PAYLOAD_MAX + 8;
+    uint8_t *buf = dev_tx_space(dev, need);
+    if (buf == NULL) {
+        stats.tx_full++;
+        return;
+    }
+    uint16_t id = 0;
+    if (qos > 0) {
+        if (++dev->packet_id == 0) {
+            dev->packet_id = 1;
+        }
+        id = dev->packet_id;
+    }
+    size_t n = mqtt_encode_publish(buf, need, topic, (const uint8_t *)payload->buf, len, qos, false, false, id);
+    if (n == 0) {
+        return;
+    }
+    if (qos > 0) {
+        dev->window_id[slot] = id;
+        dev->window_us[slot] = sample_us;
+        dev->in_flight++;
+        in_flight++;
+    }
+    stats.published++;
+    stats.published_bytes += n;
+    dev_send(dev, n, now);
+}
+
+static void dev_sample(sim_device_t *dev, uint64_t now) {
+    stream_next(dev);
+    stats.samples++;
+
+    // A failed read resynchronizes on the next start byte and retries while a frame's worth is buffered, so
+    // noise in the stream does not build up a backlog
+    pm25_data_t data;
+    rbe_report_t report;
+    bool ok = false;
+    for (int attempt = 0; attempt < SIM_READ_ATTEMPTS && !ok && dev->uart_len >= PMS_FRAME_LENGTH; attempt++) {
+        ok = pm25_sensor_read(&dev->sensor, &data);
+        if (!ok) {
+            stats.decode_errors++;
+            pm25_sensor_resync(&dev->sensor);
+        }
+    }
+    if (ok) {
+        stats.decoded++;
+        if (rbe_filter_check(&dev->rbe, &data, (uint32_t)((now - start_us) / 1000u), &report)) {
+            stats.reports++;
+            char payload[MQTT_QUEUE_PAYLOAD_MAX];
+            fmt_buf_t b;
+            if (report.reasons & RBE_REASON_THRESHOLD) {
+                fmt_init(&b, payload, sizeof(payload));
+                mqtt_payload_pm25_alert(&b, &report);
+                publish(dev, "alert", &b, 1, now, now);
+            }
+            fmt_init(&b, payload, sizeof(payload));
+            mqtt_payload_pm25_report(&b, &report);
+            publish(dev, "pm25", &b, opts.qos, now, now);
+        }
+    }
+
+    if (dev->state == DEV_UP && now - dev->last_tx_us >= MQTT_KEEP_ALIVE_S * 1000000ull / 2) {
+        uint8_t *buf = dev_tx_space(dev, 2);
+        if (buf != NULL) {
+            dev_send(dev, mqtt_encode_empty(buf, 2, MQTT_PKT_PINGREQ), now);
+        }
+    }
+}
+
+// --- Driver ---
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "Usage: %s [-H host] [-p port] [-n devices] [-r samples/s per device] [-t seconds] [-q 0|1]\n"
+            "          [-f raw PMS7003 UART capture] [-a]\n"
+            "  -a  report every sample (report-by-exception heartbeat 0)\n", name);
+}
+
+static bool parse_options(int argc, char **argv) {
+    int c;
+    while ((c = getopt(argc, argv, "H:p:n:r:t:q:f:a")) != -1) {
+        switch (c) {
+        case 'H': opts.host = optarg; break;
+        case 'p': opts.port = (uint16_t)atoi(optarg); break;
+        case 'n': opts.devices = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'r': opts.rate_hz = atof(optarg); break;
+        case 't': opts.seconds = (uint32_t)strtoul(optarg, NULL, 10); break;
+        case 'q': opts.qos = (uint8_t)(atoi(optarg) != 0); break;
+        case 'f': opts.replay_file = optarg; break;
+        case 'a': opts.all_samples = true; break;
+        default: return false;
+        }
+    }
+    return opts.devices > 0 && opts.rate_hz > 0.0;
+}
+
+static bool load_replay(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        return false;
+    }
+    size_t cap = 0;
+    for (;;) {
+        if (replay_len == cap) {
+            cap = (cap != 0) ? cap * 2 : 4096;
+            uint8_t *grown = realloc(replay, cap);
+            if (grown == NULL) {
+                break;
+            }
+            replay = grown;
+        }
+        size_t n = fread(replay + replay_len, 1, cap - replay_len, f);
+        if (n == 0) {
+            break;
+        }
+        replay_len += n;
+    }
+    fclose(f);
+    return replay_len >= PMS_FRAME_LENGTH;
+}
+
+static void raise_fd_limit(uint32_t needed) {
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < needed) {
+        rl.rlim_cur = (rl.rlim_max == RLIM_INFINITY || rl.rlim_max >= needed) ? needed : rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(double p) {
+    size_t i = (size_t)(p / 100.0 * (double)(latency_count - 1) + 0.5);
+    return latency_us[i];
+}
+
+static void print_progress(uint64_t now, const sim_stats_t *last, double dt) {
+    printf("t=%5.1fs up=%u/%u publish/s=%.0f ack/s=%.0f in_flight=%u\n", (double)(now - start_us) / 1e6,
+           stats.connected, opts.devices, (double)(stats.published - last->published) / dt,
+           (double)(stats.acked - last->acked) / dt, in_flight);
+    fflush(stdout);
+}
+
+static void print_summary(double seconds) {
+    printf("\ndevices     %u (connected %u, connect failures %u, disconnects %u)\n", opts.devices,
+           stats.connected, stats.connect_failed, stats.disconnects);
+    printf("samples     %llu (frames streamed %llu, decoded %llu, decode errors %llu, uart overruns %llu)\n",
+           (unsigned long long)stats.samples, (unsigned long long)stats.frames, (unsigned long long)stats.decoded,
+           (unsigned long long)stats.decode_errors, (unsigned long long)stats.uart_overruns);
+    printf("reports     %llu (offline %llu, window full %llu, tx full %llu)\n", (unsigned long long)stats.reports,
+           (unsigned long long)stats.offline, (unsigned long long)stats.window_full,
+           (unsigned long long)stats.tx_full);
+    printf("published   %llu in %.1f s: %.0f msg/s, %.2f MB/s\n", (unsigned long long)stats.published, seconds,
+           (double)stats.published / seconds, (double)stats.published_bytes / seconds / 1e6);
+    if (latency_count == 0) {
+        printf("latency     no PUBACKs (QoS 0 telemetry and no alerts)\n");
+        return;
+    }
+    qsort(latency_us, latency_count, sizeof(*latency_us), compare_u32);
+    printf("acked       %llu\n", (unsigned long long)stats.acked);
+    printf("latency us  p50 %u  p90 %u  p99 %u  p99.9 %u  max %u\n", percentile(50), percentile(90),
+           percentile(99), percentile(99.9), latency_us[latency_count - 1]);
+}
+
+int main(int argc, char **argv) {
+    if (!parse_options(argc, argv)) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (opts.replay_file != NULL && !load_replay(opts.replay_file)) {
+        fprintf(stderr, "Cannot read a PMS7003 stream from %s\n", opts.replay_file);
+        return 1;
+    }
+    memset(&broker, 0, sizeof(broker));
+    broker.sin_family = AF_INET;
+    broker.sin_port = htons(opts.port);
+    if (inet_pton(AF_INET, opts.host, &broker.sin_addr) != 1) {
+        fprintf(stderr, "Broker must be an IPv4 address: %s\n", opts.host);
+        return 2;
+    }
+    raise_fd_limit(opts.devices + 64);
+    epoll_fd = epoll_create1(0);
+    devices = calloc(opts.devices, sizeof(*devices));
+    if (epoll_fd < 0 || devices == NULL) {
+        fprintf(stderr, "Out of resources\n");
+        return 1;
+    }
+
+    rbe_config_t rbe;
+    rbe_default_config(&rbe);
+    if (opts.all_samples) {
+        rbe.heartbeat_ms = 0;
+    }
+    uint64_t period_us = (uint64_t)(1e6 / opts.rate_hz);
+    start_us = now_us();
+    for (uint32_t i = 0; i < opts.devices; i++) {
+        sim_device_t *dev = &devices[i];
+        dev->fd = -1;
+        snprintf(dev->client_id, sizeof(dev->client_id), "sim-%05u", i);
+        dev->rng = 0x9E3779B9u ^ (i * 2654435761u);
+        if (dev->rng == 0) {
+            dev->rng = 1;
+        }
+        dev->level.pm2_5_atm = (uint16_t)(5 + xorshift(&dev->rng) % 60);
+        if (replay != NULL) {
+            // Start each device at a different frame of the capture
+            dev->replay_pos = ((size_t)i * 7u * PMS_FRAME_LENGTH) % replay_len;
+        }
+        pm25_sensor_config_t config = pm25_sensor_default_config();
+        config.uart = (uart_inst_t *)(void *)dev;
+        pm25_sensor_init(&dev->sensor, &config, &sim_hal);
+        rbe_filter_init(&dev->rbe, &rbe);
+        // Spread the samples over the period, as independently booted devices would be
+        dev->next_sample_us = start_us + period_us * i / opts.devices;
+    }
+
+    printf("%u devices -> %s:%u, %.2f samples/s each, %u s, telemetry QoS %u, %s stream\n", opts.devices,
+           opts.host, opts.port, opts.rate_hz, opts.seconds, opts.qos,
+           (replay != NULL) ? "recorded" : "synthetic");
+    fflush(stdout);
+
+    struct epoll_event events[SIM_EVENTS];
+    uint32_t connect_next = 0;
+    uint32_t sample_next = 0;
+    uint64_t end_us = start_us + (uint64_t)opts.seconds * 1000000u;
+    uint64_t drain_us = end_us + SIM_DRAIN_MS * 1000ull;
+    uint64_t progress_us = start_us + 1000000u;
+    sim_stats_t last = stats;
+    uint64_t last_us = start_us;
+
+    for (;;) {
+        uint64_t now = now_us();
+        if (now >= drain_us) {
+            break;
+        }
+        // Ramp the connections up, SIM_CONNECTING_MAX at a time
+        while (connect_next < opts.devices && connecting < SIM_CONNECTING_MAX) {
+            if (!dev_connect(&devices[connect_next])) {
+                stats.connect_failed++;
+                devices[connect_next].state = DEV_CLOSED;
+            }
+            connect_next++;
+        }
+
+        // All devices share the period and keep their phase, so the one due next is always at the cursor
+        if (now < end_us) {
+            for (uint32_t k = 0; k < opts.devices && devices[sample_next].next_sample_us <= now; k++) {
+                sim_device_t *dev = &devices[sample_next];
+                dev_sample(dev, now);
+                dev->next_sample_us += period_us;
+                sample_next = (sample_next + 1) % opts.devices;
+            }
+        }
+
+        int timeout_ms = 100;
+        if (now < end_us) {
+            uint64_t due = devices[sample_next].next_sample_us;
+            timeout_ms = (due <= now) ? 0 : (int)((due - now + 999) / 1000);
+            if (timeout_ms > 100) {
+                timeout_ms = 100;
+            }
+        } else if (in_flight == 0) {
+            break;
+        }
+        int n = epoll_wait(epoll_fd, events, SIM_EVENTS, timeout_ms);
+        now = now_us();
+        for (int i = 0; i < n; i++) {
+            sim_device_t *dev = events[i].data.ptr;
+            if (dev->state == DEV_CLOSED) {
+                continue;
+            }
+            if (dev->state == DEV_CONNECTING) {
+                if (events[i].events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
+                    dev_connected(dev, now);
+                }
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                dev_receive(dev, now);
+            }
+            if (dev->state != DEV_CLOSED && (events[i].events & EPOLLOUT)) {
+                dev_flush(dev);
+            }
+        }
+        if (now >= progress_us) {
+            print_progress(now, &last, (double)(now - last_us) / 1e6);
+            last = stats;
+            last_us = now;
+            progress_us += 1000000u;
+        }
+    }
+
+    double seconds = (double)opts.seconds;
+    for (uint32_t i = 0; i < opts.devices; i++) {
+        sim_device_t *dev = &devices[i];
+        if (dev->state == DEV_UP) {
+            uint8_t *buf = dev_tx_space(dev, 2);
+            if (buf != NULL) {
+                dev_send(dev, mqtt_encode_empty(buf, 2, MQTT_PKT_DISCONNECT), now_us());
+            }
+        }
+    }
+    print_summary(seconds);
+    for (uint32_t i = 0; i < opts.devices; i++) {
+        if (devices[i].fd >= 0) {
+            close(devices[i].fd);
+        }
+    }
+    close(epoll_fd);
+    free(devices);
+    free(latency_us);
+    free(replay);
+    return 0;
+}
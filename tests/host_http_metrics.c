@@ -0,0 +1,63 @@
+/**
+ * File: host_http_metrics.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Host build of the local HTTP endpoints for trying them with curl or a Prometheus scraper. Serves a
+ * synthetic sensor on 127.0.0.1 and updates the responses once a second, as the firmware does after each sample.
+ *
+ *     ./host_http_metrics 8080 &
+ *     curl -s http://127.0.0.1:8080/metrics
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "metrics_page.h"
+#include "http_listen.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define UPDATE_MS   1000u
+
+static sample_cache_t cache;
+static metrics_page_t page;
+static http_server_t server;
+
+static uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+int main(int argc, char **argv) {
+    uint16_t port = (argc > 1) ? (uint16_t)atoi(argv[1]) : 8080;
+    sample_cache_init(&cache, 0);
+    metrics_page_init(&page);
+    http_server_init(&server, &page);
+    if (!http_listen_start(&server, port)) {
+        fprintf(stderr, "Cannot listen on port %u\n", port);
+        return 1;
+    }
+    printf("Serving http://127.0.0.1:%u/metrics and /latest\n", http_listen_port());
+    fflush(stdout);
+
+    uint64_t start = now_us();
+    for (uint32_t n = 0;; n++) {
+        pm25_data_t d = { 0 };
+        for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+            pm25_data_set(&d, (pm25_field_t)f, (uint16_t)((f + 1) * 10 + n % 7));
+        }
+        sample_cache_publish(&cache, 0, &d, now_us() - start);
+        aqi_report_t aqi = { .aqi = (uint16_t)(40 + n % 7) };
+        metrics_page_update(&page, &cache, 1, now_us() - start, &aqi);
+
+        uint64_t until = now_us() + UPDATE_MS * 1000u;
+        while (now_us() < until) {
+            http_listen_poll(100);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * File: archive_flash_mock.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Fake NOR flash for the sample archive: erase sets bytes to 0xFF, programming can only clear bits
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "archive_flash_mock.h"
+
+#include <string.h>
+
+static uint8_t image[ARCHIVE_MOCK_MAX_SIZE];
+static uint32_t image_size;
+static bool fail;
+static uint32_t tear_bytes;
+static int programs;
+static int erases;
+static int reads;
+
+static uint32_t mock_size(void) {
+    return image_size;
+}
+
+static bool mock_read(uint32_t addr, uint8_t *buf, size_t len) {
+    if (addr + len > image_size) {
+        return false;
+    }
+    reads++;
+    memcpy(buf, image + addr, len);
+    return true;
+}
+
+static bool mock_program_page(uint32_t addr, const uint8_t *page) {
+    if (fail || addr % ARCHIVE_PAGE_SIZE != 0 || addr >= image_size) {
+        return false;
+    }
+    uint32_t len = ARCHIVE_PAGE_SIZE;
+    if (tear_bytes != 0) {
+        len = tear_bytes;
+        tear_bytes = 0;
+    }
+    for (uint32_t i = 0; i < len; i++) {
+        image[addr + i] &= page[i];
+    }
+    programs++;
+    return true;
+}
+
+static bool mock_erase_sector(uint32_t addr) {
+    if (fail || addr % ARCHIVE_SECTOR_SIZE != 0 || addr >= image_size) {
+        return false;
+    }
+    memset(image + addr, 0xFF, ARCHIVE_SECTOR_SIZE);
+    erases++;
+    return true;
+}
+
+static const archive_flash_hal_t mock_flash = {
+    .size = mock_size,
+    .read = mock_read,
+    .program_page = mock_program_page,
+    .erase_sector = mock_erase_sector
+};
+
+const archive_flash_hal_t *archive_get_mock_flash(void) {
+    return &mock_flash;
+}
+
+void archive_mock_reset(uint32_t size) {
+    image_size = (size <= ARCHIVE_MOCK_MAX_SIZE) ? size : ARCHIVE_MOCK_MAX_SIZE;
+    memset(image, 0xFF, sizeof(image));
+    fail = false;
+    tear_bytes = 0;
+    programs = 0;
+    erases = 0;
+    reads = 0;
+}
+
+void archive_mock_set_fail(bool value) {
+    fail = value;
+}
+
+void archive_mock_tear_next(uint32_t bytes) {
+    tear_bytes = bytes;
+}
+
+uint8_t *archive_mock_image(void) {
+    return image;
+}
+
+int archive_mock_programs(void) {
+    return programs;
+}
+
+int archive_mock_erases(void) {
+    return erases;
+}
+
+int archive_mock_reads(void) {
+    return reads;
+}
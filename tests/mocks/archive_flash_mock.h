@@ -0,0 +1,37 @@
+/**
+ * File: archive_flash_mock.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Fake NOR flash for the sample archive: erase sets bytes to 0xFF, programming can only clear bits
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef ARCHIVE_FLASH_MOCK_H
+#define ARCHIVE_FLASH_MOCK_H
+
+#include "archive_flash_hal.h"
+
+#define ARCHIVE_MOCK_MAX_SIZE   (64u * 1024u)
+
+// Get the fake backend
+const archive_flash_hal_t *archive_get_mock_flash(void);
+
+// Erase the whole image and reset the counters; size is the region size in bytes (at most ARCHIVE_MOCK_MAX_SIZE)
+void archive_mock_reset(uint32_t size);
+
+// Make program and erase fail
+void archive_mock_set_fail(bool fail);
+
+// Program only the first bytes of the next page, as a reset in the middle of the write would
+void archive_mock_tear_next(uint32_t bytes);
+
+uint8_t *archive_mock_image(void);
+int archive_mock_programs(void);
+int archive_mock_erases(void);
+int archive_mock_reads(void);
+
+#endif // ARCHIVE_FLASH_MOCK_H
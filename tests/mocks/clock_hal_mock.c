@@ -0,0 +1,101 @@
+/**
+ * File: clock_hal_mock.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Fake clock backend with a simulated millisecond clock that logs voltage and clk_sys steps in order
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "clock_hal_mock.h"
+
+#include <stddef.h>
+
+static uint32_t now_ms;
+static uint32_t sys_khz;
+static uint32_t vreg_mv;
+static bool fail_voltage;
+static bool fail_clock;
+static clock_mock_step_t steps[CLOCK_MOCK_MAX_STEPS];
+static int step_count;
+
+static void log_step(clock_mock_step_kind_t kind, uint32_t value) {
+    if (step_count < CLOCK_MOCK_MAX_STEPS) {
+        steps[step_count].kind = kind;
+        steps[step_count].value = value;
+        step_count++;
+    }
+}
+
+static bool mock_set_voltage_mv(uint32_t mv) {
+    if (fail_voltage) {
+        return false;
+    }
+    vreg_mv = mv;
+    log_step(CLOCK_MOCK_VOLTAGE, mv);
+    return true;
+}
+
+static bool mock_set_sys_khz(uint32_t khz) {
+    if (fail_clock) {
+        return false;
+    }
+    sys_khz = khz;
+    log_step(CLOCK_MOCK_SYS_CLOCK, khz);
+    return true;
+}
+
+static uint32_t mock_now_ms(void) {
+    return now_ms;
+}
+
+static const clock_hal_t mock_hal = {
+    .set_voltage_mv = mock_set_voltage_mv,
+    .set_sys_khz = mock_set_sys_khz,
+    .now_ms = mock_now_ms
+};
+
+const clock_hal_t *clock_get_mock_hal(void) {
+    return &mock_hal;
+}
+
+void clock_mock_reset(uint32_t khz, uint32_t mv) {
+    now_ms = 0;
+    sys_khz = khz;
+    vreg_mv = mv;
+    fail_voltage = false;
+    fail_clock = false;
+    step_count = 0;
+}
+
+void clock_mock_set_fail(bool voltage, bool sys_clock) {
+    fail_voltage = voltage;
+    fail_clock = sys_clock;
+}
+
+void clock_mock_advance_ms(uint32_t ms) {
+    now_ms += ms;
+}
+
+uint32_t clock_mock_sys_khz(void) {
+    return sys_khz;
+}
+
+uint32_t clock_mock_vreg_mv(void) {
+    return vreg_mv;
+}
+
+int clock_mock_step_count(void) {
+    return step_count;
+}
+
+const clock_mock_step_t *clock_mock_step(int index) {
+    return (index >= 0 && index < step_count) ? &steps[index] : NULL;
+}
+
+void clock_mock_clear_steps(void) {
+    step_count = 0;
+}
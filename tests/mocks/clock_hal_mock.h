@@ -0,0 +1,46 @@
+/**
+ * File: clock_hal_mock.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Fake clock backend with a simulated millisecond clock that logs voltage and clk_sys steps in order
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef CLOCK_HAL_MOCK_H
+#define CLOCK_HAL_MOCK_H
+
+#include "clock_hal.h"
+
+#define CLOCK_MOCK_MAX_STEPS    32
+
+typedef enum {
+    CLOCK_MOCK_VOLTAGE = 0,
+    CLOCK_MOCK_SYS_CLOCK
+} clock_mock_step_kind_t;
+
+typedef struct {
+    clock_mock_step_kind_t kind;
+    uint32_t value;             // mV or kHz
+} clock_mock_step_t;
+
+// Get the fake backend
+const clock_hal_t *clock_get_mock_hal(void);
+
+// Reset the clock, the log and the failure flags; the chip starts at the given operating point
+void clock_mock_reset(uint32_t sys_khz, uint32_t vreg_mv);
+
+// Make the backend refuse voltage or clock changes
+void clock_mock_set_fail(bool voltage, bool sys_clock);
+
+void clock_mock_advance_ms(uint32_t ms);
+uint32_t clock_mock_sys_khz(void);
+uint32_t clock_mock_vreg_mv(void);
+int clock_mock_step_count(void);            // Accepted steps since reset or the last clear
+const clock_mock_step_t *clock_mock_step(int index);
+void clock_mock_clear_steps(void);
+
+#endif // CLOCK_HAL_MOCK_H
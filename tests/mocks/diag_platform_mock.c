@@ -0,0 +1,59 @@
+/**
+ * File: diag_platform_mock.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Mock platform layer of the memory diagnostics
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "diag_platform_mock.h"
+
+#include <string.h>
+
+uint32_t diag_mock_stacks[DIAG_CORE_COUNT][DIAG_MOCK_STACK_WORDS];
+
+static uintptr_t mock_sp;
+static uint32_t mock_data;
+static uint32_t mock_bss;
+static uint32_t mock_heap;
+
+void diag_mock_reset(void) {
+    memset(diag_mock_stacks, 0, sizeof(diag_mock_stacks));
+    mock_sp = (uintptr_t)&diag_mock_stacks[0][DIAG_MOCK_STACK_WORDS];
+    mock_data = 0;
+    mock_bss = 0;
+    mock_heap = 0;
+}
+
+void diag_mock_set_stack_pointer(uintptr_t sp) {
+    mock_sp = sp;
+}
+
+void diag_mock_set_sections(uint32_t data_bytes, uint32_t bss_bytes, uint32_t heap_bytes) {
+    mock_data = data_bytes;
+    mock_bss = bss_bytes;
+    mock_heap = heap_bytes;
+}
+
+bool diag_platform_stack_region(unsigned int core, diag_stack_region_t *region) {
+    if (region == NULL || core >= DIAG_CORE_COUNT) {
+        return false;
+    }
+    region->bottom = &diag_mock_stacks[core][0];
+    region->top = &diag_mock_stacks[core][DIAG_MOCK_STACK_WORDS];
+    return true;
+}
+
+uintptr_t diag_platform_stack_pointer(void) {
+    return mock_sp;
+}
+
+void diag_platform_sections(uint32_t *data_bytes, uint32_t *bss_bytes, uint32_t *heap_bytes) {
+    *data_bytes = mock_data;
+    *bss_bytes = mock_bss;
+    *heap_bytes = mock_heap;
+}
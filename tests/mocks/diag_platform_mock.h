@@ -0,0 +1,32 @@
+/**
+ * File: diag_platform_mock.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Mock platform layer of the memory diagnostics: two stacks in host memory and fixed section sizes
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef DIAG_PLATFORM_MOCK_H
+#define DIAG_PLATFORM_MOCK_H
+
+#include "diagnostics.h"
+
+#define DIAG_MOCK_STACK_WORDS   256
+
+// Simulated stacks of core0 and core1
+extern uint32_t diag_mock_stacks[DIAG_CORE_COUNT][DIAG_MOCK_STACK_WORDS];
+
+// Reset the stacks to zero, the stack pointer to the top of core0's and the section sizes
+void diag_mock_reset(void);
+
+// Stack pointer reported to diag_init()
+void diag_mock_set_stack_pointer(uintptr_t sp);
+
+// Section sizes reported to diag_get_stats()
+void diag_mock_set_sections(uint32_t data_bytes, uint32_t bss_bytes, uint32_t heap_bytes);
+
+#endif // DIAG_PLATFORM_MOCK_H
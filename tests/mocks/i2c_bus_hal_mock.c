@@ -0,0 +1,179 @@
+/**
+ * File: i2c_bus_hal_mock.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Mock I2C bus backend. Transfers take their 100 kHz bus time on a simulated clock that advances a
+ * little on every clock read, so polling loops make progress; completions are delivered when the clock passes
+ * the end of the transfer.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "i2c_bus_hal_mock.h"
+
+#include <string.h>
+
+typedef struct {
+    uint8_t addr;
+    uint32_t conversion_us;
+    uint8_t response[16];
+    size_t len;
+    uint64_t busy_until_us;
+} mock_device_t;
+
+static mock_device_t devices[I2C_MOCK_MAX_DEVICES];
+static int device_count;
+static i2c_mock_transfer_t transfers[I2C_MOCK_MAX_LOG];
+static int transfer_count;
+static int abort_count;
+static uint64_t now_us;
+static bool hang;
+
+static i2c_bus_t *mock_bus;
+static bool pending;
+static uint64_t pending_end_us;
+static i2c_bus_status_t pending_status;
+
+void i2c_mock_reset(void) {
+    memset(devices, 0, sizeof(devices));
+    memset(transfers, 0, sizeof(transfers));
+    device_count = 0;
+    transfer_count = 0;
+    abort_count = 0;
+    now_us = 1000;
+    hang = false;
+    mock_bus = NULL;
+    pending = false;
+}
+
+void i2c_mock_add_device(uint8_t addr, uint32_t conversion_us, const uint8_t *response, size_t len) {
+    if (device_count >= I2C_MOCK_MAX_DEVICES || len > sizeof(devices[0].response)) {
+        return;
+    }
+    mock_device_t *dev = &devices[device_count++];
+    dev->addr = addr;
+    dev->conversion_us = conversion_us;
+    memcpy(dev->response, response, len);
+    dev->len = len;
+}
+
+void i2c_mock_set_hang(bool value) {
+    hang = value;
+}
+
+static void deliver(void) {
+    if (pending && now_us >= pending_end_us) {
+        pending = false;
+        i2c_bus_transfer_done(mock_bus, pending_status, pending_end_us);
+    }
+}
+
+void i2c_mock_advance_us(uint64_t us) {
+    now_us += us;
+    deliver();
+}
+
+uint64_t i2c_mock_now_us(void) {
+    return now_us;
+}
+
+int i2c_mock_transfer_count(void) {
+    return transfer_count;
+}
+
+const i2c_mock_transfer_t *i2c_mock_transfer(int index) {
+    return (index >= 0 && index < transfer_count) ? &transfers[index] : NULL;
+}
+
+int i2c_mock_abort_count(void) {
+    return abort_count;
+}
+
+static void mock_init(i2c_bus_t *bus, i2c_inst_t *i2c, uint32_t baudrate) {
+    mock_bus = bus;
+}
+
+static bool mock_start(i2c_bus_t *bus, i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t write_len,
+                       uint8_t *dst, size_t read_len) {
+    if (pending) {
+        return false;
+    }
+    mock_device_t *dev = NULL;
+    for (int i = 0; i < device_count; i++) {
+        if (devices[i].addr == addr) {
+            dev = &devices[i];
+        }
+    }
+
+    // Address byte + data bytes (+ repeated-start address byte), 9 clocks each
+    size_t bytes = 1 + write_len + read_len + ((write_len > 0 && read_len > 0) ? 1 : 0);
+    i2c_bus_status_t status = I2C_BUS_OK;
+    if (dev == NULL) {
+        status = I2C_BUS_NACK;
+        bytes = 1;
+    } else if (write_len == 0 && now_us < dev->busy_until_us) {
+        status = I2C_BUS_NACK;      // Still converting: address NACKed
+        bytes = 1;
+    }
+    uint64_t end = now_us + bytes * 9 * I2C_MOCK_BIT_US;
+
+    if (status == I2C_BUS_OK) {
+        if (write_len > 0) {
+            dev->busy_until_us = end + dev->conversion_us;
+        }
+        if (read_len > 0) {
+            // A repeated-start read stretches the clock through the conversion
+            if (write_len > 0) {
+                end += dev->conversion_us;
+            }
+            for (size_t i = 0; i < read_len; i++) {
+                dst[i] = (i < dev->len) ? dev->response[i] : 0xFF;
+            }
+        }
+    }
+
+    if (transfer_count < I2C_MOCK_MAX_LOG) {
+        i2c_mock_transfer_t *log = &transfers[transfer_count++];
+        log->addr = addr;
+        log->write_len = write_len;
+        log->read_len = read_len;
+        log->start_us = now_us;
+        log->end_us = end;
+        log->status = status;
+    }
+
+    pending = !hang;
+    pending_end_us = end;
+    pending_status = status;
+    return true;
+}
+
+static void mock_abort(i2c_bus_t *bus, i2c_inst_t *i2c) {
+    abort_count++;
+    pending = false;
+}
+
+static uint64_t mock_time_us(void) {
+    now_us += I2C_MOCK_POLL_US;
+    deliver();
+    return now_us;
+}
+
+static const i2c_bus_hal_t mock_hal = {
+    .init = mock_init,
+    .start = mock_start,
+    .abort = mock_abort,
+    .time_us = mock_time_us
+};
+
+const i2c_bus_hal_t *i2c_bus_get_mock_hal(void) {
+    return &mock_hal;
+}
+
+// For test builds, default HAL is the mock
+const i2c_bus_hal_t *i2c_bus_get_default_hal(void) {
+    return &mock_hal;
+}
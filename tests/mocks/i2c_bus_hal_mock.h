@@ -0,0 +1,51 @@
+/**
+ * File: i2c_bus_hal_mock.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Mock I2C bus backend with a simulated clock and simulated devices
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef I2C_BUS_HAL_MOCK_H
+#define I2C_BUS_HAL_MOCK_H
+
+#include "i2c_bus_hal.h"
+
+#define I2C_MOCK_MAX_DEVICES    4
+#define I2C_MOCK_MAX_LOG        32
+#define I2C_MOCK_BIT_US         10      // 100 kHz
+#define I2C_MOCK_POLL_US        5       // Simulated time per clock read
+
+// One transfer seen by the backend
+typedef struct {
+    uint8_t addr;
+    size_t write_len;
+    size_t read_len;
+    uint64_t start_us;
+    uint64_t end_us;
+    i2c_bus_status_t status;
+} i2c_mock_transfer_t;
+
+// Get the mock backend
+const i2c_bus_hal_t *i2c_bus_get_mock_hal(void);
+
+// Reset clock, devices and log
+void i2c_mock_reset(void);
+
+// Add a device that NACKs reads for conversion_us after each write, then returns response
+void i2c_mock_add_device(uint8_t addr, uint32_t conversion_us, const uint8_t *response, size_t len);
+
+// Make the next transfers never complete (stuck bus)
+void i2c_mock_set_hang(bool hang);
+
+uint64_t i2c_mock_now_us(void);
+void i2c_mock_advance_us(uint64_t us);
+int i2c_mock_transfer_count(void);
+const i2c_mock_transfer_t *i2c_mock_transfer(int index);
+int i2c_mock_abort_count(void);
+
+#endif // I2C_BUS_HAL_MOCK_H
@@ -13,6 +13,12 @@
 #include "mock_hardware_gpio.h"
 #include "unity.h"
 
+#define MOCK_GPIO_COUNT 32
+
+// Mock state: last level and number of writes per pin
+static bool mock_gpio_level[MOCK_GPIO_COUNT];
+static int mock_gpio_puts[MOCK_GPIO_COUNT];
+
 // Mock functions - simplified implementation
 void gpio_init(uint gpio) {
     // Mock implementation does nothing
@@ -23,7 +29,10 @@ void gpio_set_dir(uint gpio, bool out) {
 }
 
 void gpio_put(uint gpio, bool value) {
-    // Mock implementation does nothing
+    if (gpio < MOCK_GPIO_COUNT) {
+        mock_gpio_level[gpio] = value;
+        mock_gpio_puts[gpio]++;
+    }
 }
 
 void gpio_set_function(uint gpio, gpio_function_t fn) {
@@ -49,5 +58,16 @@ void gpio_set_function_Expect(uint gpio, gpio_function_t fn) {
 
 // Reset mock state
 void gpio_mock_reset(void) {
-    // Reset any stored state
+    for (int i = 0; i < MOCK_GPIO_COUNT; i++) {
+        mock_gpio_level[i] = false;
+        mock_gpio_puts[i] = 0;
+    }
+}
+
+bool gpio_mock_get(uint gpio) {
+    return (gpio < MOCK_GPIO_COUNT) ? mock_gpio_level[gpio] : false;
+}
+
+int gpio_mock_put_count(uint gpio) {
+    return (gpio < MOCK_GPIO_COUNT) ? mock_gpio_puts[gpio] : 0;
 }
\ No newline at end of file
@@ -36,5 +36,7 @@ void gpio_set_function_Expect(uint gpio, gpio_function_t fn);
 
 // Mock control helpers
 void gpio_mock_reset(void);
+bool gpio_mock_get(uint gpio);         // Last level written to a pin
+int gpio_mock_put_count(uint gpio);    // Writes to a pin since the last reset
 
 #endif // MOCK_HARDWARE_GPIO_H
\ No newline at end of file
@@ -19,6 +19,7 @@ static bool mock_uart_is_readable_return = false;
 static bool mock_ignore_buffer = false;
 static uint8_t *mock_read_data = NULL;
 static size_t mock_read_data_offset = 0;
+static int mock_write_count = 0;
 
 void uart_init(uart_inst_t *uart, uint baudrate) {
     // Mock implementation - just verify it was called if needed
@@ -37,7 +38,7 @@ void uart_read_blocking(uart_inst_t *uart, uint8_t *dst, size_t len) {
 }
 
 void uart_write_blocking(uart_inst_t *uart, const uint8_t *src, size_t len) {
-    // Mock implementation - just verify it was called if needed
+    mock_write_count++;
 }
 
 // Mock control functions
@@ -79,4 +80,9 @@ void uart_mock_reset(void) {
     mock_ignore_buffer = false;
     mock_read_data = NULL;
     mock_read_data_offset = 0;
+    mock_write_count = 0;
+}
+
+int uart_mock_write_count(void) {
+    return mock_write_count;
 }
\ No newline at end of file
@@ -37,5 +37,6 @@ void uart_write_blocking_IgnoreArg_buffer(void);
 // Mock control helpers
 void uart_read_blocking_SetDataToReturn(uint8_t *data);
 void uart_mock_reset(void);
+int uart_mock_write_count(void);       // Writes since the last reset
 
 #endif // MOCK_HARDWARE_UART_H
\ No newline at end of file
@@ -26,9 +26,20 @@ static const pm25_gpio_hal_t mock_gpio_hal = {
     .set_function = gpio_set_function
 };
 
+static uint64_t mock_time_us = 0;
+
+static uint64_t mock_hal_time_us(void) {
+    return mock_time_us;
+}
+
+void pm25_mock_set_time_us(uint64_t time_us) {
+    mock_time_us = time_us;
+}
+
 static const pm25_hal_t mock_hal = {
     .uart = &mock_uart_hal,
-    .gpio = &mock_gpio_hal
+    .gpio = &mock_gpio_hal,
+    .time_us = mock_hal_time_us
 };
 
 const pm25_hal_t* pm25_get_mock_hal(void) {
@@ -15,4 +15,7 @@
 // Get the mock HAL implementation
 const pm25_hal_t* pm25_get_mock_hal(void);
 
+// Set the time returned by the mock HAL clock
+void pm25_mock_set_time_us(uint64_t time_us);
+
 #endif // PM25_HAL_MOCK_H
@@ -0,0 +1,101 @@
+/**
+ * File: power_hal_mock.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Fake power backend with a simulated clock and scheduled RX start bits
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "power_hal_mock.h"
+
+static uint32_t now_ms;
+static uint32_t edges[POWER_MOCK_MAX_EDGES];
+static int edge_count;
+static int sleeps;
+static int idles;
+static bool last_rx_wake;
+
+// Earliest edge after now and before the deadline, -1 if none
+static int next_edge(uint32_t deadline_ms) {
+    int best = -1;
+    for (int i = 0; i < edge_count; i++) {
+        if ((int32_t)(edges[i] - now_ms) > 0 && (int32_t)(edges[i] - deadline_ms) < 0 &&
+            (best < 0 || (int32_t)(edges[i] - edges[best]) < 0)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+static void mock_idle_until(uint32_t deadline_ms) {
+    idles++;
+    if ((int32_t)(deadline_ms - now_ms) > 0) {
+        now_ms = deadline_ms;
+    }
+}
+
+static power_wake_t mock_sleep_until(uint32_t deadline_ms, bool rx_wake) {
+    sleeps++;
+    last_rx_wake = rx_wake;
+    int edge = rx_wake ? next_edge(deadline_ms) : -1;
+    if (edge >= 0) {
+        now_ms = edges[edge];
+        return POWER_WAKE_UART_RX;
+    }
+    if ((int32_t)(deadline_ms - now_ms) > 0) {
+        now_ms = deadline_ms;
+    }
+    return POWER_WAKE_TIMER;
+}
+
+static uint32_t mock_now_ms(void) {
+    return now_ms;
+}
+
+static const power_hal_t mock_hal = {
+    .idle_until = mock_idle_until,
+    .sleep_until = mock_sleep_until,
+    .now_ms = mock_now_ms
+};
+
+const power_hal_t *power_get_mock_hal(void) {
+    return &mock_hal;
+}
+
+void power_mock_reset(void) {
+    now_ms = 0;
+    edge_count = 0;
+    sleeps = 0;
+    idles = 0;
+    last_rx_wake = false;
+}
+
+void power_mock_add_rx_edge(uint32_t at_ms) {
+    if (edge_count < POWER_MOCK_MAX_EDGES) {
+        edges[edge_count++] = at_ms;
+    }
+}
+
+uint32_t power_mock_now_ms(void) {
+    return now_ms;
+}
+
+void power_mock_advance_ms(uint32_t ms) {
+    now_ms += ms;
+}
+
+int power_mock_sleeps(void) {
+    return sleeps;
+}
+
+int power_mock_idles(void) {
+    return idles;
+}
+
+bool power_mock_last_rx_wake(void) {
+    return last_rx_wake;
+}
@@ -0,0 +1,35 @@
+/**
+ * File: power_hal_mock.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Fake power backend with a simulated clock and scheduled RX start bits
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef POWER_HAL_MOCK_H
+#define POWER_HAL_MOCK_H
+
+#include "power_hal.h"
+
+#define POWER_MOCK_MAX_EDGES    16
+
+// Get the fake backend
+const power_hal_t *power_get_mock_hal(void);
+
+// Reset clock, edges and counters
+void power_mock_reset(void);
+
+// Start bit on the RX line at the given time; ends a deep sleep only while RX wake is armed
+void power_mock_add_rx_edge(uint32_t at_ms);
+
+uint32_t power_mock_now_ms(void);
+void power_mock_advance_ms(uint32_t ms);
+int power_mock_sleeps(void);
+int power_mock_idles(void);
+bool power_mock_last_rx_wake(void);     // rx_wake argument of the last deep sleep
+
+#endif // POWER_HAL_MOCK_H
@@ -0,0 +1,81 @@
+/**
+ * File: radio_hal_mock.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Fake radio backend with a simulated clock that records power-mode switches
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "radio_hal_mock.h"
+
+static uint32_t now_ms;
+static radio_pm_t mode;
+static uint32_t mode_since_ms;
+static uint32_t active_ms;
+static int wakeups;
+static bool fail;
+
+static bool mock_set_pm(radio_pm_t new_mode) {
+    if (fail) {
+        return false;
+    }
+    if (mode == RADIO_PM_ACTIVE) {
+        active_ms += now_ms - mode_since_ms;
+    }
+    if (mode == RADIO_PM_POWERSAVE && new_mode == RADIO_PM_ACTIVE) {
+        wakeups++;
+    }
+    mode = new_mode;
+    mode_since_ms = now_ms;
+    return true;
+}
+
+static uint32_t mock_now_ms(void) {
+    return now_ms;
+}
+
+static const radio_hal_t mock_hal = {
+    .set_pm = mock_set_pm,
+    .now_ms = mock_now_ms
+};
+
+const radio_hal_t *radio_get_mock_hal(void) {
+    return &mock_hal;
+}
+
+void radio_mock_reset(void) {
+    now_ms = 0;
+    mode = RADIO_PM_POWERSAVE;
+    mode_since_ms = 0;
+    active_ms = 0;
+    wakeups = 0;
+    fail = false;
+}
+
+void radio_mock_set_fail(bool value) {
+    fail = value;
+}
+
+uint32_t radio_mock_now_ms(void) {
+    return now_ms;
+}
+
+void radio_mock_advance_ms(uint32_t ms) {
+    now_ms += ms;
+}
+
+radio_pm_t radio_mock_mode(void) {
+    return mode;
+}
+
+int radio_mock_wakeups(void) {
+    return wakeups;
+}
+
+uint32_t radio_mock_active_ms(void) {
+    return active_ms + ((mode == RADIO_PM_ACTIVE) ? now_ms - mode_since_ms : 0);
+}
@@ -0,0 +1,33 @@
+/**
+ * File: radio_hal_mock.h
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Fake radio backend with a simulated clock that records power-mode switches
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#ifndef RADIO_HAL_MOCK_H
+#define RADIO_HAL_MOCK_H
+
+#include "radio_hal.h"
+
+// Get the fake backend
+const radio_hal_t *radio_get_mock_hal(void);
+
+// Reset clock, mode and counters; the radio starts in power save
+void radio_mock_reset(void);
+
+// Make the backend refuse mode switches
+void radio_mock_set_fail(bool fail);
+
+uint32_t radio_mock_now_ms(void);
+void radio_mock_advance_ms(uint32_t ms);
+radio_pm_t radio_mock_mode(void);
+int radio_mock_wakeups(void);           // Switches from power save to active
+uint32_t radio_mock_active_ms(void);    // Time spent in active mode, measured by the fake radio
+
+#endif // RADIO_HAL_MOCK_H
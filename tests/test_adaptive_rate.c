@@ -0,0 +1,120 @@
+/**
+ * File: test_adaptive_rate.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the variability-adaptive sampling rate controller
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "adaptive_rate.h"
+#include <string.h>
+
+static adaptive_rate_t ar;
+
+void setUp(void) {
+    adaptive_rate_init(&ar, NULL);
+}
+
+void tearDown(void) {}
+
+static pm25_data_t sample(uint16_t pm2_5, uint16_t count_0_3) {
+    pm25_data_t data;
+    memset(&data, 0, sizeof(data));
+    data.pm2_5_atm = pm2_5;
+    data.count_0_3 = count_0_3;
+    return data;
+}
+
+// Feed n samples alternating +-1 around a level, returns the last interval
+static uint32_t feed_stable(int n, uint16_t pm2_5) {
+    uint32_t interval = 0;
+    for (int i = 0; i < n; i++) {
+        pm25_data_t data = sample((uint16_t)(pm2_5 + (i & 1)), (uint16_t)(1000 + 5 * (i & 1)));
+        interval = adaptive_rate_update(&ar, &data);
+    }
+    return interval;
+}
+
+void test_starts_at_full_rate(void) {
+    TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS, adaptive_rate_interval_ms(&ar));
+}
+
+void test_stable_air_stretches_to_ceiling(void) {
+    uint32_t interval = feed_stable(ADAPTIVE_RATE_DEFAULT_STABLE_SAMPLES, 20);
+    TEST_ASSERT_EQUAL_UINT32(2 * ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS, interval);
+
+    interval = feed_stable(20 * ADAPTIVE_RATE_DEFAULT_STABLE_SAMPLES, 20);
+    TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_RATE_DEFAULT_MAX_INTERVAL_MS, interval);
+    TEST_ASSERT_TRUE(adaptive_rate_sensor_can_sleep(&ar, 30000));
+}
+
+void test_step_snaps_back_within_one_frame(void) {
+    feed_stable(200, 20);
+    TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_RATE_DEFAULT_MAX_INTERVAL_MS, adaptive_rate_interval_ms(&ar));
+
+    pm25_data_t data = sample(80, 1000);
+    TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS, adaptive_rate_update(&ar, &data));
+    TEST_ASSERT_EQUAL_UINT32(1, ar.changes);
+    TEST_ASSERT_FALSE(adaptive_rate_sensor_can_sleep(&ar, 30000));
+}
+
+void test_slow_drift_is_detected(void) {
+    feed_stable(200, 20);
+
+    // +1 µg/m³ per sample accumulates in the CUSUM long before any single jump is large
+    uint32_t interval = ADAPTIVE_RATE_DEFAULT_MAX_INTERVAL_MS;
+    for (uint16_t pm = 21; pm < 40 && interval != ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS; pm++) {
+        pm25_data_t data = sample(pm, 1000);
+        interval = adaptive_rate_update(&ar, &data);
+    }
+    TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS, interval);
+}
+
+void test_unmonitored_fields_are_ignored(void) {
+    feed_stable(200, 20);
+
+    pm25_data_t data = sample(20, 1000);
+    data.pm10_atm = 900;
+    TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_RATE_DEFAULT_MAX_INTERVAL_MS, adaptive_rate_update(&ar, &data));
+}
+
+void test_respects_configured_bounds(void) {
+    adaptive_rate_config_t config;
+    adaptive_rate_default_config(&config);
+    config.min_interval_ms = 5000;
+    config.max_interval_ms = 15000;
+    adaptive_rate_init(&ar, &config);
+
+    TEST_ASSERT_EQUAL_UINT32(5000, adaptive_rate_interval_ms(&ar));
+    TEST_ASSERT_EQUAL_UINT32(15000, feed_stable(100, 20));
+}
+
+void test_limits_change_keeps_state(void) {
+    TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_RATE_DEFAULT_MAX_INTERVAL_MS, feed_stable(200, 20));
+
+    // A lower ceiling clamps the interval at once; stable air stays stable
+    adaptive_rate_set_limits(&ar, 2000, 20000);
+    TEST_ASSERT_EQUAL_UINT32(20000, adaptive_rate_interval_ms(&ar));
+    TEST_ASSERT_EQUAL_UINT32(20000, feed_stable(2, 20));
+
+    // The change detector still knows the level it learned
+    pm25_data_t data = sample(80, 1000);
+    TEST_ASSERT_EQUAL_UINT32(2000, adaptive_rate_update(&ar, &data));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_starts_at_full_rate);
+    RUN_TEST(test_stable_air_stretches_to_ceiling);
+    RUN_TEST(test_step_snaps_back_within_one_frame);
+    RUN_TEST(test_slow_drift_is_detected);
+    RUN_TEST(test_unmonitored_fields_are_ignored);
+    RUN_TEST(test_respects_configured_bounds);
+    RUN_TEST(test_limits_change_keeps_state);
+    return UNITY_END();
+}
@@ -0,0 +1,115 @@
+/**
+ * File: test_aqi.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the US-EPA AQI and NowCast engine
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "aqi.h"
+
+static aqi_nowcast_t nc;
+
+void setUp(void) {
+    aqi_nowcast_init(&nc);
+}
+
+void tearDown(void) {}
+
+// Feed one constant-value hour of 1 Hz samples starting at hour `hour`
+static void add_hour(uint32_t hour, fx_centi_t value) {
+    for (uint32_t s = 0; s < AQI_SECONDS_PER_HOUR; s += 60) {
+        aqi_nowcast_add(&nc, hour * AQI_SECONDS_PER_HOUR + s, value);
+    }
+}
+
+void test_pm25_breakpoints(void) {
+    TEST_ASSERT_EQUAL_UINT16(0, aqi_from_pm25(0));
+    TEST_ASSERT_EQUAL_UINT16(50, aqi_from_pm25(900));
+    TEST_ASSERT_EQUAL_UINT16(51, aqi_from_pm25(910));
+    TEST_ASSERT_EQUAL_UINT16(100, aqi_from_pm25(3540));
+    TEST_ASSERT_EQUAL_UINT16(101, aqi_from_pm25(3550));
+    TEST_ASSERT_EQUAL_UINT16(500, aqi_from_pm25(32540));
+    TEST_ASSERT_EQUAL_UINT16(AQI_MAX, aqi_from_pm25(90000));
+}
+
+void test_pm25_interpolation_truncates(void) {
+    // 12.0 µg/m³: 51 + 49 * (120 - 91) / 263 = 56.4 -> 56
+    TEST_ASSERT_EQUAL_UINT16(56, aqi_from_pm25(1200));
+    // 35.49 truncates to 35.4, still in the moderate band
+    TEST_ASSERT_EQUAL_UINT16(100, aqi_from_pm25(3549));
+}
+
+void test_pm10_breakpoints(void) {
+    TEST_ASSERT_EQUAL_UINT16(50, aqi_from_pm10(5400));
+    TEST_ASSERT_EQUAL_UINT16(51, aqi_from_pm10(5500));
+    TEST_ASSERT_EQUAL_UINT16(500, aqi_from_pm10(60400));
+}
+
+void test_nowcast_needs_two_recent_hours(void) {
+    fx_centi_t value;
+
+    add_hour(0, FX_FROM_INT(10));
+    aqi_nowcast_add(&nc, 1 * AQI_SECONDS_PER_HOUR, FX_FROM_INT(10));
+    TEST_ASSERT_FALSE(aqi_nowcast_get(&nc, &value));
+
+    add_hour(1, FX_FROM_INT(10));
+    aqi_nowcast_add(&nc, 2 * AQI_SECONDS_PER_HOUR, FX_FROM_INT(10));
+    TEST_ASSERT_TRUE(aqi_nowcast_get(&nc, &value));
+    TEST_ASSERT_EQUAL_INT32(FX_FROM_INT(10), value);
+}
+
+void test_nowcast_weights_recent_hours(void) {
+    fx_centi_t value;
+
+    // Stable 10 for 11 hours, then a 40 hour: w* = 0.25 -> w = 0.5
+    for (uint32_t h = 0; h < 11; h++) {
+        add_hour(h, FX_FROM_INT(10));
+    }
+    add_hour(11, FX_FROM_INT(40));
+    aqi_nowcast_add(&nc, 12 * AQI_SECONDS_PER_HOUR, 0);
+
+    TEST_ASSERT_TRUE(aqi_nowcast_get(&nc, &value));
+    // (40 + 10 * (0.5 + ... + 0.5^11)) / (1 + 0.5 + ... + 0.5^11) = 25.00
+    TEST_ASSERT_INT_WITHIN(2, 2500, value);
+}
+
+void test_nowcast_gap_invalidates(void) {
+    fx_centi_t value;
+
+    add_hour(0, FX_FROM_INT(10));
+    add_hour(1, FX_FROM_INT(10));
+    // Sensor silent for hours 2 and 3
+    aqi_nowcast_add(&nc, 4 * AQI_SECONDS_PER_HOUR, FX_FROM_INT(10));
+    TEST_ASSERT_FALSE(aqi_nowcast_get(&nc, &value));
+}
+
+void test_report(void) {
+    aqi_report_t report;
+
+    add_hour(0, FX_FROM_INT(12));
+    add_hour(1, FX_FROM_INT(12));
+    aqi_nowcast_add(&nc, 2 * AQI_SECONDS_PER_HOUR, FX_FROM_INT(12));
+
+    aqi_report_pm25(&nc, 40, &report);
+    TEST_ASSERT_EQUAL_UINT16(112, report.aqi);
+    TEST_ASSERT_TRUE(report.nowcast_valid);
+    TEST_ASSERT_EQUAL_UINT16(56, report.nowcast_aqi);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_pm25_breakpoints);
+    RUN_TEST(test_pm25_interpolation_truncates);
+    RUN_TEST(test_pm10_breakpoints);
+    RUN_TEST(test_nowcast_needs_two_recent_hours);
+    RUN_TEST(test_nowcast_weights_recent_hours);
+    RUN_TEST(test_nowcast_gap_invalidates);
+    RUN_TEST(test_report);
+    return UNITY_END();
+}
@@ -0,0 +1,235 @@
+/**
+ * File: test_boot_seq.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the boot sequencer
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "boot_seq.h"
+#include <string.h>
+
+#define POLL_MS     50u     // Main loop poll period during boot
+
+// Fake task: completes a fixed time after it was started, or fails
+typedef struct {
+    uint32_t duration_ms;
+    bool fail_start;
+    bool fail_poll;
+    int starts;
+    int polls;
+    int order;              // Start order, from start_counter
+} fake_task_t;
+
+static boot_seq_t seq;
+static int start_counter;
+
+static bool fake_start(void *ctx) {
+    fake_task_t *t = (fake_task_t *)ctx;
+    t->starts++;
+    t->order = ++start_counter;
+    return !t->fail_start;
+}
+
+static boot_step_t fake_poll(void *ctx, uint32_t elapsed_ms) {
+    fake_task_t *t = (fake_task_t *)ctx;
+    t->polls++;
+    if (t->fail_poll) {
+        return BOOT_STEP_FAILED;
+    }
+    return (elapsed_ms >= t->duration_ms) ? BOOT_STEP_DONE : BOOT_STEP_PENDING;
+}
+
+static int add(const char *name, fake_task_t *t, uint16_t deps, uint32_t timeout_ms) {
+    boot_task_t task = {
+        .name = name,
+        .start = fake_start,
+        .poll = fake_poll,
+        .ctx = t,
+        .deps = deps,
+        .timeout_ms = timeout_ms
+    };
+    return boot_seq_add(&seq, &task);
+}
+
+// Poll every POLL_MS until the sequence has finished; returns the time it took
+static uint32_t run(uint32_t limit_ms) {
+    uint32_t now = 0;
+    while (!boot_seq_poll(&seq, now) && now < limit_ms) {
+        now += POLL_MS;
+    }
+    return now;
+}
+
+void setUp(void) {
+    boot_seq_init(&seq);
+    start_counter = 0;
+}
+
+void tearDown(void) {
+}
+
+void test_independent_tasks_start_together(void) {
+    fake_task_t a = { .duration_ms = 1000 };
+    fake_task_t b = { .duration_ms = 3000 };
+    add("a", &a, 0, 0);
+    add("b", &b, 0, 0);
+
+    TEST_ASSERT_FALSE(boot_seq_poll(&seq, 0));
+    TEST_ASSERT_EQUAL_INT(1, a.starts);
+    TEST_ASSERT_EQUAL_INT(1, b.starts);
+
+    // Total is the longest task, not the sum
+    TEST_ASSERT_EQUAL_UINT32(3000, run(60000));
+    TEST_ASSERT_EQUAL_UINT32(1000, boot_seq_slot(&seq, 0)->end_ms);
+    TEST_ASSERT_EQUAL_UINT32(3000, seq.end_ms);
+}
+
+void test_dependent_task_waits_for_its_dependencies(void) {
+    fake_task_t join = { .duration_ms = 2000 };
+    fake_task_t dhcp = { .duration_ms = 1500 };
+    int j = add("join", &join, 0, 0);
+    int d = add("dhcp", &dhcp, BOOT_DEP(j), 0);
+
+    boot_seq_poll(&seq, 0);
+    TEST_ASSERT_EQUAL(BOOT_TASK_PENDING, boot_seq_state(&seq, d));
+    TEST_ASSERT_EQUAL_INT(0, dhcp.starts);
+
+    TEST_ASSERT_EQUAL_UINT32(3500, run(60000));
+    const boot_slot_t *slot = boot_seq_slot(&seq, d);
+    TEST_ASSERT_EQUAL_UINT32(2000, slot->start_ms);
+    TEST_ASSERT_EQUAL_UINT32(3500, slot->end_ms);
+    TEST_ASSERT_EQUAL_INT(1, dhcp.starts);
+}
+
+void test_chain_of_instant_tasks_finishes_in_one_poll(void) {
+    fake_task_t a = { 0 };
+    fake_task_t b = { 0 };
+    fake_task_t c = { 0 };
+    int ia = add("a", &a, 0, 0);
+    int ib = add("b", &b, BOOT_DEP(ia), 0);
+    add("c", &c, BOOT_DEP(ib), 0);
+
+    TEST_ASSERT_TRUE(boot_seq_poll(&seq, 0));
+    TEST_ASSERT_EQUAL_INT(1, a.order);
+    TEST_ASSERT_EQUAL_INT(2, b.order);
+    TEST_ASSERT_EQUAL_INT(3, c.order);
+}
+
+void test_task_without_poll_is_done_when_started(void) {
+    fake_task_t a = { 0 };
+    boot_task_t task = { .name = "sync", .start = fake_start, .ctx = &a };
+    int id = boot_seq_add(&seq, &task);
+
+    TEST_ASSERT_TRUE(boot_seq_poll(&seq, 120));
+    TEST_ASSERT_EQUAL(BOOT_TASK_DONE, boot_seq_state(&seq, id));
+    TEST_ASSERT_EQUAL_UINT32(120, boot_seq_slot(&seq, id)->start_ms);
+    TEST_ASSERT_EQUAL_UINT32(120, boot_seq_slot(&seq, id)->end_ms);
+}
+
+void test_failure_skips_dependents_only(void) {
+    fake_task_t radio = { .fail_start = true };
+    fake_task_t join = { .duration_ms = 100 };
+    fake_task_t mqtt = { .duration_ms = 100 };
+    fake_task_t sensor = { .duration_ms = 5000 };
+    int r = add("radio", &radio, 0, 0);
+    int j = add("join", &join, BOOT_DEP(r), 0);
+    int m = add("mqtt", &mqtt, BOOT_DEP(j), 0);
+    int s = add("sensor", &sensor, 0, 0);
+
+    TEST_ASSERT_EQUAL_UINT32(5000, run(60000));
+    TEST_ASSERT_EQUAL(BOOT_TASK_FAILED, boot_seq_state(&seq, r));
+    TEST_ASSERT_EQUAL(BOOT_TASK_SKIPPED, boot_seq_state(&seq, j));
+    TEST_ASSERT_EQUAL(BOOT_TASK_SKIPPED, boot_seq_state(&seq, m));
+    TEST_ASSERT_EQUAL(BOOT_TASK_DONE, boot_seq_state(&seq, s));
+    TEST_ASSERT_EQUAL_INT(0, join.starts);
+    TEST_ASSERT_EQUAL_INT(0, mqtt.starts);
+    TEST_ASSERT_FALSE(boot_seq_ready(&seq, BOOT_DEP(s) | BOOT_DEP(m)));
+    TEST_ASSERT_TRUE(boot_seq_ready(&seq, BOOT_DEP(s)));
+}
+
+void test_poll_failure_and_timeout(void) {
+    fake_task_t bad = { .duration_ms = 100, .fail_poll = true };
+    fake_task_t slow = { .duration_ms = 60000 };
+    int b = add("bad", &bad, 0, 0);
+    int s = add("slow", &slow, 0, 10000);
+
+    TEST_ASSERT_EQUAL_UINT32(10000, run(120000));
+    TEST_ASSERT_EQUAL(BOOT_TASK_FAILED, boot_seq_state(&seq, b));
+    TEST_ASSERT_EQUAL(BOOT_TASK_FAILED, boot_seq_state(&seq, s));
+    TEST_ASSERT_EQUAL_UINT32(10000, boot_seq_slot(&seq, s)->end_ms);
+
+    // Finished tasks are not polled again
+    int polls = slow.polls;
+    boot_seq_poll(&seq, 20000);
+    TEST_ASSERT_EQUAL_INT(polls, slow.polls);
+}
+
+void test_add_rejects_unknown_dependencies_and_overflow(void) {
+    fake_task_t t[BOOT_SEQ_MAX_TASKS + 1];
+    memset(t, 0, sizeof(t));
+
+    // Depends on itself / a later task
+    TEST_ASSERT_EQUAL_INT(-1, add("self", &t[0], BOOT_DEP(0), 0));
+    for (int i = 0; i < BOOT_SEQ_MAX_TASKS; i++) {
+        TEST_ASSERT_EQUAL_INT(i, add("t", &t[i], (i > 0) ? BOOT_DEP(i - 1) : 0, 0));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, add("over", &t[BOOT_SEQ_MAX_TASKS], 0, 0));
+    TEST_ASSERT_NULL(boot_seq_slot(&seq, BOOT_SEQ_MAX_TASKS));
+    TEST_ASSERT_FALSE(boot_seq_ready(&seq, BOOT_DEP(BOOT_SEQ_MAX_TASKS)));
+}
+
+// Firmware graph: sensor warm-up overlaps radio power-up, association, DHCP and the MQTT/TLS connect
+void test_firmware_boot_overlaps_warmup_and_network(void) {
+    fake_task_t pms = { .duration_ms = 30000 };
+    fake_task_t sht = { 0 };
+    fake_task_t radio = { .duration_ms = 300 };
+    fake_task_t join = { .duration_ms = 2500 };
+    fake_task_t dhcp = { .duration_ms = 1200 };
+    fake_task_t mqtt = { .duration_ms = 1800 };
+    int p = add("pms", &pms, 0, 0);
+    int s = add("sht3x", &sht, 0, 0);
+    int r = add("radio", &radio, 0, 0);
+    int j = add("join", &join, BOOT_DEP(r), 20000);
+    int d = add("dhcp", &dhcp, BOOT_DEP(j), 10000);
+    int m = add("mqtt", &mqtt, BOOT_DEP(d), 15000);
+
+    uint32_t total = run(120000);
+    uint32_t serial = 30000 + 300 + 2500 + 1200 + 1800;
+    TEST_ASSERT_EQUAL_UINT32(30000, total);
+    TEST_ASSERT_TRUE(total < serial);
+
+    // Network is up long before the sensors are warm: the first samples are sent straight away
+    TEST_ASSERT_EQUAL_UINT32(5800, boot_seq_slot(&seq, m)->end_ms);
+    TEST_ASSERT_TRUE(boot_seq_ready(&seq, BOOT_DEP(p) | BOOT_DEP(s) | BOOT_DEP(m)));
+    TEST_ASSERT_EQUAL(BOOT_TASK_DONE, boot_seq_state(&seq, d));
+}
+
+void test_null_arguments_are_harmless(void) {
+    boot_seq_init(NULL);
+    TEST_ASSERT_EQUAL_INT(-1, boot_seq_add(NULL, NULL));
+    TEST_ASSERT_EQUAL_INT(-1, boot_seq_add(&seq, NULL));
+    TEST_ASSERT_TRUE(boot_seq_poll(NULL, 0));
+    TEST_ASSERT_TRUE(boot_seq_poll(&seq, 0));
+    TEST_ASSERT_FALSE(boot_seq_ready(NULL, 0));
+    TEST_ASSERT_EQUAL(BOOT_TASK_SKIPPED, boot_seq_state(&seq, 0));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_independent_tasks_start_together);
+    RUN_TEST(test_dependent_task_waits_for_its_dependencies);
+    RUN_TEST(test_chain_of_instant_tasks_finishes_in_one_poll);
+    RUN_TEST(test_task_without_poll_is_done_when_started);
+    RUN_TEST(test_failure_skips_dependents_only);
+    RUN_TEST(test_poll_failure_and_timeout);
+    RUN_TEST(test_add_rejects_unknown_dependencies_and_overflow);
+    RUN_TEST(test_firmware_boot_overlaps_warmup_and_network);
+    RUN_TEST(test_null_arguments_are_harmless);
+    return UNITY_END();
+}
@@ -0,0 +1,258 @@
+/**
+ * File: test_clock_policy.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the clock policy on the fake clock backend
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "clock_policy.h"
+#include "clock_hal_mock.h"
+
+#define LOWER_DELAY_MS  CLOCK_POLICY_DEFAULT_LOWER_DELAY_MS
+
+static int listener_calls;
+static uint32_t listener_hz;
+static uint32_t listener_mv;     // Voltage the chip had when the listener ran
+
+static void listener(uint32_t sys_hz, void *ctx) {
+    (*(int *)ctx)++;
+    listener_hz = sys_hz;
+    listener_mv = clock_mock_vreg_mv();
+}
+
+void setUp(void) {
+    clock_mock_reset(CLOCK_POLICY_DEFAULT_BURST_KHZ, CLOCK_POLICY_DEFAULT_BURST_MV);
+    TEST_ASSERT_TRUE(clock_policy_init(NULL, clock_get_mock_hal()));
+    listener_calls = 0;
+    listener_hz = 0;
+    listener_mv = 0;
+    TEST_ASSERT_TRUE(clock_policy_add_listener(listener, &listener_calls));
+    clock_mock_clear_steps();
+}
+
+void tearDown(void) {
+}
+
+static void assert_step(int index, clock_mock_step_kind_t kind, uint32_t value) {
+    const clock_mock_step_t *step = clock_mock_step(index);
+    TEST_ASSERT_NOT_NULL(step);
+    TEST_ASSERT_EQUAL_INT(kind, step->kind);
+    TEST_ASSERT_EQUAL_UINT32(value, step->value);
+}
+
+void test_init_drops_to_acquire_level_clock_first(void) {
+    clock_mock_reset(CLOCK_POLICY_DEFAULT_BURST_KHZ, CLOCK_POLICY_DEFAULT_BURST_MV);
+    TEST_ASSERT_TRUE(clock_policy_init(NULL, clock_get_mock_hal()));
+
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_ACQUIRE, clock_policy_level());
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_ACQUIRE_KHZ, clock_mock_sys_khz());
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_ACQUIRE_MV, clock_mock_vreg_mv());
+    TEST_ASSERT_EQUAL_INT(2, clock_mock_step_count());
+    assert_step(0, CLOCK_MOCK_SYS_CLOCK, CLOCK_POLICY_DEFAULT_ACQUIRE_KHZ);
+    assert_step(1, CLOCK_MOCK_VOLTAGE, CLOCK_POLICY_DEFAULT_ACQUIRE_MV);
+}
+
+void test_burst_raises_at_once_voltage_first(void) {
+    clock_policy_burst_begin(CLOCK_BURST_TLS);
+
+    // No poll and no time passed: the burst runs at full clock from the first instruction
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_BURST, clock_policy_level());
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_BURST_KHZ, clock_mock_sys_khz());
+    TEST_ASSERT_EQUAL_INT(2, clock_mock_step_count());
+    assert_step(0, CLOCK_MOCK_VOLTAGE, CLOCK_POLICY_DEFAULT_BURST_MV);
+    assert_step(1, CLOCK_MOCK_SYS_CLOCK, CLOCK_POLICY_DEFAULT_BURST_KHZ);
+
+    // Listeners run with the new clock and the voltage that supports it
+    TEST_ASSERT_EQUAL_INT(1, listener_calls);
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_BURST_KHZ * 1000u, listener_hz);
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_BURST_MV, listener_mv);
+}
+
+void test_drop_waits_for_lower_delay(void) {
+    clock_policy_set_phase(CLOCK_PHASE_IDLE);
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_ACQUIRE, clock_policy_level());
+
+    uint32_t drop_at = 0;
+    TEST_ASSERT_TRUE(clock_policy_drop_pending(&drop_at));
+    TEST_ASSERT_EQUAL_UINT32(LOWER_DELAY_MS, drop_at);
+
+    clock_mock_advance_ms(LOWER_DELAY_MS - 1);
+    clock_policy_poll();
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_ACQUIRE, clock_policy_level());
+    TEST_ASSERT_EQUAL_INT(0, clock_mock_step_count());
+
+    clock_mock_advance_ms(1);
+    clock_policy_poll();
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_IDLE, clock_policy_level());
+    TEST_ASSERT_FALSE(clock_policy_drop_pending(NULL));
+    assert_step(0, CLOCK_MOCK_SYS_CLOCK, CLOCK_POLICY_DEFAULT_IDLE_KHZ);
+    assert_step(1, CLOCK_MOCK_VOLTAGE, CLOCK_POLICY_DEFAULT_IDLE_MV);
+    // The clock dropped before the voltage, so the listener saw the old, higher voltage
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_ACQUIRE_MV, listener_mv);
+
+    // Back to acquiring: no delay on the way up
+    clock_policy_set_phase(CLOCK_PHASE_ACQUIRE);
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_ACQUIRE, clock_policy_level());
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_ACQUIRE_KHZ, clock_mock_sys_khz());
+}
+
+void test_bursts_are_reference_counted(void) {
+    clock_policy_burst_begin(CLOCK_BURST_TLS);
+    clock_policy_burst_begin(CLOCK_BURST_TLS);
+    clock_policy_burst_begin(CLOCK_BURST_COMPRESS);
+    clock_policy_burst_end(CLOCK_BURST_TLS);
+    clock_policy_burst_end(CLOCK_BURST_COMPRESS);
+    clock_mock_advance_ms(LOWER_DELAY_MS);
+    clock_policy_poll();
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_BURST, clock_policy_level());
+
+    // Unmatched ends do not release the holder that is left
+    clock_policy_burst_end(CLOCK_BURST_DISPLAY);
+    clock_policy_burst_end(CLOCK_BURST_COMPRESS);
+    clock_mock_advance_ms(LOWER_DELAY_MS);
+    clock_policy_poll();
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_BURST, clock_policy_level());
+
+    clock_policy_burst_end(CLOCK_BURST_TLS);
+    clock_mock_advance_ms(LOWER_DELAY_MS);
+    clock_policy_poll();
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_ACQUIRE, clock_policy_level());
+
+    clock_policy_stats_t stats;
+    clock_policy_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.bursts);
+}
+
+void test_back_to_back_bursts_do_not_thrash(void) {
+    for (int i = 0; i < 10; i++) {
+        clock_policy_burst_begin(CLOCK_BURST_DISPLAY);
+        clock_mock_advance_ms(20);
+        clock_policy_burst_end(CLOCK_BURST_DISPLAY);
+        clock_mock_advance_ms(LOWER_DELAY_MS / 2);
+        clock_policy_poll();
+    }
+    // One raise, no drop in between
+    TEST_ASSERT_EQUAL_INT(1, listener_calls);
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_BURST, clock_policy_level());
+
+    clock_mock_advance_ms(LOWER_DELAY_MS);
+    clock_policy_poll();
+    TEST_ASSERT_EQUAL_INT(2, listener_calls);
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_ACQUIRE_KHZ * 1000u, listener_hz);
+}
+
+void test_refused_clock_keeps_level_and_retries(void) {
+    clock_mock_set_fail(false, true);
+    clock_policy_burst_begin(CLOCK_BURST_TLS);
+
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_ACQUIRE, clock_policy_level());
+    TEST_ASSERT_EQUAL_INT(0, listener_calls);
+    // The voltage was raised first and stays up: safe for either clock
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_BURST_MV, clock_mock_vreg_mv());
+
+    clock_policy_stats_t stats;
+    clock_policy_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.errors);
+
+    clock_mock_set_fail(false, false);
+    clock_policy_poll();
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_BURST, clock_policy_level());
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_BURST_KHZ, clock_mock_sys_khz());
+    TEST_ASSERT_EQUAL_INT(1, listener_calls);
+}
+
+void test_refused_voltage_never_overclocks(void) {
+    clock_mock_set_fail(true, false);
+    clock_policy_burst_begin(CLOCK_BURST_TLS);
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_ACQUIRE, clock_policy_level());
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_ACQUIRE_KHZ, clock_mock_sys_khz());
+    TEST_ASSERT_EQUAL_INT(0, clock_mock_step_count());
+
+    // A refused drop leaves the voltage high but the clock low
+    clock_mock_set_fail(false, false);
+    clock_policy_burst_end(CLOCK_BURST_TLS);
+    clock_policy_set_phase(CLOCK_PHASE_IDLE);
+    clock_mock_advance_ms(LOWER_DELAY_MS);
+    clock_mock_set_fail(true, false);
+    clock_policy_poll();
+    TEST_ASSERT_EQUAL_INT(CLOCK_LEVEL_IDLE, clock_policy_level());
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_IDLE_KHZ, clock_mock_sys_khz());
+    TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_ACQUIRE_MV, clock_mock_vreg_mv());
+}
+
+void test_listener_limit(void) {
+    int dummy = 0;
+    for (int i = 1; i < CLOCK_POLICY_MAX_LISTENERS; i++) {
+        TEST_ASSERT_TRUE(clock_policy_add_listener(listener, &dummy));
+    }
+    TEST_ASSERT_FALSE(clock_policy_add_listener(listener, &dummy));
+    TEST_ASSERT_FALSE(clock_policy_add_listener(NULL, NULL));
+}
+
+void test_sample_cycle_residency_and_mean_clock(void) {
+    // 1 s sample loop: 60 ms acquiring, idle otherwise; a 1.5 s TLS handshake once a minute
+    for (int s = 0; s < 600; s++) {
+        clock_policy_set_phase(CLOCK_PHASE_ACQUIRE);
+        clock_mock_advance_ms(60);
+        clock_policy_set_phase(CLOCK_PHASE_IDLE);
+        if (s % 60 == 0) {
+            clock_policy_burst_begin(CLOCK_BURST_TLS);
+            TEST_ASSERT_EQUAL_UINT32(CLOCK_POLICY_DEFAULT_BURST_KHZ, clock_mock_sys_khz());
+            clock_mock_advance_ms(1500);
+            clock_policy_burst_end(CLOCK_BURST_TLS);
+        }
+        // Waiting in 100 ms service steps
+        for (int t = 0; t < 940; t += 100) {
+            clock_mock_advance_ms(t + 100 <= 940 ? 100 : 940 - t);
+            clock_policy_poll();
+        }
+    }
+
+    clock_policy_stats_t stats;
+    clock_policy_get_stats(&stats);
+    uint64_t total = stats.residency_ms[CLOCK_LEVEL_IDLE] + stats.residency_ms[CLOCK_LEVEL_ACQUIRE] +
+                     stats.residency_ms[CLOCK_LEVEL_BURST];
+    TEST_ASSERT_EQUAL_UINT64(600u * 1000u + 10u * 1500u, total);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.bursts);
+    // Handshakes plus one lower delay after each
+    TEST_ASSERT_EQUAL_UINT64(10u * (1500u + 300u), stats.residency_ms[CLOCK_LEVEL_BURST]);
+    TEST_ASSERT_TRUE(stats.residency_ms[CLOCK_LEVEL_IDLE] > stats.residency_ms[CLOCK_LEVEL_ACQUIRE]);
+    // Far below the fixed 125 MHz the firmware used to run at
+    TEST_ASSERT_TRUE(stats.avg_khz < CLOCK_POLICY_DEFAULT_ACQUIRE_KHZ);
+    TEST_ASSERT_TRUE(stats.avg_khz > CLOCK_POLICY_DEFAULT_IDLE_KHZ);
+}
+
+void test_uninitialized_calls_are_harmless(void) {
+    TEST_ASSERT_FALSE(clock_policy_init(NULL, NULL));
+    clock_mock_clear_steps();
+    clock_policy_burst_begin(CLOCK_BURST_TLS);
+    clock_policy_set_phase(CLOCK_PHASE_IDLE);
+    clock_policy_poll();
+    clock_policy_burst_end(CLOCK_BURST_TLS);
+    TEST_ASSERT_EQUAL_INT(0, clock_mock_step_count());
+
+    clock_policy_stats_t stats;
+    clock_policy_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.transitions);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_init_drops_to_acquire_level_clock_first);
+    RUN_TEST(test_burst_raises_at_once_voltage_first);
+    RUN_TEST(test_drop_waits_for_lower_delay);
+    RUN_TEST(test_bursts_are_reference_counted);
+    RUN_TEST(test_back_to_back_bursts_do_not_thrash);
+    RUN_TEST(test_refused_clock_keeps_level_and_retries);
+    RUN_TEST(test_refused_voltage_never_overclocks);
+    RUN_TEST(test_listener_limit);
+    RUN_TEST(test_sample_cycle_residency_and_mean_clock);
+    RUN_TEST(test_uninitialized_calls_are_harmless);
+    return UNITY_END();
+}
@@ -0,0 +1,152 @@
+/**
+ * File: test_diagnostics.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the memory diagnostics (stack painting, pool and ring maxima)
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "diagnostics.h"
+#include "diag_platform_mock.h"
+#include <string.h>
+
+#define STACK_BYTES     (DIAG_MOCK_STACK_WORDS * 4u)
+
+void setUp(void) {
+    diag_mock_reset();
+}
+
+void tearDown(void) {}
+
+// Simulate a call chain that reached `bytes` below the top of a stack
+static void touch_stack(unsigned int core, uint32_t bytes) {
+    for (uint32_t w = DIAG_MOCK_STACK_WORDS - bytes / 4u; w < DIAG_MOCK_STACK_WORDS; w++) {
+        diag_mock_stacks[core][w] = w;
+    }
+}
+
+void test_painted_stack_reports_nothing_used(void) {
+    uint32_t stack[16];
+    diag_stack_paint(stack, stack + 16);
+    TEST_ASSERT_EQUAL_UINT32(0, diag_stack_high_water(stack, stack + 16));
+}
+
+void test_high_water_is_deepest_write(void) {
+    uint32_t stack[16];
+    diag_stack_paint(stack, stack + 16);
+    stack[12] = 0;
+    // Words above the deepest write count as used even if they happen to hold the paint word
+    TEST_ASSERT_EQUAL_UINT32(16, diag_stack_high_water(stack, stack + 16));
+    stack[3] = 1;
+    TEST_ASSERT_EQUAL_UINT32(52, diag_stack_high_water(stack, stack + 16));
+}
+
+void test_init_leaves_live_frames_alone(void) {
+    // Running 200 bytes below the top of core0's stack
+    uintptr_t sp = (uintptr_t)&diag_mock_stacks[0][DIAG_MOCK_STACK_WORDS] - 200u;
+    diag_mock_set_stack_pointer(sp);
+    diag_init();
+
+    // Nothing at or above sp - margin was painted
+    for (uintptr_t a = sp - DIAG_STACK_PAINT_MARGIN; a < (uintptr_t)&diag_mock_stacks[0][DIAG_MOCK_STACK_WORDS];
+         a += 4) {
+        TEST_ASSERT_EQUAL_HEX32(0, *(uint32_t *)a);
+    }
+    TEST_ASSERT_EQUAL_HEX32(DIAG_STACK_PAINT_WORD, diag_mock_stacks[0][0]);
+    // core1 is not running yet and is painted in full
+    TEST_ASSERT_EQUAL_HEX32(DIAG_STACK_PAINT_WORD, diag_mock_stacks[1][DIAG_MOCK_STACK_WORDS - 1]);
+
+    diag_stats_t stats;
+    diag_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(STACK_BYTES, stats.stack[0].size);
+    TEST_ASSERT_EQUAL_UINT32(200u + DIAG_STACK_PAINT_MARGIN, stats.stack[0].used);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.stack[1].used);
+}
+
+void test_stats_report_stack_growth(void) {
+    diag_init();
+    touch_stack(0, 512);
+    touch_stack(1, 96);
+
+    diag_stats_t stats;
+    diag_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(512, stats.stack[0].used);
+    TEST_ASSERT_EQUAL_UINT32(96, stats.stack[1].used);
+
+    // Overflow wipes the paint completely
+    touch_stack(1, STACK_BYTES);
+    diag_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(stats.stack[1].size, stats.stack[1].used);
+}
+
+void test_stats_report_sections(void) {
+    diag_mock_set_sections(1200, 48000, 150000);
+    diag_stats_t stats;
+    diag_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1200, stats.data_bytes);
+    TEST_ASSERT_EQUAL_UINT32(48000, stats.bss_bytes);
+    TEST_ASSERT_EQUAL_UINT32(150000, stats.heap_bytes);
+}
+
+void test_stats_include_pools(void) {
+    MEM_POOL_STORAGE(storage, 32, 4);
+    static mem_pool_t pool;
+    TEST_ASSERT_TRUE(mem_pool_init(&pool, "diag_test", storage, 32, 4));
+    void *a = mem_pool_alloc(&pool);
+    void *b = mem_pool_alloc(&pool);
+    mem_pool_free(&pool, a);
+    mem_pool_free(&pool, b);
+
+    diag_stats_t stats;
+    diag_get_stats(&stats);
+    bool found = false;
+    for (uint16_t i = 0; i < stats.pool_count; i++) {
+        if (strcmp(stats.pools[i].name, "diag_test") == 0) {
+            found = true;
+            TEST_ASSERT_EQUAL_UINT16(2, stats.pools[i].high_water);
+            TEST_ASSERT_EQUAL_UINT16(0, stats.pools[i].in_use);
+        }
+    }
+    TEST_ASSERT_TRUE(found);
+}
+
+static uint32_t fake_high_water(void *ctx) {
+    return *(uint32_t *)ctx;
+}
+
+void test_stats_include_rings(void) {
+    static uint32_t level = 7;
+    TEST_ASSERT_FALSE(diag_register_ring(NULL, 8, fake_high_water, &level));
+    TEST_ASSERT_TRUE(diag_register_ring("test_ring", 64, fake_high_water, &level));
+
+    diag_stats_t stats;
+    diag_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.ring_count);
+    TEST_ASSERT_EQUAL_STRING("test_ring", stats.rings[0].name);
+    TEST_ASSERT_EQUAL_UINT32(64, stats.rings[0].capacity);
+    TEST_ASSERT_EQUAL_UINT32(7, stats.rings[0].high_water);
+
+    // Read on every snapshot
+    level = 40;
+    diag_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(40, stats.rings[0].high_water);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_painted_stack_reports_nothing_used);
+    RUN_TEST(test_high_water_is_deepest_write);
+    RUN_TEST(test_init_leaves_live_frames_alone);
+    RUN_TEST(test_stats_report_stack_growth);
+    RUN_TEST(test_stats_report_sections);
+    RUN_TEST(test_stats_include_pools);
+    RUN_TEST(test_stats_include_rings);
+
+    return UNITY_END();
+}
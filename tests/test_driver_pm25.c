@@ -47,9 +47,13 @@ static uint8_t valid_frame[PMS_FRAME_LENGTH] = {
     0x02, 0x0F                           // Checksum (corrected to 0x020F)
 };
 
+static pm25_sensor_t sensor;
+
 void setUp(void) {
     uart_mock_reset();
     gpio_mock_reset();
+    pm25_mock_set_time_us(0);
+    pm25_sensor_init(&sensor, NULL, pm25_get_mock_hal());
 }
 
 void tearDown(void) {}
@@ -73,7 +77,7 @@ void test_pm25_sensor_read_valid(void) {
     pm25_data_t data;
     mock_uart_read_valid();
 
-    bool result = pm25_sensor_read(&data);
+    bool result = pm25_sensor_read(&sensor, &data);
 
     if (!result) {
         printf("DEBUG: pm25_sensor_read returned false\n");
@@ -112,7 +116,7 @@ void test_pm25_sensor_read_invalid_checksum(void) {
     uart_read_blocking_Expect(PMS_UART, NULL, PMS_FRAME_LENGTH - 2);
     uart_read_blocking_IgnoreArg_buffer();
 
-    bool result = pm25_sensor_read(&data);
+    bool result = pm25_sensor_read(&sensor, &data);
 
     TEST_ASSERT_FALSE(result);
 }
@@ -135,7 +139,7 @@ void test_pm25_sensor_read_invalid_frame_length(void) {
     uart_read_blocking_Expect(PMS_UART, NULL, PMS_FRAME_LENGTH - 2);
     uart_read_blocking_IgnoreArg_buffer();
 
-    bool result = pm25_sensor_read(&data);
+    bool result = pm25_sensor_read(&sensor, &data);
 
     TEST_ASSERT_FALSE(result);
 }
@@ -158,7 +162,217 @@ void test_pm25_sensor_init(void) {
     uart_write_blocking_Expect(PMS_UART, NULL, 7);  // Expect passive mode command (PMS command is 7 bytes)
     uart_write_blocking_IgnoreArg_buffer();
 
-    pm25_sensor_init(pm25_get_mock_hal());  // Use mock HAL
+    pm25_sensor_init(&sensor, NULL, pm25_get_mock_hal());  // Use mock HAL
+
+    TEST_ASSERT_EQUAL_PTR(PMS_UART, sensor.config.uart);
+    TEST_ASSERT_EQUAL_UINT(PMS_RESET_PIN, sensor.config.reset_pin);
+}
+
+void test_pm25_sensor_multi_instance(void) {
+    pm25_sensor_t second;
+    pm25_sensor_config_t config = {
+        .uart = (uart_inst_t *)0x2,
+        .tx_pin = 4,
+        .rx_pin = 5,
+        .set_pin = 6,
+        .reset_pin = 7
+    };
+    pm25_data_t data;
+
+    pm25_sensor_init(&second, &config, pm25_get_mock_hal());
+
+    // Each instance keeps its own wiring
+    TEST_ASSERT_EQUAL_PTR((uart_inst_t *)0x2, second.config.uart);
+    TEST_ASSERT_EQUAL_UINT(5, second.config.rx_pin);
+    TEST_ASSERT_EQUAL_PTR(PMS_UART, sensor.config.uart);
+
+    // Parser state is per instance: a good frame on one does not leak into the other
+    mock_uart_read_valid();
+    TEST_ASSERT_TRUE(pm25_sensor_read(&second, &data));
+    TEST_ASSERT_EQUAL_UINT8(PMS_FRAME_START1, second.frame[0]);
+    TEST_ASSERT_EQUAL_UINT8(0, sensor.frame[0]);
+}
+
+void test_pm25_sensor_read_uninitialized(void) {
+    pm25_sensor_t uninit = {0};
+    pm25_data_t data;
+
+    uart_is_readable_IgnoreAndReturn(true);
+    TEST_ASSERT_FALSE(pm25_sensor_read(&uninit, &data));
+    TEST_ASSERT_FALSE(pm25_sensor_read(NULL, &data));
+}
+
+void test_pm25_sensor_read_timestamp(void) {
+    pm25_data_t data;
+    pm25_mock_set_time_us(123456);
+    mock_uart_read_valid();
+    TEST_ASSERT_TRUE(pm25_sensor_read(&sensor, &data));
+    TEST_ASSERT_EQUAL_UINT64(123456, sensor.frame_time_us);
+
+    // A rejected frame keeps the timestamp of the last good one
+    uint8_t corrupt_frame[PMS_FRAME_LENGTH];
+    memcpy(corrupt_frame, valid_frame, PMS_FRAME_LENGTH);
+    corrupt_frame[PMS_FRAME_LENGTH - 1] ^= 0xFF;
+    pm25_mock_set_time_us(999999);
+    uart_read_blocking_SetDataToReturn(corrupt_frame);
+    TEST_ASSERT_FALSE(pm25_sensor_read(&sensor, &data));
+    TEST_ASSERT_EQUAL_UINT64(123456, sensor.frame_time_us);
+}
+
+void test_pm25_sensor_resync_after_wake(void) {
+    pm25_data_t data;
+    // Receiver came back mid-frame: tail of the previous frame, then a whole one
+    uint8_t stream[5 + PMS_FRAME_LENGTH] = { 0x00, 0x19, 0x4D, 0x02, 0x0F };
+    memcpy(&stream[5], valid_frame, PMS_FRAME_LENGTH);
+    uart_is_readable_IgnoreAndReturn(true);
+
+    // Without resync each call gives up on the first stray byte
+    uart_read_blocking_SetDataToReturn(stream);
+    TEST_ASSERT_FALSE(pm25_sensor_read(&sensor, &data));
+
+    // With resync one call skips the tail and reads the frame
+    uart_read_blocking_SetDataToReturn(stream);
+    pm25_sensor_resync(&sensor);
+    TEST_ASSERT_TRUE(pm25_sensor_read(&sensor, &data));
+    TEST_ASSERT_EQUAL_UINT16(25, data.pm2_5_atm);
+    TEST_ASSERT_FALSE(sensor.resync);
+
+    // Resync stays armed across a frame that fails
+    uint8_t corrupt_frame[PMS_FRAME_LENGTH];
+    memcpy(corrupt_frame, valid_frame, PMS_FRAME_LENGTH);
+    corrupt_frame[PMS_FRAME_LENGTH - 1] ^= 0xFF;
+    uart_read_blocking_SetDataToReturn(corrupt_frame);
+    pm25_sensor_resync(&sensor);
+    TEST_ASSERT_FALSE(pm25_sensor_read(&sensor, &data));
+    TEST_ASSERT_TRUE(sensor.resync);
+}
+
+static bool read_frame(uint8_t *stream) {
+    pm25_data_t data;
+    uart_is_readable_IgnoreAndReturn(true);
+    uart_read_blocking_SetDataToReturn(stream);
+    return pm25_sensor_read(&sensor, &data);
+}
+
+static bool read_nothing(void) {
+    pm25_data_t data;
+    uart_is_readable_IgnoreAndReturn(false);
+    return pm25_sensor_read(&sensor, &data);
+}
+
+void test_pm25_link_counts_failures_by_cause(void) {
+    uint8_t bad_length[PMS_FRAME_LENGTH];
+    memcpy(bad_length, valid_frame, PMS_FRAME_LENGTH);
+    bad_length[3] = 0x1C + 2;
+    uint8_t bad_checksum[PMS_FRAME_LENGTH];
+    memcpy(bad_checksum, valid_frame, PMS_FRAME_LENGTH);
+    bad_checksum[PMS_FRAME_LENGTH - 1] ^= 0x01;
+    uint8_t noise[3 + PMS_FRAME_LENGTH] = { 0x11, 0x22, 0x33 };
+    memcpy(&noise[3], valid_frame, PMS_FRAME_LENGTH);
+
+    TEST_ASSERT_FALSE(read_nothing());
+    TEST_ASSERT_EQUAL(PM25_LINK_NO_DATA, sensor.last_result);
+    TEST_ASSERT_FALSE(read_frame(noise));
+    TEST_ASSERT_EQUAL(PM25_LINK_BAD_START, sensor.last_result);
+    TEST_ASSERT_TRUE(sensor.resync);
+    TEST_ASSERT_FALSE(read_frame(bad_length));
+    TEST_ASSERT_EQUAL(PM25_LINK_BAD_LENGTH, sensor.last_result);
+    TEST_ASSERT_FALSE(read_frame(bad_checksum));
+    TEST_ASSERT_EQUAL_STRING("checksum", pm25_link_result_name(sensor.last_result));
+
+    // After a bad frame the parser hunts for the next start byte, counting what it skips
+    pm25_mock_set_time_us(5000000);
+    TEST_ASSERT_TRUE(read_frame(noise));
+    TEST_ASSERT_EQUAL(PM25_LINK_OK, sensor.last_result);
+
+    TEST_ASSERT_EQUAL_UINT32(1, sensor.link.good);
+    TEST_ASSERT_EQUAL_UINT32(1, sensor.link.bad[PM25_LINK_NO_DATA]);
+    TEST_ASSERT_EQUAL_UINT32(1, sensor.link.bad[PM25_LINK_BAD_START]);
+    TEST_ASSERT_EQUAL_UINT32(1, sensor.link.bad[PM25_LINK_BAD_LENGTH]);
+    TEST_ASSERT_EQUAL_UINT32(1, sensor.link.bad[PM25_LINK_BAD_CHECKSUM]);
+    TEST_ASSERT_EQUAL_UINT32(3, sensor.link.resync_bytes);
+    TEST_ASSERT_EQUAL_UINT64(5000000, sensor.link.last_good_us);
+}
+
+void test_pm25_link_silence_triggers_reset(void) {
+    int writes = uart_mock_write_count();
+    for (int i = 0; i < PM25_LINK_SILENT_READS; i++) {
+        TEST_ASSERT_FALSE(read_nothing());
+    }
+    pm25_mock_set_time_us(PM25_LINK_SILENCE_MS * 1000ull - 1);
+    TEST_ASSERT_FALSE(pm25_sensor_check_link(&sensor));
+    TEST_ASSERT_TRUE(gpio_mock_get(PMS_RESET_PIN));
+
+    // RESET pulled low, then released after the pulse
+    uint64_t t = PM25_LINK_SILENCE_MS * 1000ull;
+    pm25_mock_set_time_us(t);
+    TEST_ASSERT_TRUE(pm25_sensor_check_link(&sensor));
+    TEST_ASSERT_FALSE(gpio_mock_get(PMS_RESET_PIN));
+    TEST_ASSERT_EQUAL_UINT32(1, sensor.link.resets);
+
+    // Reads while the sensor is held in reset are not failures of the link
+    TEST_ASSERT_FALSE(read_nothing());
+    TEST_ASSERT_EQUAL_UINT32(PM25_LINK_SILENT_READS, sensor.link.bad[PM25_LINK_NO_DATA]);
+
+    pm25_mock_set_time_us(t + PM25_RESET_PULSE_MS * 1000ull);
+    TEST_ASSERT_TRUE(pm25_sensor_check_link(&sensor));
+    TEST_ASSERT_TRUE(gpio_mock_get(PMS_RESET_PIN));
+
+    // Once started, the sensor gets the mode command again and the parser resynchronises
+    t += (PM25_RESET_PULSE_MS + PM25_RESET_BOOT_MS) * 1000ull;
+    pm25_mock_set_time_us(t);
+    TEST_ASSERT_FALSE(pm25_sensor_check_link(&sensor));
+    TEST_ASSERT_EQUAL_INT(writes + 1, uart_mock_write_count());
+    TEST_ASSERT_TRUE(sensor.resync);
+
+    // Still silent: the next reset waits twice as long
+    for (int i = 0; i < PM25_LINK_SILENT_READS; i++) {
+        read_nothing();
+    }
+    pm25_mock_set_time_us(t + PM25_LINK_SILENCE_MS * 1000ull);
+    TEST_ASSERT_FALSE(pm25_sensor_check_link(&sensor));
+    pm25_mock_set_time_us(t + 2 * PM25_LINK_SILENCE_MS * 1000ull);
+    TEST_ASSERT_TRUE(pm25_sensor_check_link(&sensor));
+    TEST_ASSERT_EQUAL_UINT32(2, sensor.link.resets);
+}
+
+void test_pm25_link_error_rate_triggers_reset(void) {
+    uint8_t bad_checksum[PMS_FRAME_LENGTH];
+    memcpy(bad_checksum, valid_frame, PMS_FRAME_LENGTH);
+    bad_checksum[PMS_FRAME_LENGTH - 1] ^= 0x01;
+
+    // Occasional bad frames are tolerated
+    for (int i = 0; i < PM25_LINK_WINDOW; i++) {
+        read_frame((i < PM25_LINK_MAX_ERRORS - 1) ? bad_checksum : valid_frame);
+    }
+    TEST_ASSERT_FALSE(pm25_sensor_check_link(&sensor));
+
+    // A window with mostly bad frames is not, even though good ones keep arriving
+    for (int i = 0; i < PM25_LINK_WINDOW; i++) {
+        read_frame((i % 4 == 0) ? valid_frame : bad_checksum);
+    }
+    TEST_ASSERT_TRUE(pm25_sensor_check_link(&sensor));
+    TEST_ASSERT_EQUAL_UINT32(1, sensor.link.resets);
+    TEST_ASSERT_EQUAL(PM25_RECOVERY_RESET, sensor.recovery);
+}
+
+void test_pm25_link_parked_sensor_is_not_wedged(void) {
+    pm25_sensor_set_sleep(&sensor, true);
+    for (int i = 0; i < PM25_LINK_SILENT_READS; i++) {
+        read_nothing();
+    }
+    pm25_mock_set_time_us(10 * PM25_LINK_SILENCE_MS * 1000ull);
+    TEST_ASSERT_FALSE(pm25_sensor_check_link(&sensor));
+
+    // Silence counts from the wake-up
+    pm25_sensor_set_sleep(&sensor, false);
+    for (int i = 0; i < PM25_LINK_SILENT_READS; i++) {
+        read_nothing();
+    }
+    pm25_mock_set_time_us(11 * PM25_LINK_SILENCE_MS * 1000ull - 1);
+    TEST_ASSERT_FALSE(pm25_sensor_check_link(&sensor));
+    pm25_mock_set_time_us(11 * PM25_LINK_SILENCE_MS * 1000ull);
+    TEST_ASSERT_TRUE(pm25_sensor_check_link(&sensor));
 }
 
 int main(void) {
@@ -167,5 +381,13 @@ int main(void) {
     RUN_TEST(test_pm25_sensor_read_valid);
     RUN_TEST(test_pm25_sensor_read_invalid_checksum);
     RUN_TEST(test_pm25_sensor_read_invalid_frame_length);
+    RUN_TEST(test_pm25_sensor_multi_instance);
+    RUN_TEST(test_pm25_sensor_read_uninitialized);
+    RUN_TEST(test_pm25_sensor_read_timestamp);
+    RUN_TEST(test_pm25_sensor_resync_after_wake);
+    RUN_TEST(test_pm25_link_counts_failures_by_cause);
+    RUN_TEST(test_pm25_link_silence_triggers_reset);
+    RUN_TEST(test_pm25_link_error_rate_triggers_reset);
+    RUN_TEST(test_pm25_link_parked_sensor_is_not_wedged);
     return UNITY_END();
 }
\ No newline at end of file
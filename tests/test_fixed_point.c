@@ -0,0 +1,78 @@
+/**
+ * File: test_fixed_point.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the integer-only fixed-point helpers
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "fixed_point.h"
+#include <string.h>
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_sht3x_temperature_conversion(void) {
+    TEST_ASSERT_EQUAL_INT32(-4500, fx_sht3x_temp_centi(0));
+    TEST_ASSERT_EQUAL_INT32(13000, fx_sht3x_temp_centi(0xFFFF));
+    // 0x6666 -> -45 + 175 * 26214 / 65535 = 25.00 °C
+    TEST_ASSERT_EQUAL_INT32(2500, fx_sht3x_temp_centi(0x6666));
+}
+
+void test_sht3x_humidity_conversion(void) {
+    TEST_ASSERT_EQUAL_INT32(0, fx_sht3x_hum_centi(0));
+    TEST_ASSERT_EQUAL_INT32(10000, fx_sht3x_hum_centi(0xFFFF));
+    TEST_ASSERT_EQUAL_INT32(5000, fx_sht3x_hum_centi(0x8000));
+}
+
+void test_pm25_humidity_correction(void) {
+    // 0.524 * 25 - 0.0862 * 50 + 5.75 = 14.54
+    TEST_ASSERT_EQUAL_INT32(1454, fx_pm25_humidity_correct(25, FX_FROM_INT(50)));
+    // Clean air at high humidity clamps to zero
+    TEST_ASSERT_EQUAL_INT32(0, fx_pm25_humidity_correct(0, FX_FROM_INT(100)));
+}
+
+void test_round(void) {
+    TEST_ASSERT_EQUAL_INT32(14, fx_round(1429));
+    TEST_ASSERT_EQUAL_INT32(15, fx_round(1450));
+    TEST_ASSERT_EQUAL_INT32(-3, fx_round(-305));
+    TEST_ASSERT_EQUAL_INT32(-4, fx_round(-350));
+}
+
+void test_format_centi(void) {
+    char buf[FX_FORMAT_CENTI_MAX];
+
+    TEST_ASSERT_EQUAL_size_t(5, fx_format_centi(buf, sizeof(buf), 2537));
+    TEST_ASSERT_EQUAL_STRING("25.37", buf);
+    fx_format_centi(buf, sizeof(buf), -305);
+    TEST_ASSERT_EQUAL_STRING("-3.05", buf);
+    fx_format_centi(buf, sizeof(buf), 7);
+    TEST_ASSERT_EQUAL_STRING("0.07", buf);
+    fx_format_centi(buf, sizeof(buf), INT32_MIN);
+    TEST_ASSERT_EQUAL_STRING("-21474836.48", buf);
+}
+
+void test_format_centi_buffer_too_small(void) {
+    char buf[5];
+
+    TEST_ASSERT_EQUAL_size_t(0, fx_format_centi(buf, sizeof(buf), 2537));
+    TEST_ASSERT_EQUAL_size_t(4, fx_format_centi(buf, sizeof(buf), 537));
+    TEST_ASSERT_EQUAL_STRING("5.37", buf);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_sht3x_temperature_conversion);
+    RUN_TEST(test_sht3x_humidity_conversion);
+    RUN_TEST(test_pm25_humidity_correction);
+    RUN_TEST(test_round);
+    RUN_TEST(test_format_centi);
+    RUN_TEST(test_format_centi_buffer_too_small);
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+/**
+ * File: test_fmt.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the integer-only text formatter
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "fmt.h"
+#include <stdio.h>
+#include <string.h>
+
+static char out[128];
+static fmt_buf_t b;
+
+void setUp(void) {
+    memset(out, 'x', sizeof(out));
+    fmt_init(&b, out, sizeof(out));
+}
+
+void tearDown(void) {}
+
+void test_unsigned(void) {
+    fmt_u32(&b, 0);
+    fmt_char(&b, ' ');
+    fmt_u32(&b, 7);
+    fmt_char(&b, ' ');
+    fmt_u32(&b, 4294967295u);
+    TEST_ASSERT_EQUAL_size_t(14, fmt_finish(&b));
+    TEST_ASSERT_EQUAL_STRING("0 7 4294967295", out);
+}
+
+void test_signed(void) {
+    fmt_i32(&b, -1);
+    fmt_char(&b, ' ');
+    fmt_i32(&b, 2147483647);
+    fmt_char(&b, ' ');
+    fmt_i32(&b, INT32_MIN);
+    fmt_finish(&b);
+    TEST_ASSERT_EQUAL_STRING("-1 2147483647 -2147483648", out);
+}
+
+void test_fixed(void) {
+    fmt_fixed(&b, -305, 2);
+    fmt_char(&b, ' ');
+    fmt_fixed(&b, 5, 3);
+    fmt_char(&b, ' ');
+    fmt_fixed(&b, -5, 1);
+    fmt_char(&b, ' ');
+    fmt_fixed(&b, 42, 0);
+    fmt_char(&b, ' ');
+    fmt_fixed(&b, INT32_MIN, 2);
+    fmt_finish(&b);
+    TEST_ASSERT_EQUAL_STRING("-3.05 0.005 -0.5 42 -21474836.48", out);
+}
+
+void test_fixed_rejects_too_many_decimals(void) {
+    fmt_fixed(&b, 1, FMT_FIXED_MAX_DECIMALS + 1);
+    TEST_ASSERT_EQUAL_size_t(0, fmt_finish(&b));
+}
+
+void test_matches_snprintf(void) {
+    const int32_t values[] = { 0, 1, -1, 9, 10, 99, 100, -100, 65535, 1000000, -2000000000, INT32_MAX, INT32_MIN };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        char expected[32];
+        snprintf(expected, sizeof(expected), "%ld", (long)values[i]);
+        fmt_init(&b, out, sizeof(out));
+        fmt_i32(&b, values[i]);
+        fmt_finish(&b);
+        TEST_ASSERT_EQUAL_STRING(expected, out);
+    }
+}
+
+void test_json_object(void) {
+    fmt_json_object_begin(&b, NULL);
+    fmt_json_u32(&b, "seq", 12);
+    fmt_json_i32(&b, "t", -4);
+    fmt_json_fixed(&b, "nowcast", 1234, 2);
+    fmt_json_bool(&b, "valid", false);
+    fmt_json_str(&b, "id", "airsense-01");
+    fmt_json_object_end(&b);
+    fmt_finish(&b);
+    TEST_ASSERT_EQUAL_STRING("{\"seq\":12,\"t\":-4,\"nowcast\":12.34,\"valid\":false,\"id\":\"airsense-01\"}", out);
+}
+
+void test_json_nesting(void) {
+    fmt_json_object_begin(&b, NULL);
+    fmt_json_array_begin(&b, "stack");
+    for (uint32_t i = 0; i < 2; i++) {
+        fmt_json_array_begin(&b, NULL);
+        fmt_json_u32(&b, NULL, i);
+        fmt_json_u32(&b, NULL, 10 + i);
+        fmt_json_array_end(&b);
+    }
+    fmt_json_array_end(&b);
+    fmt_json_object_begin(&b, "pools");
+    fmt_json_object_end(&b);
+    fmt_json_u32(&b, "data", 5);
+    fmt_json_object_end(&b);
+    fmt_finish(&b);
+    TEST_ASSERT_EQUAL_STRING("{\"stack\":[[0,10],[1,11]],\"pools\":{},\"data\":5}", out);
+}
+
+void test_overflow_is_sticky(void) {
+    char small[8];
+    fmt_init(&b, small, sizeof(small));
+    fmt_str(&b, "1234");
+    fmt_str(&b, "5678");    // Does not fit with the terminator
+    fmt_char(&b, '9');      // Would fit, but the output is already broken
+    TEST_ASSERT_TRUE(b.overflow);
+    TEST_ASSERT_EQUAL_size_t(0, fmt_finish(&b));
+    TEST_ASSERT_EQUAL_STRING("1234", small);
+}
+
+void test_exact_fit(void) {
+    char small[5];
+    fmt_init(&b, small, sizeof(small));
+    fmt_u32(&b, 1234);
+    TEST_ASSERT_EQUAL_size_t(4, fmt_finish(&b));
+    TEST_ASSERT_EQUAL_STRING("1234", small);
+}
+
+void test_null_buffer(void) {
+    fmt_init(&b, NULL, 16);
+    fmt_u32(&b, 1);
+    TEST_ASSERT_EQUAL_size_t(0, fmt_finish(&b));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_unsigned);
+    RUN_TEST(test_signed);
+    RUN_TEST(test_fixed);
+    RUN_TEST(test_fixed_rejects_too_many_decimals);
+    RUN_TEST(test_matches_snprintf);
+    RUN_TEST(test_json_object);
+    RUN_TEST(test_json_nesting);
+    RUN_TEST(test_overflow_is_sticky);
+    RUN_TEST(test_exact_fit);
+    RUN_TEST(test_null_buffer);
+
+    return UNITY_END();
+}
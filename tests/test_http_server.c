@@ -0,0 +1,362 @@
+/**
+ * File: test_http_server.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the local HTTP endpoints: precomputed responses, request routing, connection limits,
+ * and a scrape over loopback through the POSIX transport
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "metrics_page.h"
+#include "http_server.h"
+#include "http_listen.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#define NOW_US      (10u * 1000000u)
+
+static sample_cache_t cache;
+static metrics_page_t page;
+static http_server_t server;
+
+static void publish(unsigned int sensor, uint16_t pm2_5, uint64_t timestamp_us) {
+    pm25_data_t d;
+    memset(&d, 0, sizeof(d));
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        pm25_data_set(&d, (pm25_field_t)f, (uint16_t)(100 + f));
+    }
+    d.pm2_5_atm = pm2_5;
+    sample_cache_publish(&cache, sensor, &d, timestamp_us);
+}
+
+// Current response of an endpoint, copied and terminated
+static char *response(metrics_page_id_t id) {
+    static char copy[HTTP_METRICS_BUFFER + 1];
+    const char *data;
+    size_t len;
+    int slot = metrics_page_acquire(&page, id, &data, &len);
+    TEST_ASSERT_TRUE(slot >= 0);
+    memcpy(copy, data, len);
+    copy[len] = '\0';
+    metrics_page_release(&page, id, slot);
+    return copy;
+}
+
+static const char *body_of(const char *resp) {
+    const char *body = strstr(resp, "\r\n\r\n");
+    TEST_ASSERT_NOT_NULL(body);
+    return body + 4;
+}
+
+static http_conn_t *request(const char *text) {
+    http_conn_t *conn = http_server_open(&server, NULL, 0);
+    TEST_ASSERT_NOT_NULL(conn);
+    http_server_receive(&server, conn, (const uint8_t *)text, strlen(text), 0);
+    return conn;
+}
+
+static bool starts_with(const http_conn_t *conn, const char *prefix) {
+    return conn->state == HTTP_CONN_SENDING && conn->len >= strlen(prefix) &&
+           memcmp(conn->data, prefix, strlen(prefix)) == 0;
+}
+
+void setUp(void) {
+    sample_cache_init(&cache, 0);
+    metrics_page_init(&page);
+    http_server_init(&server, &page);
+}
+
+void tearDown(void) {
+}
+
+void test_metrics_response_is_prometheus_text(void) {
+    publish(0, 12, NOW_US - 1500000u);
+    aqi_report_t aqi = { .aqi = 50, .nowcast_aqi = 42, .nowcast = 1010, .nowcast_valid = true };
+    TEST_ASSERT_TRUE(metrics_page_update(&page, &cache, 1, NOW_US, &aqi));
+
+    const char *resp = response(METRICS_PAGE_METRICS);
+    const char *body = body_of(resp);
+    TEST_ASSERT_EQUAL_INT(0, strncmp(resp, "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4", 56));
+    char length[32];
+    snprintf(length, sizeof(length), "Content-Length: %u\r\n", (unsigned)strlen(body));
+    TEST_ASSERT_NOT_NULL(strstr(resp, length));
+
+    TEST_ASSERT_NOT_NULL(strstr(body, "# TYPE airsense_pm_ugm3 gauge\n"));
+    TEST_ASSERT_NOT_NULL(strstr(body, "\nairsense_pm_ugm3{sensor=\"0\",field=\"pm2_5_atm\"} 12\n"));
+    TEST_ASSERT_NOT_NULL(strstr(body, "\nairsense_particles_per_dl{sensor=\"0\",field=\"count_0_3\"} 106\n"));
+    TEST_ASSERT_NULL(strstr(body, "airsense_pm_ugm3{sensor=\"0\",field=\"count_0_3\"}"));
+    TEST_ASSERT_NOT_NULL(strstr(body, "\nairsense_sample_age_seconds{sensor=\"0\"} 1.500\n"));
+    TEST_ASSERT_NOT_NULL(strstr(body, "\nairsense_sample_stale{sensor=\"0\"} 0\n"));
+    TEST_ASSERT_NOT_NULL(strstr(body, "\nairsense_aqi 50\n"));
+    TEST_ASSERT_NOT_NULL(strstr(body, "\nairsense_nowcast_ugm3 10.10\n"));
+    TEST_ASSERT_NOT_NULL(strstr(body, "\nairsense_uptime_seconds 10\n"));
+    TEST_ASSERT_TRUE(body[strlen(body) - 1] == '\n');
+}
+
+void test_latest_response_is_compact_json(void) {
+    publish(0, 7, NOW_US - 250000u);
+    aqi_report_t aqi = { .aqi = 29 };
+    TEST_ASSERT_TRUE(metrics_page_update(&page, &cache, 1, NOW_US, &aqi));
+
+    const char *resp = response(METRICS_PAGE_LATEST);
+    TEST_ASSERT_NOT_NULL(strstr(resp, "Content-Type: application/json\r\n"));
+    TEST_ASSERT_EQUAL_STRING("{\"uptime\":10,\"aqi\":29,\"sensors\":[{\"id\":0,\"age_ms\":250,\"stale\":false,"
+                             "\"pm1_0_cf1\":100,\"pm2_5_cf1\":101,\"pm10_cf1\":102,\"pm1_0_atm\":103,"
+                             "\"pm2_5_atm\":7,\"pm10_atm\":105,\"count_0_3\":106,\"count_0_5\":107,"
+                             "\"count_1_0\":108,\"count_2_5\":109,\"count_5_0\":110,\"count_10\":111}]}",
+                             body_of(resp));
+}
+
+void test_missing_and_stale_sensors(void) {
+    // Sensor 0 never delivered, sensor 1 last delivered ten minutes ago
+    sample_cache_init(&cache, 0);
+    publish(1, 30, 0);
+    TEST_ASSERT_TRUE(metrics_page_update(&page, &cache, 2, 600u * 1000000u, NULL));
+
+    const char *body = body_of(response(METRICS_PAGE_METRICS));
+    TEST_ASSERT_NULL(strstr(body, "sensor=\"0\""));
+    TEST_ASSERT_NOT_NULL(strstr(body, "airsense_sample_stale{sensor=\"1\"} 1\n"));
+    TEST_ASSERT_NULL(strstr(body, "airsense_aqi"));
+
+    body = body_of(response(METRICS_PAGE_LATEST));
+    TEST_ASSERT_NOT_NULL(strstr(body, "{\"id\":1,\"age_ms\":600000,\"stale\":true"));
+}
+
+void test_pinned_response_survives_updates(void) {
+    publish(0, 1, NOW_US);
+    metrics_page_update(&page, &cache, 1, NOW_US, NULL);
+
+    // One connection per version: all slots but the current one end up pinned
+    const char *data[HTTP_MAX_CONNS];
+    size_t len[HTTP_MAX_CONNS];
+    int slot[HTTP_MAX_CONNS];
+    char copy[HTTP_MAX_CONNS][HTTP_METRICS_BUFFER];
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        slot[i] = metrics_page_acquire(&page, METRICS_PAGE_METRICS, &data[i], &len[i]);
+        memcpy(copy[i], data[i], len[i]);
+        publish(0, (uint16_t)(2 + i), NOW_US);
+        TEST_ASSERT_TRUE(metrics_page_update(&page, &cache, 1, NOW_US, NULL));
+    }
+    TEST_ASSERT_FALSE(metrics_page_update(&page, &cache, 1, NOW_US, NULL));
+    TEST_ASSERT_EQUAL_UINT32(1, page.stats.skipped);
+
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        TEST_ASSERT_EQUAL_MEMORY(copy[i], data[i], len[i]);
+        metrics_page_release(&page, METRICS_PAGE_METRICS, slot[i]);
+    }
+    TEST_ASSERT_TRUE(metrics_page_update(&page, &cache, 1, NOW_US, NULL));
+    TEST_ASSERT_TRUE(page.stats.max_len[METRICS_PAGE_METRICS] <= HTTP_METRICS_BUFFER);
+}
+
+void test_requests_are_routed(void) {
+    // Before the first update there is nothing to serve
+    http_conn_t *conn = request("GET /metrics HTTP/1.1\r\n\r\n");
+    TEST_ASSERT_TRUE(starts_with(conn, "HTTP/1.0 503"));
+    http_server_close(&server, conn);
+
+    publish(0, 5, NOW_US);
+    metrics_page_update(&page, &cache, 1, NOW_US, NULL);
+
+    // Byte by byte, with headers
+    const char *text = "GET /metrics HTTP/1.1\r\nHost: airsense\r\nAccept: */*\r\n\r\n";
+    conn = http_server_open(&server, NULL, 0);
+    for (size_t i = 0; i < strlen(text); i++) {
+        TEST_ASSERT_EQUAL(i + 1 == strlen(text),
+                          http_server_receive(&server, conn, (const uint8_t *)&text[i], 1, 0));
+    }
+    TEST_ASSERT_TRUE(starts_with(conn, "HTTP/1.0 200 OK\r\nContent-Type: text/plain"));
+    http_server_close(&server, conn);
+
+    conn = request("GET /latest?pretty=1 HTTP/1.0\n\n");
+    TEST_ASSERT_TRUE(starts_with(conn, "HTTP/1.0 200 OK\r\nContent-Type: application/json"));
+    http_server_close(&server, conn);
+
+    conn = request("GET /nope HTTP/1.1\r\n\r\n");
+    TEST_ASSERT_TRUE(starts_with(conn, "HTTP/1.0 404"));
+    http_server_close(&server, conn);
+    conn = request("POST /metrics HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+    TEST_ASSERT_TRUE(starts_with(conn, "HTTP/1.0 405"));
+    http_server_close(&server, conn);
+    conn = request("hello\r\n\r\n");
+    TEST_ASSERT_TRUE(starts_with(conn, "HTTP/1.0 400"));
+    http_server_close(&server, conn);
+
+    char long_line[HTTP_REQUEST_LINE_MAX + 32];
+    snprintf(long_line, sizeof(long_line), "GET /%0*d HTTP/1.1\r\n\r\n", HTTP_REQUEST_LINE_MAX, 0);
+    conn = request(long_line);
+    TEST_ASSERT_TRUE(starts_with(conn, "HTTP/1.0 400"));
+    http_server_close(&server, conn);
+
+    // Incomplete request: nothing to send yet
+    conn = request("GET /metrics HTTP/1.1\r\nHost: a\r\n");
+    TEST_ASSERT_EQUAL(HTTP_CONN_READING, conn->state);
+    TEST_ASSERT_EQUAL_size_t(0, http_server_pending(conn, NULL));
+    http_server_close(&server, conn);
+
+    TEST_ASSERT_EQUAL_UINT32(2, server.stats.served);
+    TEST_ASSERT_EQUAL_UINT32(5, server.stats.errors);
+}
+
+void test_connections_are_bounded_and_release_their_response(void) {
+    publish(0, 5, NOW_US);
+    metrics_page_update(&page, &cache, 1, NOW_US, NULL);
+
+    http_conn_t *conns[HTTP_MAX_CONNS];
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        conns[i] = request("GET /metrics HTTP/1.1\r\n\r\n");
+    }
+    TEST_ASSERT_NULL(http_server_open(&server, NULL, 0));
+    TEST_ASSERT_EQUAL_UINT32(1, server.stats.refused);
+
+    int slot = conns[0]->slot;
+    TEST_ASSERT_EQUAL_UINT(HTTP_MAX_CONNS, atomic_load(&page.slots[METRICS_PAGE_METRICS].pins[slot]));
+
+    // Sending in pieces, done once everything is acknowledged
+    const char *data;
+    size_t total = http_server_pending(conns[0], &data);
+    http_server_queued(conns[0], 100, 0);
+    TEST_ASSERT_EQUAL_size_t(total - 100, http_server_pending(conns[0], NULL));
+    http_server_queued(conns[0], total - 100, 0);
+    http_server_acked(conns[0], total - 1, 0);
+    TEST_ASSERT_FALSE(http_server_done(conns[0]));
+    http_server_acked(conns[0], 1, 0);
+    TEST_ASSERT_TRUE(http_server_done(conns[0]));
+
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        http_server_close(&server, conns[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT(0, atomic_load(&page.slots[METRICS_PAGE_METRICS].pins[slot]));
+    TEST_ASSERT_NOT_NULL(http_server_open(&server, NULL, 0));
+}
+
+void test_idle_connections_time_out(void) {
+    http_conn_t *conn = http_server_open(&server, NULL, 1000);
+    TEST_ASSERT_FALSE(http_server_timed_out(&server, conn, 1000 + HTTP_IDLE_TIMEOUT_MS - 1));
+    http_server_receive(&server, conn, (const uint8_t *)"GET", 3, 2000);
+    TEST_ASSERT_FALSE(http_server_timed_out(&server, conn, 1000 + HTTP_IDLE_TIMEOUT_MS));
+    TEST_ASSERT_TRUE(http_server_timed_out(&server, conn, 2000 + HTTP_IDLE_TIMEOUT_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, server.stats.timeouts);
+}
+
+// --- Loopback through the POSIX transport ---
+
+static atomic_bool serving;
+
+static void *serve(void *arg) {
+    (void)arg;
+    while (atomic_load(&serving)) {
+        http_listen_poll(20);
+    }
+    return NULL;
+}
+
+static int connect_loopback(void) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr = { 0 };
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(http_listen_port());
+    struct timeval tv = { .tv_sec = 5 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    TEST_ASSERT_EQUAL_INT(0, connect(fd, (struct sockaddr *)&addr, sizeof(addr)));
+    return fd;
+}
+
+// Read until the server closes; returns the byte count, -1 on timeout
+static int read_all(int fd, char *buf, size_t size) {
+    size_t len = 0;
+    for (;;) {
+        ssize_t n = recv(fd, buf + len, size - 1 - len, 0);
+        if (n < 0) {
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        len += (size_t)n;
+    }
+    buf[len] = '\0';
+    return (int)len;
+}
+
+void test_scrape_over_loopback(void) {
+    for (unsigned int i = 0; i < SAMPLE_CACHE_MAX_ENTRIES; i++) {
+        publish(i, (uint16_t)(10 + i), NOW_US);
+    }
+    aqi_report_t aqi = { .aqi = 55, .nowcast_aqi = 51, .nowcast = 1234, .nowcast_valid = true };
+    TEST_ASSERT_TRUE(metrics_page_update(&page, &cache, SAMPLE_CACHE_MAX_ENTRIES, NOW_US, &aqi));
+    char expected[HTTP_METRICS_BUFFER + 1];
+    strcpy(expected, response(METRICS_PAGE_METRICS));
+
+    TEST_ASSERT_TRUE(http_listen_start(&server, 0));
+    TEST_ASSERT_TRUE(http_listen_port() != 0);
+    pthread_t thread;
+    atomic_store(&serving, true);
+    pthread_create(&thread, NULL, serve, NULL);
+
+    static char buf[HTTP_METRICS_BUFFER + 1];
+    int fd = connect_loopback();
+    const char *get = "GET /metrics HTTP/1.1\r\nHost: 127.0.0.1\r\nUser-Agent: curl/8.0\r\nAccept: */*\r\n\r\n";
+    send(fd, get, strlen(get), 0);
+    TEST_ASSERT_EQUAL_INT((int)strlen(expected), read_all(fd, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING(expected, buf);
+    close(fd);
+
+    // Idle clients hold every connection: the next one is closed without a response
+    int idle[HTTP_MAX_CONNS];
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        idle[i] = connect_loopback();
+        send(idle[i], "GET", 3, 0);
+    }
+    usleep(100000);
+    fd = connect_loopback();
+    send(fd, get, strlen(get), 0);
+    int n = read_all(fd, buf, sizeof(buf));
+    TEST_ASSERT_TRUE(n == 0 || (n < 0 && errno == ECONNRESET));
+    close(fd);
+
+    // Once they are gone the server answers again
+    for (int i = 0; i < HTTP_MAX_CONNS; i++) {
+        close(idle[i]);
+    }
+    usleep(100000);
+    fd = connect_loopback();
+    send(fd, "GET /latest HTTP/1.0\r\n\r\n", 24, 0);
+    TEST_ASSERT_TRUE(read_all(fd, buf, sizeof(buf)) > 0);
+    TEST_ASSERT_NOT_NULL(strstr(buf, "\"nowcast\":12.34"));
+    close(fd);
+
+    atomic_store(&serving, false);
+    pthread_join(thread, NULL);
+    http_listen_stop();
+    TEST_ASSERT_EQUAL_UINT32(1, server.stats.refused);
+    TEST_ASSERT_EQUAL_UINT32(2, server.stats.served);
+    TEST_ASSERT_TRUE(page.stats.max_len[METRICS_PAGE_METRICS] <= HTTP_METRICS_BUFFER);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_metrics_response_is_prometheus_text);
+    RUN_TEST(test_latest_response_is_compact_json);
+    RUN_TEST(test_missing_and_stale_sensors);
+    RUN_TEST(test_pinned_response_survives_updates);
+    RUN_TEST(test_requests_are_routed);
+    RUN_TEST(test_connections_are_bounded_and_release_their_response);
+    RUN_TEST(test_idle_connections_time_out);
+    RUN_TEST(test_scrape_over_loopback);
+    return UNITY_END();
+}
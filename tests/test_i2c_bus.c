@@ -0,0 +1,259 @@
+/**
+ * File: test_i2c_bus.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the shared I2C bus manager using the mock backend
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "i2c_bus.h"
+#include "i2c_bus_hal_mock.h"
+#include <string.h>
+
+#define CONVERSION_US   16000       // SHT3x high repeatability
+#define ADDR_A          0x44
+#define ADDR_B          0x45
+#define ADDR_C          0x61
+
+static i2c_bus_t bus;
+static const uint8_t cmd[2] = { 0x24, 0x00 };
+static const uint8_t response[6] = { 1, 2, 3, 4, 5, 6 };
+static int callbacks;
+
+void setUp(void) {
+    i2c_mock_reset();
+    i2c_bus_init(&bus, NULL, 100000, i2c_bus_get_mock_hal());
+    callbacks = 0;
+}
+
+void tearDown(void) {}
+
+static void count_cb(i2c_txn_t *txn, void *arg) {
+    callbacks++;
+    *(int *)arg = callbacks;
+}
+
+static void make_txn(i2c_txn_t *txn, i2c_device_t *dev, uint8_t *buf, uint32_t read_delay_us) {
+    memset(txn, 0, sizeof(*txn));
+    txn->dev = dev;
+    txn->write = cmd;
+    txn->write_len = sizeof(cmd);
+    txn->read = buf;
+    txn->read_len = 6;
+    txn->read_delay_us = read_delay_us;
+    txn->read_retries = 3;
+}
+
+static void make_dev(i2c_device_t *dev, uint8_t addr) {
+    memset(dev, 0, sizeof(*dev));
+    dev->addr = addr;
+}
+
+void test_submit_rejects_invalid_and_duplicate(void) {
+    i2c_device_t dev;
+    i2c_txn_t txn;
+    uint8_t buf[6];
+    make_dev(&dev, ADDR_A);
+    make_txn(&txn, &dev, buf, 0);
+
+    TEST_ASSERT_FALSE(i2c_bus_submit(&bus, NULL));
+    txn.dev = NULL;
+    TEST_ASSERT_FALSE(i2c_bus_submit(&bus, &txn));
+    txn.dev = &dev;
+    TEST_ASSERT_TRUE(i2c_bus_submit(&bus, &txn));
+    TEST_ASSERT_FALSE(i2c_bus_submit(&bus, &txn));
+    TEST_ASSERT_EQUAL(I2C_BUS_PENDING, txn.status);
+}
+
+void test_stretched_read_is_one_transfer(void) {
+    i2c_device_t dev;
+    i2c_txn_t txn;
+    uint8_t buf[6] = { 0 };
+    int order = 0;
+    i2c_mock_add_device(ADDR_A, CONVERSION_US, response, sizeof(response));
+    make_dev(&dev, ADDR_A);
+    make_txn(&txn, &dev, buf, 0);
+    txn.cb = count_cb;
+    txn.cb_arg = &order;
+
+    TEST_ASSERT_TRUE(i2c_bus_submit(&bus, &txn));
+    TEST_ASSERT_EQUAL(I2C_BUS_OK, i2c_bus_wait(&bus, &txn));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(response, buf, 6);
+    TEST_ASSERT_EQUAL_INT(1, i2c_mock_transfer_count());
+    TEST_ASSERT_EQUAL_INT(1, order);
+    TEST_ASSERT_EQUAL_UINT64(i2c_mock_transfer(0)->end_us, txn.done_us);
+}
+
+void test_delayed_read_releases_bus(void) {
+    i2c_device_t dev_a, dev_b;
+    i2c_txn_t txn_a, txn_b;
+    uint8_t buf_a[6], buf_b[6];
+    i2c_mock_add_device(ADDR_A, CONVERSION_US, response, sizeof(response));
+    i2c_mock_add_device(ADDR_B, 0, response, sizeof(response));
+    make_dev(&dev_a, ADDR_A);
+    make_dev(&dev_b, ADDR_B);
+    make_txn(&txn_a, &dev_a, buf_a, CONVERSION_US);
+    make_txn(&txn_b, &dev_b, buf_b, 0);
+
+    i2c_bus_submit(&bus, &txn_a);
+    i2c_bus_submit(&bus, &txn_b);
+    TEST_ASSERT_EQUAL(I2C_BUS_OK, i2c_bus_wait(&bus, &txn_a));
+    TEST_ASSERT_EQUAL(I2C_BUS_OK, txn_b.status);
+
+    // A command, B while A converts, A read
+    TEST_ASSERT_EQUAL_INT(3, i2c_mock_transfer_count());
+    TEST_ASSERT_EQUAL_HEX8(ADDR_A, i2c_mock_transfer(0)->addr);
+    TEST_ASSERT_EQUAL_UINT32(0, i2c_mock_transfer(0)->read_len);
+    TEST_ASSERT_EQUAL_HEX8(ADDR_B, i2c_mock_transfer(1)->addr);
+    TEST_ASSERT_EQUAL_HEX8(ADDR_A, i2c_mock_transfer(2)->addr);
+    TEST_ASSERT_EQUAL_UINT32(0, i2c_mock_transfer(2)->write_len);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(i2c_mock_transfer(0)->end_us + CONVERSION_US, i2c_mock_transfer(2)->start_us);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(response, buf_a, 6);
+}
+
+void test_parallel_conversions_cost_bus_time(void) {
+    const uint8_t addrs[3] = { ADDR_A, ADDR_B, ADDR_C };
+    i2c_device_t devs[3];
+    i2c_txn_t txns[3];
+    uint8_t bufs[3][6];
+    uint64_t start = i2c_mock_now_us();
+    for (int i = 0; i < 3; i++) {
+        i2c_mock_add_device(addrs[i], CONVERSION_US, response, sizeof(response));
+        make_dev(&devs[i], addrs[i]);
+        make_txn(&txns[i], &devs[i], bufs[i], CONVERSION_US);
+        TEST_ASSERT_TRUE(i2c_bus_submit(&bus, &txns[i]));
+    }
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(I2C_BUS_OK, i2c_bus_wait(&bus, &txns[i]));
+    }
+    uint64_t elapsed = i2c_mock_now_us() - start;
+    // One conversion plus a few ms of bus time, not three blocking conversions
+    TEST_ASSERT_LESS_THAN_UINT64(CONVERSION_US + 5000, elapsed);
+    TEST_ASSERT_LESS_THAN_UINT64(bus.busy_us + CONVERSION_US + 1000, elapsed);
+}
+
+void test_min_interval_per_device(void) {
+    i2c_device_t dev;
+    i2c_txn_t first, second;
+    uint8_t buf[6];
+    i2c_mock_add_device(ADDR_A, 0, response, sizeof(response));
+    make_dev(&dev, ADDR_A);
+    dev.min_interval_us = 5000;
+    make_txn(&first, &dev, buf, 0);
+    make_txn(&second, &dev, buf, 0);
+
+    i2c_bus_submit(&bus, &first);
+    i2c_bus_submit(&bus, &second);
+    TEST_ASSERT_EQUAL(I2C_BUS_OK, i2c_bus_wait(&bus, &second));
+    TEST_ASSERT_EQUAL(I2C_BUS_OK, first.status);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(first.done_us + 5000, i2c_mock_transfer(1)->start_us);
+}
+
+void test_same_device_transactions_stay_in_order(void) {
+    i2c_device_t dev;
+    i2c_txn_t first, second;
+    uint8_t buf1[6], buf2[6];
+    int order1 = 0, order2 = 0;
+    i2c_mock_add_device(ADDR_A, CONVERSION_US, response, sizeof(response));
+    make_dev(&dev, ADDR_A);
+    make_txn(&first, &dev, buf1, CONVERSION_US);
+    make_txn(&second, &dev, buf2, 0);
+    first.cb = count_cb;
+    first.cb_arg = &order1;
+    second.cb = count_cb;
+    second.cb_arg = &order2;
+
+    i2c_bus_submit(&bus, &first);
+    i2c_bus_submit(&bus, &second);
+    i2c_bus_wait(&bus, &second);
+    TEST_ASSERT_EQUAL_INT(1, order1);
+    TEST_ASSERT_EQUAL_INT(2, order2);
+    // Second did not cut into the first one's conversion gap
+    TEST_ASSERT_EQUAL_INT(3, i2c_mock_transfer_count());
+    TEST_ASSERT_EQUAL_UINT32(0, i2c_mock_transfer(1)->write_len);
+}
+
+void test_busy_device_read_is_retried(void) {
+    i2c_device_t dev;
+    i2c_txn_t txn;
+    uint8_t buf[6];
+    // Conversion takes longer than the caller's delay
+    i2c_mock_add_device(ADDR_A, CONVERSION_US + 1500, response, sizeof(response));
+    make_dev(&dev, ADDR_A);
+    make_txn(&txn, &dev, buf, CONVERSION_US);
+
+    i2c_bus_submit(&bus, &txn);
+    TEST_ASSERT_EQUAL(I2C_BUS_OK, i2c_bus_wait(&bus, &txn));
+    TEST_ASSERT_EQUAL(I2C_BUS_NACK, i2c_mock_transfer(1)->status);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(response, buf, 6);
+}
+
+void test_retries_exhausted(void) {
+    i2c_device_t dev;
+    i2c_txn_t txn;
+    uint8_t buf[6];
+    i2c_mock_add_device(ADDR_A, 10 * CONVERSION_US, response, sizeof(response));
+    make_dev(&dev, ADDR_A);
+    make_txn(&txn, &dev, buf, CONVERSION_US);
+    txn.read_retries = 2;
+
+    i2c_bus_submit(&bus, &txn);
+    TEST_ASSERT_EQUAL(I2C_BUS_NACK, i2c_bus_wait(&bus, &txn));
+    TEST_ASSERT_EQUAL_INT(1 + 3, i2c_mock_transfer_count());
+    TEST_ASSERT_EQUAL_UINT32(1, bus.errors);
+}
+
+void test_missing_device_nacks(void) {
+    i2c_device_t dev;
+    i2c_txn_t txn;
+    uint8_t buf[6];
+    make_dev(&dev, ADDR_A);
+    make_txn(&txn, &dev, buf, 0);
+
+    i2c_bus_submit(&bus, &txn);
+    TEST_ASSERT_EQUAL(I2C_BUS_NACK, i2c_bus_wait(&bus, &txn));
+    TEST_ASSERT_FALSE(i2c_bus_poll(&bus));
+}
+
+void test_stuck_transfer_times_out(void) {
+    i2c_device_t dev;
+    i2c_txn_t txn, next;
+    uint8_t buf[6];
+    i2c_mock_add_device(ADDR_A, 0, response, sizeof(response));
+    make_dev(&dev, ADDR_A);
+    make_txn(&txn, &dev, buf, 0);
+    make_txn(&next, &dev, buf, 0);
+    txn.timeout_us = 2000;
+
+    i2c_mock_set_hang(true);
+    i2c_bus_submit(&bus, &txn);
+    i2c_bus_submit(&bus, &next);
+    i2c_bus_poll(&bus);
+    i2c_mock_set_hang(false);
+    TEST_ASSERT_EQUAL(I2C_BUS_TIMEOUT, i2c_bus_wait(&bus, &txn));
+    TEST_ASSERT_EQUAL_INT(1, i2c_mock_abort_count());
+    // The bus recovers for the next transaction
+    TEST_ASSERT_EQUAL(I2C_BUS_OK, i2c_bus_wait(&bus, &next));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_submit_rejects_invalid_and_duplicate);
+    RUN_TEST(test_stretched_read_is_one_transfer);
+    RUN_TEST(test_delayed_read_releases_bus);
+    RUN_TEST(test_parallel_conversions_cost_bus_time);
+    RUN_TEST(test_min_interval_per_device);
+    RUN_TEST(test_same_device_transactions_stay_in_order);
+    RUN_TEST(test_busy_device_read_is_retried);
+    RUN_TEST(test_retries_exhausted);
+    RUN_TEST(test_missing_device_nacks);
+    RUN_TEST(test_stuck_transfer_times_out);
+
+    return UNITY_END();
+}
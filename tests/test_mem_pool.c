@@ -0,0 +1,200 @@
+/**
+ * File: test_mem_pool.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the fixed-block memory pool
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "mem_pool.h"
+#include <pthread.h>
+#include <string.h>
+
+#define BLOCK_SIZE      20
+#define BLOCK_COUNT     4
+#define THREADS         4
+#define ROUNDS          100000
+
+MEM_POOL_STORAGE(storage, BLOCK_SIZE, BLOCK_COUNT);
+static mem_pool_t pool;
+
+void setUp(void) {
+    TEST_ASSERT_TRUE(mem_pool_init(&pool, "test", storage, BLOCK_SIZE, BLOCK_COUNT));
+}
+
+void tearDown(void) {}
+
+void test_init_rejects_bad_arguments(void) {
+    mem_pool_t other;
+    TEST_ASSERT_FALSE(mem_pool_init(&other, "bad", NULL, BLOCK_SIZE, BLOCK_COUNT));
+    TEST_ASSERT_FALSE(mem_pool_init(&other, "bad", storage, 0, BLOCK_COUNT));
+    TEST_ASSERT_FALSE(mem_pool_init(&other, "bad", storage, BLOCK_SIZE, 0));
+    TEST_ASSERT_FALSE(mem_pool_init(&other, "bad", storage + 1, BLOCK_SIZE, BLOCK_COUNT));
+    TEST_ASSERT_FALSE(mem_pool_init(&other, "bad", storage, BLOCK_SIZE, MEM_POOL_MAX_BLOCKS + 1));
+}
+
+void test_blocks_are_aligned_and_disjoint(void) {
+    uint8_t *blocks[BLOCK_COUNT];
+    for (int i = 0; i < BLOCK_COUNT; i++) {
+        blocks[i] = mem_pool_alloc(&pool);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+        TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)((uintptr_t)blocks[i] % MEM_POOL_ALIGN));
+        memset(blocks[i], i + 1, BLOCK_SIZE);
+    }
+    for (int i = 0; i < BLOCK_COUNT; i++) {
+        for (int b = 0; b < BLOCK_SIZE; b++) {
+            TEST_ASSERT_EQUAL_UINT8(i + 1, blocks[i][b]);
+        }
+    }
+}
+
+void test_exhaustion_is_counted(void) {
+    for (int i = 0; i < BLOCK_COUNT; i++) {
+        TEST_ASSERT_NOT_NULL(mem_pool_alloc(&pool));
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, mem_pool_available(&pool));
+    TEST_ASSERT_NULL(mem_pool_alloc(&pool));
+    TEST_ASSERT_NULL(mem_pool_alloc(&pool));
+
+    mem_pool_stats_t stats;
+    mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL_STRING("test", stats.name);
+    TEST_ASSERT_EQUAL_UINT16(BLOCK_COUNT, stats.in_use);
+    TEST_ASSERT_EQUAL_UINT32(BLOCK_COUNT, stats.allocs);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.exhausted);
+}
+
+void test_freed_block_is_reused(void) {
+    void *a = mem_pool_alloc(&pool);
+    mem_pool_free(&pool, a);
+    TEST_ASSERT_EQUAL_PTR(a, mem_pool_alloc(&pool));
+    TEST_ASSERT_EQUAL_UINT16(BLOCK_COUNT - 1, mem_pool_available(&pool));
+}
+
+void test_high_water_mark(void) {
+    void *a = mem_pool_alloc(&pool);
+    void *b = mem_pool_alloc(&pool);
+    void *c = mem_pool_alloc(&pool);
+    mem_pool_free(&pool, b);
+    mem_pool_free(&pool, c);
+    mem_pool_free(&pool, a);
+
+    mem_pool_stats_t stats;
+    mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.in_use);
+    TEST_ASSERT_EQUAL_UINT16(3, stats.high_water);
+}
+
+void test_invalid_free_is_ignored(void) {
+    uint8_t *a = mem_pool_alloc(&pool);
+    uint8_t outside[8];
+    mem_pool_free(&pool, a + 1);
+    mem_pool_free(&pool, outside);
+    mem_pool_free(&pool, NULL);
+
+    mem_pool_stats_t stats;
+    mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.invalid_frees);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.in_use);
+    TEST_ASSERT_TRUE(mem_pool_owns(&pool, a));
+    TEST_ASSERT_FALSE(mem_pool_owns(&pool, a + 1));
+}
+
+void test_double_free_is_ignored(void) {
+    void *a = mem_pool_alloc(&pool);
+    void *b = mem_pool_alloc(&pool);
+    mem_pool_free(&pool, a);
+    mem_pool_free(&pool, a);
+    // A block never handed out is free as well
+    mem_pool_free(&pool, (uint8_t *)storage + 3 * MEM_POOL_BLOCK_STRIDE(BLOCK_SIZE));
+
+    mem_pool_stats_t stats;
+    mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.invalid_frees);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.in_use);
+
+    // a is on the free list once: every free block still comes out exactly once
+    void *blocks[BLOCK_COUNT - 1];
+    for (int i = 0; i < BLOCK_COUNT - 1; i++) {
+        blocks[i] = mem_pool_alloc(&pool);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+        TEST_ASSERT_TRUE(blocks[i] != b);
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT_TRUE(blocks[i] != blocks[j]);
+        }
+    }
+    TEST_ASSERT_NULL(mem_pool_alloc(&pool));
+}
+
+void test_pools_are_registered_once(void) {
+    size_t count = mem_pool_count();
+    TEST_ASSERT_TRUE(count >= 1);
+    // Re-initialization (setUp runs before every test) keeps a single registry slot
+    TEST_ASSERT_TRUE(mem_pool_init(&pool, "test", storage, BLOCK_SIZE, BLOCK_COUNT));
+    TEST_ASSERT_EQUAL_size_t(count, mem_pool_count());
+
+    bool found = false;
+    for (size_t i = 0; i < mem_pool_count(); i++) {
+        found |= (mem_pool_at(i) == &pool);
+    }
+    TEST_ASSERT_TRUE(found);
+    TEST_ASSERT_NULL(mem_pool_at(count));
+}
+
+static void *churn_thread(void *arg) {
+    (void)arg;
+    uintptr_t errors = 0;
+    for (int i = 0; i < ROUNDS; i++) {
+        uint32_t *block = mem_pool_alloc(&pool);
+        if (block == NULL) {
+            continue;
+        }
+        // Nobody else may hold the block while we do
+        *block = (uint32_t)i;
+        if (*block != (uint32_t)i) {
+            errors++;
+        }
+        mem_pool_free(&pool, block);
+    }
+    return (void *)errors;
+}
+
+void test_concurrent_alloc_free(void) {
+    pthread_t threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, churn_thread, NULL));
+    }
+    for (int i = 0; i < THREADS; i++) {
+        void *errors;
+        pthread_join(threads[i], &errors);
+        TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)(uintptr_t)errors);
+    }
+
+    mem_pool_stats_t stats;
+    mem_pool_get_stats(&pool, &stats);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.in_use);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.invalid_frees);
+    TEST_ASSERT_TRUE(stats.high_water <= BLOCK_COUNT);
+    TEST_ASSERT_EQUAL_UINT16(BLOCK_COUNT, mem_pool_available(&pool));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_init_rejects_bad_arguments);
+    RUN_TEST(test_blocks_are_aligned_and_disjoint);
+    RUN_TEST(test_exhaustion_is_counted);
+    RUN_TEST(test_freed_block_is_reused);
+    RUN_TEST(test_high_water_mark);
+    RUN_TEST(test_invalid_free_is_ignored);
+    RUN_TEST(test_double_free_is_ignored);
+    RUN_TEST(test_pools_are_registered_once);
+    RUN_TEST(test_concurrent_alloc_free);
+
+    return UNITY_END();
+}
@@ -0,0 +1,189 @@
+/**
+ * File: test_mqtt_codec.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the MQTT 3.1.1 packet codec
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "mqtt_codec.h"
+#include <string.h>
+
+static uint8_t buf[512];
+
+void setUp(void) {
+    memset(buf, 0, sizeof(buf));
+}
+
+void tearDown(void) {}
+
+void test_connect_persistent_session(void) {
+    static const uint8_t expected[] = {
+        0x10, 0x0E, 0x00, 0x04, 'M', 'Q', 'T', 'T', 0x04, 0x00, 0x00, 0x3C, 0x00, 0x02, 'a', 'b'
+    };
+    mqtt_connect_opts_t opts = { .client_id = "ab", .keep_alive_s = 60, .clean_session = false };
+    size_t n = mqtt_encode_connect(buf, sizeof(buf), &opts);
+    TEST_ASSERT_EQUAL_size_t(sizeof(expected), n);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, n);
+}
+
+void test_connect_flags(void) {
+    mqtt_connect_opts_t opts = { .client_id = "c", .username = "u", .password = "pw", .clean_session = true };
+    size_t n = mqtt_encode_connect(buf, sizeof(buf), &opts);
+    TEST_ASSERT_EQUAL_size_t(2 + 10 + 3 + 3 + 4, n);
+    TEST_ASSERT_EQUAL_HEX8(0xC2, buf[9]);
+
+    // Password without username is not allowed by the protocol
+    opts.username = NULL;
+    TEST_ASSERT_EQUAL_size_t(0, mqtt_encode_connect(buf, sizeof(buf), &opts));
+}
+
+void test_publish_round_trip(void) {
+    static const uint8_t expected[] = { 0x33, 0x09, 0x00, 0x03, 't', '/', 'x', 0x12, 0x34, 'h', 'i' };
+    size_t n = mqtt_encode_publish(buf, sizeof(buf), "t/x", (const uint8_t *)"hi", 2, 1, true, false, 0x1234);
+    TEST_ASSERT_EQUAL_size_t(sizeof(expected), n);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, buf, n);
+
+    mqtt_packet_t pkt;
+    TEST_ASSERT_EQUAL_size_t(n, mqtt_parse_packet(buf, n, &pkt));
+    mqtt_publish_t pub;
+    TEST_ASSERT_TRUE(mqtt_decode_publish(&pkt, &pub));
+    TEST_ASSERT_EQUAL_UINT16(3, pub.topic_len);
+    TEST_ASSERT_EQUAL_MEMORY("t/x", pub.topic, 3);
+    TEST_ASSERT_EQUAL_UINT32(2, pub.payload_len);
+    TEST_ASSERT_EQUAL_MEMORY("hi", pub.payload, 2);
+    TEST_ASSERT_EQUAL_UINT8(1, pub.qos);
+    TEST_ASSERT_TRUE(pub.retain);
+    TEST_ASSERT_EQUAL_UINT16(0x1234, pub.packet_id);
+}
+
+void test_publish_rejects_invalid(void) {
+    // QoS 1 needs a packet id, QoS 2 is not supported, empty topics are invalid
+    TEST_ASSERT_EQUAL_size_t(0, mqtt_encode_publish(buf, sizeof(buf), "t", NULL, 0, 1, false, false, 0));
+    TEST_ASSERT_EQUAL_size_t(0, mqtt_encode_publish(buf, sizeof(buf), "t", NULL, 0, 2, false, false, 1));
+    TEST_ASSERT_EQUAL_size_t(0, mqtt_encode_publish(buf, sizeof(buf), "", NULL, 0, 0, false, false, 0));
+    // Does not fit
+    TEST_ASSERT_EQUAL_size_t(0, mqtt_encode_publish(buf, 6, "topic", (const uint8_t *)"x", 1, 0, false, false, 0));
+}
+
+void test_multi_byte_remaining_length(void) {
+    uint8_t payload[300];
+    memset(payload, 0xA5, sizeof(payload));
+    size_t n = mqtt_encode_publish(buf, sizeof(buf), "t", payload, sizeof(payload), 0, false, false, 0);
+    // Remaining length 303 = 0xAF 0x02
+    TEST_ASSERT_EQUAL_size_t(1 + 2 + 303, n);
+    TEST_ASSERT_EQUAL_HEX8(0xAF, buf[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x02, buf[2]);
+
+    // Every proper prefix is incomplete
+    mqtt_packet_t pkt;
+    for (size_t len = 0; len < n; len++) {
+        TEST_ASSERT_EQUAL_size_t(MQTT_PARSE_INCOMPLETE, mqtt_parse_packet(buf, len, &pkt));
+    }
+    TEST_ASSERT_EQUAL_size_t(n, mqtt_parse_packet(buf, n, &pkt));
+    TEST_ASSERT_EQUAL_UINT32(303, pkt.body_len);
+}
+
+void test_subscribe_and_unsubscribe(void) {
+    static const uint8_t sub[] = { 0x82, 0x08, 0x00, 0x07, 0x00, 0x03, 'a', '/', 'b', 0x01 };
+    static const uint8_t unsub[] = { 0xA2, 0x07, 0x00, 0x08, 0x00, 0x03, 'a', '/', 'b' };
+    size_t n = mqtt_encode_subscribe(buf, sizeof(buf), 7, "a/b", 1);
+    TEST_ASSERT_EQUAL_size_t(sizeof(sub), n);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(sub, buf, n);
+    n = mqtt_encode_unsubscribe(buf, sizeof(buf), 8, "a/b");
+    TEST_ASSERT_EQUAL_size_t(sizeof(unsub), n);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(unsub, buf, n);
+    TEST_ASSERT_EQUAL_size_t(0, mqtt_encode_subscribe(buf, sizeof(buf), 0, "a/b", 1));
+}
+
+void test_small_packets(void) {
+    TEST_ASSERT_EQUAL_size_t(4, mqtt_encode_puback(buf, sizeof(buf), 0xBEEF));
+    TEST_ASSERT_EQUAL_HEX8(0x40, buf[0]);
+    TEST_ASSERT_EQUAL_size_t(2, mqtt_encode_empty(buf, sizeof(buf), MQTT_PKT_PINGREQ));
+    TEST_ASSERT_EQUAL_HEX8(0xC0, buf[0]);
+    TEST_ASSERT_EQUAL_size_t(2, mqtt_encode_empty(buf, sizeof(buf), MQTT_PKT_DISCONNECT));
+    TEST_ASSERT_EQUAL_HEX8(0xE0, buf[0]);
+    TEST_ASSERT_EQUAL_size_t(0, mqtt_encode_empty(buf, sizeof(buf), MQTT_PKT_CONNACK));
+}
+
+void test_decode_connack(void) {
+    const uint8_t present[] = { 0x20, 0x02, 0x01, 0x00 };
+    const uint8_t refused[] = { 0x20, 0x02, 0x00, 0x05 };
+    const uint8_t bad_len[] = { 0x20, 0x03, 0x00, 0x00, 0x00 };
+    mqtt_packet_t pkt;
+    bool session_present;
+    uint8_t rc;
+
+    TEST_ASSERT_EQUAL_size_t(4, mqtt_parse_packet(present, sizeof(present), &pkt));
+    TEST_ASSERT_TRUE(mqtt_decode_connack(&pkt, &session_present, &rc));
+    TEST_ASSERT_TRUE(session_present);
+    TEST_ASSERT_EQUAL_UINT8(MQTT_CONNACK_ACCEPTED, rc);
+
+    mqtt_parse_packet(refused, sizeof(refused), &pkt);
+    TEST_ASSERT_TRUE(mqtt_decode_connack(&pkt, &session_present, &rc));
+    TEST_ASSERT_FALSE(session_present);
+    TEST_ASSERT_EQUAL_UINT8(5, rc);
+
+    mqtt_parse_packet(bad_len, sizeof(bad_len), &pkt);
+    TEST_ASSERT_FALSE(mqtt_decode_connack(&pkt, &session_present, &rc));
+    TEST_ASSERT_FALSE(mqtt_decode_ack(&pkt, NULL, NULL));
+}
+
+void test_decode_acks(void) {
+    const uint8_t suback[] = { 0x90, 0x03, 0x00, 0x07, 0x80 };
+    const uint8_t puback[] = { 0x40, 0x02, 0x12, 0x34 };
+    mqtt_packet_t pkt;
+    uint16_t id;
+    uint8_t granted = 0;
+
+    mqtt_parse_packet(suback, sizeof(suback), &pkt);
+    TEST_ASSERT_TRUE(mqtt_decode_ack(&pkt, &id, &granted));
+    TEST_ASSERT_EQUAL_UINT16(7, id);
+    TEST_ASSERT_EQUAL_HEX8(MQTT_SUBACK_FAILURE, granted);
+
+    mqtt_parse_packet(puback, sizeof(puback), &pkt);
+    TEST_ASSERT_TRUE(mqtt_decode_ack(&pkt, &id, NULL));
+    TEST_ASSERT_EQUAL_UINT16(0x1234, id);
+    TEST_ASSERT_FALSE(mqtt_decode_publish(&pkt, &(mqtt_publish_t){0}));
+}
+
+void test_parse_stream_and_malformed(void) {
+    // PINGRESP followed by PUBACK in one read
+    const uint8_t stream[] = { 0xD0, 0x00, 0x40, 0x02, 0x00, 0x01 };
+    mqtt_packet_t pkt;
+    TEST_ASSERT_EQUAL_size_t(2, mqtt_parse_packet(stream, sizeof(stream), &pkt));
+    TEST_ASSERT_EQUAL_UINT8(MQTT_PKT_PINGRESP, pkt.type);
+    TEST_ASSERT_EQUAL_size_t(4, mqtt_parse_packet(stream + 2, sizeof(stream) - 2, &pkt));
+    TEST_ASSERT_EQUAL_UINT8(MQTT_PKT_PUBACK, pkt.type);
+
+    const uint8_t too_long[] = { 0x30, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 };
+    const uint8_t reserved[] = { 0x00, 0x00 };
+    TEST_ASSERT_EQUAL_size_t(MQTT_PARSE_MALFORMED, mqtt_parse_packet(too_long, sizeof(too_long), &pkt));
+    TEST_ASSERT_EQUAL_size_t(MQTT_PARSE_MALFORMED, mqtt_parse_packet(reserved, sizeof(reserved), &pkt));
+
+    // Topic length pointing past the packet
+    const uint8_t bad_topic[] = { 0x30, 0x03, 0x00, 0x05, 'a' };
+    mqtt_parse_packet(bad_topic, sizeof(bad_topic), &pkt);
+    mqtt_publish_t pub;
+    TEST_ASSERT_FALSE(mqtt_decode_publish(&pkt, &pub));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_connect_persistent_session);
+    RUN_TEST(test_connect_flags);
+    RUN_TEST(test_publish_round_trip);
+    RUN_TEST(test_publish_rejects_invalid);
+    RUN_TEST(test_multi_byte_remaining_length);
+    RUN_TEST(test_subscribe_and_unsubscribe);
+    RUN_TEST(test_small_packets);
+    RUN_TEST(test_decode_connack);
+    RUN_TEST(test_decode_acks);
+    RUN_TEST(test_parse_stream_and_malformed);
+    return UNITY_END();
+}
@@ -0,0 +1,104 @@
+/**
+ * File: test_mqtt_payload.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the MQTT telemetry payloads
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "mqtt_payload.h"
+#include <string.h>
+
+static char out[320];
+static fmt_buf_t b;
+static rbe_report_t report;
+
+static void fill(pm25_data_t *d) {
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        pm25_data_set(d, (pm25_field_t)f, (uint16_t)(f + 1));
+    }
+}
+
+void setUp(void) {
+    fmt_init(&b, out, sizeof(out));
+    memset(&report, 0, sizeof(report));
+    report.seq = 42;
+    report.timestamp_ms = 123456;
+    report.reasons = RBE_REASON_DEADBAND | RBE_REASON_THRESHOLD;
+    report.level = 2;
+    fill(&report.data);
+}
+
+void tearDown(void) {
+}
+
+void test_sample_has_every_field_in_frame_order(void) {
+    mqtt_payload_pm25(&b, &report.data);
+    TEST_ASSERT_TRUE(fmt_finish(&b) > 0);
+    TEST_ASSERT_EQUAL_STRING("{\"pm1_0_cf1\":1,\"pm2_5_cf1\":2,\"pm10_cf1\":3,\"pm1_0_atm\":4,\"pm2_5_atm\":5,"
+                             "\"pm10_atm\":6,\"count_0_3\":7,\"count_0_5\":8,\"count_1_0\":9,\"count_2_5\":10,"
+                             "\"count_5_0\":11,\"count_10\":12}", out);
+}
+
+void test_report_leads_with_sequence_and_reasons(void) {
+    mqtt_payload_pm25_report(&b, &report);
+    TEST_ASSERT_TRUE(fmt_finish(&b) > 0);
+    TEST_ASSERT_EQUAL_STRING("{\"seq\":42,\"ts\":123456,\"reasons\":10,\"level\":2,\"pm1_0_cf1\":1,\"pm2_5_cf1\":2,"
+                             "\"pm10_cf1\":3,\"pm1_0_atm\":4,\"pm2_5_atm\":5,\"pm10_atm\":6,\"count_0_3\":7,"
+                             "\"count_0_5\":8,\"count_1_0\":9,\"count_2_5\":10,\"count_5_0\":11,\"count_10\":12}", out);
+}
+
+void test_alert_is_short(void) {
+    mqtt_payload_pm25_alert(&b, &report);
+    TEST_ASSERT_TRUE(fmt_finish(&b) > 0);
+    TEST_ASSERT_EQUAL_STRING("{\"seq\":42,\"ts\":123456,\"level\":2,\"pm2_5_atm\":5}", out);
+}
+
+void test_worst_case_report_fits_the_queue_payload(void) {
+    report.seq = UINT32_MAX;
+    report.timestamp_ms = UINT32_MAX;
+    report.reasons = 0xFF;
+    report.level = 0xFF;
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        pm25_data_set(&report.data, (pm25_field_t)f, UINT16_MAX);
+    }
+    mqtt_payload_pm25_report(&b, &report);
+    TEST_ASSERT_TRUE(fmt_finish(&b) > 0);
+
+    // A buffer that is too small fails instead of sending a truncated body
+    char small[64];
+    fmt_init(&b, small, sizeof(small));
+    mqtt_payload_pm25_report(&b, &report);
+    TEST_ASSERT_EQUAL_size_t(0, fmt_finish(&b));
+}
+
+void test_link_health_names_every_cause(void) {
+    pm25_link_stats_t link;
+    memset(&link, 0, sizeof(link));
+    link.good = 100;
+    link.bad[PM25_LINK_NO_DATA] = 1;
+    link.bad[PM25_LINK_BAD_START] = 2;
+    link.bad[PM25_LINK_BAD_LENGTH] = 3;
+    link.bad[PM25_LINK_BAD_CHECKSUM] = 4;
+    link.resync_bytes = 57;
+    link.resets = 1;
+    mqtt_payload_pm25_link(&b, 2, &link, 1500);
+    TEST_ASSERT_TRUE(fmt_finish(&b) > 0);
+    TEST_ASSERT_EQUAL_STRING("{\"sensor\":2,\"good\":100,\"no_data\":1,\"start\":2,\"length\":3,\"checksum\":4,"
+                             "\"resync_bytes\":57,\"resets\":1,\"silent_ms\":1500}", out);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_sample_has_every_field_in_frame_order);
+    RUN_TEST(test_report_leads_with_sequence_and_reasons);
+    RUN_TEST(test_alert_is_short);
+    RUN_TEST(test_worst_case_report_fits_the_queue_payload);
+    RUN_TEST(test_link_health_names_every_cause);
+    return UNITY_END();
+}
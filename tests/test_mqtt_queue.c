@@ -0,0 +1,246 @@
+/**
+ * File: test_mqtt_queue.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the priority-lane outbound MQTT message queue
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "mqtt_queue.h"
+#include <string.h>
+
+#define RATE    100     // Bulk bytes per second
+#define BURST   200
+
+static mqtt_queue_t queue;
+static const uint8_t payload[100] = { 0 };
+
+void setUp(void) {
+    mqtt_queue_init(&queue, RATE, BURST, 0);
+}
+
+void tearDown(void) {}
+
+static bool push(mqtt_lane_t lane, size_t len, uint32_t now_ms) {
+    return mqtt_queue_push(&queue, lane, (lane == MQTT_LANE_ALERT) ? "alert" : "bulk", payload, len, 0, false, now_ms);
+}
+
+static void pop_release(uint32_t now_ms) {
+    mqtt_msg_t *msg = mqtt_queue_pop(&queue, now_ms);
+    TEST_ASSERT_NOT_NULL(msg);
+    mqtt_queue_release(&queue, msg);
+}
+
+void test_empty_queue_pops_nothing(void) {
+    TEST_ASSERT_NULL(mqtt_queue_pop(&queue, 0));
+}
+
+void test_message_contents_are_copied(void) {
+    const uint8_t data[] = { 1, 2, 3 };
+    TEST_ASSERT_TRUE(mqtt_queue_push(&queue, MQTT_LANE_BULK, "a/b", data, sizeof(data), 1, true, 5));
+    mqtt_msg_t *msg = mqtt_queue_pop(&queue, 7);
+    TEST_ASSERT_NOT_NULL(msg);
+    TEST_ASSERT_EQUAL_STRING("a/b", msg->topic);
+    TEST_ASSERT_EQUAL_UINT16(3, msg->len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, msg->payload, 3);
+    TEST_ASSERT_EQUAL_UINT8(1, msg->qos);
+    TEST_ASSERT_TRUE(msg->retain);
+    TEST_ASSERT_EQUAL_UINT32(2, queue.stats[MQTT_LANE_BULK].max_latency_ms);
+}
+
+void test_alert_jumps_bulk_backlog(void) {
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(push(MQTT_LANE_BULK, 10, 0));
+    }
+    TEST_ASSERT_TRUE(push(MQTT_LANE_ALERT, 10, 0));
+    mqtt_msg_t *msg = mqtt_queue_pop(&queue, 0);
+    TEST_ASSERT_NOT_NULL(msg);
+    TEST_ASSERT_EQUAL_UINT8(MQTT_LANE_ALERT, msg->lane);
+    mqtt_queue_release(&queue, msg);
+    TEST_ASSERT_EQUAL_UINT16(5, mqtt_queue_depth(&queue, MQTT_LANE_BULK));
+}
+
+void test_lanes_are_fifo(void) {
+    for (uint8_t i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(mqtt_queue_push(&queue, MQTT_LANE_BULK, "bulk", &i, 1, 0, false, 0));
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        mqtt_msg_t *msg = mqtt_queue_pop(&queue, 0);
+        TEST_ASSERT_NOT_NULL(msg);
+        TEST_ASSERT_EQUAL_UINT8(i, msg->payload[0]);
+        mqtt_queue_release(&queue, msg);
+    }
+}
+
+void test_bulk_is_shaped_by_token_bucket(void) {
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_TRUE(push(MQTT_LANE_BULK, 100, 0));
+    }
+    // Burst of 200 bytes lets two through
+    pop_release(0);
+    pop_release(0);
+    TEST_ASSERT_NULL(mqtt_queue_pop(&queue, 0));
+    // 100 bytes/s: one more after a second, not before
+    TEST_ASSERT_NULL(mqtt_queue_pop(&queue, 999));
+    pop_release(1000);
+    // Refill does not lose fractions across polls
+    for (uint32_t t = 1010; t < 2000; t += 10) {
+        TEST_ASSERT_NULL(mqtt_queue_pop(&queue, t));
+    }
+    pop_release(2000);
+}
+
+void test_bulk_rate_is_bounded_over_time(void) {
+    uint32_t bytes = 0;
+    for (uint32_t t = 0; t <= 10000; t += 50) {
+        while (mqtt_queue_depth(&queue, MQTT_LANE_BULK) < 4) {
+            push(MQTT_LANE_BULK, 50, t);
+        }
+        mqtt_msg_t *msg;
+        while ((msg = mqtt_queue_pop(&queue, t)) != NULL) {
+            bytes += msg->len;
+            mqtt_queue_release(&queue, msg);
+        }
+    }
+    // Burst plus 10 s at the configured rate
+    TEST_ASSERT_UINT32_WITHIN(50, BURST + 10 * RATE, bytes);
+}
+
+void test_alerts_are_not_shaped(void) {
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(push(MQTT_LANE_ALERT, 100, 0));
+    }
+    for (int i = 0; i < 5; i++) {
+        pop_release(0);
+    }
+}
+
+void test_zero_rate_disables_shaping(void) {
+    mqtt_queue_init(&queue, 0, 0, 0);
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(push(MQTT_LANE_BULK, 100, 0));
+    }
+    for (int i = 0; i < 5; i++) {
+        pop_release(0);
+    }
+}
+
+void test_bulk_rate_change_keeps_queue(void) {
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_TRUE(push(MQTT_LANE_BULK, 100, 0));
+    }
+    pop_release(0);
+    pop_release(0);
+    TEST_ASSERT_NULL(mqtt_queue_pop(&queue, 500));
+
+    // Half a second at the old rate is credited, then 200 bytes/s
+    mqtt_queue_set_bulk_rate(&queue, 2 * RATE, BURST, 500);
+    TEST_ASSERT_EQUAL_UINT16(4, mqtt_queue_depth(&queue, MQTT_LANE_BULK));
+    TEST_ASSERT_NULL(mqtt_queue_pop(&queue, 749));
+    pop_release(750);
+    TEST_ASSERT_NULL(mqtt_queue_pop(&queue, 1249));
+    pop_release(1250);
+
+    // Unshaped drains the rest at once
+    mqtt_queue_set_bulk_rate(&queue, 0, 0, 1250);
+    pop_release(1250);
+    pop_release(1250);
+    TEST_ASSERT_NULL(mqtt_queue_pop(&queue, 1250));
+}
+
+void test_bulk_cannot_take_alert_reserve(void) {
+    int accepted = 0;
+    while (push(MQTT_LANE_BULK, 10, 0)) {
+        accepted++;
+    }
+    TEST_ASSERT_EQUAL_INT(MQTT_QUEUE_POOL_SIZE - MQTT_QUEUE_ALERT_RESERVE, accepted);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.stats[MQTT_LANE_BULK].dropped);
+    for (int i = 0; i < MQTT_QUEUE_ALERT_RESERVE; i++) {
+        TEST_ASSERT_TRUE(push(MQTT_LANE_ALERT, 10, 0));
+    }
+}
+
+void test_alert_evicts_oldest_bulk_when_full(void) {
+    uint8_t i = 0;
+    while (mqtt_queue_push(&queue, MQTT_LANE_BULK, "bulk", &i, 1, 0, false, 0)) {
+        i++;
+    }
+    for (int a = 0; a < MQTT_QUEUE_ALERT_RESERVE + 1; a++) {
+        TEST_ASSERT_TRUE(push(MQTT_LANE_ALERT, 10, 0));
+    }
+    TEST_ASSERT_EQUAL_UINT16(MQTT_QUEUE_POOL_SIZE - MQTT_QUEUE_ALERT_RESERVE - 1,
+                             mqtt_queue_depth(&queue, MQTT_LANE_BULK));
+    for (int a = 0; a < MQTT_QUEUE_ALERT_RESERVE + 1; a++) {
+        pop_release(0);
+    }
+    // Bulk message 0 was evicted
+    mqtt_msg_t *msg = mqtt_queue_pop(&queue, 0);
+    TEST_ASSERT_NOT_NULL(msg);
+    TEST_ASSERT_EQUAL_UINT8(1, msg->payload[0]);
+}
+
+void test_alert_latency_bounded_while_draining_backlog(void) {
+    // Outage backlog fills the bulk lane; an alert raised meanwhile is next out
+    while (push(MQTT_LANE_BULK, 100, 0)) {
+    }
+    uint32_t alert_at = 0;
+    for (uint32_t t = 0; t < 60000; t += 100) {
+        if (t == 5000) {
+            TEST_ASSERT_TRUE(push(MQTT_LANE_ALERT, 20, t));
+            alert_at = t;
+        }
+        mqtt_msg_t *msg = mqtt_queue_pop(&queue, t);
+        if (msg != NULL) {
+            if (msg->lane == MQTT_LANE_ALERT) {
+                TEST_ASSERT_EQUAL_UINT32(alert_at, t);
+            }
+            mqtt_queue_release(&queue, msg);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, queue.stats[MQTT_LANE_ALERT].max_latency_ms);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.stats[MQTT_LANE_ALERT].sent);
+}
+
+void test_oversized_message_is_rejected(void) {
+    TEST_ASSERT_FALSE(mqtt_queue_push(&queue, MQTT_LANE_BULK, "bulk", payload, MQTT_QUEUE_PAYLOAD_MAX + 1, 0, false, 0));
+    char topic[MQTT_QUEUE_TOPIC_MAX + 1];
+    memset(topic, 'a', sizeof(topic) - 1);
+    topic[sizeof(topic) - 1] = '\0';
+    TEST_ASSERT_FALSE(mqtt_queue_push(&queue, MQTT_LANE_BULK, topic, payload, 1, 0, false, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, queue.stats[MQTT_LANE_BULK].dropped);
+}
+
+void test_pool_buffers_are_reused(void) {
+    for (int i = 0; i < 10 * MQTT_QUEUE_POOL_SIZE; i++) {
+        TEST_ASSERT_TRUE(push(MQTT_LANE_ALERT, 10, 0));
+        pop_release(0);
+    }
+    TEST_ASSERT_EQUAL_UINT16(MQTT_QUEUE_POOL_SIZE, mem_pool_available(&queue.pool));
+    TEST_ASSERT_EQUAL_UINT16(1, queue.stats[MQTT_LANE_ALERT].max_depth);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_queue_pops_nothing);
+    RUN_TEST(test_message_contents_are_copied);
+    RUN_TEST(test_alert_jumps_bulk_backlog);
+    RUN_TEST(test_lanes_are_fifo);
+    RUN_TEST(test_bulk_is_shaped_by_token_bucket);
+    RUN_TEST(test_bulk_rate_is_bounded_over_time);
+    RUN_TEST(test_alerts_are_not_shaped);
+    RUN_TEST(test_zero_rate_disables_shaping);
+    RUN_TEST(test_bulk_rate_change_keeps_queue);
+    RUN_TEST(test_bulk_cannot_take_alert_reserve);
+    RUN_TEST(test_alert_evicts_oldest_bulk_when_full);
+    RUN_TEST(test_alert_latency_bounded_while_draining_backlog);
+    RUN_TEST(test_oversized_message_is_rejected);
+    RUN_TEST(test_pool_buffers_are_reused);
+
+    return UNITY_END();
+}
@@ -0,0 +1,240 @@
+/**
+ * File: test_mqtt_session.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for MQTT connection reuse: TLS session cache, store policy and persistent sessions
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "mqtt_session.h"
+#include <string.h>
+
+#define LIFETIME_MS     60000u
+#define SAVE_MS         10000u
+
+// Store in RAM that counts its writes
+typedef struct {
+    uint8_t data[MQTT_TLS_SESSION_MAX];
+    size_t len;
+    int saves;
+    int erases;
+} ram_store_t;
+
+static size_t ram_load(void *ctx, uint8_t *buf, size_t size) {
+    ram_store_t *s = ctx;
+    if (s->len == 0 || s->len > size) {
+        return 0;
+    }
+    memcpy(buf, s->data, s->len);
+    return s->len;
+}
+
+static bool ram_save(void *ctx, const uint8_t *data, size_t len) {
+    ram_store_t *s = ctx;
+    memcpy(s->data, data, len);
+    s->len = len;
+    s->saves++;
+    return true;
+}
+
+static void ram_erase(void *ctx) {
+    ram_store_t *s = ctx;
+    s->len = 0;
+    s->erases++;
+}
+
+static ram_store_t ram;
+static const mqtt_session_store_t store = { ram_load, ram_save, ram_erase, &ram };
+static mqtt_session_t session;
+
+static const uint8_t ticket_a[] = { 1, 2, 3, 4, 5 };
+static const uint8_t ticket_b[] = { 6, 7, 8, 9 };
+
+void setUp(void) {
+    memset(&ram, 0, sizeof(ram));
+    mqtt_session_init(&session, NULL, LIFETIME_MS, SAVE_MS, 0);
+}
+
+void tearDown(void) {}
+
+void test_first_connect_is_full_handshake(void) {
+    size_t len;
+    TEST_ASSERT_NULL(mqtt_session_tls_resume_data(&session, 0, &len));
+    TEST_ASSERT_EQUAL_size_t(0, len);
+
+    mqtt_session_tls_established(&session, false, ticket_a, sizeof(ticket_a), 100);
+    TEST_ASSERT_EQUAL_UINT32(1, session.stats.full_handshakes);
+    TEST_ASSERT_EQUAL_UINT32(0, session.stats.resume_rejected);
+
+    const uint8_t *data = mqtt_session_tls_resume_data(&session, 200, &len);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL_size_t(sizeof(ticket_a), len);
+    TEST_ASSERT_EQUAL_MEMORY(ticket_a, data, len);
+}
+
+void test_resumed_and_rejected_handshakes(void) {
+    size_t len;
+    mqtt_session_tls_established(&session, false, ticket_a, sizeof(ticket_a), 0);
+
+    // Accepted: renewed ticket replaces the old one
+    mqtt_session_tls_resume_data(&session, 1000, &len);
+    mqtt_session_tls_established(&session, true, ticket_b, sizeof(ticket_b), 1000);
+    TEST_ASSERT_EQUAL_UINT32(1, session.stats.resumed_handshakes);
+    const uint8_t *data = mqtt_session_tls_resume_data(&session, 2000, &len);
+    TEST_ASSERT_EQUAL_MEMORY(ticket_b, data, sizeof(ticket_b));
+
+    // Offered but the server ran a full handshake
+    mqtt_session_tls_established(&session, false, ticket_a, sizeof(ticket_a), 2000);
+    TEST_ASSERT_EQUAL_UINT32(2, session.stats.full_handshakes);
+    TEST_ASSERT_EQUAL_UINT32(1, session.stats.resume_rejected);
+}
+
+void test_lifetime_counts_from_full_handshake(void) {
+    size_t len;
+    mqtt_session_tls_established(&session, false, ticket_a, sizeof(ticket_a), 0);
+    // Resumption does not extend the lifetime
+    mqtt_session_tls_resume_data(&session, LIFETIME_MS - 1000, &len);
+    mqtt_session_tls_established(&session, true, ticket_b, sizeof(ticket_b), LIFETIME_MS - 1000);
+    TEST_ASSERT_NULL(mqtt_session_tls_resume_data(&session, LIFETIME_MS, &len));
+    TEST_ASSERT_EQUAL_size_t(0, session.tls_len);
+}
+
+void test_failed_handshake_drops_offered_session(void) {
+    size_t len;
+    mqtt_session_tls_established(&session, false, ticket_a, sizeof(ticket_a), 0);
+
+    // Not offered (e.g. TCP connect failed before): kept
+    mqtt_session_tls_failed(&session);
+    TEST_ASSERT_NOT_NULL(mqtt_session_tls_resume_data(&session, 10, &len));
+
+    mqtt_session_tls_failed(&session);
+    TEST_ASSERT_NULL(mqtt_session_tls_resume_data(&session, 20, &len));
+}
+
+void test_unusable_export_is_ignored(void) {
+    static uint8_t big[MQTT_TLS_SESSION_MAX + 1];
+    size_t len;
+    mqtt_session_tls_established(&session, false, ticket_a, sizeof(ticket_a), 0);
+
+    // Resumed without a new export: the accepted session stays usable
+    mqtt_session_tls_resume_data(&session, 10, &len);
+    mqtt_session_tls_established(&session, true, NULL, 0, 10);
+    TEST_ASSERT_NOT_NULL(mqtt_session_tls_resume_data(&session, 20, &len));
+
+    // Full handshake whose session is too large to cache: nothing to offer
+    mqtt_session_tls_established(&session, false, big, sizeof(big), 20);
+    TEST_ASSERT_NULL(mqtt_session_tls_resume_data(&session, 30, &len));
+}
+
+void test_persistent_session_skips_resubscribe(void) {
+    // New broker session: subscribe
+    TEST_ASSERT_TRUE(mqtt_session_connack(&session, false));
+    mqtt_session_subscribed(&session);
+
+    // Broker kept it: nothing to send
+    TEST_ASSERT_FALSE(mqtt_session_connack(&session, true));
+    TEST_ASSERT_FALSE(mqtt_session_connack(&session, true));
+
+    // Broker lost it: subscribe again
+    TEST_ASSERT_TRUE(mqtt_session_connack(&session, false));
+    TEST_ASSERT_EQUAL_UINT32(4, session.stats.connects);
+    TEST_ASSERT_EQUAL_UINT32(2, session.stats.session_present);
+    TEST_ASSERT_EQUAL_UINT32(2, session.stats.resubscribes);
+}
+
+void test_incomplete_subscribe_is_repeated(void) {
+    // Connection dropped before the SUBACK: the broker's session may lack the topics
+    TEST_ASSERT_TRUE(mqtt_session_connack(&session, false));
+    TEST_ASSERT_TRUE(mqtt_session_connack(&session, true));
+    mqtt_session_subscribed(&session);
+    TEST_ASSERT_FALSE(mqtt_session_connack(&session, true));
+
+    // A new topic in the list forces the next connection to subscribe
+    mqtt_session_reset_subscriptions(&session);
+    TEST_ASSERT_TRUE(mqtt_session_connack(&session, true));
+}
+
+void test_store_survives_restart(void) {
+    size_t len;
+    mqtt_session_init(&session, &store, LIFETIME_MS, SAVE_MS, 0);
+    mqtt_session_tls_established(&session, false, ticket_a, sizeof(ticket_a), 0);
+    // Writes wait for the flush
+    TEST_ASSERT_EQUAL_INT(0, ram.saves);
+    mqtt_session_flush(&session, 0);
+    TEST_ASSERT_EQUAL_INT(1, ram.saves);
+    TEST_ASSERT_EQUAL_UINT32(1, session.stats.store_saves);
+
+    mqtt_session_t rebooted;
+    mqtt_session_init(&rebooted, &store, LIFETIME_MS, SAVE_MS, 5000);
+    const uint8_t *data = mqtt_session_tls_resume_data(&rebooted, 5000, &len);
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_EQUAL_MEMORY(ticket_a, data, sizeof(ticket_a));
+}
+
+void test_store_write_rate_is_bounded(void) {
+    size_t len;
+    mqtt_session_init(&session, &store, 0, SAVE_MS, 0);
+    mqtt_session_tls_established(&session, false, ticket_a, sizeof(ticket_a), 0);
+    mqtt_session_flush(&session, 0);
+
+    // Same session again: no write
+    mqtt_session_tls_resume_data(&session, 100, &len);
+    mqtt_session_tls_established(&session, true, ticket_a, sizeof(ticket_a), 100);
+    mqtt_session_flush(&session, 100);
+    TEST_ASSERT_EQUAL_INT(1, ram.saves);
+
+    // Renewed ticket inside the interval: RAM only
+    mqtt_session_tls_resume_data(&session, 200, &len);
+    mqtt_session_tls_established(&session, true, ticket_b, sizeof(ticket_b), 200);
+    mqtt_session_flush(&session, 200);
+    TEST_ASSERT_EQUAL_INT(1, ram.saves);
+
+    // Renewed ticket after the interval: written
+    mqtt_session_tls_resume_data(&session, SAVE_MS, &len);
+    mqtt_session_tls_established(&session, true, ticket_a, sizeof(ticket_a), SAVE_MS);
+    mqtt_session_flush(&session, SAVE_MS);
+    TEST_ASSERT_EQUAL_INT(2, ram.saves);
+
+    // A full handshake is always written
+    mqtt_session_tls_established(&session, false, ticket_b, sizeof(ticket_b), SAVE_MS + 1);
+    mqtt_session_flush(&session, SAVE_MS + 1);
+    TEST_ASSERT_EQUAL_INT(3, ram.saves);
+    TEST_ASSERT_EQUAL_MEMORY(ticket_b, ram.data, sizeof(ticket_b));
+}
+
+void test_dropped_session_is_erased_from_store(void) {
+    size_t len;
+    mqtt_session_init(&session, &store, LIFETIME_MS, SAVE_MS, 0);
+    mqtt_session_tls_established(&session, false, ticket_a, sizeof(ticket_a), 0);
+    mqtt_session_flush(&session, 0);
+
+    mqtt_session_tls_resume_data(&session, 10, &len);
+    mqtt_session_tls_failed(&session);
+    mqtt_session_flush(&session, 10);
+    TEST_ASSERT_EQUAL_INT(1, ram.erases);
+    TEST_ASSERT_EQUAL_size_t(0, ram.len);
+
+    mqtt_session_t rebooted;
+    mqtt_session_init(&rebooted, &store, LIFETIME_MS, SAVE_MS, 20);
+    TEST_ASSERT_NULL(mqtt_session_tls_resume_data(&rebooted, 20, &len));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_connect_is_full_handshake);
+    RUN_TEST(test_resumed_and_rejected_handshakes);
+    RUN_TEST(test_lifetime_counts_from_full_handshake);
+    RUN_TEST(test_failed_handshake_drops_offered_session);
+    RUN_TEST(test_unusable_export_is_ignored);
+    RUN_TEST(test_persistent_session_skips_resubscribe);
+    RUN_TEST(test_incomplete_subscribe_is_repeated);
+    RUN_TEST(test_store_survives_restart);
+    RUN_TEST(test_store_write_rate_is_bounded);
+    RUN_TEST(test_dropped_session_is_erased_from_store);
+    return UNITY_END();
+}
@@ -0,0 +1,588 @@
+/**
+ * File: test_mqtt_tls_loopback.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Loopback test of MQTT connection reuse against a local TLS broker stand-in. The stand-in runs on
+ * 127.0.0.1 with a self-signed certificate, a TLS session cache and per-client persistent MQTT sessions; the client
+ * side drives mqtt_codec, mqtt_session and mqtt_inflight the way mqtt_client.c does, with OpenSSL in place of
+ * mbedTLS. Needs the OpenSSL development files on the host.
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "mqtt_codec.h"
+#include "mqtt_session.h"
+#include "mqtt_inflight.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+#define CLIENT_ID       "airsense-test"
+#define TOPIC           "airsense/" CLIENT_ID "/config"
+#define ALERT_TOPIC     "airsense/" CLIENT_ID "/alert"
+#define IO_TIMEOUT_S    5
+
+// Packet reader over a TLS connection
+typedef struct {
+    SSL *ssl;
+    uint8_t buf[512];
+    size_t len;
+    size_t consumed;        // Bytes of the last returned packet
+} link_t;
+
+static bool link_read_packet(link_t *l, mqtt_packet_t *pkt) {
+    memmove(l->buf, l->buf + l->consumed, l->len - l->consumed);
+    l->len -= l->consumed;
+    l->consumed = 0;
+    for (;;) {
+        size_t n = mqtt_parse_packet(l->buf, l->len, pkt);
+        if (n == MQTT_PARSE_MALFORMED) {
+            return false;
+        }
+        if (n != MQTT_PARSE_INCOMPLETE) {
+            l->consumed = n;
+            return true;
+        }
+        if (l->len == sizeof(l->buf)) {
+            return false;
+        }
+        int r = SSL_read(l->ssl, l->buf + l->len, (int)(sizeof(l->buf) - l->len));
+        if (r <= 0) {
+            return false;
+        }
+        l->len += (size_t)r;
+    }
+}
+
+static bool link_write(link_t *l, const uint8_t *data, size_t len) {
+    return len > 0 && SSL_write(l->ssl, data, (int)len) == (int)len;
+}
+
+static void set_timeouts(int fd) {
+    struct timeval tv = { .tv_sec = IO_TIMEOUT_S };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// Broker stand-in: one connection per serve thread, state kept across connections
+
+typedef struct {
+    SSL_CTX *ctx;
+    int listen_fd;
+    uint16_t port;
+    bool has_session;           // Persistent session of CLIENT_ID
+    bool subscribed;            // Part of that session
+    int subscribes;             // SUBSCRIBE packets received in total
+    int connections;
+    int publishes;              // PUBLISH packets received in total
+    int drop_publishes;         // Close the connection instead of acknowledging the next ones
+    mqtt_publish_t last_publish;
+} broker_t;
+
+static EVP_PKEY *server_key;
+static X509 *server_cert;
+static broker_t broker;
+
+static void make_certificate(void) {
+    server_key = EVP_EC_gen("P-256");
+    server_cert = X509_new();
+    X509_set_version(server_cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(server_cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(server_cert), -60);
+    X509_gmtime_adj(X509_getm_notAfter(server_cert), 3600);
+    X509_set_pubkey(server_cert, server_key);
+    X509_NAME *name = X509_get_subject_name(server_cert);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char *)"broker.local", -1, -1, 0);
+    X509_set_issuer_name(server_cert, name);
+    X509_EXTENSION *ext = X509V3_EXT_conf_nid(NULL, NULL, NID_basic_constraints, "critical,CA:TRUE");
+    X509_add_ext(server_cert, ext, -1);
+    X509_EXTENSION_free(ext);
+    X509_sign(server_cert, server_key, EVP_sha256());
+}
+
+// Fresh TLS state: new ticket keys and an empty session cache, as after a broker restart
+static SSL_CTX *broker_new_ctx(bool tickets) {
+    SSL_CTX *ctx = SSL_CTX_new(TLS_server_method());
+    SSL_CTX_set_max_proto_version(ctx, TLS1_2_VERSION);
+    SSL_CTX_use_certificate(ctx, server_cert);
+    SSL_CTX_use_PrivateKey(ctx, server_key);
+    SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_set_session_id_context(ctx, (const unsigned char *)"mqtt", 4);
+    if (!tickets) {
+        SSL_CTX_set_options(ctx, SSL_OP_NO_TICKET);
+    }
+    return ctx;
+}
+
+static void broker_start(bool tickets) {
+    memset(&broker, 0, sizeof(broker));
+    broker.ctx = broker_new_ctx(tickets);
+    broker.listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(broker.listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK) };
+    TEST_ASSERT_EQUAL_INT(0, bind(broker.listen_fd, (struct sockaddr *)&addr, sizeof(addr)));
+    TEST_ASSERT_EQUAL_INT(0, listen(broker.listen_fd, 4));
+    socklen_t addr_len = sizeof(addr);
+    getsockname(broker.listen_fd, (struct sockaddr *)&addr, &addr_len);
+    broker.port = ntohs(addr.sin_port);
+}
+
+static void broker_stop(void) {
+    close(broker.listen_fd);
+    SSL_CTX_free(broker.ctx);
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+// CONNECT body: protocol name, level, flags, keep-alive, client id
+static bool broker_on_connect(link_t *l, const mqtt_packet_t *pkt) {
+    if (pkt->body_len < 12) {
+        return false;
+    }
+    bool clean = (pkt->body[7] & 0x02) != 0;
+    uint16_t id_len = get_u16(pkt->body + 10);
+    bool known = (id_len == strlen(CLIENT_ID)) && memcmp(pkt->body + 12, CLIENT_ID, id_len) == 0;
+    if (!known || clean) {
+        broker.subscribed = false;
+    }
+    bool present = known && !clean && broker.has_session;
+    broker.has_session = known && !clean;
+    uint8_t connack[] = { MQTT_PKT_CONNACK << 4, 2, present ? 1 : 0, MQTT_CONNACK_ACCEPTED };
+    return link_write(l, connack, sizeof(connack));
+}
+
+static void *broker_serve_one(void *arg) {
+    (void)arg;
+    int fd = accept(broker.listen_fd, NULL, NULL);
+    if (fd < 0) {
+        return NULL;
+    }
+    set_timeouts(fd);
+    broker.connections++;
+    link_t l = { .ssl = SSL_new(broker.ctx) };
+    SSL_set_fd(l.ssl, fd);
+    if (SSL_accept(l.ssl) == 1) {
+        mqtt_packet_t pkt;
+        bool open = true;
+        while (open && link_read_packet(&l, &pkt)) {
+            switch (pkt.type) {
+            case MQTT_PKT_CONNECT:
+                open = broker_on_connect(&l, &pkt);
+                break;
+            case MQTT_PKT_SUBSCRIBE: {
+                broker.subscribes++;
+                broker.subscribed = true;
+                uint8_t suback[] = { MQTT_PKT_SUBACK << 4, 3, pkt.body[0], pkt.body[1], 1 };
+                open = link_write(&l, suback, sizeof(suback));
+                break;
+            }
+            case MQTT_PKT_PUBLISH: {
+                mqtt_publish_t pub;
+                if (!mqtt_decode_publish(&pkt, &pub)) {
+                    open = false;
+                    break;
+                }
+                broker.publishes++;
+                broker.last_publish = pub;
+                if (broker.drop_publishes > 0) {
+                    // Link lost before the PUBACK went out
+                    broker.drop_publishes--;
+                    open = false;
+                } else if (pub.qos == 1) {
+                    uint8_t puback[4];
+                    open = link_write(&l, puback, mqtt_encode_puback(puback, sizeof(puback), pub.packet_id));
+                }
+                break;
+            }
+            case MQTT_PKT_DISCONNECT:
+                open = false;
+                break;
+            default:
+                break;
+            }
+        }
+        SSL_shutdown(l.ssl);
+    }
+    SSL_free(l.ssl);
+    close(fd);
+    return NULL;
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+// Client side, same sequence as mqtt_client.c
+
+typedef struct {
+    bool resumed;
+    bool session_present;
+    bool subscribed;            // SUBSCRIBE sent on this connection
+} connect_result_t;
+
+static SSL_CTX *client_ctx;
+static int cert_verifications;
+
+static int client_verify_cb(int preverify_ok, X509_STORE_CTX *store) {
+    (void)store;
+    // Only a full handshake carries the certificate chain; mqtt_client.c detects resumption this way
+    cert_verifications++;
+    return preverify_ok;
+}
+
+// TLS connect, CONNECT and, if the session needs it, SUBSCRIBE. The link stays open for client_close().
+static bool client_open(mqtt_session_t *session, uint32_t now_ms, connect_result_t *result, link_t *link, int *fd) {
+    memset(result, 0, sizeof(*result));
+    memset(link, 0, sizeof(*link));
+    *fd = socket(AF_INET, SOCK_STREAM, 0);
+    set_timeouts(*fd);
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET, .sin_port = htons(broker.port), .sin_addr.s_addr = htonl(INADDR_LOOPBACK)
+    };
+    if (connect(*fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        return false;
+    }
+    link_t l = { .ssl = SSL_new(client_ctx) };
+    SSL_set_fd(l.ssl, *fd);
+    SSL_set_tlsext_host_name(l.ssl, "broker.local");
+
+    size_t len;
+    const uint8_t *data = mqtt_session_tls_resume_data(session, now_ms, &len);
+    if (data != NULL) {
+        const unsigned char *p = data;
+        SSL_SESSION *saved = d2i_SSL_SESSION(NULL, &p, (long)len);
+        if (saved == NULL || SSL_set_session(l.ssl, saved) != 1) {
+            mqtt_session_tls_failed(session);
+        }
+        SSL_SESSION_free(saved);
+    }
+
+    cert_verifications = 0;
+    bool ok = SSL_connect(l.ssl) == 1;
+    if (!ok) {
+        mqtt_session_tls_failed(session);
+        SSL_free(l.ssl);
+        l.ssl = NULL;
+    } else {
+        result->resumed = (cert_verifications == 0);
+        TEST_ASSERT_EQUAL(SSL_session_reused(l.ssl) == 1, result->resumed);
+
+        uint8_t blob[MQTT_TLS_SESSION_MAX];
+        SSL_SESSION *current = SSL_get1_session(l.ssl);
+        int n = i2d_SSL_SESSION(current, NULL);
+        unsigned char *p = blob;
+        if (n > 0 && (size_t)n <= sizeof(blob)) {
+            i2d_SSL_SESSION(current, &p);
+        } else {
+            n = 0;
+        }
+        SSL_SESSION_free(current);
+        mqtt_session_tls_established(session, result->resumed, blob, (size_t)n, now_ms);
+
+        uint8_t packet[128];
+        mqtt_connect_opts_t opts = { .client_id = CLIENT_ID, .keep_alive_s = 60, .clean_session = false };
+        mqtt_packet_t pkt;
+        ok = link_write(&l, packet, mqtt_encode_connect(packet, sizeof(packet), &opts)) &&
+             link_read_packet(&l, &pkt) && mqtt_decode_connack(&pkt, &result->session_present, NULL);
+
+        if (ok && mqtt_session_connack(session, result->session_present)) {
+            result->subscribed = true;
+            uint16_t id = 0;
+            ok = link_write(&l, packet, mqtt_encode_subscribe(packet, sizeof(packet), 1, TOPIC, 1)) &&
+                 link_read_packet(&l, &pkt) && mqtt_decode_ack(&pkt, &id, NULL) && id == 1;
+            if (ok) {
+                mqtt_session_subscribed(session);
+            }
+        }
+    }
+    *link = l;
+    return ok;
+}
+
+static void client_close(link_t *l, int fd, bool disconnect) {
+    if (l->ssl != NULL) {
+        if (disconnect) {
+            uint8_t packet[2];
+            link_write(l, packet, mqtt_encode_empty(packet, sizeof(packet), MQTT_PKT_DISCONNECT));
+        }
+        SSL_shutdown(l->ssl);
+        SSL_free(l->ssl);
+    }
+    close(fd);
+}
+
+static bool client_connect(mqtt_session_t *session, uint32_t now_ms, connect_result_t *result) {
+    link_t l;
+    int fd;
+    bool ok = client_open(session, now_ms, result, &l, &fd);
+    client_close(&l, fd, ok);
+    return ok;
+}
+
+// Connect, write the publishes cut off by the last connection, then msg (if any) as packet_id, and wait for every
+// PUBACK: the order of service_mqtt_client()
+static bool client_publish(mqtt_session_t *session, mqtt_inflight_t *inflight, mqtt_msg_t *msg, uint16_t packet_id,
+                           connect_result_t *result) {
+    link_t l;
+    int fd;
+    bool ok = client_open(session, 0, result, &l, &fd);
+    uint8_t packet[256];
+    if (ok) {
+        mqtt_inflight_connack(inflight, result->session_present);
+        mqtt_inflight_entry_t *e;
+        while (ok && (e = mqtt_inflight_next_resend(inflight)) != NULL) {
+            ok = link_write(&l, packet, mqtt_encode_publish(packet, sizeof(packet), e->msg->topic, e->msg->payload,
+                                                            e->msg->len, e->msg->qos, e->msg->retain, e->dup,
+                                                            e->packet_id));
+            mqtt_inflight_resent(inflight, e, 0);
+        }
+    }
+    if (ok && msg != NULL) {
+        ok = link_write(&l, packet, mqtt_encode_publish(packet, sizeof(packet), msg->topic, msg->payload, msg->len,
+                                                        msg->qos, msg->retain, false, packet_id)) &&
+             mqtt_inflight_add(inflight, msg, packet_id, 0);
+    }
+    while (ok && inflight->count > 0) {
+        mqtt_packet_t pkt;
+        uint16_t id;
+        ok = link_read_packet(&l, &pkt) && pkt.type == MQTT_PKT_PUBACK && mqtt_decode_ack(&pkt, &id, NULL) &&
+             mqtt_inflight_puback(inflight, id) && mqtt_inflight_take(inflight) != NULL;
+    }
+    if (!ok) {
+        mqtt_inflight_link_down(inflight);
+    }
+    client_close(&l, fd, ok);
+    return ok;
+}
+
+// One connection against the stand-in
+static void run_connect(mqtt_session_t *session, uint32_t now_ms, connect_result_t *result) {
+    pthread_t thread;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, broker_serve_one, NULL));
+    bool ok = client_connect(session, now_ms, result);
+    pthread_join(thread, NULL);
+    TEST_ASSERT_TRUE_MESSAGE(ok, "MQTT over TLS connect failed");
+}
+
+// One publishing connection against the stand-in
+static bool run_publish(mqtt_session_t *session, mqtt_inflight_t *inflight, mqtt_msg_t *msg, uint16_t packet_id,
+                        connect_result_t *result) {
+    pthread_t thread;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, broker_serve_one, NULL));
+    bool ok = client_publish(session, inflight, msg, packet_id, result);
+    pthread_join(thread, NULL);
+    return ok;
+}
+
+// ---------------------------------------------------------------------------------------------------------------
+
+static mqtt_session_t session;
+
+void setUp(void) {
+    client_ctx = SSL_CTX_new(TLS_client_method());
+    SSL_CTX_set_max_proto_version(client_ctx, TLS1_2_VERSION);
+    SSL_CTX_set_verify(client_ctx, SSL_VERIFY_PEER, client_verify_cb);
+    X509_STORE_add_cert(SSL_CTX_get_cert_store(client_ctx), server_cert);
+    mqtt_session_init(&session, NULL, 3600000u, 0, 0);
+}
+
+void tearDown(void) {
+    SSL_CTX_free(client_ctx);
+}
+
+void test_first_connect_full_handshake_and_subscribe(void) {
+    broker_start(true);
+    connect_result_t r;
+    run_connect(&session, 0, &r);
+    TEST_ASSERT_FALSE(r.resumed);
+    TEST_ASSERT_FALSE(r.session_present);
+    TEST_ASSERT_TRUE(r.subscribed);
+    TEST_ASSERT_EQUAL_INT(1, broker.subscribes);
+    TEST_ASSERT_EQUAL_UINT32(1, session.stats.full_handshakes);
+    broker_stop();
+}
+
+void test_reconnect_resumes_ticket_and_skips_subscribe(void) {
+    broker_start(true);
+    connect_result_t r;
+    run_connect(&session, 0, &r);
+    for (uint32_t i = 1; i <= 3; i++) {
+        run_connect(&session, i * 1000, &r);
+        TEST_ASSERT_TRUE(r.resumed);
+        TEST_ASSERT_TRUE(r.session_present);
+        TEST_ASSERT_FALSE(r.subscribed);
+    }
+    TEST_ASSERT_EQUAL_INT(4, broker.connections);
+    TEST_ASSERT_EQUAL_INT(1, broker.subscribes);
+    TEST_ASSERT_EQUAL_UINT32(1, session.stats.full_handshakes);
+    TEST_ASSERT_EQUAL_UINT32(3, session.stats.resumed_handshakes);
+    TEST_ASSERT_EQUAL_UINT32(3, session.stats.session_present);
+    TEST_ASSERT_EQUAL_UINT32(1, session.stats.resubscribes);
+    broker_stop();
+}
+
+void test_reconnect_resumes_session_id(void) {
+    broker_start(false);
+    connect_result_t r;
+    run_connect(&session, 0, &r);
+    run_connect(&session, 1000, &r);
+    TEST_ASSERT_TRUE(r.resumed);
+    TEST_ASSERT_FALSE(r.subscribed);
+    TEST_ASSERT_EQUAL_INT(1, broker.subscribes);
+    broker_stop();
+}
+
+void test_server_forgets_tls_session(void) {
+    broker_start(true);
+    connect_result_t r;
+    run_connect(&session, 0, &r);
+
+    // New ticket keys and empty cache: full handshake, MQTT session still there
+    SSL_CTX_free(broker.ctx);
+    broker.ctx = broker_new_ctx(true);
+    run_connect(&session, 1000, &r);
+    TEST_ASSERT_FALSE(r.resumed);
+    TEST_ASSERT_TRUE(r.session_present);
+    TEST_ASSERT_FALSE(r.subscribed);
+    TEST_ASSERT_EQUAL_UINT32(1, session.stats.resume_rejected);
+
+    // The new session is cached and resumes
+    run_connect(&session, 2000, &r);
+    TEST_ASSERT_TRUE(r.resumed);
+    broker_stop();
+}
+
+void test_broker_lost_mqtt_session_resubscribes(void) {
+    broker_start(true);
+    connect_result_t r;
+    run_connect(&session, 0, &r);
+
+    broker.has_session = false;
+    run_connect(&session, 1000, &r);
+    TEST_ASSERT_TRUE(r.resumed);
+    TEST_ASSERT_FALSE(r.session_present);
+    TEST_ASSERT_TRUE(r.subscribed);
+    TEST_ASSERT_EQUAL_INT(2, broker.subscribes);
+    broker_stop();
+}
+
+// Store kept in RAM across a simulated reboot
+static uint8_t stored[MQTT_TLS_SESSION_MAX];
+static size_t stored_len;
+
+static size_t store_load(void *ctx, uint8_t *buf, size_t size) {
+    (void)ctx;
+    if (stored_len > size) {
+        return 0;
+    }
+    memcpy(buf, stored, stored_len);
+    return stored_len;
+}
+
+static bool store_save(void *ctx, const uint8_t *data, size_t len) {
+    (void)ctx;
+    memcpy(stored, data, len);
+    stored_len = len;
+    return true;
+}
+
+static void store_erase(void *ctx) {
+    (void)ctx;
+    stored_len = 0;
+}
+
+void test_stored_session_resumes_after_reboot(void) {
+    static const mqtt_session_store_t store = { store_load, store_save, store_erase, NULL };
+    stored_len = 0;
+    broker_start(true);
+    connect_result_t r;
+    mqtt_session_init(&session, &store, 3600000u, 0, 0);
+    run_connect(&session, 0, &r);
+    mqtt_session_flush(&session, 0);
+    TEST_ASSERT_TRUE(stored_len > 0);
+
+    // Reboot: TLS resumes from the store; subscriptions are sent again since their state is RAM only
+    mqtt_session_init(&session, &store, 3600000u, 0, 0);
+    run_connect(&session, 0, &r);
+    TEST_ASSERT_TRUE(r.resumed);
+    TEST_ASSERT_TRUE(r.session_present);
+    broker_stop();
+}
+
+static mqtt_msg_t alert = { .topic = ALERT_TOPIC, .payload = "{\"pm2_5\":180}", .len = 13, .qos = 1 };
+
+void test_publish_cut_off_before_puback_is_resent_as_duplicate(void) {
+    broker_start(true);
+    connect_result_t r;
+    mqtt_inflight_t inflight;
+    mqtt_inflight_init(&inflight);
+
+    broker.drop_publishes = 1;
+    TEST_ASSERT_FALSE(run_publish(&session, &inflight, &alert, 7, &r));
+    TEST_ASSERT_EQUAL_INT(1, broker.publishes);
+    TEST_ASSERT_FALSE(broker.last_publish.dup);
+    TEST_ASSERT_EQUAL_UINT8(1, inflight.count);
+    TEST_ASSERT_NOT_NULL(mqtt_inflight_next_resend(&inflight));
+
+    // Session present: the same packet id again, flagged as a duplicate, and acknowledged this time
+    TEST_ASSERT_TRUE(run_publish(&session, &inflight, NULL, 0, &r));
+    TEST_ASSERT_TRUE(r.session_present);
+    TEST_ASSERT_EQUAL_INT(2, broker.publishes);
+    TEST_ASSERT_TRUE(broker.last_publish.dup);
+    TEST_ASSERT_EQUAL_UINT16(7, broker.last_publish.packet_id);
+    TEST_ASSERT_EQUAL_INT(13, (int)broker.last_publish.payload_len);
+    TEST_ASSERT_EQUAL_UINT8(0, inflight.count);
+    TEST_ASSERT_EQUAL_UINT32(1, inflight.stats.resent);
+    TEST_ASSERT_EQUAL_UINT32(1, inflight.stats.completed);
+    broker_stop();
+}
+
+void test_publish_cut_off_is_resent_as_new_without_session(void) {
+    broker_start(true);
+    connect_result_t r;
+    mqtt_inflight_t inflight;
+    mqtt_inflight_init(&inflight);
+
+    broker.drop_publishes = 1;
+    TEST_ASSERT_FALSE(run_publish(&session, &inflight, &alert, 9, &r));
+
+    // The broker lost our session with the id: the publish is new to it
+    broker.has_session = false;
+    TEST_ASSERT_TRUE(run_publish(&session, &inflight, NULL, 0, &r));
+    TEST_ASSERT_FALSE(r.session_present);
+    TEST_ASSERT_EQUAL_INT(2, broker.publishes);
+    TEST_ASSERT_FALSE(broker.last_publish.dup);
+    TEST_ASSERT_EQUAL_UINT8(0, inflight.count);
+    broker_stop();
+}
+
+int main(void) {
+    make_certificate();
+    UNITY_BEGIN();
+    RUN_TEST(test_first_connect_full_handshake_and_subscribe);
+    RUN_TEST(test_reconnect_resumes_ticket_and_skips_subscribe);
+    RUN_TEST(test_reconnect_resumes_session_id);
+    RUN_TEST(test_server_forgets_tls_session);
+    RUN_TEST(test_broker_lost_mqtt_session_resubscribes);
+    RUN_TEST(test_stored_session_resumes_after_reboot);
+    RUN_TEST(test_publish_cut_off_before_puback_is_resent_as_duplicate);
+    RUN_TEST(test_publish_cut_off_is_resent_as_new_without_session);
+    int failures = UNITY_END();
+    X509_free(server_cert);
+    EVP_PKEY_free(server_key);
+    return failures;
+}
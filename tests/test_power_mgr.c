@@ -0,0 +1,164 @@
+/**
+ * File: test_power_mgr.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the power manager on the fake power backend
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "power_mgr.h"
+#include "power_hal_mock.h"
+
+#define RX_HOLD_MS  POWER_MGR_DEFAULT_RX_HOLD_MS
+
+static int wake_calls;
+static int rx_wake_calls;
+static uint32_t last_wake_ms;
+
+static void on_wake(power_wake_t cause, void *ctx) {
+    (void)ctx;
+    wake_calls++;
+    if (cause == POWER_WAKE_UART_RX) {
+        rx_wake_calls++;
+    }
+    last_wake_ms = power_mock_now_ms();
+}
+
+void setUp(void) {
+    power_mock_reset();
+    TEST_ASSERT_TRUE(power_mgr_init(NULL, power_get_mock_hal()));
+    TEST_ASSERT_TRUE(power_mgr_add_listener(on_wake, NULL));
+    wake_calls = 0;
+    rx_wake_calls = 0;
+    last_wake_ms = 0;
+}
+
+void tearDown(void) {
+}
+
+void test_long_wait_is_one_deep_sleep(void) {
+    power_mgr_wait_until(1000);
+
+    TEST_ASSERT_EQUAL_UINT32(1000, power_mock_now_ms());
+    TEST_ASSERT_EQUAL_INT(1, power_mock_sleeps());
+    TEST_ASSERT_EQUAL_INT(0, power_mock_idles());
+    TEST_ASSERT_EQUAL_INT(1, wake_calls);
+
+    power_mgr_stats_t stats;
+    power_mgr_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT64(1000, stats.residency_ms[POWER_STATE_SLEEP]);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.timer_wakes);
+    TEST_ASSERT_EQUAL_UINT16(1000, stats.sleep_permille);
+}
+
+void test_short_wait_stays_idle(void) {
+    power_mgr_wait_until(POWER_MGR_DEFAULT_MIN_SLEEP_MS - 1);
+
+    TEST_ASSERT_EQUAL_INT(0, power_mock_sleeps());
+    TEST_ASSERT_EQUAL_INT(1, power_mock_idles());
+    TEST_ASSERT_EQUAL_INT(0, wake_calls);
+
+    power_mgr_stats_t stats;
+    power_mgr_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.short_waits);
+    TEST_ASSERT_EQUAL_UINT64(POWER_MGR_DEFAULT_MIN_SLEEP_MS - 1, stats.residency_ms[POWER_STATE_IDLE]);
+}
+
+void test_past_deadline_returns_at_once(void) {
+    power_mock_advance_ms(500);
+    power_mgr_wait_until(400);
+    power_mgr_wait_until(500);
+
+    TEST_ASSERT_EQUAL_UINT32(500, power_mock_now_ms());
+    TEST_ASSERT_EQUAL_INT(0, power_mock_sleeps());
+    TEST_ASSERT_EQUAL_INT(0, power_mock_idles());
+}
+
+void test_rx_edge_holds_for_frame_then_sleeps_again(void) {
+    power_mgr_set_rx_wake(true);
+    power_mock_add_rx_edge(300);
+    power_mock_add_rx_edge(700);
+
+    power_mgr_wait_until(1000);
+
+    TEST_ASSERT_EQUAL_UINT32(1000, power_mock_now_ms());
+    TEST_ASSERT_TRUE(power_mock_last_rx_wake());
+    // Sleep to each edge, idle through the frame, sleep on to the deadline
+    TEST_ASSERT_EQUAL_INT(3, power_mock_sleeps());
+    TEST_ASSERT_EQUAL_INT(2, power_mock_idles());
+    TEST_ASSERT_EQUAL_INT(2, rx_wake_calls);
+    TEST_ASSERT_EQUAL_INT(3, wake_calls);
+
+    power_mgr_stats_t stats;
+    power_mgr_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.rx_wakes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.timer_wakes);
+    TEST_ASSERT_EQUAL_UINT64(2 * RX_HOLD_MS, stats.residency_ms[POWER_STATE_IDLE]);
+    TEST_ASSERT_EQUAL_UINT64(1000 - 2 * RX_HOLD_MS, stats.residency_ms[POWER_STATE_SLEEP]);
+}
+
+void test_listeners_run_after_the_frame_is_in(void) {
+    power_mgr_set_rx_wake(true);
+    power_mock_add_rx_edge(300);
+    power_mgr_wait_until(320);
+
+    // Hold cut short by the deadline; the listener (parser resync) runs after it
+    TEST_ASSERT_EQUAL_INT(1, rx_wake_calls);
+    TEST_ASSERT_EQUAL_UINT32(320, last_wake_ms);
+}
+
+void test_rx_wake_disarmed_while_sensors_parked(void) {
+    power_mock_add_rx_edge(300);
+    power_mgr_wait_until(1000);
+
+    TEST_ASSERT_FALSE(power_mock_last_rx_wake());
+    TEST_ASSERT_EQUAL_INT(1, power_mock_sleeps());
+    TEST_ASSERT_EQUAL_INT(0, rx_wake_calls);
+}
+
+void test_residency_adds_up(void) {
+    // 1 s sample loop: 60 ms of work, then a wait for the rest of the second
+    for (uint32_t s = 1; s <= 100; s++) {
+        power_mock_advance_ms(60);
+        power_mgr_wait_until(s * 1000u);
+    }
+    power_mock_advance_ms(60);
+
+    power_mgr_stats_t stats;
+    power_mgr_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT64(101 * 60, stats.residency_ms[POWER_STATE_RUN]);
+    TEST_ASSERT_EQUAL_UINT64(100 * 940, stats.residency_ms[POWER_STATE_SLEEP]);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.residency_ms[POWER_STATE_IDLE]);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.sleeps);
+    TEST_ASSERT_EQUAL_UINT16(939, stats.sleep_permille);
+}
+
+void test_uninitialized_calls_are_harmless(void) {
+    TEST_ASSERT_FALSE(power_mgr_init(NULL, NULL));
+    power_mgr_wait_until(1000);
+    TEST_ASSERT_EQUAL_INT(0, power_mock_sleeps());
+
+    power_mgr_stats_t stats;
+    power_mgr_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.sleeps);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.sleep_permille);
+    TEST_ASSERT_FALSE(power_mgr_add_listener(NULL, NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_long_wait_is_one_deep_sleep);
+    RUN_TEST(test_short_wait_stays_idle);
+    RUN_TEST(test_past_deadline_returns_at_once);
+    RUN_TEST(test_rx_edge_holds_for_frame_then_sleeps_again);
+    RUN_TEST(test_listeners_run_after_the_frame_is_in);
+    RUN_TEST(test_rx_wake_disarmed_while_sensors_parked);
+    RUN_TEST(test_residency_adds_up);
+    RUN_TEST(test_uninitialized_calls_are_harmless);
+    return UNITY_END();
+}
@@ -0,0 +1,248 @@
+/**
+ * File: test_radio_sched.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the radio power-save scheduler on the fake radio backend
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "radio_sched.h"
+#include "radio_hal_mock.h"
+#include <string.h>
+
+#define INTERVAL_MS     30000u
+#define WINDOW_MAX_MS   5000u
+#define LINGER_MS       500u
+#define KEEP_ALIVE_MS   120000u
+#define SERVICE_MS      100u    // Client service period
+
+// Client as seen by the scheduler: queued messages, unacknowledged packets, packet times
+typedef struct {
+    int queued;
+    int in_flight;
+    int sent;
+    int pings;
+    uint32_t last_tx_ms;
+    uint32_t last_rx_ms;
+    uint32_t max_rx_gap_ms;
+    bool connected_stalled;     // Acks never arrive
+} sim_client_t;
+
+static radio_sched_t sched;
+static sim_client_t client;
+
+static void init_sched(uint32_t interval_ms) {
+    radio_sched_config_t config = {
+        .interval_ms = interval_ms,
+        .window_max_ms = WINDOW_MAX_MS,
+        .linger_ms = LINGER_MS,
+        .keep_alive_ms = KEEP_ALIVE_MS
+    };
+    radio_sched_init(&sched, &config, radio_get_mock_hal());
+}
+
+// One service call of the client
+static void service(bool urgent) {
+    uint32_t now = radio_mock_now_ms();
+    if (!radio_sched_poll(&sched, client.queued > 0 || client.in_flight > 0, urgent)) {
+        return;
+    }
+    // Acks of packets sent on the previous call
+    if (client.in_flight > 0 && !client.connected_stalled) {
+        client.in_flight = 0;
+        if (now - client.last_rx_ms > client.max_rx_gap_ms) {
+            client.max_rx_gap_ms = now - client.last_rx_ms;
+        }
+        client.last_rx_ms = now;
+    }
+    if (client.queued > 0) {
+        client.sent += client.queued;
+        client.in_flight += client.queued;
+        client.queued = 0;
+        client.last_tx_ms = now;
+    }
+    if (radio_sched_ping_due(&sched, client.last_tx_ms, client.last_rx_ms)) {
+        client.pings++;
+        client.in_flight++;
+        client.last_tx_ms = now;
+    }
+}
+
+// Run the service loop; publish one message every event_ms (0: none)
+static void run(uint32_t duration_ms, uint32_t event_ms) {
+    for (uint32_t t = 0; t < duration_ms; t += SERVICE_MS) {
+        if (event_ms != 0 && t % event_ms == 0 && t != 0) {
+            client.queued++;
+        }
+        service(false);
+        radio_mock_advance_ms(SERVICE_MS);
+    }
+}
+
+void setUp(void) {
+    radio_mock_reset();
+    memset(&client, 0, sizeof(client));
+    init_sched(INTERVAL_MS);
+}
+
+void tearDown(void) {}
+
+void test_starts_active_and_sleeps_when_idle(void) {
+    TEST_ASSERT_EQUAL(RADIO_PM_ACTIVE, radio_mock_mode());
+    run(LINGER_MS + SERVICE_MS, 0);
+    TEST_ASSERT_EQUAL(RADIO_PM_POWERSAVE, radio_mock_mode());
+    TEST_ASSERT_EQUAL_UINT32(1, sched.stats.windows);
+}
+
+void test_events_are_batched_into_windows(void) {
+    // One message every 5 s for 5 minutes: 60 events, 10 windows
+    run(300000, 5000);
+    TEST_ASSERT_EQUAL_INT(59, client.sent + client.queued);
+    TEST_ASSERT_EQUAL_UINT32(10, sched.stats.windows);
+    TEST_ASSERT_EQUAL_INT(10, radio_mock_wakeups());
+    // Every window flushed the whole batch
+    TEST_ASSERT_TRUE(client.queued <= 6);
+    TEST_ASSERT_EQUAL_UINT32(0, sched.stats.expired_windows);
+}
+
+void test_urgent_opens_window_without_shifting_cadence(void) {
+    run(10000, 0);
+    TEST_ASSERT_EQUAL(RADIO_PM_POWERSAVE, radio_mock_mode());
+
+    client.queued = 1;
+    service(true);
+    TEST_ASSERT_EQUAL(RADIO_PM_ACTIVE, radio_mock_mode());
+    TEST_ASSERT_EQUAL_UINT32(1, sched.stats.urgent_windows);
+    TEST_ASSERT_EQUAL_INT(1, client.sent);
+
+    // Regular window still opens at 30 s
+    run(INTERVAL_MS - 10000 - SERVICE_MS, 0);
+    TEST_ASSERT_EQUAL(RADIO_PM_POWERSAVE, radio_mock_mode());
+    radio_mock_advance_ms(SERVICE_MS);
+    service(false);
+    TEST_ASSERT_EQUAL(RADIO_PM_ACTIVE, radio_mock_mode());
+    TEST_ASSERT_EQUAL_UINT32(3, sched.stats.windows);
+}
+
+void test_next_window_lets_caller_sleep_between_windows(void) {
+    uint32_t at = 0;
+    TEST_ASSERT_FALSE(radio_sched_next_window(&sched, &at));
+
+    run(LINGER_MS + SERVICE_MS, 0);
+    TEST_ASSERT_TRUE(radio_sched_next_window(&sched, &at));
+    TEST_ASSERT_EQUAL_UINT32(INTERVAL_MS, at);
+
+    // Sleeping straight to that time opens the window on the first poll
+    radio_mock_advance_ms(at - radio_mock_now_ms());
+    service(false);
+    TEST_ASSERT_EQUAL(RADIO_PM_ACTIVE, radio_mock_mode());
+    TEST_ASSERT_FALSE(radio_sched_next_window(&sched, &at));
+
+    // Without windows the caller always keeps polling
+    init_sched(0);
+    TEST_ASSERT_FALSE(radio_sched_next_window(&sched, &at));
+}
+
+void test_window_expires_with_traffic_pending(void) {
+    client.connected_stalled = true;
+    client.queued = 1;
+    run(WINDOW_MAX_MS + SERVICE_MS, 0);
+    TEST_ASSERT_EQUAL(RADIO_PM_POWERSAVE, radio_mock_mode());
+    TEST_ASSERT_EQUAL_UINT32(1, sched.stats.expired_windows);
+}
+
+void test_keepalive_pings_ride_on_windows(void) {
+    // Idle connection for 20 minutes
+    run(1200000, 0);
+    TEST_ASSERT_EQUAL_UINT32(40, sched.stats.windows);
+    // No extra wake-ups for pings, and the broker never waits longer than the keep-alive
+    TEST_ASSERT_EQUAL_INT(40, radio_mock_wakeups());
+    TEST_ASSERT_TRUE(client.pings > 0);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)client.pings, sched.stats.keepalive_pings);
+    TEST_ASSERT_TRUE(client.max_rx_gap_ms <= KEEP_ALIVE_MS);
+    // Pinging every window would be wasteful: keep-alive 120 s with 30 s windows needs at most one in three
+    TEST_ASSERT_TRUE(client.pings <= 40 / 3 + 1);
+}
+
+void test_traffic_suppresses_pings(void) {
+    run(600000, 10000);
+    TEST_ASSERT_EQUAL_INT(0, client.pings);
+}
+
+void test_duty_cycle_matches_radio(void) {
+    run(600000, 10000);
+    radio_sched_stats_t stats;
+    radio_sched_get_stats(&sched, &stats);
+    TEST_ASSERT_EQUAL_UINT64(600000, stats.active_ms + stats.powersave_ms);
+    TEST_ASSERT_EQUAL_UINT64(radio_mock_active_ms(), stats.active_ms);
+    TEST_ASSERT_EQUAL_UINT16((uint16_t)((stats.active_ms * 1000 + 300000) / 600000), stats.duty_permille);
+    // Each window lasts about one service round plus the linger time
+    TEST_ASSERT_TRUE(stats.duty_permille < 30);
+}
+
+void test_no_windows_keeps_radio_active(void) {
+    radio_mock_reset();
+    init_sched(0);
+    run(300000, 0);
+    TEST_ASSERT_EQUAL(RADIO_PM_ACTIVE, radio_mock_mode());
+    TEST_ASSERT_EQUAL_INT(1, radio_mock_wakeups());     // The one at init
+    TEST_ASSERT_EQUAL_INT(2, client.pings);
+    radio_sched_stats_t stats;
+    radio_sched_get_stats(&sched, &stats);
+    TEST_ASSERT_EQUAL_UINT16(1000, stats.duty_permille);
+}
+
+void test_reconfiguration_takes_effect_without_restart(void) {
+    run(10000, 0);
+    TEST_ASSERT_EQUAL(RADIO_PM_POWERSAVE, radio_mock_mode());
+
+    // A shorter period pulls the pending window forward instead of waiting out the old one
+    radio_sched_config_t config = sched.config;
+    config.interval_ms = 5000;
+    radio_sched_set_config(&sched, &config);
+    uint32_t at = 0;
+    TEST_ASSERT_TRUE(radio_sched_next_window(&sched, &at));
+    TEST_ASSERT_EQUAL_UINT32(15000, at);
+    run(5000 + SERVICE_MS, 0);
+    TEST_ASSERT_EQUAL_UINT32(2, sched.stats.windows);
+
+    // Period 0 keeps the radio on from now on
+    config.interval_ms = 0;
+    radio_sched_set_config(&sched, &config);
+    TEST_ASSERT_EQUAL(RADIO_PM_ACTIVE, radio_mock_mode());
+    run(60000, 0);
+    TEST_ASSERT_EQUAL(RADIO_PM_ACTIVE, radio_mock_mode());
+
+    // And back to windows: the open one closes by the usual rules
+    config.interval_ms = INTERVAL_MS;
+    radio_sched_set_config(&sched, &config);
+    run(LINGER_MS + SERVICE_MS, 0);
+    TEST_ASSERT_EQUAL(RADIO_PM_POWERSAVE, radio_mock_mode());
+}
+
+void test_backend_errors_are_counted(void) {
+    radio_mock_set_fail(true);
+    run(LINGER_MS + SERVICE_MS, 0);
+    TEST_ASSERT_EQUAL_UINT32(1, sched.stats.pm_errors);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_starts_active_and_sleeps_when_idle);
+    RUN_TEST(test_events_are_batched_into_windows);
+    RUN_TEST(test_urgent_opens_window_without_shifting_cadence);
+    RUN_TEST(test_next_window_lets_caller_sleep_between_windows);
+    RUN_TEST(test_window_expires_with_traffic_pending);
+    RUN_TEST(test_keepalive_pings_ride_on_windows);
+    RUN_TEST(test_traffic_suppresses_pings);
+    RUN_TEST(test_duty_cycle_matches_radio);
+    RUN_TEST(test_no_windows_keeps_radio_active);
+    RUN_TEST(test_reconfiguration_takes_effect_without_restart);
+    RUN_TEST(test_backend_errors_are_counted);
+    return UNITY_END();
+}
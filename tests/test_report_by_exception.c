@@ -0,0 +1,183 @@
+/**
+ * File: test_report_by_exception.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for report-by-exception publishing and host-side series reconstruction
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "report_by_exception.h"
+#include <stdlib.h>
+#include <string.h>
+
+static rbe_filter_t filter;
+static rbe_report_t report;
+
+void setUp(void) {
+    rbe_filter_init(&filter, NULL);
+}
+
+void tearDown(void) {}
+
+static pm25_data_t sample(uint16_t pm2_5) {
+    pm25_data_t data;
+    memset(&data, 0, sizeof(data));
+    data.pm2_5_atm = pm2_5;
+    data.pm2_5_cf1 = pm2_5;
+    data.count_0_3 = (uint16_t)(1000u + pm2_5 * 5u);
+    return data;
+}
+
+void test_first_sample_is_reported(void) {
+    pm25_data_t data = sample(10);
+    TEST_ASSERT_TRUE(rbe_filter_check(&filter, &data, 0, &report));
+    TEST_ASSERT_EQUAL_UINT8(RBE_REASON_FIRST, report.reasons);
+    TEST_ASSERT_EQUAL_UINT32(0, report.seq);
+}
+
+void test_deadband_suppresses_small_changes(void) {
+    pm25_data_t data = sample(10);
+    rbe_filter_check(&filter, &data, 0, &report);
+
+    data = sample(12);
+    TEST_ASSERT_FALSE(rbe_filter_check(&filter, &data, 1000, &report));
+
+    data = sample(13);
+    TEST_ASSERT_TRUE(rbe_filter_check(&filter, &data, 2000, &report));
+    TEST_ASSERT_EQUAL_UINT8(RBE_REASON_DEADBAND, report.reasons);
+    TEST_ASSERT_EQUAL_UINT32(1, report.seq);
+}
+
+void test_percentage_deadband_on_large_values(void) {
+    pm25_data_t data = sample(100);
+    rbe_filter_check(&filter, &data, 0, &report);
+
+    // 10 % of 100 is wider than the 2 µg/m³ absolute band
+    TEST_ASSERT_EQUAL_UINT16(10, rbe_deadband(&filter.config, PM25_FIELD_PM2_5_ATM, 100));
+    data = sample(109);
+    TEST_ASSERT_FALSE(rbe_filter_check(&filter, &data, 1000, &report));
+}
+
+void test_heartbeat(void) {
+    pm25_data_t data = sample(10);
+    rbe_filter_check(&filter, &data, 0, &report);
+
+    TEST_ASSERT_FALSE(rbe_filter_check(&filter, &data, RBE_DEFAULT_HEARTBEAT_MS - 1, &report));
+    TEST_ASSERT_TRUE(rbe_filter_check(&filter, &data, RBE_DEFAULT_HEARTBEAT_MS, &report));
+    TEST_ASSERT_EQUAL_UINT8(RBE_REASON_HEARTBEAT, report.reasons);
+}
+
+void test_config_change_keeps_last_report(void) {
+    pm25_data_t data = sample(10);
+    rbe_filter_check(&filter, &data, 0, &report);
+
+    rbe_config_t config = filter.config;
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        config.abs_deadband[f] = (f >= PM25_FIELD_COUNT_0_3) ? 100 : 5;
+        config.pct_deadband_x10[f] = 0;
+    }
+    config.heartbeat_ms = 60000;
+    rbe_filter_set_config(&filter, &config);
+
+    // Compared with the report sent before the change, under the new deadband
+    data = sample(15);
+    TEST_ASSERT_FALSE(rbe_filter_check(&filter, &data, 1000, &report));
+    data = sample(16);
+    TEST_ASSERT_TRUE(rbe_filter_check(&filter, &data, 2000, &report));
+    TEST_ASSERT_EQUAL_UINT32(1, report.seq);
+
+    TEST_ASSERT_TRUE(rbe_filter_check(&filter, &data, 62000, &report));
+    TEST_ASSERT_EQUAL_UINT8(RBE_REASON_HEARTBEAT, report.reasons);
+}
+
+void test_threshold_crossing_with_hysteresis(void) {
+    rbe_config_t config;
+    rbe_default_config(&config);
+    config.abs_deadband[PM25_FIELD_PM2_5_ATM] = 100;
+    config.abs_deadband[PM25_FIELD_PM2_5_CF1] = 100;
+    config.abs_deadband[PM25_FIELD_COUNT_0_3] = 10000;
+    config.pct_deadband_x10[PM25_FIELD_PM2_5_ATM] = 0;
+    rbe_filter_init(&filter, &config);
+
+    pm25_data_t data = sample(34);
+    rbe_filter_check(&filter, &data, 0, &report);
+
+    data = sample(35);
+    TEST_ASSERT_TRUE(rbe_filter_check(&filter, &data, 1000, &report));
+    TEST_ASSERT_EQUAL_UINT8(RBE_REASON_THRESHOLD, report.reasons);
+    TEST_ASSERT_EQUAL_UINT8(1, report.level);
+
+    // Within hysteresis: no flapping
+    data = sample(33);
+    TEST_ASSERT_FALSE(rbe_filter_check(&filter, &data, 2000, &report));
+    data = sample(31);
+    TEST_ASSERT_TRUE(rbe_filter_check(&filter, &data, 3000, &report));
+    TEST_ASSERT_EQUAL_UINT8(0, report.level);
+}
+
+void test_reconstruction_stays_within_bounds(void) {
+    rbe_reconstructor_t rc;
+    rbe_reconstruct_init(&rc, &filter.config);
+
+    uint32_t sent = 0;
+    const uint32_t n = 4 * 3600;
+    srand(42);
+    for (uint32_t t = 0; t < n; t++) {
+        // Stable site with sensor noise, one pollution event in the middle
+        uint16_t pm = (uint16_t)(12 + rand() % 3);
+        if (t > 7000 && t < 7600) {
+            pm = (uint16_t)(60 + (t - 7000) / 10);
+        }
+        pm25_data_t truth = sample(pm);
+        uint32_t now_ms = t * 1000u;
+
+        if (rbe_filter_check(&filter, &truth, now_ms, &report)) {
+            rbe_reconstruct_push(&rc, &report);
+            sent++;
+        }
+
+        pm25_data_t rebuilt;
+        uint16_t bound[PM25_FIELD_COUNT];
+        TEST_ASSERT_TRUE(rbe_reconstruct_at(&rc, now_ms, &rebuilt, bound));
+        for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+            int32_t err = (int32_t)pm25_data_get(&truth, (pm25_field_t)f) - pm25_data_get(&rebuilt, (pm25_field_t)f);
+            TEST_ASSERT_TRUE(abs(err) <= bound[f]);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, rc.lost);
+    // Most samples on a stable site are not published
+    TEST_ASSERT_LESS_THAN(n / 10, sent);
+}
+
+void test_reconstruction_detects_loss(void) {
+    rbe_reconstructor_t rc;
+    rbe_reconstruct_init(&rc, NULL);
+
+    rbe_report_t r = { .seq = 0, .timestamp_ms = 0 };
+    rbe_reconstruct_push(&rc, &r);
+    TEST_ASSERT_FALSE(rbe_reconstruct_at(&rc, RBE_DEFAULT_HEARTBEAT_MS + RBE_DEFAULT_MAX_SAMPLE_MS + 1, NULL, NULL));
+
+    r.seq = 3;
+    r.timestamp_ms = 2 * RBE_DEFAULT_HEARTBEAT_MS;
+    rbe_reconstruct_push(&rc, &r);
+    TEST_ASSERT_EQUAL_UINT32(2, rc.lost);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_sample_is_reported);
+    RUN_TEST(test_deadband_suppresses_small_changes);
+    RUN_TEST(test_percentage_deadband_on_large_values);
+    RUN_TEST(test_heartbeat);
+    RUN_TEST(test_config_change_keeps_last_report);
+    RUN_TEST(test_threshold_crossing_with_hysteresis);
+    RUN_TEST(test_reconstruction_stays_within_bounds);
+    RUN_TEST(test_reconstruction_detects_loss);
+    return UNITY_END();
+}
@@ -0,0 +1,181 @@
+/**
+ * File: test_runtime_config.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for runtime configuration parsing, validation and the versioned store
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "runtime_config.h"
+#include "adaptive_rate.h"
+#include "report_by_exception.h"
+#include "mqtt_config.h"
+#include <stdio.h>
+#include <string.h>
+
+static runtime_config_store_t store;
+
+void setUp(void) {
+    runtime_config_store_init(&store);
+}
+
+void tearDown(void) {}
+
+static runtime_config_result_t parse(const char *text, runtime_config_t *config) {
+    return runtime_config_parse(text, strlen(text), config);
+}
+
+static runtime_config_result_t update(const char *text) {
+    return runtime_config_store_update(&store, text, strlen(text));
+}
+
+void test_defaults_match_modules(void) {
+    runtime_config_t config;
+    runtime_config_default(&config);
+    TEST_ASSERT_EQUAL_UINT32(0, config.version);
+    TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_RATE_DEFAULT_MIN_INTERVAL_MS, config.sample_min_ms);
+    TEST_ASSERT_EQUAL_UINT32(ADAPTIVE_RATE_DEFAULT_MAX_INTERVAL_MS, config.sample_max_ms);
+    TEST_ASSERT_EQUAL_UINT32(RBE_DEFAULT_HEARTBEAT_MS, config.heartbeat_ms);
+    TEST_ASSERT_EQUAL_UINT16(RBE_DEFAULT_DEADBAND_MASS, config.deadband_mass);
+    TEST_ASSERT_EQUAL_UINT32(MQTT_PUBLISH_WINDOW_MS, config.window_ms);
+    TEST_ASSERT_EQUAL_UINT32(MQTT_BULK_RATE_BPS, config.bulk_rate_bps);
+}
+
+void test_full_message_is_parsed(void) {
+    runtime_config_t config;
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_OK,
+                      parse("v=7 rate=2000 slow=60000 hb=300000 db=3 dbn=40 dbp=50 win=10000 winmax=2000 bulk=256",
+                            &config));
+    TEST_ASSERT_EQUAL_UINT32(7, config.version);
+    TEST_ASSERT_EQUAL_UINT32(2000, config.sample_min_ms);
+    TEST_ASSERT_EQUAL_UINT32(60000, config.sample_max_ms);
+    TEST_ASSERT_EQUAL_UINT32(300000, config.heartbeat_ms);
+    TEST_ASSERT_EQUAL_UINT16(3, config.deadband_mass);
+    TEST_ASSERT_EQUAL_UINT16(40, config.deadband_count);
+    TEST_ASSERT_EQUAL_UINT16(50, config.deadband_pct_x10);
+    TEST_ASSERT_EQUAL_UINT32(10000, config.window_ms);
+    TEST_ASSERT_EQUAL_UINT32(2000, config.window_max_ms);
+    TEST_ASSERT_EQUAL_UINT32(256, config.bulk_rate_bps);
+}
+
+void test_omitted_keys_take_defaults(void) {
+    runtime_config_t config;
+    runtime_config_t defaults;
+    runtime_config_default(&defaults);
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_OK, parse("hb=60000,v=2", &config));
+    TEST_ASSERT_EQUAL_UINT32(2, config.version);
+    TEST_ASSERT_EQUAL_UINT32(60000, config.heartbeat_ms);
+    TEST_ASSERT_EQUAL_UINT32(defaults.sample_min_ms, config.sample_min_ms);
+    TEST_ASSERT_EQUAL_UINT32(defaults.window_ms, config.window_ms);
+
+    // Radio always on and unshaped bulk are valid
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_OK, parse("v=3 win=0 bulk=0", &config));
+    TEST_ASSERT_EQUAL_UINT32(0, config.window_ms);
+}
+
+void test_bad_messages_are_rejected_whole(void) {
+    runtime_config_t config;
+    runtime_config_default(&config);
+    config.version = 99;
+
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_NO_VERSION, parse("rate=2000", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_NO_VERSION, parse("v=0", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_SYNTAX, parse("v=1 rate", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_SYNTAX, parse("v=1 rate=2s", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_SYNTAX, parse("v=1 v=2", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_SYNTAX, parse("v=1 hb=12345678901", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_SYNTAX, parse("", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_UNKNOWN_KEY, parse("v=1 speed=3", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_RANGE, parse("v=1 rate=100", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_RANGE, parse("v=1 rate=5000 slow=2000", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_RANGE, parse("v=1 hb=4294967295", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_RANGE, parse("v=1 db=5000", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_RANGE, parse("v=1 win=10000 winmax=20000", &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_RANGE, parse("v=1 bulk=10", &config));
+
+    char too_long[RUNTIME_CONFIG_TEXT_MAX + 8];
+    memset(too_long, ' ', sizeof(too_long));
+    memcpy(too_long, "v=1", 3);
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_SYNTAX, runtime_config_parse(too_long, sizeof(too_long), &config));
+
+    // Nothing was written by any of them
+    TEST_ASSERT_EQUAL_UINT32(99, config.version);
+}
+
+void test_window_period_fits_the_keep_alive(void) {
+    // The client pings only inside windows: one window per keep-alive is the longest period that keeps the session
+    runtime_config_t config;
+    char text[48];
+    snprintf(text, sizeof(text), "v=1 win=%u", MQTT_KEEP_ALIVE_S * 1000u);
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_OK, parse(text, &config));
+    TEST_ASSERT_EQUAL_UINT32(MQTT_KEEP_ALIVE_S * 1000u, config.window_ms);
+    snprintf(text, sizeof(text), "v=1 win=%u", MQTT_KEEP_ALIVE_S * 1000u + 1u);
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_RANGE, parse(text, &config));
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_RANGE, parse("v=1 win=3600000", &config));
+}
+
+void test_store_applies_newer_versions_only(void) {
+    runtime_config_t config;
+    runtime_config_status_t status;
+
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_OK, update("v=5 hb=60000"));
+    TEST_ASSERT_TRUE(runtime_config_store_read(&store, &config, &status));
+    TEST_ASSERT_EQUAL_UINT32(5, config.version);
+    TEST_ASSERT_EQUAL_UINT32(60000, config.heartbeat_ms);
+    TEST_ASSERT_EQUAL_UINT32(1, status.applied);
+
+    // The retained message delivered again on reconnect: accepted, nothing swapped
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_OK, update("v=5 hb=60000"));
+    TEST_ASSERT_TRUE(runtime_config_store_read(&store, &config, &status));
+    TEST_ASSERT_EQUAL_UINT32(2, status.messages);
+    TEST_ASSERT_EQUAL_UINT32(1, status.applied);
+
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_STALE, update("v=4 hb=1000"));
+    TEST_ASSERT_TRUE(runtime_config_store_read(&store, &config, &status));
+    TEST_ASSERT_EQUAL_UINT32(5, config.version);
+    TEST_ASSERT_EQUAL_UINT32(60000, config.heartbeat_ms);
+    TEST_ASSERT_EQUAL_UINT32(4, status.received);
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_STALE, status.result);
+}
+
+void test_store_keeps_active_config_on_error(void) {
+    runtime_config_t config;
+    runtime_config_status_t status;
+    update("v=2 rate=2000");
+
+    TEST_ASSERT_EQUAL(RUNTIME_CONFIG_RANGE, update("v=3 rate=10"));
+    TEST_ASSERT_TRUE(runtime_config_store_read(&store, &config, &status));
+    TEST_ASSERT_EQUAL_UINT32(2, config.version);
+    TEST_ASSERT_EQUAL_UINT32(2000, config.sample_min_ms);
+    // The status names the rejected version, so the backend can tell which push failed
+    TEST_ASSERT_EQUAL_UINT32(3, status.received);
+    TEST_ASSERT_EQUAL_STRING("range", runtime_config_result_name(status.result));
+    TEST_ASSERT_EQUAL_UINT32(2, status.messages);
+    TEST_ASSERT_EQUAL_UINT32(1, status.applied);
+}
+
+void test_store_read_fails_while_writer_is_busy(void) {
+    // Writer interrupted half-way: the odd count must not yield a torn copy
+    atomic_store(&store.seq, 1u);
+    TEST_ASSERT_FALSE(runtime_config_store_read(&store, NULL, NULL));
+    atomic_store(&store.seq, 2u);
+    TEST_ASSERT_TRUE(runtime_config_store_read(&store, NULL, NULL));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_defaults_match_modules);
+    RUN_TEST(test_full_message_is_parsed);
+    RUN_TEST(test_omitted_keys_take_defaults);
+    RUN_TEST(test_bad_messages_are_rejected_whole);
+    RUN_TEST(test_window_period_fits_the_keep_alive);
+    RUN_TEST(test_store_applies_newer_versions_only);
+    RUN_TEST(test_store_keeps_active_config_on_error);
+    RUN_TEST(test_store_read_fails_while_writer_is_busy);
+    return UNITY_END();
+}
@@ -0,0 +1,330 @@
+/**
+ * File: test_sample_archive.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the compressed on-flash sample archive and its host decoder
+ *
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "sample_archive.h"
+#include "archive_flash_mock.h"
+#include <string.h>
+
+#define REGION_SIZE     (16u * 1024u)   // 4 sectors, 64 blocks
+#define REGION_BLOCKS   (REGION_SIZE / ARCHIVE_PAGE_SIZE)
+
+static sample_archive_t archive;
+static archive_record_t decoded[256];
+
+// Simulated PMS7003 output: mass values that drift slowly, particle counts that move on most frames
+static void pms_sample(uint32_t i, pm25_data_t *d) {
+    uint32_t noise = (i * 2654435761u) >> 28;     // 0..15
+    uint16_t pm = (uint16_t)(12 + (i / 20) % 8);
+    d->pm1_0_cf1 = (uint16_t)(pm - 4);
+    d->pm2_5_cf1 = pm;
+    d->pm10_cf1 = (uint16_t)(pm + 3);
+    d->pm1_0_atm = (uint16_t)(pm - 4);
+    d->pm2_5_atm = pm;
+    d->pm10_atm = (uint16_t)(pm + 3);
+    d->count_0_3 = (uint16_t)(2100 + pm * 10 + noise);
+    d->count_0_5 = (uint16_t)(620 + pm * 3 + noise / 2);
+    d->count_1_0 = (uint16_t)(110 + pm + noise / 4);
+    d->count_2_5 = (uint16_t)(12 + noise / 8);
+    d->count_5_0 = 3;
+    d->count_10 = 1;
+}
+
+static void assert_data_equal(const pm25_data_t *expected, const pm25_data_t *actual) {
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        TEST_ASSERT_EQUAL_UINT16(pm25_data_get(expected, (pm25_field_t)f), pm25_data_get(actual, (pm25_field_t)f));
+    }
+}
+
+static int read_and_decode(uint32_t seq, archive_header_t *header) {
+    uint8_t block[ARCHIVE_BLOCK_SIZE];
+    TEST_ASSERT_TRUE(sample_archive_read_block(&archive, seq, block));
+    return archive_decode_block(block, sizeof(block), header, decoded, 256);
+}
+
+// Decode every stored block of a sensor, in order; returns the number of records
+static int decode_source(uint8_t source, archive_record_t *out, int max) {
+    int total = 0;
+    for (uint32_t seq = archive.oldest_seq; seq < archive.next_seq; seq++) {
+        uint8_t block[ARCHIVE_BLOCK_SIZE];
+        archive_header_t h;
+        TEST_ASSERT_TRUE(sample_archive_read_block(&archive, seq, block));
+        TEST_ASSERT_TRUE(archive_parse_header(block, sizeof(block), &h));
+        if (h.source != source) {
+            continue;
+        }
+        int n = archive_decode_block(block, sizeof(block), NULL, out + total, max - total);
+        TEST_ASSERT_TRUE(n > 0);
+        total += n;
+    }
+    return total;
+}
+
+void setUp(void) {
+    archive_mock_reset(REGION_SIZE);
+    TEST_ASSERT_TRUE(sample_archive_init(&archive, archive_get_mock_flash()));
+}
+
+void tearDown(void) {
+}
+
+void test_round_trip_through_flash(void) {
+    pm25_data_t d;
+    for (uint32_t i = 0; i < 100; i++) {
+        pms_sample(i, &d);
+        TEST_ASSERT_TRUE(sample_archive_append(&archive, 0, 5000 + i * 1000, &d));
+    }
+    TEST_ASSERT_TRUE(archive.next_seq > 0);
+    TEST_ASSERT_TRUE(archive.writers[0].count > 0);
+    TEST_ASSERT_TRUE(sample_archive_flush(&archive));
+    TEST_ASSERT_EQUAL_UINT8(0, archive.writers[0].count);
+
+    archive_header_t h;
+    TEST_ASSERT_TRUE(read_and_decode(0, &h) > 0);
+    TEST_ASSERT_EQUAL_UINT8(0, h.source);
+    TEST_ASSERT_EQUAL_UINT32(0, h.seq);
+    TEST_ASSERT_EQUAL_UINT32(5000, h.first_ms);
+
+    static archive_record_t all[100];
+    TEST_ASSERT_EQUAL_INT(100, decode_source(0, all, 100));
+    for (uint32_t i = 0; i < 100; i++) {
+        pms_sample(i, &d);
+        TEST_ASSERT_EQUAL_UINT32(5000 + i * 1000, all[i].ts_ms);
+        assert_data_equal(&d, &all[i].data);
+    }
+}
+
+void test_regular_cadence_costs_two_bytes_per_unchanged_record(void) {
+    pm25_data_t d;
+    memset(&d, 0, sizeof(d));
+    // 1 s cadence and clean air: the first record is an empty change mask, the second sets the interval (two varint
+    // bytes) and every later one is a zero delta-of-delta and an empty mask, so 118 records take 1 + 3 + 2 * 116 bytes
+    for (uint32_t i = 0; i < 119; i++) {
+        sample_archive_append(&archive, 0, i * 1000, &d);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, archive.next_seq);
+
+    archive_header_t h;
+    TEST_ASSERT_EQUAL_INT(118, read_and_decode(0, &h));
+    TEST_ASSERT_EQUAL_UINT8(1 + 3 + 2 * 116, h.len);
+    TEST_ASSERT_EQUAL_UINT32(117 * 1000, decoded[117].ts_ms);
+
+    // Record 119 opened the next block, starting from zero again
+    TEST_ASSERT_EQUAL_UINT8(1, archive.writers[0].count);
+    TEST_ASSERT_EQUAL_UINT32(118 * 1000, archive.writers[0].first_ms);
+}
+
+void test_jittered_and_adaptive_timestamps_round_trip(void) {
+    pm25_data_t d;
+    pms_sample(0, &d);
+    uint32_t ts[120];
+    uint32_t t = 1000;
+    for (uint32_t i = 0; i < 120; i++) {
+        // Jitter of a few ms, and the adaptive interval stepping from 1 s up to 120 s
+        uint32_t interval = (i < 40) ? 1000 : (i < 80) ? 30000 : 120000;
+        t += interval + (i * 7) % 5 - 2;
+        ts[i] = t;
+        sample_archive_append(&archive, 0, t, &d);
+    }
+    sample_archive_flush(&archive);
+
+    TEST_ASSERT_EQUAL_INT(120, decode_source(0, decoded, 256));
+    for (int i = 0; i < 120; i++) {
+        TEST_ASSERT_EQUAL_UINT32(ts[i], decoded[i].ts_ms);
+    }
+}
+
+void test_pms_series_compresses_at_least_two_to_one(void) {
+    archive_mock_reset(ARCHIVE_MOCK_MAX_SIZE);
+    TEST_ASSERT_TRUE(sample_archive_init(&archive, archive_get_mock_flash()));
+
+    pm25_data_t d;
+    for (uint32_t i = 0; i < 2000; i++) {
+        pms_sample(i, &d);
+        sample_archive_append(&archive, 0, i * 1000 + (i % 3), &d);
+    }
+    sample_archive_flush(&archive);
+
+    archive_stats_t stats;
+    sample_archive_get_stats(&archive, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2000, stats.records);
+    TEST_ASSERT_EQUAL_UINT32(archive.next_seq, stats.blocks);
+    TEST_ASSERT_EQUAL_UINT32(0, archive.oldest_seq);
+    TEST_ASSERT_TRUE(stats.raw_bytes == 2000 * (sizeof(uint32_t) + sizeof(pm25_data_t)));
+    TEST_ASSERT_TRUE(stats.raw_bytes >= 2 * stats.encoded_bytes);
+
+    // Every block decodes on its own
+    static archive_record_t all[2000];
+    TEST_ASSERT_EQUAL_INT(2000, decode_source(0, all, 2000));
+    pms_sample(1999, &d);
+    assert_data_equal(&d, &all[1999].data);
+}
+
+void test_ring_erases_the_oldest_sector(void) {
+    pm25_data_t d;
+    pms_sample(0, &d);
+    for (uint32_t i = 0; i < REGION_BLOCKS + 16; i++) {
+        sample_archive_append(&archive, 0, i, &d);
+        sample_archive_flush(&archive);
+    }
+    TEST_ASSERT_EQUAL_UINT32(REGION_BLOCKS + 16, archive.next_seq);
+    TEST_ASSERT_EQUAL_UINT32(16, archive.oldest_seq);
+    TEST_ASSERT_EQUAL_INT(5, archive_mock_erases());
+
+    uint8_t block[ARCHIVE_BLOCK_SIZE];
+    TEST_ASSERT_FALSE(sample_archive_read_block(&archive, 15, block));
+    TEST_ASSERT_TRUE(sample_archive_read_block(&archive, 16, block));
+    TEST_ASSERT_TRUE(sample_archive_read_block(&archive, REGION_BLOCKS + 15, block));
+    TEST_ASSERT_FALSE(sample_archive_read_block(&archive, REGION_BLOCKS + 16, block));
+}
+
+void test_mount_recovers_range_and_starts_a_new_boot(void) {
+    pm25_data_t d;
+    pms_sample(0, &d);
+    for (uint32_t i = 0; i < REGION_BLOCKS + 20; i++) {
+        sample_archive_append(&archive, (uint8_t)(i % 2), i, &d);
+        sample_archive_flush(&archive);
+    }
+    uint16_t boot = archive.boot;
+
+    sample_archive_t mounted;
+    TEST_ASSERT_TRUE(sample_archive_init(&mounted, archive_get_mock_flash()));
+    TEST_ASSERT_EQUAL_UINT32(archive.next_seq, mounted.next_seq);
+    TEST_ASSERT_EQUAL_UINT32(archive.oldest_seq, mounted.oldest_seq);
+    TEST_ASSERT_EQUAL_UINT16(boot + 1, mounted.boot);
+
+    // New blocks continue the ring and carry the new boot number
+    sample_archive_append(&mounted, 0, 7, &d);
+    sample_archive_flush(&mounted);
+    archive = mounted;
+    archive_header_t h;
+    TEST_ASSERT_EQUAL_INT(1, read_and_decode(REGION_BLOCKS + 20, &h));
+    TEST_ASSERT_EQUAL_UINT16(boot + 1, h.boot);
+}
+
+void test_torn_write_is_skipped_on_mount(void) {
+    pm25_data_t d;
+    pms_sample(0, &d);
+    for (uint32_t i = 0; i < 3; i++) {
+        sample_archive_append(&archive, 0, i, &d);
+        sample_archive_flush(&archive);
+    }
+    // Reset while block 3 was programmed: only the header made it
+    archive_mock_tear_next(ARCHIVE_HEADER_SIZE);
+    sample_archive_append(&archive, 0, 3, &d);
+    sample_archive_flush(&archive);
+
+    uint8_t block[ARCHIVE_BLOCK_SIZE];
+    TEST_ASSERT_FALSE(sample_archive_read_block(&archive, 3, block));
+
+    sample_archive_t mounted;
+    TEST_ASSERT_TRUE(sample_archive_init(&mounted, archive_get_mock_flash()));
+    TEST_ASSERT_EQUAL_UINT32(0, mounted.oldest_seq);
+    TEST_ASSERT_EQUAL_UINT32(4, mounted.next_seq);
+
+    // A page with garbage but no valid header is not programmed over either
+    archive_mock_image()[4 * ARCHIVE_PAGE_SIZE + 100] = 0x00;
+    TEST_ASSERT_TRUE(sample_archive_init(&mounted, archive_get_mock_flash()));
+    TEST_ASSERT_EQUAL_UINT32(5, mounted.next_seq);
+
+    sample_archive_append(&mounted, 0, 9, &d);
+    TEST_ASSERT_TRUE(sample_archive_flush(&mounted));
+    TEST_ASSERT_TRUE(sample_archive_read_block(&mounted, 5, block));
+}
+
+void test_seek_finds_the_block_of_a_sensor_by_time(void) {
+    pm25_data_t d;
+    pms_sample(0, &d);
+    // Two sensors write blocks in turn, block k of sensor 1 starts at k * 10 s
+    for (uint32_t k = 0; k < 20; k++) {
+        sample_archive_append(&archive, 0, k * 10000 + 1, &d);
+        sample_archive_flush(&archive);
+        sample_archive_append(&archive, 1, k * 10000, &d);
+        sample_archive_append(&archive, 1, k * 10000 + 5000, &d);
+        sample_archive_flush(&archive);
+    }
+    uint16_t boot = archive.boot;
+
+    // Sensor 1 block k has sequence number 2k + 1
+    TEST_ASSERT_EQUAL_UINT32(2 * 7 + 1, sample_archive_seek(&archive, 1, boot, 75000));
+    TEST_ASSERT_EQUAL_UINT32(2 * 7 + 1, sample_archive_seek(&archive, 1, boot, 70000));
+    TEST_ASSERT_EQUAL_UINT32(2 * 19 + 1, sample_archive_seek(&archive, 1, boot, 999999));
+    TEST_ASSERT_EQUAL_UINT32(2 * 7, sample_archive_seek(&archive, 0, boot, 75000));
+
+    // Before everything stored, and an earlier / later boot
+    TEST_ASSERT_EQUAL_UINT32(1, sample_archive_seek(&archive, 1, boot, 0));
+    TEST_ASSERT_EQUAL_UINT32(1, sample_archive_seek(&archive, 1, (uint16_t)(boot - 1), 500000));
+    TEST_ASSERT_EQUAL_UINT32(39, sample_archive_seek(&archive, 1, (uint16_t)(boot + 1), 0));
+
+    TEST_ASSERT_EQUAL_UINT32(ARCHIVE_SEQ_NONE, sample_archive_seek(&archive, 2, boot, 0));
+}
+
+void test_corrupted_blocks_are_rejected(void) {
+    pm25_data_t d;
+    for (uint32_t i = 0; i < 10; i++) {
+        pms_sample(i, &d);
+        sample_archive_append(&archive, 0, i * 1000, &d);
+    }
+    sample_archive_flush(&archive);
+
+    uint8_t block[ARCHIVE_BLOCK_SIZE];
+    TEST_ASSERT_TRUE(sample_archive_read_block(&archive, 0, block));
+    TEST_ASSERT_EQUAL_INT(10, archive_decode_block(block, sizeof(block), NULL, decoded, 256));
+
+    // Truncated on the way, or a flipped payload bit
+    TEST_ASSERT_EQUAL_INT(-1, archive_decode_block(block, ARCHIVE_HEADER_SIZE + 3, NULL, decoded, 256));
+    block[ARCHIVE_HEADER_SIZE + 4] ^= 0x01;
+    TEST_ASSERT_EQUAL_INT(-1, archive_decode_block(block, sizeof(block), NULL, decoded, 256));
+
+    archive_mock_image()[ARCHIVE_HEADER_SIZE + 4] ^= 0x01;
+    TEST_ASSERT_FALSE(sample_archive_read_block(&archive, 0, block));
+
+    // Decoding into a short buffer stops at max
+    archive_mock_image()[ARCHIVE_HEADER_SIZE + 4] ^= 0x01;
+    TEST_ASSERT_TRUE(sample_archive_read_block(&archive, 0, block));
+    TEST_ASSERT_EQUAL_INT(4, archive_decode_block(block, sizeof(block), NULL, decoded, 4));
+}
+
+void test_flash_failures_and_missing_region(void) {
+    pm25_data_t d;
+    pms_sample(0, &d);
+    archive_mock_set_fail(true);
+    sample_archive_append(&archive, 0, 0, &d);
+    TEST_ASSERT_FALSE(sample_archive_flush(&archive));
+    TEST_ASSERT_EQUAL_UINT32(1, archive.stats.errors);
+    TEST_ASSERT_EQUAL_UINT32(0, archive.stats.blocks);
+
+    // No region (program image too large): nothing is accepted
+    archive_mock_reset(0);
+    TEST_ASSERT_FALSE(sample_archive_init(&archive, archive_get_mock_flash()));
+    TEST_ASSERT_FALSE(sample_archive_append(&archive, 0, 0, &d));
+    TEST_ASSERT_FALSE(sample_archive_init(&archive, NULL));
+    TEST_ASSERT_FALSE(sample_archive_init(NULL, archive_get_mock_flash()));
+    TEST_ASSERT_FALSE(sample_archive_append(&archive, ARCHIVE_MAX_SOURCES, 0, &d));
+    TEST_ASSERT_EQUAL_UINT32(ARCHIVE_SEQ_NONE, sample_archive_seek(NULL, 0, 0, 0));
+    TEST_ASSERT_EQUAL_INT(-1, archive_decode_block(NULL, 0, NULL, NULL, 0));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_round_trip_through_flash);
+    RUN_TEST(test_regular_cadence_costs_two_bytes_per_unchanged_record);
+    RUN_TEST(test_jittered_and_adaptive_timestamps_round_trip);
+    RUN_TEST(test_pms_series_compresses_at_least_two_to_one);
+    RUN_TEST(test_ring_erases_the_oldest_sector);
+    RUN_TEST(test_mount_recovers_range_and_starts_a_new_boot);
+    RUN_TEST(test_torn_write_is_skipped_on_mount);
+    RUN_TEST(test_seek_finds_the_block_of_a_sensor_by_time);
+    RUN_TEST(test_corrupted_blocks_are_rejected);
+    RUN_TEST(test_flash_failures_and_missing_region);
+    return UNITY_END();
+}
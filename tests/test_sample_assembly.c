@@ -0,0 +1,124 @@
+/**
+ * File: test_sample_assembly.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for time-aligned joint sample assembly of PMS7003 and SHT3x readings
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "sample_assembly.h"
+#include <string.h>
+
+static sample_assembly_t sa;
+static pm25_data_t pm;
+static joint_sample_t joint;
+
+void setUp(void) {
+    sample_assembly_config_t config = {
+        .align_window_us = 100000,      // 100 ms
+        .max_interp_gap_us = 10000000   // 10 s
+    };
+    sample_assembly_init(&sa, &config);
+    memset(&pm, 0, sizeof(pm));
+    pm.pm2_5_atm = 12;
+}
+
+void tearDown(void) {}
+
+void test_no_env_reading(void) {
+    TEST_ASSERT_FALSE(sample_assembly_join(&sa, 1000, &pm, &joint));
+    TEST_ASSERT_FALSE(joint.has_env);
+    TEST_ASSERT_EQUAL_UINT64(1000, joint.timestamp_us);
+    TEST_ASSERT_EQUAL_UINT16(12, joint.pm.pm2_5_atm);
+}
+
+void test_nearest_inside_window(void) {
+    sample_assembly_add_env(&sa, 1020000, 2500, 4000);
+    TEST_ASSERT_TRUE(sample_assembly_join(&sa, 1000000, &pm, &joint));
+    TEST_ASSERT_FALSE(joint.interpolated);
+    TEST_ASSERT_EQUAL_INT32(2500, joint.temperature);
+    TEST_ASSERT_EQUAL_INT32(4000, joint.humidity);
+    TEST_ASSERT_EQUAL_UINT32(20000, joint.skew_us);
+}
+
+void test_nearest_outside_window(void) {
+    sample_assembly_add_env(&sa, 1000000, 2500, 4000);
+    TEST_ASSERT_FALSE(sample_assembly_join(&sa, 1200000, &pm, &joint));
+    TEST_ASSERT_FALSE(joint.has_env);
+}
+
+void test_interpolates_between_bracketing_readings(void) {
+    sample_assembly_add_env(&sa, 0, 2000, 6000);
+    sample_assembly_add_env(&sa, 4000000, 2400, 5000);
+    TEST_ASSERT_TRUE(sample_assembly_join(&sa, 1000000, &pm, &joint));
+    TEST_ASSERT_TRUE(joint.interpolated);
+    TEST_ASSERT_EQUAL_INT32(2100, joint.temperature);
+    TEST_ASSERT_EQUAL_INT32(5750, joint.humidity);
+    TEST_ASSERT_EQUAL_UINT32(1000000, joint.skew_us);
+}
+
+void test_interpolation_rounds_to_nearest(void) {
+    sample_assembly_add_env(&sa, 0, 0, 0);
+    sample_assembly_add_env(&sa, 3000, 1, -1);
+    sample_assembly_join(&sa, 2000, &pm, &joint);
+    TEST_ASSERT_EQUAL_INT32(1, joint.temperature);
+    TEST_ASSERT_EQUAL_INT32(-1, joint.humidity);
+    sample_assembly_join(&sa, 1000, &pm, &joint);
+    TEST_ASSERT_EQUAL_INT32(0, joint.temperature);
+}
+
+void test_gap_too_long_falls_back_to_nearest(void) {
+    sample_assembly_add_env(&sa, 0, 2000, 6000);
+    sample_assembly_add_env(&sa, 20050000, 2400, 5000);
+    TEST_ASSERT_TRUE(sample_assembly_join(&sa, 20000000, &pm, &joint));
+    TEST_ASSERT_FALSE(joint.interpolated);
+    TEST_ASSERT_EQUAL_INT32(2400, joint.temperature);
+    TEST_ASSERT_EQUAL_UINT32(50000, joint.skew_us);
+}
+
+void test_exact_match_is_not_shifted(void) {
+    sample_assembly_add_env(&sa, 500, 2222, 3333);
+    sample_assembly_add_env(&sa, 900, 9999, 9999);
+    TEST_ASSERT_TRUE(sample_assembly_join(&sa, 500, &pm, &joint));
+    TEST_ASSERT_EQUAL_INT32(2222, joint.temperature);
+    TEST_ASSERT_EQUAL_UINT32(0, joint.skew_us);
+}
+
+void test_history_keeps_latest_readings(void) {
+    for (int i = 0; i < SAMPLE_ASSEMBLY_ENV_HISTORY + 3; i++) {
+        sample_assembly_add_env(&sa, (uint64_t)i * 1000000, FX_FROM_INT(i), FX_FROM_INT(50));
+    }
+    // Oldest readings were overwritten
+    TEST_ASSERT_FALSE(sample_assembly_join(&sa, 0, &pm, &joint));
+    uint64_t last = (uint64_t)(SAMPLE_ASSEMBLY_ENV_HISTORY + 2) * 1000000;
+    TEST_ASSERT_TRUE(sample_assembly_join(&sa, last - 500000, &pm, &joint));
+    TEST_ASSERT_TRUE(joint.interpolated);
+    TEST_ASSERT_EQUAL_INT32(FX_FROM_INT(SAMPLE_ASSEMBLY_ENV_HISTORY + 1) + 50, joint.temperature);
+}
+
+void test_default_config(void) {
+    sample_assembly_init(&sa, NULL);
+    TEST_ASSERT_EQUAL_UINT32(SAMPLE_ASSEMBLY_DEFAULT_WINDOW_US, sa.config.align_window_us);
+    TEST_ASSERT_EQUAL_UINT32(SAMPLE_ASSEMBLY_DEFAULT_MAX_INTERP_GAP_US, sa.config.max_interp_gap_us);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_no_env_reading);
+    RUN_TEST(test_nearest_inside_window);
+    RUN_TEST(test_nearest_outside_window);
+    RUN_TEST(test_interpolates_between_bracketing_readings);
+    RUN_TEST(test_interpolation_rounds_to_nearest);
+    RUN_TEST(test_gap_too_long_falls_back_to_nearest);
+    RUN_TEST(test_exact_match_is_not_shifted);
+    RUN_TEST(test_history_keeps_latest_readings);
+    RUN_TEST(test_default_config);
+
+    return UNITY_END();
+}
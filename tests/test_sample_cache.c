@@ -0,0 +1,152 @@
+/**
+ * File: test_sample_cache.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the seqlock-protected latest-sample cache
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "sample_cache.h"
+#include <pthread.h>
+#include <string.h>
+
+#define WRITES      200000
+#define READERS     3
+
+static sample_cache_t cache;
+
+void setUp(void) {
+    sample_cache_init(&cache, 1000);
+}
+
+void tearDown(void) {}
+
+static pm25_data_t filled(uint16_t value) {
+    pm25_data_t data;
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        pm25_data_set(&data, (pm25_field_t)f, value);
+    }
+    return data;
+}
+
+void test_read_before_publish_fails(void) {
+    sample_cache_snapshot_t snap;
+    TEST_ASSERT_FALSE(sample_cache_read(&cache, 0, 0, &snap));
+}
+
+void test_read_returns_published_sample(void) {
+    pm25_data_t data = filled(42);
+    sample_cache_publish(&cache, 1, &data, 5000000);
+    sample_cache_snapshot_t snap;
+    TEST_ASSERT_TRUE(sample_cache_read(&cache, 1, 5250000, &snap));
+    TEST_ASSERT_EQUAL_MEMORY(&data, &snap.data, sizeof(data));
+    TEST_ASSERT_EQUAL_UINT64(5000000, snap.timestamp_us);
+    TEST_ASSERT_EQUAL_UINT32(250, snap.age_ms);
+    TEST_ASSERT_FALSE(snap.stale);
+    // Other entries are untouched
+    TEST_ASSERT_FALSE(sample_cache_read(&cache, 0, 5250000, &snap));
+}
+
+void test_old_sample_is_stale(void) {
+    pm25_data_t data = filled(7);
+    sample_cache_publish(&cache, 0, &data, 0);
+    sample_cache_snapshot_t snap;
+    TEST_ASSERT_TRUE(sample_cache_read(&cache, 0, 1000000, &snap));
+    TEST_ASSERT_FALSE(snap.stale);
+    TEST_ASSERT_TRUE(sample_cache_read(&cache, 0, 1001000, &snap));
+    TEST_ASSERT_TRUE(snap.stale);
+}
+
+void test_default_max_age(void) {
+    sample_cache_init(&cache, 0);
+    TEST_ASSERT_EQUAL_UINT32(SAMPLE_CACHE_DEFAULT_MAX_AGE_MS, cache.max_age_ms);
+}
+
+void test_invalid_index_is_rejected(void) {
+    pm25_data_t data = filled(1);
+    sample_cache_publish(&cache, SAMPLE_CACHE_MAX_ENTRIES, &data, 0);
+    sample_cache_snapshot_t snap;
+    TEST_ASSERT_FALSE(sample_cache_read(&cache, SAMPLE_CACHE_MAX_ENTRIES, 0, &snap));
+}
+
+void test_reader_gives_up_while_writer_is_busy(void) {
+    pm25_data_t data = filled(1);
+    sample_cache_publish(&cache, 0, &data, 0);
+    // Writer interrupted mid-update, e.g. by a reader IRQ on the same core
+    atomic_store(&cache.entries[0].seq, atomic_load(&cache.entries[0].seq) + 1);
+    sample_cache_snapshot_t snap;
+    TEST_ASSERT_FALSE(sample_cache_read(&cache, 0, 0, &snap));
+}
+
+static atomic_bool writer_done;
+
+static void *writer_thread(void *arg) {
+    for (uint32_t i = 1; i <= WRITES; i++) {
+        pm25_data_t data = filled((uint16_t)i);
+        sample_cache_publish(&cache, 0, &data, i);
+    }
+    atomic_store(&writer_done, true);
+    return NULL;
+}
+
+static void *reader_thread(void *arg) {
+    uintptr_t torn = 0;
+    uint64_t last = 0;
+    while (!atomic_load(&writer_done)) {
+        sample_cache_snapshot_t snap;
+        if (!sample_cache_read(&cache, 0, 0, &snap)) {
+            continue;
+        }
+        // Every field and the timestamp come from the same write, and time never goes back
+        uint16_t expect = (uint16_t)snap.timestamp_us;
+        for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+            if (pm25_data_get(&snap.data, (pm25_field_t)f) != expect) {
+                torn++;
+            }
+        }
+        if (snap.timestamp_us < last) {
+            torn++;
+        }
+        last = snap.timestamp_us;
+    }
+    return (void *)torn;
+}
+
+void test_concurrent_readers_never_see_torn_sample(void) {
+    pthread_t writer;
+    pthread_t readers[READERS];
+    atomic_store(&writer_done, false);
+
+    for (int i = 0; i < READERS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&readers[i], NULL, reader_thread, NULL));
+    }
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&writer, NULL, writer_thread, NULL));
+    pthread_join(writer, NULL);
+    for (int i = 0; i < READERS; i++) {
+        void *torn;
+        pthread_join(readers[i], &torn);
+        TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)(uintptr_t)torn);
+    }
+    sample_cache_snapshot_t snap;
+    TEST_ASSERT_TRUE(sample_cache_read(&cache, 0, WRITES, &snap));
+    TEST_ASSERT_EQUAL_UINT64(WRITES, snap.timestamp_us);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_read_before_publish_fails);
+    RUN_TEST(test_read_returns_published_sample);
+    RUN_TEST(test_old_sample_is_stale);
+    RUN_TEST(test_default_max_age);
+    RUN_TEST(test_invalid_index_is_rejected);
+    RUN_TEST(test_reader_gives_up_while_writer_is_busy);
+    RUN_TEST(test_concurrent_readers_never_see_torn_sample);
+
+    return UNITY_END();
+}
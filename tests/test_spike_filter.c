@@ -0,0 +1,136 @@
+/**
+ * File: test_spike_filter.c
+ * Author: trung.la
+ * Date: October 19 2026
+ * Description: Unit tests for the running median and the Hampel spike filter
+ * 
+ * COPYRIGHT RESERVED, 2025 Episteme Labs. All rights reserved.
+ * The reproduction, distribution and utilization of this document as well as the communication of its contents to
+ * others without explicit authorization is prohibited. Offenders will be held liable for the payment of damages.
+ * All rights reserved in the event of the grant of a patent, utility model or design.
+ */
+
+#include "unity.h"
+#include "running_median.h"
+#include "spike_filter.h"
+#include <stdlib.h>
+#include <string.h>
+
+static spike_filter_t filter;
+
+void setUp(void) {
+    spike_filter_init(&filter, NULL);
+}
+
+void tearDown(void) {}
+
+static uint16_t brute_force_median(const uint16_t *values, int n) {
+    uint16_t sorted[RUNNING_MEDIAN_MAX_WINDOW];
+    memcpy(sorted, values, n * sizeof(uint16_t));
+    for (int i = 1; i < n; i++) {
+        for (int j = i; j > 0 && sorted[j - 1] > sorted[j]; j--) {
+            uint16_t t = sorted[j];
+            sorted[j] = sorted[j - 1];
+            sorted[j - 1] = t;
+        }
+    }
+    if (n & 1) {
+        return sorted[n / 2];
+    }
+    return (uint16_t)(((uint32_t)sorted[n / 2 - 1] + sorted[n / 2]) / 2);
+}
+
+void test_running_median_matches_sort(void) {
+    for (uint8_t window = 1; window <= RUNNING_MEDIAN_MAX_WINDOW; window++) {
+        running_median_t rm;
+        uint16_t history[1000];
+
+        running_median_init(&rm, window);
+        srand(window);
+        for (int i = 0; i < 1000; i++) {
+            history[i] = (uint16_t)(rand() % 300);
+            running_median_insert(&rm, history[i]);
+
+            int n = (i + 1 < window) ? i + 1 : window;
+            TEST_ASSERT_EQUAL_UINT16(brute_force_median(&history[i + 1 - n], n), running_median_get(&rm));
+        }
+        TEST_ASSERT_TRUE(running_median_full(&rm));
+    }
+}
+
+static void fill(pm25_data_t *data, uint16_t value) {
+    for (int f = 0; f < PM25_FIELD_COUNT; f++) {
+        pm25_data_set(data, (pm25_field_t)f, value);
+    }
+}
+
+void test_spike_is_suppressed_and_flagged(void) {
+    pm25_data_t data;
+
+    for (int i = 0; i < SPIKE_FILTER_DEFAULT_WINDOW; i++) {
+        fill(&data, (uint16_t)(20 + (i & 1)));
+        TEST_ASSERT_EQUAL_UINT16(0, spike_filter_apply(&filter, &data));
+    }
+
+    fill(&data, 21);
+    data.pm2_5_atm = 500;
+    TEST_ASSERT_EQUAL_UINT16(PM25_FIELD_BIT(PM25_FIELD_PM2_5_ATM), spike_filter_apply(&filter, &data));
+    TEST_ASSERT_UINT_WITHIN(1, 20, data.pm2_5_atm);
+    TEST_ASSERT_EQUAL_UINT16(21, data.pm10_atm);
+    TEST_ASSERT_EQUAL_UINT32(1, filter.suppressed[PM25_FIELD_PM2_5_ATM]);
+}
+
+void test_no_flags_during_warmup(void) {
+    pm25_data_t data;
+
+    fill(&data, 20);
+    spike_filter_apply(&filter, &data);
+    fill(&data, 900);
+    TEST_ASSERT_EQUAL_UINT16(0, spike_filter_apply(&filter, &data));
+    TEST_ASSERT_EQUAL_UINT16(900, data.pm2_5_atm);
+}
+
+void test_level_shift_is_followed(void) {
+    pm25_data_t data;
+    uint16_t mask = 0;
+
+    for (int i = 0; i < SPIKE_FILTER_DEFAULT_WINDOW; i++) {
+        fill(&data, 20);
+        spike_filter_apply(&filter, &data);
+    }
+    // A sustained change is accepted once it holds the window majority
+    for (int i = 0; i < SPIKE_FILTER_DEFAULT_WINDOW; i++) {
+        fill(&data, 200);
+        mask = spike_filter_apply(&filter, &data);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, mask);
+    TEST_ASSERT_EQUAL_UINT16(200, data.pm2_5_atm);
+}
+
+void test_disabled_field_passes_through(void) {
+    spike_filter_config_t config;
+    pm25_data_t data;
+
+    spike_filter_default_config(&config);
+    config.fields[PM25_FIELD_COUNT_0_3].enabled = false;
+    spike_filter_init(&filter, &config);
+
+    for (int i = 0; i < SPIKE_FILTER_DEFAULT_WINDOW; i++) {
+        fill(&data, 20);
+        spike_filter_apply(&filter, &data);
+    }
+    fill(&data, 20);
+    data.count_0_3 = 5000;
+    TEST_ASSERT_EQUAL_UINT16(0, spike_filter_apply(&filter, &data));
+    TEST_ASSERT_EQUAL_UINT16(5000, data.count_0_3);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_running_median_matches_sort);
+    RUN_TEST(test_spike_is_suppressed_and_flagged);
+    RUN_TEST(test_no_flags_during_warmup);
+    RUN_TEST(test_level_shift_is_followed);
+    RUN_TEST(test_disabled_field_passes_through);
+    return UNITY_END();
+}